@@ -0,0 +1,96 @@
+#include "../bench_helpers.h"
+#include <c_base/base/macros.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/base/strings/C_Rope.h>
+#include <c_base/base/strings/strings.h>
+#include <c_base/base/varargs.h>
+
+#define PIECE_LEN 64
+#define DOCUMENT_LEN Megabytes(100)
+// the last tenth of the document comes from inserts
+#define APPEND_LEN (DOCUMENT_LEN / 10 * 9)
+#define CONCAT_LEN Kilobytes(512)
+
+static ascii piece[PIECE_LEN];
+
+/* the string grows by one piece per concat, every concat copies
+ * everything so far. kept short, it is quadratic */
+static void bench_string_concat(void) {
+  C_String* text = C_String_new_empty(0);
+  C_String* view = C_String_new(piece, PIECE_LEN);
+
+  Bench("C_String_concat_PR 64 bytes to 512KB", CONCAT_LEN / PIECE_LEN, {
+    for (u32 i = 0; i < CONCAT_LEN / PIECE_LEN; i++) {
+      text = C_String_concat_PR(Pass(text), view, ArgsEnd);
+    }
+  });
+
+  Unref(view);
+  Unref(text);
+}
+
+static void bench_rope_small(void) {
+  C_Rope* rope = C_Rope_new();
+  StringView view = StringView_construct(piece, PIECE_LEN);
+
+  Bench("C_Rope_append 64 bytes to 512KB", CONCAT_LEN / PIECE_LEN, {
+    for (u32 i = 0; i < CONCAT_LEN / PIECE_LEN; i++) {
+      C_Rope_append(rope, view);
+    }
+  });
+
+  Unref(rope);
+}
+
+static void bench_rope_document(void) {
+  C_Rope* rope = C_Rope_new();
+  StringView view = StringView_construct(piece, PIECE_LEN);
+
+  Bench("C_Rope_append 64 bytes to 90MB", APPEND_LEN / PIECE_LEN, {
+    for (u32 i = 0; i < APPEND_LEN / PIECE_LEN; i++) {
+      C_Rope_append(rope, view);
+    }
+  });
+
+  u64 insert_count = (DOCUMENT_LEN - APPEND_LEN) / PIECE_LEN;
+  Bench("C_Rope_insert 64 bytes at random to 100MB", insert_count, {
+    for (u64 i = 0; i < insert_count; i++) {
+      C_Rope_insert(rope, bench_rand() % (C_Rope_get_len(rope) + 1), view);
+    }
+  });
+  bench_report_value("  depth", C_Rope_get_depth(rope), "");
+
+  u64 found = 0;
+  Bench("C_Rope_at random (1M)", 1000000, {
+    for (u32 i = 0; i < 1000000; i++) {
+      found += C_Rope_at(rope, bench_rand() % C_Rope_get_len(rope)) == 'x';
+    }
+  });
+
+  Bench("C_Rope_delete 64 bytes at random (100k)", 100000, {
+    for (u32 i = 0; i < 100000; i++) {
+      C_Rope_delete(
+        rope, bench_rand() % (C_Rope_get_len(rope) - PIECE_LEN), PIECE_LEN);
+    }
+  });
+
+  C_String* flat = null;
+  Bench("C_Rope_to_str_R 100MB", 1, { flat = C_Rope_to_str_R(rope); });
+  bench_report_value("  length", C_String_get_len(flat), "bytes");
+  bench_report_value("  found", found, "");
+
+  Unref(flat);
+  Unref(rope);
+}
+
+int main(void) {
+  for (u32 i = 0; i < PIECE_LEN; i++) {
+    piece[i] = 'a' + i % 26;
+  }
+
+  bench_string_concat();
+  bench_rope_small();
+  bench_rope_document();
+
+  return 0;
+}
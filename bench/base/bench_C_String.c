@@ -0,0 +1,65 @@
+#include "../bench_helpers.h"
+#include <c_base/base/memory/allocator.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/base/strings/string_convert.h>
+#include <c_base/base/strings/strings.h>
+#include <c_base/ds/C_Array.h>
+
+#define STRING_LEN 1000000
+#define LONG_LEN 64
+
+// the strings start at different chars, so their hashes differ
+#define OFFSETS 16
+
+static ascii chars[LONG_LEN + OFFSETS];
+
+static void bench_copy(u32 len, char* name) {
+  C_Array* strings = C_Array_new(STRING_LEN);
+
+  u64 allocations = allocator_get_allocations();
+  Bench(name, STRING_LEN, {
+    for (u32 i = 0; i < STRING_LEN; i++) {
+      C_Array_put_P(
+        strings, i, Pass(C_String_new_copy(chars + i % OFFSETS, len)));
+    }
+  });
+  bench_report_value(
+    "  allocations", allocator_get_allocations() - allocations, "");
+
+  // reading the chars of strings spread over the heap
+  u64 sum = 0;
+  Bench("  IHashable_hash of each", STRING_LEN, {
+    C_ArrayForeach(strings, { sum += IHashable_hash(value); });
+  });
+  bench_report_value("  hash sum", sum % 1000000, "");
+
+  Unref(strings);
+}
+
+static void bench_numbers(void) {
+  C_Array* strings = C_Array_new(STRING_LEN);
+
+  u64 allocations = allocator_get_allocations();
+  Bench("u64_to_str_R (1M)", STRING_LEN, {
+    for (u32 i = 0; i < STRING_LEN; i++) {
+      C_Array_put_P(strings, i, Pass(u64_to_str_R(bench_rand())));
+    }
+  });
+  bench_report_value(
+    "  allocations", allocator_get_allocations() - allocations, "");
+
+  Unref(strings);
+}
+
+int main(void) {
+  for (u32 i = 0; i < LONG_LEN + OFFSETS; i++) {
+    chars[i] = 'a' + i % 26;
+  }
+
+  bench_copy(8, "C_String_new_copy 8 chars (1M)");
+  bench_copy(StringInlineCap, "C_String_new_copy 24 chars (1M)");
+  bench_copy(LONG_LEN, "C_String_new_copy 64 chars (1M)");
+  bench_numbers();
+
+  return 0;
+}
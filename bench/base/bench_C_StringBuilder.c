@@ -0,0 +1,219 @@
+#include "../bench_helpers.h"
+#include <c_base/base/memory/allocator.h>
+#include <c_base/base/memory/handles.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/base/strings/C_StringBuilder.h>
+#include <c_base/base/strings/format.h>
+#include <c_base/base/strings/string_convert.h>
+#include <c_base/base/strings/strings.h>
+#include <c_base/ds/C_Array.h>
+#include <c_base/ds/C_List.h>
+#include <c_base/os/os_io.h>
+
+#define VALUE_LEN 100000
+#define ROUNDS 10
+#define PRINT_LEN 1000000
+#define FORMAT_LEN 1000000
+// the splits are slow, fewer rounds
+#define SPLIT_LEN 100000
+
+/* how the formatters built their strings before, every piece is a string
+ * in a list that is joined at the end */
+static C_String* list_join_to_str_R(C_Array* values) {
+  C_String* sep = S(", ");
+  C_List* list = C_List_new();
+  C_List_push_P(list, PS("["));
+
+  C_ArrayForeach(values, {
+    C_List_push_P(list, Pass(IFormattable_to_str_PR(value)));
+    C_List_push_P(list, sep);
+  });
+  Unref(C_List_pop_R(list));
+  C_List_push_P(list, PS("]"));
+
+  C_String* result = C_String_join_PR(Pass(C_List_to_array_PR(list)));
+  Unref(list);
+  Unref(sep);
+  return result;
+}
+
+static void bench_to_str(C_Array* values) {
+  u64 len = 0;
+
+  Bench("C_List + C_String_join_PR to_str 100k values (10 rounds)",
+    ROUNDS * VALUE_LEN, {
+      for (u32 round = 0; round < ROUNDS; round++) {
+        C_String* str = list_join_to_str_R(values);
+        len += C_String_get_len(str);
+        Unref(str);
+      }
+    });
+
+  Bench("C_Array_to_str_R 100k values (10 rounds)", ROUNDS * VALUE_LEN, {
+    for (u32 round = 0; round < ROUNDS; round++) {
+      C_String* str = C_Array_to_str_R(values);
+      len += C_String_get_len(str);
+      Unref(str);
+    }
+  });
+  bench_report_value("  chars", len, "");
+}
+
+static void bench_numbers(void) {
+  u64 len = 0;
+
+  Bench("u64_to_str_R + C_List + join 100k numbers (10 rounds)",
+    ROUNDS * VALUE_LEN, {
+      for (u32 round = 0; round < ROUNDS; round++) {
+        C_List* list = C_List_new();
+        for (u32 i = 0; i < VALUE_LEN; i++) {
+          C_List_push_P(list, Pass(u64_to_str_R(bench_rand() % 1000000)));
+        }
+        C_String* str = C_String_join_PR(Pass(C_List_to_array_PR(list)));
+        len += C_String_get_len(str);
+        Unref(str);
+        Unref(list);
+      }
+    });
+
+  Bench("C_StringBuilder_append_u64 100k numbers (10 rounds)",
+    ROUNDS * VALUE_LEN, {
+      for (u32 round = 0; round < ROUNDS; round++) {
+        C_StringBuilder* builder = C_StringBuilder_new();
+        for (u32 i = 0; i < VALUE_LEN; i++) {
+          C_StringBuilder_append_u64(builder, bench_rand() % 1000000);
+        }
+        C_String* str = C_StringBuilder_finish_R(builder);
+        len += C_String_get_len(str);
+        Unref(str);
+        Unref(builder);
+      }
+    });
+  bench_report_value("  chars", len, "");
+}
+
+/* printing a large array to a file. before write_to it was made into one
+ * string first, from a string per value */
+static void bench_print(void) {
+  C_Array* values = C_Array_new(PRINT_LEN);
+  for (u32 i = 0; i < PRINT_LEN; i++) {
+    C_Array_put_P(values, i, Pass(C_Handle_u32_new(bench_rand() % 1000000)));
+  }
+
+  C_Result* open = C_File_new_open_P(PS("/dev/null"), FILE_W);
+  C_File* file = C_Result_force_R(open);
+  Unref(open);
+
+  u64 allocations = allocator_get_allocations();
+  Bench("list + join then write 1M values to /dev/null", PRINT_LEN, {
+    C_String* str = list_join_to_str_R(values);
+    Unref(C_File_write_chars_R(
+      file, C_String_get_chars(str), C_String_get_len(str)));
+    Unref(str);
+  });
+  bench_report_value(
+    "  allocations", allocator_get_allocations() - allocations, "");
+
+  allocations = allocator_get_allocations();
+  Bench("write_to a file sink 1M values to /dev/null", PRINT_LEN, {
+    C_StringBuilder* sink = C_File_new_sink(file);
+    IFormattable_write_to_PR(values, sink, null);
+    Unref(sink);
+  });
+  bench_report_value(
+    "  allocations", allocator_get_allocations() - allocations, "");
+
+  Unref(file);
+  Unref(values);
+}
+
+// how format_get_value_PR found a key before, two splits per lookup
+static C_String* split_get_value_PR(C_String* format, C_String* key) {
+  Ref(key);
+  C_Array* split1 = C_String_split_R(format, ';');
+
+  C_String* result = null;
+  C_ArrayForeach(split1, {
+    C_Array* split2 = C_String_split_R(value, '=');
+    if (C_String_equals(C_Array_at_B(split2, 0), key)) {
+      result = C_Array_at_R(split2, 1);
+    }
+    Unref(split2);
+  });
+
+  Unref(split1);
+  Unref(key);
+  return result;
+}
+
+static void bench_format(void) {
+  C_String* format = S("start=<;end=>;sep=|;el_sep= = ");
+  C_String* keys[4] = {S("start"), S("end"), S("sep"), S("el_sep")};
+  u64 len = 0;
+
+  Bench("C_String_split_R lookup of 4 keys (100k formats)", SPLIT_LEN, {
+    for (u32 i = 0; i < SPLIT_LEN; i++) {
+      for (u32 key = 0; key < 4; key++) {
+        C_String* value = split_get_value_PR(format, keys[key]);
+        len += C_String_get_len(value);
+        Unref(value);
+      }
+    }
+  });
+
+  Bench("C_Format_new_P and 4 fields (1M formats)", FORMAT_LEN, {
+    for (u32 i = 0; i < FORMAT_LEN; i++) {
+      C_Format* compiled = C_Format_new_P(format);
+      for (u32 field = 0; field < FormatFieldCount; field++) {
+        len += C_Format_get(compiled, field).len;
+      }
+      Unref(compiled);
+    }
+  });
+
+  // a short list formatted over and over, like a log line
+  C_Array* small = C_Array_new(3);
+  for (u32 i = 0; i < 3; i++) {
+    C_Array_put_P(small, i, Pass(C_Handle_u32_new(i * 1000)));
+  }
+
+  Bench("C_Array_to_str_format_R 3 values (1M)", FORMAT_LEN, {
+    for (u32 i = 0; i < FORMAT_LEN; i++) {
+      C_String* str = C_Array_to_str_format_R(small, format);
+      len += C_String_get_len(str);
+      Unref(str);
+    }
+  });
+
+  C_Format* compiled = C_Format_new_P(format);
+  Bench("IFormattable_to_str_compiled_PR 3 values (1M)", FORMAT_LEN, {
+    for (u32 i = 0; i < FORMAT_LEN; i++) {
+      C_String* str = IFormattable_to_str_compiled_PR(small, compiled);
+      len += C_String_get_len(str);
+      Unref(str);
+    }
+  });
+  bench_report_value("  chars", len, "");
+
+  Unref(compiled);
+  Unref(small);
+  for (u32 key = 0; key < 4; key++) {
+    Unref(keys[key]);
+  }
+  Unref(format);
+}
+
+int main(void) {
+  C_Array* values = C_Array_new(VALUE_LEN);
+  for (u32 i = 0; i < VALUE_LEN; i++) {
+    C_Array_put_P(values, i, Pass(C_Handle_u32_new(bench_rand() % 1000000)));
+  }
+
+  bench_to_str(values);
+  bench_numbers();
+  bench_print();
+  bench_format();
+
+  Unref(values);
+  return 0;
+}
@@ -0,0 +1,34 @@
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <time.h>
+
+#include "bench_helpers.h"
+
+static u64 bench_rand_state = 88172645463325252ul;
+
+u64 bench_now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (u64)ts.tv_sec * 1000000000ul + (u64)ts.tv_nsec;
+}
+
+void bench_report(char* name, u64 ns, u64 ops) {
+  f64 ns_per_op = (ops == 0) ? 0 : (f64)ns / (f64)ops;
+  f64 ops_per_sec = (ns == 0) ? 0 : (f64)ops * 1e9 / (f64)ns;
+
+  printf("%-48s %12.3f ms %12.2f ns/op %14.0f op/s\n", name, (f64)ns / 1e6,
+    ns_per_op, ops_per_sec);
+  fflush(stdout);
+}
+
+void bench_report_value(char* name, f64 value, char* unit) {
+  printf("%-48s %12.3f %s\n", name, value, unit);
+  fflush(stdout);
+}
+
+u64 bench_rand(void) {
+  bench_rand_state ^= bench_rand_state << 13;
+  bench_rand_state ^= bench_rand_state >> 7;
+  bench_rand_state ^= bench_rand_state << 17;
+  return bench_rand_state;
+}
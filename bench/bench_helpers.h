@@ -0,0 +1,19 @@
+#ifndef BENCH_HELPERS_H
+#define BENCH_HELPERS_H
+
+#include <c_base/base/types.h>
+
+#define Bench(name, ops, code)                                                 \
+  do {                                                                         \
+    u64 _start = bench_now_ns();                                               \
+    {code} bench_report(name, bench_now_ns() - _start, ops);                   \
+  } while (0)
+
+u64 bench_now_ns(void);
+void bench_report(char* name, u64 ns, u64 ops);
+void bench_report_value(char* name, f64 value, char* unit);
+
+/* xorshift, so benchmarks are reproducible between runs */
+u64 bench_rand(void);
+
+#endif
@@ -0,0 +1,133 @@
+#include "../bench_helpers.h"
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_BitSet.h>
+#include <c_base/ds/C_RoaringBitSet.h>
+#include <c_base/ds/ds_simd.h>
+#include <stdio.h>
+
+// 16M bits, 2MB per set
+#define BIT_LEN (1u << 24)
+#define OP_ROUNDS 20
+#define SPARSE_LEN 100000
+
+// keeps the results alive
+static u64 sink = 0;
+
+static void bench_dense(void) {
+  C_BitSet* a = C_BitSet_new(BIT_LEN);
+  C_BitSet* b = C_BitSet_new(BIT_LEN);
+  for (u32 i = 0; i < BIT_LEN / 2; i++) {
+    C_BitSet_set(a, bench_rand() % BIT_LEN);
+    C_BitSet_set(b, bench_rand() % BIT_LEN);
+  }
+
+  Bench("C_BitSet test (16M)", BIT_LEN, {
+    for (u32 i = 0; i < BIT_LEN; i++) {
+      sink += C_BitSet_test(a, i);
+    }
+  });
+
+  Bench("C_BitSet find_next_set, all (16M bits)", BIT_LEN, {
+    u64 index = C_BitSet_find_next_set(a, 0);
+    while (index < BIT_LEN) {
+      index = C_BitSet_find_next_set(a, index + 1);
+    }
+  });
+
+  // ops are words
+  u64 words = (u64)C_BitSet_get_word_len(a) * OP_ROUNDS;
+  for (SimdLevel level = SIMD_SCALAR; level <= simd_detect_level();
+       level++) {
+    simd_set_level(level);
+    char name[64];
+
+    snprintf(name, sizeof(name), "  count (16M bits, %s)",
+      simd_level_name(level));
+    Bench(name, words, {
+      for (u32 round = 0; round < OP_ROUNDS; round++) {
+        sink += C_BitSet_count(a);
+      }
+    });
+
+    snprintf(
+      name, sizeof(name), "  and (16M bits, %s)", simd_level_name(level));
+    Bench(name, words, {
+      for (u32 round = 0; round < OP_ROUNDS; round++) {
+        C_BitSet_and(a, b);
+      }
+    });
+
+    snprintf(
+      name, sizeof(name), "  or (16M bits, %s)", simd_level_name(level));
+    Bench(name, words, {
+      for (u32 round = 0; round < OP_ROUNDS; round++) {
+        C_BitSet_or(a, b);
+      }
+    });
+  }
+  simd_set_level(simd_detect_level());
+
+  Unref(a);
+  Unref(b);
+}
+
+// the same values in a dense and a compressed set
+static void bench_compressed(char* title, u32 len, u32 range) {
+  C_BitSet* dense_a = C_BitSet_new(range);
+  C_BitSet* dense_b = C_BitSet_new(range);
+  C_RoaringBitSet* a = C_RoaringBitSet_new();
+  C_RoaringBitSet* b = C_RoaringBitSet_new();
+  for (u32 i = 0; i < len; i++) {
+    u32 value_a = (u32)(bench_rand() % range);
+    u32 value_b = (u32)(bench_rand() % range);
+    C_BitSet_set(dense_a, value_a);
+    C_BitSet_set(dense_b, value_b);
+    C_RoaringBitSet_add(a, value_a);
+    C_RoaringBitSet_add(b, value_b);
+  }
+
+  bench_report_value(title, len, "values");
+  bench_report_value(
+    "  C_BitSet memory", (f64)C_BitSet_get_word_len(dense_a) * 8, "bytes");
+  bench_report_value(
+    "  C_RoaringBitSet memory", C_RoaringBitSet_get_bytes(a), "bytes");
+
+  Bench("  C_BitSet and + count", len, {
+    C_BitSet_and(dense_a, dense_b);
+    sink += C_BitSet_count(dense_a);
+  });
+
+  Bench("  C_RoaringBitSet and_R", len, {
+    C_RoaringBitSet* result = C_RoaringBitSet_and_R(a, b);
+    sink += C_RoaringBitSet_get_len(result);
+    Unref(result);
+  });
+
+  Bench("  C_RoaringBitSet or_R", len, {
+    C_RoaringBitSet* result = C_RoaringBitSet_or_R(a, b);
+    sink += C_RoaringBitSet_get_len(result);
+    Unref(result);
+  });
+
+  Bench("  C_RoaringBitSet contains", len, {
+    for (u32 i = 0; i < len; i++) {
+      sink += C_RoaringBitSet_contains(a, (u32)(bench_rand() % range));
+    }
+  });
+
+  Unref(dense_a);
+  Unref(dense_b);
+  Unref(a);
+  Unref(b);
+}
+
+int main(void) {
+  bench_dense();
+  // 1 value per 2700, the dense sets are 32MB
+  bench_compressed("sparse, 256M", SPARSE_LEN, 1u << 28);
+  // about 4 of 10 bits set
+  bench_compressed("dense, 16M", BIT_LEN / 2, BIT_LEN);
+
+  bench_report_value("sink", sink != 0, "");
+  return 0;
+}
@@ -0,0 +1,123 @@
+#include "../bench_helpers.h"
+#include <c_base/base/memory/allocator.h>
+#include <c_base/base/memory/handles.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_Array.h>
+#include <c_base/ds/C_DArray.h>
+
+#define PUSH_LEN 1000000
+#define BATCH_LEN 1000
+#define SMALL_COUNT 100000
+#define SMALL_LEN 4
+
+/* the same handle is pushed over and over,
+ * so the numbers do not include allocating values */
+
+static void bench_push(C_Handle_u32* handle) {
+  C_DArray* darray = C_DArray_new();
+  Bench("C_DArray_push_P (1M)", PUSH_LEN, {
+    for (u32 i = 0; i < PUSH_LEN; i++) {
+      C_DArray_push_P(darray, handle);
+    }
+  });
+  Unref(darray);
+
+  C_Array* batch = C_Array_new(BATCH_LEN);
+  for (u32 i = 0; i < BATCH_LEN; i++) {
+    C_Array_put_P(batch, i, handle);
+  }
+
+  darray = C_DArray_new();
+  Bench("C_DArray_push_array_P 1k batches (1M)", PUSH_LEN, {
+    for (u32 i = 0; i < PUSH_LEN / BATCH_LEN; i++) {
+      C_DArray_push_array_P(darray, batch);
+    }
+  });
+  Unref(darray);
+
+  Unref(batch);
+}
+
+static void bench_growth(C_Handle_u32* handle, char* name, DArrayGrowth growth) {
+  C_DArray* darray = C_DArray_new();
+  C_DArray_set_growth(darray, growth);
+
+  Bench(name, PUSH_LEN, {
+    for (u32 i = 0; i < PUSH_LEN; i++) {
+      C_DArray_push_P(darray, handle);
+    }
+  });
+  bench_report_value("  capacity", C_DArray_get_cap(darray), "values");
+
+  Unref(darray);
+}
+
+/* short arrays are created and destroyed right away, the allocation counts
+ * show that their values live inside the object */
+static void bench_small(C_Handle_u32* handle) {
+  u64 allocations = allocator_get_allocations();
+  Bench("C_DArray_new + 4 pushes (100k)", SMALL_COUNT, {
+    for (u32 i = 0; i < SMALL_COUNT; i++) {
+      C_DArray* darray = C_DArray_new();
+      for (u32 j = 0; j < SMALL_LEN; j++) {
+        C_DArray_push_P(darray, handle);
+      }
+      Unref(darray);
+    }
+  });
+  bench_report_value("  allocations per darray",
+    (f64)(allocator_get_allocations() - allocations) / SMALL_COUNT, "");
+
+  allocations = allocator_get_allocations();
+  Bench("C_DArray_new + 16 pushes (100k)", SMALL_COUNT, {
+    for (u32 i = 0; i < SMALL_COUNT; i++) {
+      C_DArray* darray = C_DArray_new();
+      for (u32 j = 0; j < 4 * SMALL_LEN; j++) {
+        C_DArray_push_P(darray, handle);
+      }
+      Unref(darray);
+    }
+  });
+  bench_report_value("  allocations per darray",
+    (f64)(allocator_get_allocations() - allocations) / SMALL_COUNT, "");
+
+  allocations = allocator_get_allocations();
+  Bench("C_Array_new 4 values (100k)", SMALL_COUNT, {
+    for (u32 i = 0; i < SMALL_COUNT; i++) {
+      C_Array* array = C_Array_new(SMALL_LEN);
+      for (u32 j = 0; j < SMALL_LEN; j++) {
+        C_Array_put_P(array, j, handle);
+      }
+      Unref(array);
+    }
+  });
+  bench_report_value("  allocations per array",
+    (f64)(allocator_get_allocations() - allocations) / SMALL_COUNT, "");
+
+  C_String* string = S("a,b,c");
+  allocations = allocator_get_allocations();
+  Bench("C_String_split_R 3 parts (100k)", SMALL_COUNT, {
+    for (u32 i = 0; i < SMALL_COUNT; i++) {
+      Unref(C_String_split_R(string, ','));
+    }
+  });
+  bench_report_value("  allocations per split",
+    (f64)(allocator_get_allocations() - allocations) / SMALL_COUNT, "");
+  Unref(string);
+}
+
+int main(void) {
+  C_Handle_u32* handle = C_Handle_u32_new(1);
+
+  bench_push(handle);
+  bench_growth(handle, "C_DArray_push_P DArrayGrowth_double (1M)",
+    DArrayGrowth_double);
+  bench_growth(handle, "C_DArray_push_P DArrayGrowth_one_half (1M)",
+    DArrayGrowth_one_half);
+  bench_growth(handle, "C_DArray_push_P DArrayGrowth_pages (1M)",
+    DArrayGrowth_pages);
+  bench_small(handle);
+
+  Unref(handle);
+  return 0;
+}
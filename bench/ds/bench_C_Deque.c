@@ -0,0 +1,96 @@
+#include "../bench_helpers.h"
+#include <c_base/base/memory/handles.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_DArray.h>
+#include <c_base/ds/C_Deque.h>
+#include <c_base/ds/C_List.h>
+
+#define FIFO_LEN 1000000
+#define FIFO_OPS 1000000
+/* pop_front on a C_DArray moves the whole buffer, keep it short */
+#define DARRAY_LEN 10000
+#define DARRAY_OPS 10000
+
+/* the same handle is queued over and over,
+ * so the numbers do not include allocating values */
+
+static void bench_fifo(C_Handle_u32* handle) {
+  C_Deque* deque = C_Deque_new();
+
+  Bench("C_Deque push_P (1M)", FIFO_LEN, {
+    for (u32 i = 0; i < FIFO_LEN; i++) {
+      C_Deque_push_P(deque, handle);
+    }
+  });
+
+  Bench("C_Deque push_P/pop_front_R at 1M", FIFO_OPS, {
+    for (u32 i = 0; i < FIFO_OPS; i++) {
+      C_Deque_push_P(deque, handle);
+      Unref(C_Deque_pop_front_R(deque));
+    }
+  });
+
+  Bench("C_Deque push_front_P/pop_R at 1M", FIFO_OPS, {
+    for (u32 i = 0; i < FIFO_OPS; i++) {
+      C_Deque_push_front_P(deque, handle);
+      Unref(C_Deque_pop_R(deque));
+    }
+  });
+
+  Bench("C_Deque pop_front_R (1M)", FIFO_LEN, {
+    for (u32 i = 0; i < FIFO_LEN; i++) {
+      Unref(C_Deque_pop_front_R(deque));
+    }
+  });
+
+  Unref(deque);
+}
+
+static void bench_fifo_others(C_Handle_u32* handle) {
+  C_List* list = C_List_new();
+  for (u32 i = 0; i < FIFO_LEN; i++) {
+    C_List_push_P(list, handle);
+  }
+
+  Bench("C_List push_P/pop_front_R at 1M", FIFO_OPS, {
+    for (u32 i = 0; i < FIFO_OPS; i++) {
+      C_List_push_P(list, handle);
+      Unref(C_List_pop_front_R(list));
+    }
+  });
+
+  C_DArray* darray = C_DArray_new();
+  C_Deque* deque = C_Deque_new();
+  for (u32 i = 0; i < DARRAY_LEN; i++) {
+    C_DArray_push_P(darray, handle);
+    C_Deque_push_P(deque, handle);
+  }
+
+  Bench("C_DArray push_P/pop_front_R at 10k", DARRAY_OPS, {
+    for (u32 i = 0; i < DARRAY_OPS; i++) {
+      C_DArray_push_P(darray, handle);
+      Unref(C_DArray_pop_front_R(darray));
+    }
+  });
+
+  Bench("C_Deque push_P/pop_front_R at 10k", DARRAY_OPS, {
+    for (u32 i = 0; i < DARRAY_OPS; i++) {
+      C_Deque_push_P(deque, handle);
+      Unref(C_Deque_pop_front_R(deque));
+    }
+  });
+
+  Unref(list);
+  Unref(darray);
+  Unref(deque);
+}
+
+int main(void) {
+  C_Handle_u32* handle = C_Handle_u32_new(1);
+
+  bench_fifo(handle);
+  bench_fifo_others(handle);
+
+  Unref(handle);
+  return 0;
+}
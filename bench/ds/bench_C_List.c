@@ -0,0 +1,105 @@
+#include "../bench_helpers.h"
+#include <c_base/base/memory/handles.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_Array.h>
+#include <c_base/ds/C_HashTable.h>
+#include <c_base/ds/C_List.h>
+
+#define LIST_LEN 100000
+/* the indexed loop is quadratic, at 100k it runs for over a minute */
+#define INDEXED_LEN 10000
+#define CHAIN_LEN 2000
+#define QUEUE_OPS 1000000
+#define QUEUE_DEPTH 16
+
+static C_List* make_list(u32 len) {
+  C_List* list = C_List_new();
+  for (u32 i = 0; i < len; i++) {
+    C_List_push_P(list, Pass(C_Handle_u32_new(i)));
+  }
+  return list;
+}
+
+static void bench_traversal(void) {
+  C_List* list = make_list(LIST_LEN);
+  C_List* list2 = make_list(LIST_LEN);
+  C_List* short_list = make_list(INDEXED_LEN);
+  volatile u64 sum = 0;
+
+  Bench("C_List indexed at_B loop (10k)", INDEXED_LEN, {
+    for (u32 i = 0; i < C_List_get_len(short_list); i++) {
+      sum += C_Handle_u32_get_value(C_List_at_B(short_list, i));
+    }
+  });
+
+  Bench("C_ListForeach (10k)", INDEXED_LEN, {
+    C_ListForeach(short_list, { sum += C_Handle_u32_get_value(value); });
+  });
+
+  Bench("C_ListForeach (100k)", LIST_LEN, {
+    C_ListForeach(list, { sum += C_Handle_u32_get_value(value); });
+  });
+
+  Bench("C_List_to_array_PR (100k)", LIST_LEN,
+    { Unref(C_List_to_array_PR(list)); });
+
+  Bench("C_List_equals (100k)", LIST_LEN,
+    { sum += C_List_equals(list, list2); });
+
+  Bench("C_List_hash (100k)", LIST_LEN, { sum += C_List_hash(list); });
+
+  Unref(list);
+  Unref(list2);
+  Unref(short_list);
+}
+
+static void bench_hash_table_chains(void) {
+  /* one bucket, so every lookup scans a single long chain */
+  C_HashTable* table = C_HashTable_new_cap(1);
+  for (u32 i = 0; i < CHAIN_LEN; i++) {
+    C_HashTable_put_P(table, Pass(C_Handle_u32_new(i)), null);
+  }
+
+  volatile u64 found = 0;
+  C_Handle_u32* key = C_Handle_u32_new(CHAIN_LEN - 1);
+  Bench("C_HashTable_contains_P (2k chain, key at end)", CHAIN_LEN, {
+    for (u32 i = 0; i < CHAIN_LEN; i++) {
+      found += C_HashTable_contains_P(table, key);
+    }
+  });
+
+  Unref(key);
+  Unref(table);
+}
+
+static void bench_queue_churn(char* name, u32 node_cache_cap) {
+  C_List* queue = C_List_new();
+  C_List_set_node_cache_cap(queue, node_cache_cap);
+  C_Handle_u32* handle = C_Handle_u32_new(0);
+
+  Bench(name, QUEUE_OPS, {
+    for (u32 i = 0; i < QUEUE_OPS / QUEUE_DEPTH; i++) {
+      for (u32 j = 0; j < QUEUE_DEPTH; j++) {
+        C_List_push_P(queue, handle);
+      }
+      for (u32 j = 0; j < QUEUE_DEPTH; j++) {
+        Unref(C_List_pop_front_R(queue));
+      }
+    }
+  });
+
+  ListStats stats = C_List_get_stats(queue);
+  bench_report_value(
+    "  node cache hit rate", ListStats_hit_rate(&stats) * 100, "%");
+
+  Unref(handle);
+  Unref(queue);
+}
+
+int main(void) {
+  bench_traversal();
+  bench_queue_churn("C_List queue churn, no node cache (1M)", 0);
+  bench_queue_churn("C_List queue churn, node cache (1M)", ListNodeCacheCap);
+  bench_hash_table_chains();
+  return 0;
+}
@@ -0,0 +1,137 @@
+#include "../bench_helpers.h"
+#include <c_base/base/memory/allocator.h>
+#include <c_base/base/memory/handles.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_DArray.h>
+#include <c_base/ds/C_OrderedMap.h>
+
+// every sorted darray insert moves half the darray, so it stays small
+#define MAP_LEN 30000
+#define LOOKUPS 1000000
+#define SCANS 100000
+#define SCAN_LEN 100
+#define MIXED_OPS 100000
+
+/* the keys are created up front and left to process exit, with the maps,
+ * so the numbers only include the containers. the darray stores the keys
+ * as values too, each one is a key and its own value */
+
+static C_Handle_u64** make_keys(u32 len) {
+  C_Handle_u64** keys = allocate(len * sizeof(C_Handle_u64*));
+  for (u32 i = 0; i < len; i++) {
+    keys[i] = C_Handle_u64_new(bench_rand());
+  }
+  return keys;
+}
+
+static void bench_darray(C_Handle_u64** keys, C_Handle_u64** probes) {
+  C_DArray* darray = C_DArray_new();
+  CompareFunc compare = C_Handle_u64_compare;
+
+  Bench("sorted C_DArray insert (30k)", MAP_LEN, {
+    for (u32 i = 0; i < MAP_LEN; i++) {
+      C_DArray_insert_sorted_P(darray, keys[i], compare);
+    }
+  });
+
+  u64 found = 0;
+  Bench("sorted C_DArray lookup (30k, 1M)", LOOKUPS, {
+    for (u32 i = 0; i < LOOKUPS; i++) {
+      void* key = keys[i % MAP_LEN];
+      u32 index = C_DArray_lower_bound(darray, key, compare);
+      found += C_DArray_at_B(darray, index) == key;
+    }
+  });
+  bench_report_value("  found", found, "keys");
+
+  u64 sum = 0;
+  Bench("sorted C_DArray scan 100 keys (30k, 100k)", SCANS * SCAN_LEN, {
+    for (u32 i = 0; i < SCANS; i++) {
+      u32 index = C_DArray_lower_bound(darray, probes[i % MAP_LEN], compare);
+      u32 end = index + SCAN_LEN;
+      end = end < C_DArray_get_len(darray) ? end : C_DArray_get_len(darray);
+      for (; index < end; index++) {
+        sum += C_Handle_u64_get_value(C_DArray_at_B(darray, index));
+      }
+    }
+  });
+  bench_report_value("  sum", sum, "");
+
+  // a new key on every 10th operation, the rest are short scans
+  C_Handle_u64** extra = make_keys(MIXED_OPS / 10);
+  sum = 0;
+  Bench("sorted C_DArray 10% insert 90% scan (100k)", MIXED_OPS, {
+    for (u32 i = 0; i < MIXED_OPS; i++) {
+      if (i % 10 == 0) {
+        C_DArray_insert_sorted_P(darray, extra[i / 10], compare);
+        continue;
+      }
+      u32 index = C_DArray_lower_bound(darray, probes[i % MAP_LEN], compare);
+      u32 end = index + SCAN_LEN;
+      end = end < C_DArray_get_len(darray) ? end : C_DArray_get_len(darray);
+      for (; index < end; index++) {
+        sum += C_Handle_u64_get_value(C_DArray_at_B(darray, index));
+      }
+    }
+  });
+  bench_report_value("  sum", sum, "");
+}
+
+static void bench_map(C_Handle_u64** keys, C_Handle_u64** probes) {
+  C_OrderedMap* map = C_OrderedMap_new_by(C_Handle_u64_compare);
+
+  Bench("C_OrderedMap put (30k)", MAP_LEN, {
+    for (u32 i = 0; i < MAP_LEN; i++) {
+      C_OrderedMap_put_P(map, keys[i], keys[i]);
+    }
+  });
+  bench_report_value("  depth", C_OrderedMap_get_depth(map), "levels");
+
+  u64 found = 0;
+  Bench("C_OrderedMap lookup (30k, 1M)", LOOKUPS, {
+    for (u32 i = 0; i < LOOKUPS; i++) {
+      void* key = keys[i % MAP_LEN];
+      found += C_OrderedMap_at_PB(map, key) == key;
+    }
+  });
+  bench_report_value("  found", found, "keys");
+
+  u64 sum = 0;
+  Bench("C_OrderedMap scan 100 keys (30k, 100k)", SCANS * SCAN_LEN, {
+    for (u32 i = 0; i < SCANS; i++) {
+      MapCursor cursor = C_OrderedMap_lower_bound_P(map, probes[i % MAP_LEN]);
+      for (u32 j = 0; j < SCAN_LEN && MapCursor_valid(&cursor); j++) {
+        sum += C_Handle_u64_get_value(MapCursor_get_value_B(&cursor));
+        MapCursor_next(&cursor);
+      }
+    }
+  });
+  bench_report_value("  sum", sum, "");
+
+  C_Handle_u64** extra = make_keys(MIXED_OPS / 10);
+  sum = 0;
+  Bench("C_OrderedMap 10% insert 90% scan (100k)", MIXED_OPS, {
+    for (u32 i = 0; i < MIXED_OPS; i++) {
+      if (i % 10 == 0) {
+        C_OrderedMap_put_P(map, extra[i / 10], extra[i / 10]);
+        continue;
+      }
+      MapCursor cursor = C_OrderedMap_lower_bound_P(map, probes[i % MAP_LEN]);
+      for (u32 j = 0; j < SCAN_LEN && MapCursor_valid(&cursor); j++) {
+        sum += C_Handle_u64_get_value(MapCursor_get_value_B(&cursor));
+        MapCursor_next(&cursor);
+      }
+    }
+  });
+  bench_report_value("  sum", sum, "");
+}
+
+int main(void) {
+  C_Handle_u64** keys = make_keys(MAP_LEN);
+  C_Handle_u64** probes = make_keys(MAP_LEN);
+
+  bench_darray(keys, probes);
+  bench_map(keys, probes);
+
+  return 0;
+}
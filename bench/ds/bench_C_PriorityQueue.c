@@ -0,0 +1,127 @@
+#include "../bench_helpers.h"
+#include <c_base/base/memory/allocator.h>
+#include <c_base/base/memory/handles.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_DArray.h>
+#include <c_base/ds/C_PriorityQueue.h>
+
+#define QUEUE_LEN 20000
+#define HOLD_OPS 1000000
+// every sorted insert moves half the darray, fewer rounds keep it short
+#define SORTED_HOLD_OPS 20000
+
+/* the handles are created up front and left to process exit,
+ * so the numbers only include the queues */
+
+static s32 compare_descending(void* a, void* b) {
+  return C_Handle_u32_compare(b, a);
+}
+
+static C_Handle_u32** make_values(u32 len) {
+  C_Handle_u32** values = allocate(len * sizeof(C_Handle_u32*));
+  for (u32 i = 0; i < len; i++) {
+    values[i] = C_Handle_u32_new(bench_rand());
+  }
+  return values;
+}
+
+// what the schedulers do today, sorted largest first so pop takes the end
+static void bench_sorted_darray(C_Handle_u32** values) {
+  C_DArray* darray = C_DArray_new();
+
+  Bench("sorted C_DArray insert (20k)", QUEUE_LEN, {
+    for (u32 i = 0; i < QUEUE_LEN; i++) {
+      C_DArray_insert_sorted_P(darray, values[i], compare_descending);
+    }
+  });
+
+  Bench("sorted C_DArray pop + insert (20k held, 20k)", SORTED_HOLD_OPS, {
+    for (u32 i = 0; i < SORTED_HOLD_OPS; i++) {
+      Unref(C_DArray_pop_R(darray));
+      C_DArray_insert_sorted_P(
+        darray, values[i % QUEUE_LEN], compare_descending);
+    }
+  });
+
+  Bench("sorted C_DArray pop (20k)", QUEUE_LEN, {
+    for (u32 i = 0; i < QUEUE_LEN; i++) {
+      Unref(C_DArray_pop_R(darray));
+    }
+  });
+
+  Unref(darray);
+}
+
+static void bench_queue(C_Handle_u32** values) {
+  C_PriorityQueue* queue = C_PriorityQueue_new_by(C_Handle_u32_compare);
+
+  Bench("C_PriorityQueue push (20k)", QUEUE_LEN, {
+    for (u32 i = 0; i < QUEUE_LEN; i++) {
+      C_PriorityQueue_push_P(queue, values[i]);
+    }
+  });
+
+  Bench("C_PriorityQueue pop + push (20k held, 1M)", HOLD_OPS, {
+    for (u32 i = 0; i < HOLD_OPS; i++) {
+      Unref(C_PriorityQueue_pop_R(queue));
+      C_PriorityQueue_push_P(queue, values[i % QUEUE_LEN]);
+    }
+  });
+
+  Bench("C_PriorityQueue pop (20k)", QUEUE_LEN, {
+    for (u32 i = 0; i < QUEUE_LEN; i++) {
+      Unref(C_PriorityQueue_pop_R(queue));
+    }
+  });
+
+  Unref(queue);
+}
+
+static void bench_queue_u64(void) {
+  C_PriorityQueue_u64* queue = C_PriorityQueue_u64_new();
+  PriorityHandle* handles = allocate(QUEUE_LEN * sizeof(PriorityHandle));
+
+  Bench("C_PriorityQueue_u64 push (20k)", QUEUE_LEN, {
+    for (u32 i = 0; i < QUEUE_LEN; i++) {
+      u64 priority = (bench_rand() >> 2) | ((u64)1 << 62);
+      handles[i] = C_PriorityQueue_u64_push(queue, priority, i);
+    }
+  });
+
+  /* every value moves closer to the front, like a dijkstra relaxation.
+   * the pushed priorities are all above 2^62 and the new ones below */
+  Bench("C_PriorityQueue_u64 decrease_key (20k)", QUEUE_LEN, {
+    for (u32 i = 0; i < QUEUE_LEN; i++) {
+      C_PriorityQueue_u64_decrease_key(queue, handles[i], bench_rand() >> 2);
+    }
+  });
+
+  u64 sum = 0;
+  Bench("C_PriorityQueue_u64 pop + push (20k held, 1M)", HOLD_OPS, {
+    for (u32 i = 0; i < HOLD_OPS; i++) {
+      PriorityEntry entry = C_PriorityQueue_u64_pop(queue);
+      sum += entry.value;
+      C_PriorityQueue_u64_push(queue, bench_rand() >> 1, entry.value);
+    }
+  });
+  bench_report_value("value sum", sum, "");
+
+  Bench("C_PriorityQueue_u64 pop (20k)", QUEUE_LEN, {
+    for (u32 i = 0; i < QUEUE_LEN; i++) {
+      C_PriorityQueue_u64_pop(queue);
+    }
+  });
+
+  deallocate(handles);
+  Unref(queue);
+}
+
+int main(void) {
+  C_Handle_u32** values = make_values(QUEUE_LEN);
+
+  bench_sorted_darray(values);
+  bench_queue(values);
+  bench_queue_u64();
+
+  return 0;
+}
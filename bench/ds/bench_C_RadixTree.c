@@ -0,0 +1,132 @@
+#include "../bench_helpers.h"
+#include <c_base/base/memory/allocator.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/base/strings/strings.h>
+#include <c_base/ds/C_HashTable.h>
+#include <c_base/ds/C_RadixTree.h>
+
+#define KEY_LEN 200000
+#define LOOKUPS 1000000
+#define ROUTES 64
+#define SCANS 10000
+
+/* path like keys below a few shared directories, so the tree has long
+ * shared prefixes and wide nodes after them. the keys are created up
+ * front and left to process exit, with the containers */
+static char* dirs[] = {
+  "/api/v1/users/", "/api/v1/orders/", "/api/v2/users/", "/static/img/"};
+
+static C_String* make_key(void) {
+  ascii buffer[32];
+  char* dir = dirs[bench_rand() % 4];
+  u32 len = 0;
+  while (dir[len]) {
+    buffer[len] = dir[len];
+    len++;
+  }
+
+  u64 bits = bench_rand();
+  for (u32 i = 0; i < 12; i++) {
+    buffer[len++] = "0123456789abcdef"[bits & 15];
+    bits >>= 4;
+  }
+  return C_String_new_copy(buffer, len);
+}
+
+static C_String** make_keys(u32 len) {
+  C_String** keys = allocate(len * sizeof(C_String*));
+  for (u32 i = 0; i < len; i++) {
+    keys[i] = make_key();
+  }
+  return keys;
+}
+
+static void bench_hashtable(C_String** keys) {
+  // the table does not grow, it gets one bucket per key
+  C_HashTable* table = C_HashTable_new_cap(KEY_LEN);
+
+  Bench("C_HashTable put (200k)", KEY_LEN, {
+    for (u32 i = 0; i < KEY_LEN; i++) {
+      C_HashTable_put_P(table, keys[i], keys[i]);
+    }
+  });
+
+  u64 found = 0;
+  Bench("C_HashTable lookup (200k, 1M)", LOOKUPS, {
+    for (u32 i = 0; i < LOOKUPS; i++) {
+      void* key = keys[bench_rand() % KEY_LEN];
+      found += C_HashTable_at_PB(table, key) == key;
+    }
+  });
+  bench_report_value("  found", found, "keys");
+}
+
+static bool count_visit(StringView key, void* value, void* data) {
+  (void)key;
+  (void)value;
+  (*(u64*)data)++;
+  return true;
+}
+
+static void bench_tree(C_String** keys) {
+  C_RadixTree* tree = C_RadixTree_new();
+
+  Bench("C_RadixTree put (200k)", KEY_LEN, {
+    for (u32 i = 0; i < KEY_LEN; i++) {
+      C_RadixTree_put_P(tree, C_String_get_view(keys[i]), keys[i]);
+    }
+  });
+
+  u64 found = 0;
+  Bench("C_RadixTree lookup (200k, 1M)", LOOKUPS, {
+    for (u32 i = 0; i < LOOKUPS; i++) {
+      C_String* key = keys[bench_rand() % KEY_LEN];
+      found += C_RadixTree_at_B(tree, C_String_get_view(key)) == key;
+    }
+  });
+  bench_report_value("  found", found, "keys");
+
+  // a routing table, every key is matched against a few short prefixes
+  C_RadixTree* routes = C_RadixTree_new();
+  for (u32 i = 0; i < ROUTES; i++) {
+    C_String* route = C_String_substr_R(keys[i], 0, 16);
+    if (!C_RadixTree_contains(routes, C_String_get_view(route))) {
+      C_RadixTree_put_P(routes, C_String_get_view(route), route);
+    }
+    Unref(route);
+  }
+  for (u32 i = 0; i < 4; i++) {
+    StringView dir = StringView_construct(dirs[i], cstr_len(dirs[i]));
+    C_RadixTree_put_P(routes, dir, keys[i]);
+  }
+
+  u64 matched = 0;
+  Bench("C_RadixTree longest prefix (1M)", LOOKUPS, {
+    for (u32 i = 0; i < LOOKUPS; i++) {
+      StringView key = C_String_get_view(keys[bench_rand() % KEY_LEN]);
+      u32 len = 0;
+      C_RadixTree_longest_prefix_B(routes, key, &len);
+      matched += len;
+    }
+  });
+  bench_report_value("  matched", matched, "bytes");
+
+  u64 visited = 0;
+  Bench("C_RadixTree foreach prefix of 16 bytes (10k)", SCANS, {
+    for (u32 i = 0; i < SCANS; i++) {
+      StringView prefix = C_String_get_view(keys[bench_rand() % KEY_LEN]);
+      prefix.len = 16;
+      C_RadixTree_foreach_prefix(tree, prefix, count_visit, &visited);
+    }
+  });
+  bench_report_value("  visited", visited, "keys");
+}
+
+int main(void) {
+  C_String** keys = make_keys(KEY_LEN);
+
+  bench_hashtable(keys);
+  bench_tree(keys);
+
+  return 0;
+}
@@ -0,0 +1,121 @@
+#include "../bench_helpers.h"
+#include <c_base/base/memory/allocator.h>
+#include <c_base/base/memory/handles.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_DArray.h>
+#include <c_base/ds/C_SlotMap.h>
+
+#define LIVE_LEN 10000
+#define CHURN_LEN 100000
+#define LOOKUP_LEN 1000000
+#define ITERATE_ROUNDS 100
+
+/* both stores hold LIVE_LEN values, the same handle object, and go through
+ * the same random removes and inserts. live holds the handles, for the
+ * darray that is the index. the darray keeps nulls in removed places and
+ * an insert scans for the first one, as the stores did before */
+
+static u64 darray_insert(C_DArray* darray, C_Handle_u32* value) {
+  void** data = C_DArray_get_data(darray);
+  u32 len = C_DArray_get_len(darray);
+  for (u32 i = 0; i < len; i++) {
+    if (!data[i]) {
+      data[i] = Ref(value);
+      return i;
+    }
+  }
+
+  C_DArray_push_P(darray, value);
+  return len;
+}
+
+static void darray_remove(C_DArray* darray, u64 index) {
+  void** data = C_DArray_get_data(darray);
+  Unref(data[index]);
+  data[index] = null;
+}
+
+static void bench_darray(C_Handle_u32* value) {
+  C_DArray* darray = C_DArray_new();
+  u64* live = allocate(LIVE_LEN * sizeof(u64));
+  for (u32 i = 0; i < LIVE_LEN; i++) {
+    live[i] = darray_insert(darray, value);
+  }
+
+  Bench("C_DArray with holes remove + insert (100k)", CHURN_LEN, {
+    for (u32 i = 0; i < CHURN_LEN; i++) {
+      u32 pick = bench_rand() % LIVE_LEN;
+      darray_remove(darray, live[pick]);
+      live[pick] = darray_insert(darray, value);
+    }
+  });
+
+  u64 found = 0;
+  Bench("C_DArray with holes lookup (1M)", LOOKUP_LEN, {
+    for (u32 i = 0; i < LOOKUP_LEN; i++) {
+      found += C_DArray_at_B(darray, live[bench_rand() % LIVE_LEN]) != null;
+    }
+  });
+
+  // holes are made by removing every other value
+  for (u32 i = 0; i < LIVE_LEN; i += 2) {
+    darray_remove(darray, live[i]);
+  }
+  Bench("C_DArray with holes iterate half full (100 rounds)",
+    ITERATE_ROUNDS * LIVE_LEN / 2, {
+      for (u32 round = 0; round < ITERATE_ROUNDS; round++) {
+        C_DArrayForeach(darray, { found += value != null; });
+      }
+    });
+  bench_report_value("  found", found, "values");
+
+  Unref(darray);
+  deallocate(live);
+}
+
+static void bench_slot_map(C_Handle_u32* value) {
+  C_SlotMap* map = C_SlotMap_new();
+  u64* live = allocate(LIVE_LEN * sizeof(u64));
+  for (u32 i = 0; i < LIVE_LEN; i++) {
+    live[i] = C_SlotMap_insert_P(map, value);
+  }
+
+  Bench("C_SlotMap remove + insert (100k)", CHURN_LEN, {
+    for (u32 i = 0; i < CHURN_LEN; i++) {
+      u32 pick = bench_rand() % LIVE_LEN;
+      Unref(C_SlotMap_remove_R(map, live[pick]));
+      live[pick] = C_SlotMap_insert_P(map, value);
+    }
+  });
+
+  u64 found = 0;
+  Bench("C_SlotMap lookup (1M)", LOOKUP_LEN, {
+    for (u32 i = 0; i < LOOKUP_LEN; i++) {
+      found += C_SlotMap_at_B(map, live[bench_rand() % LIVE_LEN]) != null;
+    }
+  });
+
+  for (u32 i = 0; i < LIVE_LEN; i += 2) {
+    Unref(C_SlotMap_remove_R(map, live[i]));
+  }
+  Bench("C_SlotMap iterate half full (100 rounds)",
+    ITERATE_ROUNDS * LIVE_LEN / 2, {
+      for (u32 round = 0; round < ITERATE_ROUNDS; round++) {
+        C_SlotMapForeach(map, { found += value != null; });
+      }
+    });
+  bench_report_value("  found", found, "values");
+
+  Unref(map);
+  deallocate(live);
+}
+
+int main(void) {
+  C_Handle_u32* value = C_Handle_u32_new(1);
+
+  bench_darray(value);
+  bench_slot_map(value);
+
+  Unref(value);
+  return 0;
+}
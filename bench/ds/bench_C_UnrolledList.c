@@ -0,0 +1,70 @@
+#include "../bench_helpers.h"
+#include <c_base/base/memory/handles.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_List.h>
+#include <c_base/ds/C_UnrolledList.h>
+
+#define ITER_LEN 100000
+#define INSERT_COUNT 20000
+
+/* the big containers are left to process exit, releasing millions of blocks
+ * fragments the allocator free list and slows down every later phase */
+static void bench_iteration(void) {
+  volatile u64 sum = 0;
+
+  C_List* list = C_List_new();
+  for (u32 i = 0; i < ITER_LEN; i++) {
+    C_List_push_P(list, Pass(C_Handle_u32_new(i)));
+  }
+  Bench("C_List iteration (100k)", ITER_LEN,
+    { C_ListForeach(list, { sum += (u64)value; }); });
+
+  C_UnrolledList* unrolled = C_UnrolledList_new();
+  for (u32 i = 0; i < ITER_LEN; i++) {
+    C_UnrolledList_push_P(unrolled, Pass(C_Handle_u32_new(i)));
+  }
+  Bench("C_UnrolledList iteration (100k)", ITER_LEN,
+    { C_UnrolledListForeach(unrolled, { sum += (u64)value; }); });
+}
+
+static void bench_middle_insert(void) {
+  C_Handle_u32* handle = C_Handle_u32_new(0);
+
+  C_List* list = C_List_new();
+  Bench("C_List_add_P middle (20k)", INSERT_COUNT, {
+    for (u32 i = 0; i < INSERT_COUNT; i++) {
+      C_List_add_P(list, C_List_get_len(list) / 2, handle);
+    }
+  });
+
+  C_UnrolledList* unrolled = C_UnrolledList_new();
+  Bench("C_UnrolledList_add_P middle (20k)", INSERT_COUNT, {
+    for (u32 i = 0; i < INSERT_COUNT; i++) {
+      C_UnrolledList_add_P(
+        unrolled, C_UnrolledList_get_len(unrolled) / 2, handle);
+    }
+  });
+
+  Bench("C_List_remove_R middle (20k)", INSERT_COUNT, {
+    for (u32 i = 0; i < INSERT_COUNT; i++) {
+      Unref(C_List_remove_R(list, C_List_get_len(list) / 2));
+    }
+  });
+
+  Bench("C_UnrolledList_remove_R middle (20k)", INSERT_COUNT, {
+    for (u32 i = 0; i < INSERT_COUNT; i++) {
+      Unref(C_UnrolledList_remove_R(
+        unrolled, C_UnrolledList_get_len(unrolled) / 2));
+    }
+  });
+
+  Unref(list);
+  Unref(unrolled);
+  Unref(handle);
+}
+
+int main(void) {
+  bench_iteration();
+  bench_middle_insert();
+  return 0;
+}
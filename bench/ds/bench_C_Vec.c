@@ -0,0 +1,72 @@
+#include "../bench_helpers.h"
+#include <c_base/base/memory/handles.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_DArray.h>
+#include <c_base/ds/C_Vec.h>
+
+#define SUM_LEN 1000000
+#define SUM_ROUNDS 10
+
+/* the darray holds one handle per value like real code would,
+ * it is never freed since releasing 1M handles dominates the run */
+
+static void bench_push(void) {
+  C_Vec_u32* vec = C_Vec_u32_new();
+
+  Bench("C_Vec_u32 push (1M)", SUM_LEN, {
+    for (u32 i = 0; i < SUM_LEN; i++) {
+      C_Vec_u32_push(vec, i);
+    }
+  });
+
+  Unref(vec);
+}
+
+static void bench_sum(void) {
+  C_Vec_u32* vec = C_Vec_u32_new();
+  C_DArray* darray = C_DArray_new();
+  for (u32 i = 0; i < SUM_LEN; i++) {
+    u32 value = bench_rand();
+    C_Vec_u32_push(vec, value);
+    C_DArray_push_P(darray, Pass(C_Handle_u32_new(value)));
+  }
+
+  u64 darray_sum = 0;
+  Bench("C_DArray of C_Handle_u32 sum (1M)", SUM_LEN * SUM_ROUNDS, {
+    for (u32 round = 0; round < SUM_ROUNDS; round++) {
+      C_DArrayForeach(
+        darray, { darray_sum += C_Handle_u32_get_value(value); });
+    }
+  });
+
+  u64 vec_sum = 0;
+  Bench("C_Vec_u32 at sum (1M)", SUM_LEN * SUM_ROUNDS, {
+    for (u32 round = 0; round < SUM_ROUNDS; round++) {
+      for (u32 i = 0; i < SUM_LEN; i++) {
+        vec_sum += C_Vec_u32_at(vec, i);
+      }
+    }
+  });
+
+  u64 data_sum = 0;
+  Bench("C_Vec_u32 get_data sum (1M)", SUM_LEN * SUM_ROUNDS, {
+    for (u32 round = 0; round < SUM_ROUNDS; round++) {
+      u32* data = C_Vec_u32_get_data(vec);
+      for (u32 i = 0; i < SUM_LEN; i++) {
+        data_sum += data[i];
+      }
+    }
+  });
+
+  // keeps the sums alive and checks the three loops agree
+  bench_report_value("sums match", darray_sum == vec_sum && vec_sum == data_sum,
+    "bool");
+
+  Unref(vec);
+}
+
+int main(void) {
+  bench_push();
+  bench_sum();
+  return 0;
+}
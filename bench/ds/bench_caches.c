@@ -0,0 +1,150 @@
+#include "../bench_helpers.h"
+#include <c_base/base/memory/allocator.h>
+#include <c_base/base/memory/handles.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_Array.h>
+#include <c_base/ds/C_ClockCache.h>
+#include <c_base/ds/C_HashTable.h>
+#include <c_base/ds/C_List.h>
+#include <c_base/ds/C_LruCache.h>
+#include <c_base/os/os_threads.h>
+#include <stdio.h>
+
+#define CACHE_CAP 1000
+// keys are drawn from twice the capacity, about half the gets hit
+#define KEY_RANGE (CACHE_CAP * 2)
+#define OPS 200000
+#define THREAD_OPS 200000
+#define MAX_THREADS 4
+
+typedef struct {
+  ClassObject base;
+  C_ClockCache* cache;
+  u64 seed;
+} BenchJob;
+
+static void BenchJob_destroy(void* self) { (void)self; }
+
+static u32 bench_key(void) { return (u32)(bench_rand() % KEY_RANGE); }
+
+static StringView key_of(ascii* buffer, u64 key) {
+  s32 len = snprintf(buffer, 32, "key-%llu", (unsigned long long)key);
+  return StringView_construct(buffer, (u32)len);
+}
+
+/* the cache that was built before: a table for the values and a list of
+ * the keys by recency. a hit has to find its key in the list */
+static void bench_table_list(void) {
+  C_HashTable* table = C_HashTable_new();
+  C_List* recency = C_List_new();
+
+  Bench("C_HashTable + C_List get or put (200k)", OPS, {
+    for (u32 i = 0; i < OPS; i++) {
+      C_Handle_u32* key = C_Handle_u32_new(bench_key());
+      if (C_HashTable_contains_P(table, key)) {
+        ListCursor cursor = ListCursor_construct(recency);
+        while (!C_Handle_u32_equals(ListCursor_get_B(&cursor), key)) {
+          ListCursor_next(&cursor);
+        }
+        Unref(C_List_remove_cursor_R(recency, &cursor));
+        C_List_push_front_P(recency, key);
+      } else {
+        if (C_List_get_len(recency) == CACHE_CAP) {
+          void* oldest = C_List_pop_R(recency);
+          Unref(C_HashTable_remove_PR(table, oldest));
+          Unref(oldest);
+        }
+        C_HashTable_put_P(table, key, Pass(C_Handle_u32_new(i)));
+        C_List_push_front_P(recency, key);
+      }
+      Unref(key);
+    }
+  });
+
+  Unref(recency);
+  Unref(table);
+}
+
+static void bench_lru(void) {
+  C_LruCache* cache = C_LruCache_new(CACHE_CAP);
+
+  Bench("C_LruCache get or put (200k)", OPS, {
+    for (u32 i = 0; i < OPS; i++) {
+      C_Handle_u32* key = C_Handle_u32_new(bench_key());
+      if (!C_LruCache_get_PB(cache, key)) {
+        C_LruCache_put_P(cache, key, Pass(C_Handle_u32_new(i)));
+      }
+      Unref(key);
+    }
+  });
+
+  CacheStats stats = C_LruCache_get_stats(cache);
+  bench_report_value("C_LruCache hit rate", CacheStats_hit_rate(&stats), "");
+  Unref(cache);
+}
+
+static void clock_ops(C_ClockCache* cache, u64 seed, u32 len) {
+  ascii buffer[32];
+  for (u32 i = 0; i < len; i++) {
+    // xorshift per thread, bench_rand is not shared between threads
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    StringView key = key_of(buffer, seed % KEY_RANGE);
+
+    u64 value = 0;
+    if (!C_ClockCache_get(cache, key, &value)) {
+      C_ClockCache_put(cache, key, &seed);
+    }
+  }
+}
+
+static void clock_func(C_Thread* thread) {
+  BenchJob* job = C_Thread_get_arg_B(thread, 0);
+  clock_ops(job->cache, job->seed, THREAD_OPS);
+}
+
+static void bench_clock(u32 thread_count) {
+  C_ClockCache* cache = C_ClockCache_new(CACHE_CAP, 16, sizeof(u64));
+  BenchJob* jobs[MAX_THREADS];
+  C_Array* args[MAX_THREADS];
+  C_Thread* threads[MAX_THREADS];
+
+  char name[64];
+  snprintf(name, sizeof(name), "C_ClockCache get or put, %u threads (200k)",
+    thread_count);
+  Bench(name, (u64)THREAD_OPS * thread_count, {
+    for (u32 i = 0; i < thread_count; i++) {
+      jobs[i] = allocate(sizeof(BenchJob));
+      jobs[i]->base = ClassObject_construct(BenchJob_destroy, null);
+      jobs[i]->cache = cache;
+      jobs[i]->seed = 0x9e3779b97f4a7c15ull * (i + 1);
+      args[i] = C_Array_new(1);
+      C_Array_put_P(args[i], 0, Pass(jobs[i]));
+      threads[i] = C_Thread_new(clock_func, args[i]);
+      Unref(C_Thread_run(threads[i]));
+    }
+    for (u32 i = 0; i < thread_count; i++) {
+      C_Thread_join(threads[i]);
+      Unref(threads[i]);
+      Unref(args[i]);
+    }
+  });
+
+  CacheStats stats = C_ClockCache_get_stats(cache);
+  snprintf(name, sizeof(name), "C_ClockCache hit rate, %u threads",
+    thread_count);
+  bench_report_value(name, CacheStats_hit_rate(&stats), "");
+  Unref(cache);
+}
+
+int main(void) {
+  bench_report_value("cpus", os_threads_cpu_count(), "");
+
+  bench_table_list();
+  bench_lru();
+  bench_clock(1);
+  bench_clock(MAX_THREADS);
+
+  return 0;
+}
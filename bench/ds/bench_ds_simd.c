@@ -0,0 +1,82 @@
+#include "../bench_helpers.h"
+#include <c_base/base/memory/allocator.h>
+#include <c_base/ds/ds_simd.h>
+#include <stdio.h>
+
+/* 1M values of every type fit in the last level cache of most cpus,
+ * so the numbers show the kernels and not the memory bandwidth */
+#define KERNEL_LEN 1000000
+#define KERNEL_ROUNDS 20
+
+// keeps the results alive
+static f64 sink = 0;
+
+#define BenchKernel(T, kernel, level, code)                                    \
+  do {                                                                         \
+    char name[64];                                                             \
+    snprintf(name, sizeof(name), "%s_" #T " (1M, %s)", kernel,                 \
+      simd_level_name(level));                                                 \
+    Bench(name, (u64)KERNEL_LEN * KERNEL_ROUNDS, {                             \
+      for (u32 round = 0; round < KERNEL_ROUNDS; round++) {                    \
+        code                                                                   \
+      }                                                                        \
+    });                                                                        \
+  } while (0)
+
+#define BenchKernels(T)                                                        \
+  static void bench_##T(void) {                                                \
+    T* a = allocate(KERNEL_LEN * sizeof(T));                                   \
+    T* b = allocate(KERNEL_LEN * sizeof(T));                                   \
+    T* dst = allocate(KERNEL_LEN * sizeof(T));                                 \
+    for (u32 i = 0; i < KERNEL_LEN; i++) {                                     \
+      a[i] = (T)(bench_rand() % 1000);                                         \
+      b[i] = (T)(bench_rand() % 1000);                                         \
+    }                                                                          \
+    /* never found, so find scans everything */                                \
+    T needle = (T)5000;                                                        \
+                                                                               \
+    for (SimdLevel level = SIMD_SCALAR; level <= simd_detect_level();          \
+         level++) {                                                            \
+      simd_set_level(level);                                                   \
+                                                                               \
+      BenchKernel(T, "sum", level, { sink += simd_sum_##T(a, KERNEL_LEN); });  \
+      BenchKernel(T, "min", level, { sink += simd_min_##T(a, KERNEL_LEN); });  \
+      BenchKernel(T, "max", level, { sink += simd_max_##T(a, KERNEL_LEN); });  \
+      BenchKernel(                                                             \
+        T, "argmin", level, { sink += simd_argmin_##T(a, KERNEL_LEN); });      \
+      BenchKernel(T, "find", level,                                            \
+        { sink += simd_find_##T(a, KERNEL_LEN, needle); });                    \
+      BenchKernel(T, "count", level,                                           \
+        { sink += simd_count_##T(a, KERNEL_LEN, a[0]); });                     \
+      BenchKernel(                                                             \
+        T, "dot", level, { sink += simd_dot_##T(a, b, KERNEL_LEN); });         \
+      BenchKernel(                                                             \
+        T, "add", level, { simd_add_##T(dst, a, b, KERNEL_LEN); });            \
+      BenchKernel(                                                             \
+        T, "mul", level, { simd_mul_##T(dst, a, b, KERNEL_LEN); });            \
+      BenchKernel(                                                             \
+        T, "scale", level, { simd_scale_##T(dst, a, 3, KERNEL_LEN); });        \
+    }                                                                          \
+                                                                               \
+    simd_set_level(simd_detect_level());                                       \
+    deallocate(a);                                                             \
+    deallocate(b);                                                             \
+    deallocate(dst);                                                           \
+  }
+
+BenchKernels(u32)
+BenchKernels(u64)
+BenchKernels(f32)
+BenchKernels(f64)
+
+int main(void) {
+  bench_report_value("simd level", simd_detect_level(), "");
+
+  bench_u32();
+  bench_u64();
+  bench_f32();
+  bench_f64();
+
+  bench_report_value("sink", sink != 0, "");
+  return 0;
+}
@@ -0,0 +1,138 @@
+#include "../bench_helpers.h"
+#include <c_base/base/memory/allocator.h>
+#include <c_base/base/memory/handles.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_BloomFilter.h>
+#include <c_base/ds/C_CuckooFilter.h>
+#include <c_base/ds/C_HashTable.h>
+#include <c_base/ds/ds_simd.h>
+
+#define KEY_LEN 1000000
+#define PROBES 1000000
+#define TABLE_LEN 100000
+
+/* keys 0 .. KEY_LEN - 1 are added, probes from KEY_LEN on are never added,
+ * so every positive probe is a false positive */
+
+static void bench_bloom(u32 bits_per_key) {
+  C_BloomFilter* filter = C_BloomFilter_new(KEY_LEN, bits_per_key);
+  bench_report_value("bloom filter bits per key", bits_per_key, "");
+
+  Bench("  add (1M)", KEY_LEN, {
+    for (u64 i = 0; i < KEY_LEN; i++) {
+      C_BloomFilter_add_hash(filter, ds_hash_mix(i));
+    }
+  });
+
+  u64 hits = 0;
+  Bench("  contains, added keys (1M)", PROBES, {
+    for (u64 i = 0; i < PROBES; i++) {
+      hits += C_BloomFilter_contains_hash(filter, ds_hash_mix(i));
+    }
+  });
+  bench_report_value("  hits", hits, "keys");
+
+  // the best level, then the scalar version
+  SimdLevel levels[2] = {simd_get_level(), SIMD_SCALAR};
+  for (u32 l = 0; l < 2; l++) {
+    simd_set_level(levels[l]);
+    u64 false_positives = 0;
+    Bench("  contains, other keys (1M)", PROBES, {
+      for (u64 i = KEY_LEN; i < KEY_LEN + PROBES; i++) {
+        false_positives +=
+          C_BloomFilter_contains_hash(filter, ds_hash_mix(i));
+      }
+    });
+    bench_report_value(simd_level_name(levels[l]),
+      100.0 * false_positives / PROBES, "% positive");
+  }
+  simd_set_level(levels[0]);
+
+  Unref(filter);
+}
+
+static void bench_cuckoo(void) {
+  C_CuckooFilter* filter = C_CuckooFilter_new(KEY_LEN);
+
+  u64 added = 0;
+  Bench("cuckoo filter add (1M)", KEY_LEN, {
+    for (u64 i = 0; i < KEY_LEN; i++) {
+      added += C_CuckooFilter_add_hash(filter, ds_hash_mix(i));
+    }
+  });
+  bench_report_value("  added", added, "keys");
+  bench_report_value(
+    "  load", 100.0 * added / C_CuckooFilter_get_cap(filter), "%");
+
+  u64 hits = 0;
+  Bench("  contains, added keys (1M)", PROBES, {
+    for (u64 i = 0; i < PROBES; i++) {
+      hits += C_CuckooFilter_contains_hash(filter, ds_hash_mix(i));
+    }
+  });
+  bench_report_value("  hits", hits, "keys");
+
+  u64 false_positives = 0;
+  Bench("  contains, other keys (1M)", PROBES, {
+    for (u64 i = KEY_LEN; i < KEY_LEN + PROBES; i++) {
+      false_positives += C_CuckooFilter_contains_hash(filter, ds_hash_mix(i));
+    }
+  });
+  bench_report_value(
+    "  false positives", 100.0 * false_positives / PROBES, "%");
+
+  Bench("  remove (1M)", KEY_LEN, {
+    for (u64 i = 0; i < KEY_LEN; i++) {
+      C_CuckooFilter_remove_hash(filter, ds_hash_mix(i));
+    }
+  });
+  bench_report_value("  left", C_CuckooFilter_get_len(filter), "keys");
+
+  Unref(filter);
+}
+
+/* the use case: a table that is mostly asked for keys it does not have.
+ * 9 of 10 probes miss, the filter answers them without touching the
+ * table. the keys are left to process exit with the table */
+static void bench_table_misses(void) {
+  C_HashTable* table = C_HashTable_new_cap(TABLE_LEN);
+  C_BloomFilter* filter = C_BloomFilter_new(TABLE_LEN, 10);
+  for (u64 i = 0; i < TABLE_LEN; i++) {
+    C_Handle_u64* key = C_Handle_u64_new(i);
+    C_HashTable_put_P(table, key, key);
+    C_BloomFilter_add_P(filter, key);
+  }
+
+  C_Handle_u64** probes = allocate(PROBES * sizeof(C_Handle_u64*));
+  for (u64 i = 0; i < PROBES; i++) {
+    u64 value = i % 10 == 0 ? bench_rand() % TABLE_LEN : TABLE_LEN + i;
+    probes[i] = C_Handle_u64_new(value);
+  }
+
+  u64 found = 0;
+  Bench("C_HashTable contains, 90% misses (1M)", PROBES, {
+    for (u64 i = 0; i < PROBES; i++) {
+      found += C_HashTable_contains_P(table, probes[i]);
+    }
+  });
+  bench_report_value("  found", found, "keys");
+
+  found = 0;
+  Bench("bloom filter then C_HashTable contains (1M)", PROBES, {
+    for (u64 i = 0; i < PROBES; i++) {
+      found += C_BloomFilter_contains_P(filter, probes[i]) &&
+               C_HashTable_contains_P(table, probes[i]);
+    }
+  });
+  bench_report_value("  found", found, "keys");
+}
+
+int main(void) {
+  bench_bloom(8);
+  bench_bloom(12);
+  bench_bloom(16);
+  bench_cuckoo();
+  bench_table_misses();
+
+  return 0;
+}
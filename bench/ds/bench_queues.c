@@ -0,0 +1,217 @@
+#include "../bench_helpers.h"
+#include <c_base/base/memory/allocator.h>
+#include <c_base/base/memory/handles.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_Array.h>
+#include <c_base/ds/C_List.h>
+#include <c_base/ds/C_MpmcQueue.h>
+#include <c_base/ds/C_SpscQueue.h>
+#include <c_base/os/os_atomic.h>
+#include <c_base/os/os_threads.h>
+#include <stdio.h>
+
+#define ROUND_TRIPS 100000
+#define THROUGHPUT_LEN 5000000
+#define QUEUE_CAP 1024
+// pauses before a waiting thread yields, one cpu still makes progress
+#define SPIN_LIMIT 100
+
+/* every queue kind is driven through the same functions, so the numbers
+ * differ only by the queue. the C_List kind is the mutex guarded list
+ * that was used for handoffs before, its values are one shared handle
+ * that is referenced and unreferenced under the mutex */
+typedef enum { QUEUE_SPSC, QUEUE_MPMC, QUEUE_LIST } QueueKind;
+
+typedef struct {
+  QueueKind kind;
+  C_SpscQueue* spsc;
+  C_MpmcQueue* mpmc;
+  C_List* list;
+  Mutex mutex;
+} BenchQueue;
+
+typedef struct {
+  ClassObject base;
+  BenchQueue* ping;
+  BenchQueue* pong;
+  u64 len;
+} BenchJob;
+
+static C_Handle_u64* list_value = null;
+
+static void bench_wait(u32* spins) {
+  if (++*spins < SPIN_LIMIT) {
+    os_atomic_pause();
+  } else {
+    os_threads_yield();
+  }
+}
+
+static BenchQueue* BenchQueue_new(QueueKind kind) {
+  BenchQueue* self = allocate(sizeof(BenchQueue));
+  self->kind = kind;
+  self->spsc = kind == QUEUE_SPSC ? C_SpscQueue_new(QUEUE_CAP) : null;
+  self->mpmc = kind == QUEUE_MPMC ? C_MpmcQueue_new(QUEUE_CAP) : null;
+  self->list = kind == QUEUE_LIST ? C_List_new() : null;
+  self->mutex = Mutex_construct();
+  return self;
+}
+
+static void BenchQueue_free(BenchQueue* self) {
+  Unref(self->spsc);
+  Unref(self->mpmc);
+  Unref(self->list);
+  deallocate(self);
+}
+
+static void BenchQueue_push(BenchQueue* self, u64 value) {
+  u32 spins = 0;
+  switch (self->kind) {
+  case QUEUE_SPSC:
+    while (!C_SpscQueue_push(self->spsc, (void*)value)) {
+      bench_wait(&spins);
+    }
+    break;
+  case QUEUE_MPMC:
+    while (!C_MpmcQueue_push(self->mpmc, (void*)value)) {
+      bench_wait(&spins);
+    }
+    break;
+  case QUEUE_LIST:
+    Mutex_lock(&self->mutex);
+    C_List_push_P(self->list, list_value);
+    Mutex_unlock(&self->mutex);
+    break;
+  }
+}
+
+static void BenchQueue_pop(BenchQueue* self) {
+  u32 spins = 0;
+  void* value = null;
+  switch (self->kind) {
+  case QUEUE_SPSC:
+    while (!C_SpscQueue_pop(self->spsc, &value)) {
+      bench_wait(&spins);
+    }
+    break;
+  case QUEUE_MPMC:
+    while (!C_MpmcQueue_pop(self->mpmc, &value)) {
+      bench_wait(&spins);
+    }
+    break;
+  case QUEUE_LIST:
+    while (true) {
+      Mutex_lock(&self->mutex);
+      if (C_List_get_len(self->list)) {
+        Unref(C_List_pop_front_R(self->list));
+        Mutex_unlock(&self->mutex);
+        return;
+      }
+      Mutex_unlock(&self->mutex);
+      bench_wait(&spins);
+    }
+  }
+}
+
+static void BenchJob_destroy(void* self) { (void)self; }
+
+// answers every ping with a pong
+static void echo_func(C_Thread* thread) {
+  BenchJob* job = C_Thread_get_arg_B(thread, 0);
+  for (u64 i = 0; i < job->len; i++) {
+    BenchQueue_pop(job->ping);
+    BenchQueue_push(job->pong, i);
+  }
+}
+
+static void produce_func(C_Thread* thread) {
+  BenchJob* job = C_Thread_get_arg_B(thread, 0);
+  for (u64 i = 0; i < job->len; i++) {
+    BenchQueue_push(job->ping, i);
+  }
+}
+
+// args is unreferenced by the caller after the join
+static C_Thread* start_thread(void (*func)(C_Thread* self), C_Array** args,
+  BenchQueue* ping, BenchQueue* pong, u64 len) {
+  BenchJob* job = allocate(sizeof(BenchJob));
+  job->base = ClassObject_construct(BenchJob_destroy, null);
+  job->ping = ping;
+  job->pong = pong;
+  job->len = len;
+
+  *args = C_Array_new(1);
+  C_Array_put_P(*args, 0, Pass(job));
+  C_Thread* thread = C_Thread_new(func, *args);
+  Unref(C_Thread_run(thread));
+  return thread;
+}
+
+static char* queue_name(QueueKind kind) {
+  switch (kind) {
+  case QUEUE_SPSC:
+    return "C_SpscQueue";
+  case QUEUE_MPMC:
+    return "C_MpmcQueue";
+  default:
+    return "C_List + Mutex";
+  }
+}
+
+static void bench_ping_pong(QueueKind kind) {
+  BenchQueue* ping = BenchQueue_new(kind);
+  BenchQueue* pong = BenchQueue_new(kind);
+  C_Array* args = null;
+  C_Thread* thread = start_thread(echo_func, &args, ping, pong, ROUND_TRIPS);
+
+  char name[64];
+  snprintf(name, sizeof(name), "%s ping pong (100k round trips)",
+    queue_name(kind));
+  Bench(name, ROUND_TRIPS, {
+    for (u64 i = 0; i < ROUND_TRIPS; i++) {
+      BenchQueue_push(ping, i);
+      BenchQueue_pop(pong);
+    }
+  });
+
+  C_Thread_join(thread);
+  Unref(thread);
+  Unref(args);
+  BenchQueue_free(ping);
+  BenchQueue_free(pong);
+}
+
+static void bench_throughput(QueueKind kind) {
+  BenchQueue* queue = BenchQueue_new(kind);
+
+  char name[64];
+  snprintf(name, sizeof(name), "%s producer to consumer (5M)",
+    queue_name(kind));
+  Bench(name, THROUGHPUT_LEN, {
+    C_Array* args = null;
+    C_Thread* thread =
+      start_thread(produce_func, &args, queue, null, THROUGHPUT_LEN);
+    for (u64 i = 0; i < THROUGHPUT_LEN; i++) {
+      BenchQueue_pop(queue);
+    }
+    C_Thread_join(thread);
+    Unref(thread);
+    Unref(args);
+  });
+
+  BenchQueue_free(queue);
+}
+
+int main(void) {
+  list_value = C_Handle_u64_new(0);
+  bench_report_value("cpus", os_threads_cpu_count(), "");
+
+  QueueKind kinds[3] = {QUEUE_SPSC, QUEUE_MPMC, QUEUE_LIST};
+  for (u32 i = 0; i < 3; i++) {
+    bench_ping_pong(kinds[i]);
+    bench_throughput(kinds[i]);
+  }
+
+  Unref(list_value);
+  return 0;
+}
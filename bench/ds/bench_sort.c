@@ -0,0 +1,64 @@
+#include "../bench_helpers.h"
+#include <c_base/base/memory/handles.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_DArray.h>
+#include <c_base/ds/C_List.h>
+
+#define NUMERIC_LEN 10000000
+#define GENERIC_LEN 1000000
+#define LIST_LEN 1000000
+
+/* the containers are left to process exit, freeing millions of handles
+ * one by one costs more than the sorts being measured */
+
+static C_DArray* make_darray(u32 len) {
+  C_DArray* darray = C_DArray_new_cap(len);
+  for (u32 i = 0; i < len; i++) {
+    C_DArray_push_P(darray, Pass(C_Handle_u64_new(bench_rand())));
+  }
+  return darray;
+}
+
+static bool darray_sorted(C_DArray* darray) {
+  for (u32 i = 1; i < C_DArray_get_len(darray); i++) {
+    if (C_Handle_u64_compare(C_DArray_at_B(darray, i - 1),
+          C_DArray_at_B(darray, i)) > 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void bench_darray_sort(void) {
+  C_DArray* numeric = make_darray(NUMERIC_LEN);
+  Bench("C_DArray_sort u64 keys (10M)", NUMERIC_LEN,
+    { C_DArray_sort(numeric); });
+  bench_report_value("sorted", darray_sorted(numeric), "bool");
+
+  Bench("C_DArray_sort already sorted (10M)", NUMERIC_LEN,
+    { C_DArray_sort(numeric); });
+
+  C_DArray* generic = make_darray(GENERIC_LEN);
+  Bench("C_DArray_sort_by compare (1M)", GENERIC_LEN,
+    { C_DArray_sort_by(generic, C_Handle_u64_compare); });
+  bench_report_value("sorted", darray_sorted(generic), "bool");
+
+  C_DArray* keyed = make_darray(GENERIC_LEN);
+  Bench("C_DArray_sort u64 keys (1M)", GENERIC_LEN,
+    { C_DArray_sort(keyed); });
+}
+
+static void bench_list_sort(void) {
+  C_List* list = C_List_new();
+  for (u32 i = 0; i < LIST_LEN; i++) {
+    C_List_push_P(list, Pass(C_Handle_u64_new(bench_rand())));
+  }
+
+  Bench("C_List_sort merge (1M)", LIST_LEN, { C_List_sort(list); });
+}
+
+int main(void) {
+  bench_darray_sort();
+  bench_list_sort();
+  return 0;
+}
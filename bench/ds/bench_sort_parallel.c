@@ -0,0 +1,67 @@
+#include "../bench_helpers.h"
+#include <c_base/base/memory/handles.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_DArray.h>
+#include <c_base/os/os_threads.h>
+#include <stdio.h>
+
+#define NUMERIC_LEN 10000000
+#define GENERIC_LEN 2000000
+
+/* the containers are left to process exit, freeing millions of handles
+ * one by one costs more than the sorts being measured */
+
+static C_DArray* make_darray(u32 len) {
+  C_DArray* darray = C_DArray_new_cap(len);
+  for (u32 i = 0; i < len; i++) {
+    C_DArray_push_P(darray, Pass(C_Handle_u64_new(bench_rand())));
+  }
+  return darray;
+}
+
+/* same values in the same unsorted order, without allocating new handles */
+static C_DArray* copy_darray(C_DArray* source) {
+  C_DArray* darray = C_DArray_new_cap(C_DArray_get_len(source));
+  C_DArrayForeach(source, { C_DArray_push_P(darray, value); });
+  return darray;
+}
+
+static u32 max_threads(void) {
+  u32 cpus = os_threads_cpu_count();
+  return cpus < 4 ? 4 : cpus;
+}
+
+static void bench_scaling(void) {
+  C_DArray* numeric = make_darray(NUMERIC_LEN);
+  C_DArray* generic = make_darray(GENERIC_LEN);
+  bench_report_value("cpus", os_threads_cpu_count(), "");
+
+  for (u32 threads = 1; threads <= max_threads(); threads *= 2) {
+    C_DArray* darray = copy_darray(numeric);
+    u64 start = bench_now_ns();
+    C_DArray_sort_parallel(darray, threads);
+    u64 ns = bench_now_ns() - start;
+
+    char name[64];
+    snprintf(name, sizeof(name), "sort_parallel u64 keys (10M, %u threads)",
+      threads);
+    bench_report(name, ns, NUMERIC_LEN);
+  }
+
+  for (u32 threads = 1; threads <= max_threads(); threads *= 2) {
+    C_DArray* darray = copy_darray(generic);
+    u64 start = bench_now_ns();
+    C_DArray_sort_by_parallel(darray, C_Handle_u64_compare, threads);
+    u64 ns = bench_now_ns() - start;
+
+    char name[64];
+    snprintf(name, sizeof(name), "sort_by_parallel compare (2M, %u threads)",
+      threads);
+    bench_report(name, ns, GENERIC_LEN);
+  }
+}
+
+int main(void) {
+  bench_scaling();
+  return 0;
+}
@@ -0,0 +1,128 @@
+#include "../bench_helpers.h"
+#include <c_base/base/memory/allocator.h>
+#include <c_base/base/memory/handles.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_DArray.h>
+#include <c_base/ds/ds_sorted.h>
+
+#define BALANCED_LEN 5000
+#define SKEWED_SMALL_LEN 100
+#define SKEWED_LARGE_LEN 1000000
+#define SEARCH_COUNT 1000000
+#define NEEDLE_COUNT 4096
+
+/* the darrays are left to process exit, freeing 1M handles one by one
+ * costs more than the operations being measured */
+
+// every step-th u32, so about one value in step is shared between arrays
+static C_DArray* make_sorted(u32 len, u32 step) {
+  C_DArray* darray = C_DArray_new_cap(len);
+  u32 value = 0;
+  for (u32 i = 0; i < len; i++) {
+    value += 1 + bench_rand() % step;
+    C_DArray_push_P(darray, Pass(C_Handle_u32_new(value)));
+  }
+  return darray;
+}
+
+// what sorted input allows us to avoid, every pair is compared
+static u32 naive_intersection(C_DArray* a, C_DArray* b) {
+  u32 len = 0;
+  C_DArrayForeach(a, {
+    void* a_value = value;
+    C_DArrayForeach(b, {
+      if (C_Handle_u32_compare(a_value, value) == 0) {
+        len++;
+        break;
+      }
+    });
+  });
+  return len;
+}
+
+static void bench_intersection(
+  char* naive_name, char* name, C_DArray* a, C_DArray* b) {
+  u64 ops = (u64)C_DArray_get_len(a) + C_DArray_get_len(b);
+
+  u32 naive_len = 0;
+  Bench(naive_name, ops, { naive_len = naive_intersection(a, b); });
+
+  C_DArray* result = null;
+  Bench(name, ops,
+    { result = C_DArray_intersection_R(a, b, C_Handle_u32_compare); });
+
+  bench_report_value(
+    "lengths match", naive_len == C_DArray_get_len(result), "bool");
+  Unref(result);
+}
+
+static void bench_balanced(void) {
+  C_DArray* a = make_sorted(BALANCED_LEN, 4);
+  C_DArray* b = make_sorted(BALANCED_LEN, 4);
+
+  bench_intersection("naive intersection (5k x 5k)",
+    "C_DArray_intersection_R linear (5k x 5k)", a, b);
+
+  C_DArray* result = null;
+  Bench("C_DArray_union_R (5k x 5k)", 2 * BALANCED_LEN,
+    { result = C_DArray_union_R(a, b, C_Handle_u32_compare); });
+  Unref(result);
+
+  Bench("C_DArray_difference_R (5k x 5k)", 2 * BALANCED_LEN,
+    { result = C_DArray_difference_R(a, b, C_Handle_u32_compare); });
+  Unref(result);
+}
+
+static void bench_skewed(void) {
+  C_DArray* small = make_sorted(SKEWED_SMALL_LEN, 40000);
+  C_DArray* large = make_sorted(SKEWED_LARGE_LEN, 4);
+
+  bench_intersection("naive intersection (100 x 1M)",
+    "C_DArray_intersection_R gallop (100 x 1M)", small, large);
+
+  // the linear merge the gallop replaces, on the raw data
+  void** out = allocate(SKEWED_SMALL_LEN * sizeof(void*));
+  u32 len = 0;
+  Bench("linear merge intersection (100 x 1M)",
+    SKEWED_SMALL_LEN + SKEWED_LARGE_LEN, {
+      void** a = C_DArray_get_data(small);
+      void** b = C_DArray_get_data(large);
+      u32 i = 0;
+      u32 j = 0;
+      while (i < SKEWED_SMALL_LEN && j < SKEWED_LARGE_LEN) {
+        s32 order = C_Handle_u32_compare(a[i], b[j]);
+        if (order == 0) {
+          out[len++] = a[i];
+        }
+        i += order <= 0;
+        j += order >= 0;
+      }
+    });
+  bench_report_value("matches", len, "values");
+  deallocate(out);
+}
+
+static void bench_search(void) {
+  C_DArray* darray = make_sorted(SKEWED_LARGE_LEN, 4);
+  C_DArray* needles = C_DArray_new_cap(NEEDLE_COUNT);
+  for (u32 i = 0; i < NEEDLE_COUNT; i++) {
+    u32 value = bench_rand() % (4 * SKEWED_LARGE_LEN);
+    C_DArray_push_P(needles, Pass(C_Handle_u32_new(value)));
+  }
+
+  u64 found = 0;
+  Bench("C_DArray_lower_bound (1M values, 1M searches)", SEARCH_COUNT, {
+    for (u32 i = 0; i < SEARCH_COUNT; i++) {
+      void* needle = C_DArray_at_B(needles, i % NEEDLE_COUNT);
+      found += C_DArray_lower_bound(darray, needle, C_Handle_u32_compare);
+    }
+  });
+  bench_report_value("index sum", found, "");
+}
+
+int main(void) {
+  bench_balanced();
+  bench_skewed();
+  bench_search();
+  return 0;
+}
@@ -11,4 +11,7 @@ void* allocate(u64 size);
 void deallocate(void* ptr);
 void* reallocate(void* ptr, u64 size);
 
+// blocks handed out since the start, a reallocate that moves counts as one
+u64 allocator_get_allocations(void);
+
 #endif
@@ -14,14 +14,19 @@
   C_String* Concat(C_Handle_##T, _to_str_R)(void* self);                       \
   C_String* Concat(C_Handle_##T, _to_str_format_R)(void* self,                 \
                                                    C_String* format);          \
+  void Concat(C_Handle_##T, _write_to)(void* self, C_StringBuilder* sink,      \
+                                       C_Format* format);                      \
   u32 Concat(C_Handle_##T, _hash)(void* self);                                 \
   bool Concat(C_Handle_##T, _equals)(void* a, void* b);                        \
+  s32 Concat(C_Handle_##T, _compare)(void* a, void* b);                        \
+  u64 Concat(C_Handle_##T, _key)(void* self);                                  \
                                                                                \
   C_Handle_##T* Concat(C_Handle_##T, _new)(T value);                           \
   void Concat(C_Handle_##T, _destroy)(void* self);                             \
   T Concat(C_Handle_##T, _get_value)(C_Handle_##T * self);
 
-#define GenericTypeImpl_C_Handle(T, to_str_func, to_str_format_func)           \
+#define GenericTypeImpl_C_Handle(T, to_str_func, to_str_format_func,         \
+                                 write_to_func)                                \
   struct C_Handle_##T {                                                        \
     ClassObject base;                                                          \
                                                                                \
@@ -29,7 +34,8 @@
   };                                                                           \
   static IHashable Concat(C_Handle_##T, _i_hashable) = {0};                    \
   static IFormattable Concat(C_Handle_##T, _i_formattable) = {0};              \
-  static Interface* Concat(C_Handle_##T, _interfaces)[3];                      \
+  static IComparable Concat(C_Handle_##T, _i_comparable) = {0};                \
+  static Interface* Concat(C_Handle_##T, _interfaces)[4];                      \
                                                                                \
   u32 Concat(C_Handle_##T, _hash)(void* self) {                                \
     C_Handle_##T* self_cast = self;                                            \
@@ -46,6 +52,29 @@
     return mem_equals(&a_cast->value, &b_cast->value, sizeof(T));              \
   }                                                                            \
                                                                                \
+  s32 Concat(C_Handle_##T, _compare)(void* a, void* b) {                       \
+    C_Handle_##T* a_cast = a;                                                  \
+    C_Handle_##T* b_cast = b;                                                  \
+                                                                               \
+    return (a_cast->value > b_cast->value) - (a_cast->value < b_cast->value);  \
+  }                                                                            \
+                                                                               \
+  /* signed values get their sign bit flipped so negatives sort first, */     \
+  /* floats flip every bit when negative so their bits sort like values */     \
+  u64 Concat(C_Handle_##T, _key)(void* self) {                                 \
+    C_Handle_##T* self_cast = self;                                            \
+    if ((T)1.5 != (T)1) {                                                      \
+      u64 top = (u64)1 << (sizeof(T) * 8 - 1);                                 \
+      u64 bits = 0;                                                            \
+      mem_copy(&bits, &self_cast->value, sizeof(T));                           \
+      return (bits & top) ? ~bits & (top | (top - 1)) : bits | top;            \
+    }                                                                          \
+    if ((T)-1 > (T)0) {                                                        \
+      return (u64)self_cast->value;                                            \
+    }                                                                          \
+    return (u64)(s64)self_cast->value ^ ((u64)1 << 63);                        \
+  }                                                                            \
+                                                                               \
   void Concat(C_Handle_##T, _destroy)(void* self) { (void)self; }              \
                                                                                \
   C_String* Concat(C_Handle_##T, _to_str_R)(void* self) {                      \
@@ -56,6 +85,12 @@
                                                    C_String* format) {         \
     C_Handle_##T* self_cast = self;                                            \
     return to_str_format_func(self_cast->value, format);                       \
+  }                                                                            \
+  void Concat(C_Handle_##T, _write_to)(void* self, C_StringBuilder* sink,      \
+                                       C_Format* format) {                     \
+    (void)format;                                                              \
+    C_Handle_##T* self_cast = self;                                            \
+    write_to_func(self_cast->value, sink);                                     \
   }                                                                            \
                                                                                \
   C_Handle_##T* Concat(C_Handle_##T, _new)(T value) {                          \
@@ -63,15 +98,21 @@
             (Interface*)&Concat(C_Handle_##T, _i_hashable))) {                 \
       Concat(C_Handle_##T, _i_hashable) = IHashable_construct(                 \
           Concat(C_Handle_##T, _equals), Concat(C_Handle_##T, _hash));         \
-      Concat(C_Handle_##T, _i_formattable) = IFormattable_construct_format(    \
-          Concat(C_Handle_##T, _to_str_R),                                     \
-          Concat(C_Handle_##T, _to_str_format_R));                             \
+      Concat(C_Handle_##T, _i_formattable) =                                   \
+          IFormattable_construct_format_write(                                 \
+              Concat(C_Handle_##T, _to_str_R),                                 \
+              Concat(C_Handle_##T, _to_str_format_R),                          \
+              Concat(C_Handle_##T, _write_to));                                \
+      Concat(C_Handle_##T, _i_comparable) = IComparable_construct_key(         \
+          Concat(C_Handle_##T, _compare), Concat(C_Handle_##T, _key));         \
                                                                                \
       Concat(C_Handle_##T, _interfaces)[0] =                                   \
           (Interface*)&Concat(C_Handle_##T, _i_hashable);                      \
       Concat(C_Handle_##T, _interfaces)[1] =                                   \
           (Interface*)&Concat(C_Handle_##T, _i_formattable);                   \
-      Concat(C_Handle_##T, _interfaces)[2] = null;                             \
+      Concat(C_Handle_##T, _interfaces)[2] =                                   \
+          (Interface*)&Concat(C_Handle_##T, _i_comparable);                    \
+      Concat(C_Handle_##T, _interfaces)[3] = null;                             \
     }                                                                          \
                                                                                \
     C_Handle_##T* self = allocate(sizeof(C_Handle_##T));                       \
@@ -97,6 +138,9 @@ GenericType_C_Handle(s16)
 GenericType_C_Handle(s32)
 GenericType_C_Handle(s64)
 
+GenericType_C_Handle(f32)
+GenericType_C_Handle(f64)
+
 GenericType_C_Handle(b8)
 GenericType_C_Handle(b16)
 GenericType_C_Handle(b32)
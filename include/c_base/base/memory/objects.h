@@ -80,6 +80,27 @@ IHashable IHashable_construct(
 bool IHashable_equals(void* a, void* b);
 u32 IHashable_hash(void* self);
 
+/******************************
+ * IComparable
+ ******************************/
+typedef struct {
+  Interface interface;
+  s32 (*compare)(void* a, void* b);
+
+  // optional, maps the object to an u64 with the same ordering as compare,
+  // lets sorts compare numbers directly instead of calling compare
+  u64 (*key)(void* self);
+} IComparable;
+Id(IComparable)
+
+// construct
+IComparable IComparable_construct(s32 (*compare)(void* a, void* b));
+IComparable IComparable_construct_key(
+  s32 (*compare)(void* a, void* b), u64 (*key)(void* self));
+
+// methods
+s32 IComparable_compare(void* a, void* b);
+
 /******************************
  * other
  ******************************/
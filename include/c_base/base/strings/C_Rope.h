@@ -0,0 +1,55 @@
+#ifndef ROPE_H
+#define ROPE_H
+
+#include <c_base/base/strings/string_view.h>
+#include <c_base/base/strings/strings.h>
+#include <c_base/base/types.h>
+
+/* a string for large texts that change in the middle. the chars are in
+ * chunks of at most RopeChunkSize bytes, the leaves of a balanced (AVL)
+ * tree where every node knows the length below it. insert, delete and
+ * index walk one path, concat joins two trees along their edges.
+ * nodes are shared between ropes after concat and substr and copied when
+ * a shared path is changed, so neither copies the chars */
+// implements: IFormattable
+typedef struct C_Rope C_Rope;
+
+#define RopeChunkSize 1024
+
+/******************************
+ * new/dest
+ ******************************/
+C_Rope* C_Rope_new(void);
+// copies the chars
+C_Rope* C_Rope_new_view(StringView view);
+
+void C_Rope_destroy(void* self);
+
+/******************************
+ * logic
+ ******************************/
+void C_Rope_append(C_Rope* self, StringView text);
+// index can be the length, which appends
+void C_Rope_insert(C_Rope* self, u64 index, StringView text);
+void C_Rope_delete(C_Rope* self, u64 index, u64 len);
+
+// appends the chars of other, which shares its nodes and is not changed
+void C_Rope_append_rope_P(C_Rope* self, C_Rope* other);
+C_Rope* C_Rope_concat_PR(C_Rope* a, C_Rope* b);
+C_Rope* C_Rope_substr_R(C_Rope* self, u64 index, u64 len);
+
+ascii C_Rope_at(C_Rope* self, u64 index);
+
+// flattens the chunks into one string
+C_String* C_Rope_to_str_R(void* self);
+// appends the chunks to sink without flattening
+void C_Rope_write_to(void* self, C_StringBuilder* sink, C_Format* format);
+
+/******************************
+ * get/set
+ ******************************/
+u64 C_Rope_get_len(C_Rope* self);
+// edges from the root to the deepest chunk, 0 for one chunk
+u32 C_Rope_get_depth(C_Rope* self);
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef STRING_BUILDER_H
+#define STRING_BUILDER_H
+
+#include <c_base/base/strings/string_convert.h>
+#include <c_base/base/strings/string_view.h>
+#include <c_base/base/strings/strings.h>
+#include <c_base/base/types.h>
+
+/* builds a string piece by piece in one buffer that doubles when it runs
+ * out, so appending n chars costs O(n) overall. finish hands the buffer
+ * to the new string instead of copying it.
+ * a sink builder has a fixed buffer instead and hands it to flush when it
+ * is full, that is how write_to reaches files and the console */
+// implements: IFormattable
+// C_StringBuilder is declared in strings.h, IFormattable writes into it
+
+typedef void (*StringBuilderFlush)(void* target, StringView chars);
+
+#define StringBuilderStartCap 64
+
+/******************************
+ * new/dest
+ ******************************/
+C_StringBuilder* C_StringBuilder_new(void);
+C_StringBuilder* C_StringBuilder_new_cap(u32 cap);
+/* keeps at most cap chars, at least NumberStrMaxLen, and flushes them to
+ * target when more come. target is borrowed. destroy flushes the rest */
+C_StringBuilder* C_StringBuilder_new_sink(
+  u32 cap, StringBuilderFlush flush, void* target);
+
+void C_StringBuilder_destroy(void* self);
+
+/******************************
+ * logic
+ ******************************/
+void C_StringBuilder_append_char(C_StringBuilder* self, ascii character);
+void C_StringBuilder_append_view(C_StringBuilder* self, StringView view);
+void C_StringBuilder_append_P(C_StringBuilder* self, C_String* string);
+
+// appends what IFormattable_write_to writes of value
+void C_StringBuilder_append_str_P(C_StringBuilder* self, void* value);
+void C_StringBuilder_append_str_format_P(
+  C_StringBuilder* self, void* value, C_Format* format);
+
+// the same text as the x_to_str_R functions
+void C_StringBuilder_append_u64(C_StringBuilder* self, u64 x);
+void C_StringBuilder_append_s64(C_StringBuilder* self, s64 x);
+void C_StringBuilder_append_f64(C_StringBuilder* self, f64 x);
+
+/* makes room for len more chars without growing again, a sink flushes
+ * instead */
+void C_StringBuilder_reserve(C_StringBuilder* self, u32 len);
+// removes the last len chars, a sink only has the ones not flushed
+void C_StringBuilder_pop(C_StringBuilder* self, u32 len);
+void C_StringBuilder_clear(C_StringBuilder* self);
+// hands the chars to the flush of a sink, does nothing for the others
+void C_StringBuilder_flush(C_StringBuilder* self);
+
+// copies the chars, the builder can go on
+C_String* C_StringBuilder_to_str_R(void* self);
+void C_StringBuilder_write_to(
+  void* self, C_StringBuilder* sink, C_Format* format);
+/* moves the chars into the string, the builder is empty afterwards. a
+ * sink copies the chars it has not flushed */
+C_String* C_StringBuilder_finish_R(C_StringBuilder* self);
+
+/******************************
+ * get/set
+ ******************************/
+u32 C_StringBuilder_get_len(C_StringBuilder* self);
+u32 C_StringBuilder_get_cap(C_StringBuilder* self);
+// valid until the next append
+StringView C_StringBuilder_get_view(C_StringBuilder* self);
+
+#endif
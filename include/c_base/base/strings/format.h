@@ -1,8 +1,56 @@
 #ifndef FORMAT_H
 #define FORMAT_H
 
+#include <c_base/base/strings/string_view.h>
 #include <c_base/base/strings/strings.h>
 
+/* a format string like "start=[;end=];sep=, " parsed once. the values are
+ * views into the format string, the fields the containers use are found
+ * by index. write_to gets a C_Format, so writing does no parsing */
+// C_Format is declared in strings.h, IFormattable takes it
+
+typedef enum {
+  FormatStart,
+  FormatEnd,
+  FormatSep,
+  FormatElSep,
+  FormatFieldCount,
+} FormatField;
+
+// the defaults of the containers, static like C_StringEmpty
+extern C_Format* C_FormatList; // "start=[;end=];sep=, "
+extern C_Format* C_FormatSet; // "start={;end=};sep=, "
+extern C_Format* C_FormatMap; // "start=[;end=];sep=, ;el_sep= : "
+
+/******************************
+ * new/dest
+ ******************************/
+// the last value of a key counts, a key without '=' has an empty value
+C_Format* C_Format_new_P(C_String* format);
+
+void C_Format_destroy(void* self);
+
+/******************************
+ * logic
+ ******************************/
+// empty when the field is not set
+StringView C_Format_get(C_Format* self, FormatField field);
+bool C_Format_has(C_Format* self, FormatField field);
+
+// any key, null when it is not set
+C_String* C_Format_get_value_R(C_Format* self, StringView key);
+
+/******************************
+ * get/set
+ ******************************/
+// null for the static formats
+C_String* C_Format_get_format_B(C_Format* self);
+u32 C_Format_get_len(C_Format* self);
+
+/******************************
+ * format strings
+ ******************************/
+// parses format for one key, keep a C_Format to look up more
 C_String* format_get_value_PR(C_String* format, C_String* key);
 
 #endif
@@ -6,6 +6,16 @@
 
 ascii digit_to_hex(u8 digit);
 
+// enough room for every number the writers below produce
+#define NumberStrMaxLen 40
+
+/* write the text of x to dest, which needs NumberStrMaxLen chars, and
+ * return how many were written */
+u32 u64_write(ascii* dest, u64 x);
+u32 s64_write(ascii* dest, s64 x);
+// the same text as f64_to_str_R
+u32 f64_write(ascii* dest, f64 x);
+
 C_String* u8_to_str_R(u8 x);
 C_String* u16_to_str_R(u16 x);
 C_String* u32_to_str_R(u32 x);
@@ -16,6 +26,10 @@ C_String* s16_to_str_R(s16 x);
 C_String* s32_to_str_R(s32 x);
 C_String* s64_to_str_R(s64 x);
 
+// fixed notation with at most 6 fraction digits
+C_String* f32_to_str_R(f32 x);
+C_String* f64_to_str_R(f64 x);
+
 C_String* b8_to_str_R(b8 x);
 C_String* b16_to_str_R(b16 x);
 C_String* b32_to_str_R(b32 x);
@@ -36,6 +50,9 @@ C_String* s16_to_str_format_R(s16 x, C_String* format);
 C_String* s32_to_str_format_R(s32 x, C_String* format);
 C_String* s64_to_str_format_R(s64 x, C_String* format);
 
+C_String* f32_to_str_format_R(f32 x, C_String* format);
+C_String* f64_to_str_format_R(f64 x, C_String* format);
+
 C_String* b8_to_str_format_R(b8 x, C_String* format);
 C_String* b16_to_str_format_R(b16 x, C_String* format);
 C_String* b32_to_str_format_R(b32 x, C_String* format);
@@ -45,6 +62,27 @@ C_String* ptr_to_str_format_R(void* ptr, C_String* format);
 
 C_String* bool_to_str_format_R(bool x, C_String* format);
 
+// append the text of the to_str_R functions above to sink
+void u8_write_to(u8 x, C_StringBuilder* sink);
+void u16_write_to(u16 x, C_StringBuilder* sink);
+void u32_write_to(u32 x, C_StringBuilder* sink);
+void u64_write_to(u64 x, C_StringBuilder* sink);
+
+void s8_write_to(s8 x, C_StringBuilder* sink);
+void s16_write_to(s16 x, C_StringBuilder* sink);
+void s32_write_to(s32 x, C_StringBuilder* sink);
+void s64_write_to(s64 x, C_StringBuilder* sink);
+
+void f32_write_to(f32 x, C_StringBuilder* sink);
+void f64_write_to(f64 x, C_StringBuilder* sink);
+
+void b8_write_to(b8 x, C_StringBuilder* sink);
+void b16_write_to(b16 x, C_StringBuilder* sink);
+void b32_write_to(b32 x, C_StringBuilder* sink);
+void b64_write_to(b64 x, C_StringBuilder* sink);
+
+void bool_write_to(bool x, C_StringBuilder* sink);
+
 C_Result* /* u32 */ u32_parse_PR(C_String* string);
 C_Result* /* s32 */ s32_parse_PR(C_String* string);
 
@@ -10,18 +10,32 @@
 #define S(cstr) C_String_new((ascii*)cstr, sizeof(cstr) - 1)
 #define PS(cstr) Pass(S(cstr))
 
+/* copies up to this length keep their chars in the string, without a
+ * second allocation. fits every u64 and s64, the string is 80 bytes */
+#define StringInlineCap 24
+
 GenericVal_ErrorCode(EG_Strings)
 
-// implements: IFormattable, IHashable
+// implements: IFormattable, IHashable, IComparable
 typedef struct C_String C_String;
 
 extern C_String* C_StringEmpty;
 
+// see C_StringBuilder.h, the sink write_to writes into
+typedef struct C_StringBuilder C_StringBuilder;
+// see format.h, a parsed format string
+typedef struct C_Format C_Format;
+
+/* write_to appends the text to sink, a null format is the default one.
+ * types that write can leave to_str_R and to_str_format_R null, they are
+ * made with a builder then. types that only make strings are written by
+ * appending the string */
 typedef struct {
   Interface interface;
 
   C_String* (*to_str_R)(void* self);
   C_String* (*to_str_format_R)(void* self, C_String* format);
+  void (*write_to)(void* self, C_StringBuilder* sink, C_Format* format);
 } IFormattable;
 Id(IFormattable)
 
@@ -31,9 +45,22 @@ Id(IFormattable)
 IFormattable IFormattable_construct_format(C_String* (*to_str_R)(void* self),
   C_String* (*to_str_format_R)(void* self, C_String* format));
 IFormattable IFormattable_construct(C_String* (*to_str_R)(void* self));
+IFormattable IFormattable_construct_write(
+  void (*write_to)(void* self, C_StringBuilder* sink, C_Format* format));
+// to_str_R and to_str_format_R can be null
+IFormattable IFormattable_construct_format_write(
+  C_String* (*to_str_R)(void* self),
+  C_String* (*to_str_format_R)(void* self, C_String* format),
+  void (*write_to)(void* self, C_StringBuilder* sink, C_Format* format));
 
 C_String* IFormattable_to_str_PR(void* self);
+// parses format once for a type that writes
 C_String* IFormattable_to_str_format_PR(void* self, C_String* format);
+// format can be null, it is not parsed again
+C_String* IFormattable_to_str_compiled_PR(void* self, C_Format* format);
+// format can be null
+void IFormattable_write_to_PR(
+  void* self, C_StringBuilder* sink, C_Format* format);
 
 /******************************
  * new/dest
@@ -43,6 +70,8 @@ C_String* C_String_new_view(StringView view);
 C_String* C_String_new_empty(u32 len);
 C_String* C_String_new_view_copy(StringView view);
 C_String* C_String_new_copy(ascii* chars, u32 len);
+// takes chars from allocate, they are deallocated with the string
+C_String* C_String_new_owned(ascii* chars, u32 len);
 
 void C_String_destroy(void* self);
 
@@ -50,9 +79,11 @@ void C_String_destroy(void* self);
  * logic
  ******************************/
 C_String* C_String_to_str_R(void* self);
+void C_String_write_to(void* self, C_StringBuilder* sink, C_Format* format);
 ascii C_String_at(C_String* self, u32 index);
 void C_String_put(C_String* self, u32 index, ascii character);
 
+// shares the chars of original and keeps it alive
 C_String* C_String_substr_R(C_String* original, u32 index, u32 len);
 C_String* C_String_concat_PR(C_String* string, ...);
 
@@ -60,11 +91,13 @@ C_Array* /* C_String* */ C_String_split_R(C_String* string, ascii splitter);
 C_String* C_String_join_PR(C_Array* /* C_String* */ strings);
 
 bool C_String_equals(void* a, void* b);
+s32 C_String_compare(void* a, void* b);
 /******************************
  * get/set
  ******************************/
 ascii* C_String_get_chars(C_String* self);
 u32 C_String_get_len(C_String* self);
+StringView C_String_get_view(C_String* self);
 
 /******************************
  * cstr conversion
@@ -75,5 +108,6 @@ C_Ptr* C_String_to_cstr(C_String* self);
 /* cyclic dependencies :( */
 C_String* C_Array_to_str_format_R(void* self, C_String* format);
 C_String* C_Array_to_str_R(void* self);
+void C_Array_write_to(void* self, C_StringBuilder* sink, C_Format* format);
 
 #endif
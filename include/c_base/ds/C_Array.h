@@ -4,6 +4,7 @@
 #include <c_base/base/errors/errors.h>
 #include <c_base/base/types.h>
 #include <c_base/ds/ds_base.h>
+#include <c_base/ds/ds_sort.h>
 
 #define C_ArrayForeach(array, code)                                            \
   do {                                                                         \
@@ -41,6 +42,15 @@ void* C_Array_peek_front_R(C_Array* self);
 
 void C_Array_clear(C_Array* self);
 
+// values must implement IComparable, nulls sort first
+void C_Array_sort(C_Array* self);
+void C_Array_sort_by(C_Array* self, CompareFunc compare);
+
+// threads == 0 uses every cpu, short arrays are sorted on the calling thread
+void C_Array_sort_parallel(C_Array* self, u32 threads);
+void C_Array_sort_by_parallel(
+  C_Array* self, CompareFunc compare, u32 threads);
+
 bool C_Array_equals(void* a, void* b);
 u32 C_Array_hash(void* self);
 
@@ -49,5 +59,7 @@ u32 C_Array_hash(void* self);
  ******************************/
 
 u32 C_Array_get_len(C_Array* self);
+// the values, valid until the array is destroyed
+void** C_Array_get_data(C_Array* self);
 
 #endif
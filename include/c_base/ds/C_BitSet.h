@@ -0,0 +1,62 @@
+#ifndef BIT_SET_H
+#define BIT_SET_H
+
+#include <c_base/base/errors/errors.h>
+#include <c_base/base/strings/strings.h>
+#include <c_base/base/types.h>
+#include <c_base/ds/ds_base.h>
+
+/* a fixed number of bits packed into u64 words. the operations over
+ * whole sets run the ds_simd bit kernels */
+typedef struct C_BitSet C_BitSet;
+
+/******************************
+ * new/dest
+ ******************************/
+// len bits, all clear
+C_BitSet* C_BitSet_new(u64 len);
+C_BitSet* C_BitSet_new_copy(C_BitSet* other);
+
+void C_BitSet_destroy(void* self);
+
+/******************************
+ * logic
+ ******************************/
+void C_BitSet_set(C_BitSet* self, u64 index);
+void C_BitSet_clear(C_BitSet* self, u64 index);
+bool C_BitSet_test(C_BitSet* self, u64 index);
+
+void C_BitSet_set_all(C_BitSet* self);
+void C_BitSet_clear_all(C_BitSet* self);
+
+// index of the first set bit at or after from, len when there is none
+u64 C_BitSet_find_next_set(C_BitSet* self, u64 from);
+
+// number of set bits
+u64 C_BitSet_count(C_BitSet* self);
+// number of set bits below index
+u64 C_BitSet_rank(C_BitSet* self, u64 index);
+
+// self = self op other, both have the same len. andnot is self & ~other
+void C_BitSet_and(C_BitSet* self, C_BitSet* other);
+void C_BitSet_or(C_BitSet* self, C_BitSet* other);
+void C_BitSet_xor(C_BitSet* self, C_BitSet* other);
+void C_BitSet_andnot(C_BitSet* self, C_BitSet* other);
+
+u32 C_BitSet_hash(void* self);
+bool C_BitSet_equals(void* a, void* b);
+
+// the indices of the set bits
+C_String* C_BitSet_to_str_format_R(void* self, C_String* format);
+C_String* C_BitSet_to_str_R(void* self);
+void C_BitSet_write_to(void* self, C_StringBuilder* sink, C_Format* format);
+
+/******************************
+ * get/set
+ ******************************/
+u64 C_BitSet_get_len(C_BitSet* self);
+// the words, bit i is bit i % 64 of word i / 64. bits past len stay clear
+u64* C_BitSet_get_words(C_BitSet* self);
+u32 C_BitSet_get_word_len(C_BitSet* self);
+
+#endif
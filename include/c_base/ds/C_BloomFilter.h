@@ -0,0 +1,45 @@
+#ifndef BLOOM_FILTER_H
+#define BLOOM_FILTER_H
+
+#include <c_base/base/errors/errors.h>
+#include <c_base/base/types.h>
+#include <c_base/ds/ds_base.h>
+
+/* a split block bloom filter. every key sets 8 bits in one block of
+ * 256 bits, one bit in each 32 bit word, so a lookup touches a single
+ * cache line. contains never misses an added key, other keys are reported
+ * with a rate that depends on bits_per_key: ~3% at 8, ~0.5% at 12 and
+ * ~0.1% at 16 */
+typedef struct C_BloomFilter C_BloomFilter;
+
+/******************************
+ * new/dest
+ ******************************/
+C_BloomFilter* C_BloomFilter_new(u32 expected_len, u32 bits_per_key);
+
+void C_BloomFilter_destroy(void* self);
+
+/******************************
+ * logic
+ ******************************/
+// keys must implement IHashable, they are not stored
+void C_BloomFilter_add_P(C_BloomFilter* self, void* key);
+bool C_BloomFilter_contains_P(C_BloomFilter* self, void* key);
+
+void C_BloomFilter_add_bytes(C_BloomFilter* self, void* data, u64 size);
+bool C_BloomFilter_contains_bytes(C_BloomFilter* self, void* data, u64 size);
+
+// hash has to be mixed over all 64 bits, see ds_hash_mix
+void C_BloomFilter_add_hash(C_BloomFilter* self, u64 hash);
+bool C_BloomFilter_contains_hash(C_BloomFilter* self, u64 hash);
+
+void C_BloomFilter_clear(C_BloomFilter* self);
+
+/******************************
+ * get/set
+ ******************************/
+// number of adds, keys added twice count twice
+u32 C_BloomFilter_get_len(C_BloomFilter* self);
+u64 C_BloomFilter_get_bits(C_BloomFilter* self);
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef CLOCK_CACHE_H
+#define CLOCK_CACHE_H
+
+#include <c_base/base/errors/errors.h>
+#include <c_base/base/strings/string_view.h>
+#include <c_base/base/types.h>
+#include <c_base/ds/C_LruCache.h>
+#include <c_base/ds/ds_base.h>
+
+/* a cache that many threads can use at once. the keys are split by hash
+ * into shards with a lock each, so threads only wait for each other on the
+ * same shard. eviction is CLOCK: a hit only sets a bit on its entry, when a
+ * shard is full a hand walks its slots, clears set bits and evicts the
+ * first entry without one.
+ * reference counts are not atomic, so keys are copied bytes and values are
+ * value_size bytes copied in by put and out by get */
+typedef struct C_ClockCache C_ClockCache;
+
+// key and value are valid during the call, the shard is locked
+typedef void (*ClockEvict)(StringView key, void* value, void* data);
+
+/******************************
+ * new/dest
+ ******************************/
+/* shard_count is rounded up to a power of two, cap up to a multiple of
+ * it. a few shards per thread keep the waits short */
+C_ClockCache* C_ClockCache_new(u32 cap, u32 shard_count, u32 value_size);
+
+void C_ClockCache_destroy(void* self);
+
+/******************************
+ * logic
+ ******************************/
+// an existing key gets the new value
+void C_ClockCache_put(C_ClockCache* self, StringView key, void* value);
+// copies the value to value, false on a miss
+bool C_ClockCache_get(C_ClockCache* self, StringView key, void* value);
+// the evict callback is not called
+bool C_ClockCache_remove(C_ClockCache* self, StringView key);
+
+void C_ClockCache_clear(C_ClockCache* self);
+
+/******************************
+ * get/set
+ ******************************/
+// sums of all shards, each shard is read at a different moment
+u32 C_ClockCache_get_len(C_ClockCache* self);
+CacheStats C_ClockCache_get_stats(C_ClockCache* self);
+
+u32 C_ClockCache_get_cap(C_ClockCache* self);
+
+// set it before other threads use the cache
+void C_ClockCache_set_evict(C_ClockCache* self, ClockEvict evict, void* data);
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef CUCKOO_FILTER_H
+#define CUCKOO_FILTER_H
+
+#include <c_base/base/errors/errors.h>
+#include <c_base/base/types.h>
+#include <c_base/ds/ds_base.h>
+
+/* a cuckoo filter with buckets of 4 fingerprints of 16 bits.
+ * like a bloom filter contains never misses an added key and reports
+ * others with a small rate (~0.01%), unlike one keys can be removed again.
+ * every key has two buckets, a full bucket moves a fingerprint to its
+ * other bucket to make room */
+typedef struct C_CuckooFilter C_CuckooFilter;
+
+/******************************
+ * new/dest
+ ******************************/
+// room for at least cap keys
+C_CuckooFilter* C_CuckooFilter_new(u32 cap);
+
+void C_CuckooFilter_destroy(void* self);
+
+/******************************
+ * logic
+ ******************************/
+/* keys must implement IHashable, they are not stored.
+ * add returns false when the filter is full, the key was not added */
+bool C_CuckooFilter_add_P(C_CuckooFilter* self, void* key);
+bool C_CuckooFilter_contains_P(C_CuckooFilter* self, void* key);
+// only remove keys that were added, others may remove a different key
+bool C_CuckooFilter_remove_P(C_CuckooFilter* self, void* key);
+
+bool C_CuckooFilter_add_bytes(C_CuckooFilter* self, void* data, u64 size);
+bool C_CuckooFilter_contains_bytes(
+  C_CuckooFilter* self, void* data, u64 size);
+bool C_CuckooFilter_remove_bytes(C_CuckooFilter* self, void* data, u64 size);
+
+// hash has to be mixed over all 64 bits, see ds_hash_mix
+bool C_CuckooFilter_add_hash(C_CuckooFilter* self, u64 hash);
+bool C_CuckooFilter_contains_hash(C_CuckooFilter* self, u64 hash);
+bool C_CuckooFilter_remove_hash(C_CuckooFilter* self, u64 hash);
+
+void C_CuckooFilter_clear(C_CuckooFilter* self);
+
+/******************************
+ * get/set
+ ******************************/
+u32 C_CuckooFilter_get_len(C_CuckooFilter* self);
+// number of fingerprint slots, adds start failing at about 95% of it
+u64 C_CuckooFilter_get_cap(C_CuckooFilter* self);
+
+#endif
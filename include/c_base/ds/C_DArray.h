@@ -3,7 +3,10 @@
 
 #include <c_base/base/strings/strings.h>
 #include <c_base/base/types.h>
+#include <c_base/ds/C_Array.h>
 #include <c_base/ds/ds_base.h>
+#include <c_base/ds/ds_sort.h>
+#include <c_base/ds/ds_sorted.h>
 
 #define C_DArrayForeach(darray, code)                                          \
   do {                                                                         \
@@ -17,6 +20,20 @@
 
 typedef struct C_DArray C_DArray;
 
+/* returns the capacity a darray grows to when it needs space for min_cap
+ * values, the result must be at least min_cap */
+typedef u32 (*DArrayGrowth)(u32 cap, u32 min_cap);
+
+// darrays with a capacity up to this keep their values inside the darray
+#define DArrayInlineCap 8
+
+// page size used by DArrayGrowth_pages
+#define DArrayGrowthPage Kilobytes(4)
+
+u32 DArrayGrowth_double(u32 cap, u32 min_cap);
+u32 DArrayGrowth_one_half(u32 cap, u32 min_cap);
+u32 DArrayGrowth_pages(u32 cap, u32 min_cap);
+
 C_DArray* C_DArray_new(void);
 C_DArray* C_DArray_new_cap(u32 cap);
 
@@ -25,6 +42,9 @@ void C_DArray_destroy(void* self);
 C_Array* C_DArray_to_array_PR(C_DArray* self);
 
 void C_DArray_push_P(C_DArray* self, void* value);
+// appends len values with a single capacity check
+void C_DArray_push_many_P(C_DArray* self, void** values, u32 len);
+void C_DArray_push_array_P(C_DArray* self, C_Array* array);
 void C_DArray_push_front_P(C_DArray* self, void* value);
 
 void* C_DArray_pop_R(C_DArray* self);
@@ -43,16 +63,47 @@ void* C_DArray_at_B(C_DArray* self, u32 index);
 void* C_DArray_remove_R(C_DArray* self, u32 index);
 
 void C_DArray_resize(C_DArray* self, u32 cap);
+// grows the capacity to at least cap using the growth policy
+void C_DArray_reserve(C_DArray* self, u32 cap);
 void C_DArray_compress(C_DArray* self);
 void C_DArray_clear(C_DArray* self);
 
+// values must implement IComparable, nulls sort first
+void C_DArray_sort(C_DArray* self);
+void C_DArray_sort_by(C_DArray* self, CompareFunc compare);
+
+// threads == 0 uses every cpu, short arrays are sorted on the calling thread
+void C_DArray_sort_parallel(C_DArray* self, u32 threads);
+void C_DArray_sort_by_parallel(
+  C_DArray* self, CompareFunc compare, u32 threads);
+
+/* the darrays must be sorted by compare, see ds_sorted.h.
+ * IComparable_compare can be passed for IComparable values */
+u32 C_DArray_lower_bound(C_DArray* self, void* value, CompareFunc compare);
+u32 C_DArray_upper_bound(C_DArray* self, void* value, CompareFunc compare);
+SortedRange C_DArray_equal_range(
+  C_DArray* self, void* value, CompareFunc compare);
+// inserts after the values equal to value and returns the index
+u32 C_DArray_insert_sorted_P(C_DArray* self, void* value, CompareFunc compare);
+
+C_DArray* C_DArray_union_R(C_DArray* a, C_DArray* b, CompareFunc compare);
+C_DArray* C_DArray_intersection_R(
+  C_DArray* a, C_DArray* b, CompareFunc compare);
+C_DArray* C_DArray_difference_R(C_DArray* a, C_DArray* b, CompareFunc compare);
+
 u32 C_DArray_hash(void* self);
 bool C_DArray_equals(void* a, void* b);
 
 C_String* C_DArray_to_str_format_R(void* self, C_String* format);
 C_String* C_DArray_to_str_R(void* self);
+void C_DArray_write_to(void* self, C_StringBuilder* sink, C_Format* format);
 
 u32 C_DArray_get_cap(C_DArray* self);
 u32 C_DArray_get_len(C_DArray* self);
+// the values, valid until the darray grows, shrinks or is destroyed
+void** C_DArray_get_data(C_DArray* self);
+
+// DArrayGrowth_double by default
+void C_DArray_set_growth(C_DArray* self, DArrayGrowth growth);
 
 #endif
@@ -0,0 +1,67 @@
+#ifndef DEQUE_H
+#define DEQUE_H
+
+#include <c_base/base/errors/errors.h>
+#include <c_base/base/strings/strings.h>
+#include <c_base/ds/C_Array.h>
+#include <c_base/ds/ds_base.h>
+
+#define C_DequeForeach(deque, code)                                            \
+  do {                                                                         \
+    for (u32 iter = 0; iter < C_Deque_get_len(deque); iter++) {                \
+      void* value = C_Deque_at_B(deque, iter);                                 \
+      {                                                                        \
+        code                                                                   \
+      }                                                                        \
+    }                                                                          \
+  } while (0)
+
+typedef struct C_Deque C_Deque;
+
+/******************************
+ * new/dest
+ ******************************/
+C_Deque* C_Deque_new(void);
+// cap is rounded up to a power of two, at most 2^31
+C_Deque* C_Deque_new_cap(u32 cap);
+
+void C_Deque_destroy(void* self);
+
+/******************************
+ * logic
+ ******************************/
+C_Array* C_Deque_to_array_PR(C_Deque* self);
+
+void C_Deque_push_P(C_Deque* self, void* value);
+void C_Deque_push_front_P(C_Deque* self, void* value);
+
+void* C_Deque_pop_R(C_Deque* self);
+void* C_Deque_pop_front_R(C_Deque* self);
+
+void* C_Deque_peek_B(C_Deque* self);
+void* C_Deque_peek_R(C_Deque* self);
+
+void* C_Deque_peek_front_B(C_Deque* self);
+void* C_Deque_peek_front_R(C_Deque* self);
+
+void* C_Deque_at_B(C_Deque* self, u32 index);
+void* C_Deque_at_R(C_Deque* self, u32 index);
+
+void C_Deque_put_P(C_Deque* self, u32 index, void* value);
+
+void C_Deque_clear(C_Deque* self);
+
+u32 C_Deque_hash(void* self);
+bool C_Deque_equals(void* a, void* b);
+
+C_String* C_Deque_to_str_format_R(void* self, C_String* format);
+C_String* C_Deque_to_str_R(void* self);
+void C_Deque_write_to(void* self, C_StringBuilder* sink, C_Format* format);
+
+/******************************
+ * get/set
+ ******************************/
+u32 C_Deque_get_len(C_Deque* self);
+u32 C_Deque_get_cap(C_Deque* self);
+
+#endif
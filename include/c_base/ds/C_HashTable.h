@@ -29,5 +29,6 @@ bool C_HashTable_equals(void* a, void* b);
 
 C_String* C_HashTable_to_str_format_R(void* self, C_String* format);
 C_String* C_HashTable_to_str_R(void* self);
+void C_HashTable_write_to(void* self, C_StringBuilder* sink, C_Format* format);
 
 #endif
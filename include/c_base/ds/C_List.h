@@ -5,11 +5,14 @@
 #include <c_base/base/strings/strings.h>
 #include <c_base/ds/C_Array.h>
 #include <c_base/ds/ds_base.h>
+#include <c_base/ds/ds_sort.h>
 
 #define C_ListForeach(list, code)                                              \
   do {                                                                         \
-    for (u32 iter = 0; iter < C_List_get_len(list); iter++) {                  \
-      void* value = C_List_at_B(list, iter);                                   \
+    ListCursor __cursor = ListCursor_construct(list);                          \
+    for (u32 iter = 0; ListCursor_valid(&__cursor);                            \
+      iter++, ListCursor_next(&__cursor)) {                                    \
+      void* value = ListCursor_get_B(&__cursor);                               \
       {                                                                        \
         code                                                                   \
       }                                                                        \
@@ -23,6 +26,36 @@ typedef struct Node {
 
 typedef struct C_List C_List;
 
+// how many released nodes a list keeps for reuse by default
+#define ListNodeCacheCap 64
+
+/******************************
+ * ListCursor
+ ******************************/
+typedef struct {
+  Node* prev;
+  Node* node;
+} ListCursor;
+
+ListCursor ListCursor_construct(C_List* list);
+
+bool ListCursor_valid(ListCursor* self);
+void ListCursor_next(ListCursor* self);
+
+void* ListCursor_get_B(ListCursor* self);
+void* ListCursor_get_R(ListCursor* self);
+
+/******************************
+ * ListStats
+ ******************************/
+typedef struct {
+  u64 node_hits;   // nodes taken from the spare node cache
+  u64 node_misses; // nodes that had to be allocated
+  u32 spare_nodes;
+} ListStats;
+
+f64 ListStats_hit_rate(ListStats* self);
+
 /******************************
  * new/dest
  ******************************/
@@ -52,18 +85,27 @@ void* C_List_at_B(C_List* self, u32 index);
 void* C_List_at_R(C_List* self, u32 index);
 
 void* C_List_remove_R(C_List* self, u32 index);
+void* C_List_remove_cursor_R(C_List* self, ListCursor* cursor);
 
 void C_List_clear(C_List* self);
 
+// stable merge sort, values must implement IComparable
+void C_List_sort(C_List* self);
+void C_List_sort_by(C_List* self, CompareFunc compare);
+
 u32 C_List_hash(void* self);
 bool C_List_equals(void* a, void* b);
 
 C_String* C_List_to_str_format_R(void* self, C_String* format);
 C_String* C_List_to_str_R(void* self);
+void C_List_write_to(void* self, C_StringBuilder* sink, C_Format* format);
 
 /******************************
  * get/set
  ******************************/
 u32 C_List_get_len(C_List* self);
 
+ListStats C_List_get_stats(C_List* self);
+void C_List_set_node_cache_cap(C_List* self, u32 cap);
+
 #endif
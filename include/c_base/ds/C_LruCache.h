@@ -0,0 +1,83 @@
+#ifndef LRU_CACHE_H
+#define LRU_CACHE_H
+
+#include <c_base/base/errors/errors.h>
+#include <c_base/base/types.h>
+#include <c_base/ds/ds_base.h>
+
+/* a map with a budget that drops the least recently used entries when
+ * the budget is exceeded. entries are in a hash index and in a doubly
+ * linked list by recency, a hit moves its entry to the front, so get,
+ * put, remove and evict are all O(1) */
+typedef struct C_LruCache C_LruCache;
+
+/******************************
+ * CacheStats
+ ******************************/
+typedef struct {
+  u64 hits;
+  u64 misses;
+  // entries dropped to stay within the budget
+  u64 evictions;
+} CacheStats;
+
+f64 CacheStats_hit_rate(CacheStats* self);
+
+/******************************
+ * CacheCallbacks
+ ******************************/
+typedef struct {
+  // cost of an entry against the budget, null costs every entry 1
+  u64 (*cost)(void* key, void* value, void* data);
+  // an entry is evicted, key and value are borrowed
+  void (*evict)(void* key, void* value, void* data);
+  // value of a missing key for get_or_load, a new reference or null
+  void* (*load)(void* key, void* data);
+  void* data;
+} CacheCallbacks;
+
+/******************************
+ * new/dest
+ ******************************/
+// how many released entries a cache keeps for reuse
+#define LruSpareCap 64
+
+/* budget is the total cost of the entries. every entry costs 1 unless a
+ * cost callback is set, then budget is e.g. a number of bytes */
+C_LruCache* C_LruCache_new(u64 budget);
+
+void C_LruCache_destroy(void* self);
+
+/******************************
+ * logic
+ ******************************/
+// keys must implement IHashable, an existing key gets the new value
+void C_LruCache_put_P(C_LruCache* self, void* key, void* value);
+
+// a hit makes the entry the most recently used, null on a miss
+void* C_LruCache_get_PB(C_LruCache* self, void* key);
+void* C_LruCache_get_PR(C_LruCache* self, void* key);
+// a miss calls the load callback and puts its value
+void* C_LruCache_get_or_load_PR(C_LruCache* self, void* key);
+
+// does not change the recency or the stats
+bool C_LruCache_contains_P(C_LruCache* self, void* key);
+
+// the evict callback is not called, null when the key is missing
+void* C_LruCache_remove_PR(C_LruCache* self, void* key);
+
+void C_LruCache_clear(C_LruCache* self);
+
+/******************************
+ * get/set
+ ******************************/
+u32 C_LruCache_get_len(C_LruCache* self);
+// the total cost of the entries
+u64 C_LruCache_get_used(C_LruCache* self);
+u64 C_LruCache_get_budget(C_LruCache* self);
+
+CacheStats C_LruCache_get_stats(C_LruCache* self);
+
+void C_LruCache_set_callbacks(C_LruCache* self, CacheCallbacks callbacks);
+
+#endif
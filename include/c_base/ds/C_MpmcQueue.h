@@ -0,0 +1,38 @@
+#ifndef MPMC_QUEUE_H
+#define MPMC_QUEUE_H
+
+#include <c_base/base/errors/errors.h>
+#include <c_base/base/types.h>
+#include <c_base/ds/ds_base.h>
+
+/* a bounded lock-free fifo for any number of producer and consumer
+ * threads. every slot has a sequence number that tells whether it is free
+ * for the push or filled for the pop of a given round, so a push and a pop
+ * only compete on their own index. values are not referenced, see
+ * C_SpscQueue */
+typedef struct C_MpmcQueue C_MpmcQueue;
+
+/******************************
+ * new/dest
+ ******************************/
+// cap is rounded up to a power of two, at least 2
+C_MpmcQueue* C_MpmcQueue_new(u32 cap);
+
+void C_MpmcQueue_destroy(void* self);
+
+/******************************
+ * logic
+ ******************************/
+// false when the queue is full
+bool C_MpmcQueue_push(C_MpmcQueue* self, void* value);
+// false when the queue is empty
+bool C_MpmcQueue_pop(C_MpmcQueue* self, void** value);
+
+/******************************
+ * get/set
+ ******************************/
+// a snapshot, stale as soon as another thread pushes or pops
+u32 C_MpmcQueue_get_len(C_MpmcQueue* self);
+u32 C_MpmcQueue_get_cap(C_MpmcQueue* self);
+
+#endif
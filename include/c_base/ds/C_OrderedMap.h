@@ -0,0 +1,93 @@
+#ifndef ORDERED_MAP_H
+#define ORDERED_MAP_H
+
+#include <c_base/base/errors/errors.h>
+#include <c_base/base/strings/strings.h>
+#include <c_base/base/types.h>
+#include <c_base/ds/ds_base.h>
+#include <c_base/ds/ds_sort.h>
+
+#define C_OrderedMapForeach(map, code)                                         \
+  do {                                                                         \
+    MapCursor __cursor = MapCursor_construct(map);                             \
+    for (u32 iter = 0; MapCursor_valid(&__cursor);                             \
+      iter++, MapCursor_next(&__cursor)) {                                     \
+      void* key = MapCursor_get_key_B(&__cursor);                              \
+      void* value = MapCursor_get_value_B(&__cursor);                          \
+      (void)key;                                                               \
+      (void)value;                                                             \
+      {                                                                        \
+        code                                                                   \
+      }                                                                        \
+    }                                                                          \
+  } while (0)
+
+/* a B+-tree, the keys are kept sorted by compare.
+ * a leaf holds up to MapLeafCap keys and values, a branch up to
+ * MapBranchCap children. the leaves are linked for in order iteration */
+#define MapLeafCap 32
+#define MapBranchCap 32
+
+typedef struct C_OrderedMap C_OrderedMap;
+typedef struct MapLeaf MapLeaf;
+
+/******************************
+ * MapCursor
+ ******************************/
+// points at a key of a map, valid until the map is changed
+typedef struct {
+  MapLeaf* leaf;
+  u32 index;
+} MapCursor;
+
+// cursor at the smallest key
+MapCursor MapCursor_construct(C_OrderedMap* map);
+
+bool MapCursor_valid(MapCursor* self);
+void MapCursor_next(MapCursor* self);
+
+void* MapCursor_get_key_B(MapCursor* self);
+void* MapCursor_get_value_B(MapCursor* self);
+void* MapCursor_get_value_R(MapCursor* self);
+
+/******************************
+ * new/dest
+ ******************************/
+// keys must implement IComparable, nulls are the smallest
+C_OrderedMap* C_OrderedMap_new(void);
+C_OrderedMap* C_OrderedMap_new_by(CompareFunc compare);
+
+void C_OrderedMap_destroy(void* self);
+
+/******************************
+ * logic
+ ******************************/
+void C_OrderedMap_put_P(C_OrderedMap* self, void* key, void* value);
+
+void* C_OrderedMap_at_PB(C_OrderedMap* self, void* key);
+void* C_OrderedMap_at_PR(C_OrderedMap* self, void* key);
+
+bool C_OrderedMap_contains_P(C_OrderedMap* self, void* key);
+
+void* C_OrderedMap_remove_PR(C_OrderedMap* self, void* key);
+
+// cursor at the first key not less than key, invalid when there is none
+MapCursor C_OrderedMap_lower_bound_P(C_OrderedMap* self, void* key);
+
+void C_OrderedMap_clear(C_OrderedMap* self);
+
+u32 C_OrderedMap_hash(void* self);
+bool C_OrderedMap_equals(void* a, void* b);
+
+C_String* C_OrderedMap_to_str_format_R(void* self, C_String* format);
+C_String* C_OrderedMap_to_str_R(void* self);
+void C_OrderedMap_write_to(void* self, C_StringBuilder* sink, C_Format* format);
+
+/******************************
+ * get/set
+ ******************************/
+u32 C_OrderedMap_get_len(C_OrderedMap* self);
+// levels of branches above the leaves, 0 while the root is a leaf
+u32 C_OrderedMap_get_depth(C_OrderedMap* self);
+
+#endif
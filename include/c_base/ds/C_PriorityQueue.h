@@ -0,0 +1,93 @@
+#ifndef PRIORITY_QUEUE_H
+#define PRIORITY_QUEUE_H
+
+#include <c_base/base/errors/errors.h>
+#include <c_base/base/strings/strings.h>
+#include <c_base/ds/C_Array.h>
+#include <c_base/ds/ds_base.h>
+#include <c_base/ds/ds_sort.h>
+
+/* min queues backed by a 4-ary heap, pop returns the smallest value.
+ * push returns a handle that stays valid until its value is popped,
+ * decrease_key uses it to find the value without searching the heap.
+ * a handle is a slot in the low 32 bits and a generation in the high
+ * ones, a slot is reused after a pop but its old handles stay invalid */
+typedef u64 PriorityHandle;
+
+typedef struct C_PriorityQueue C_PriorityQueue;
+
+/******************************
+ * new/dest
+ ******************************/
+// values must implement IComparable, nulls are the smallest
+C_PriorityQueue* C_PriorityQueue_new(void);
+C_PriorityQueue* C_PriorityQueue_new_by(CompareFunc compare);
+
+void C_PriorityQueue_destroy(void* self);
+
+/******************************
+ * logic
+ ******************************/
+PriorityHandle C_PriorityQueue_push_P(C_PriorityQueue* self, void* value);
+
+void* C_PriorityQueue_pop_R(C_PriorityQueue* self);
+
+void* C_PriorityQueue_peek_B(C_PriorityQueue* self);
+void* C_PriorityQueue_peek_R(C_PriorityQueue* self);
+
+// replaces the value of handle with one that compares less or equal
+void C_PriorityQueue_decrease_key_P(
+  C_PriorityQueue* self, PriorityHandle handle, void* value);
+// false once the value of handle was popped or the queue cleared
+bool C_PriorityQueue_contains(C_PriorityQueue* self, PriorityHandle handle);
+
+// the values in heap order, not sorted
+C_Array* C_PriorityQueue_to_array_PR(C_PriorityQueue* self);
+
+void C_PriorityQueue_clear(C_PriorityQueue* self);
+
+C_String* C_PriorityQueue_to_str_format_R(void* self, C_String* format);
+C_String* C_PriorityQueue_to_str_R(void* self);
+void C_PriorityQueue_write_to(
+  void* self, C_StringBuilder* sink, C_Format* format);
+
+/******************************
+ * get/set
+ ******************************/
+u32 C_PriorityQueue_get_len(C_PriorityQueue* self);
+
+/******************************
+ * C_PriorityQueue_u64
+ ******************************/
+/* the same queue for plain values ordered by a u64 priority,
+ * for schedulers that queue ids or indices instead of objects */
+typedef struct {
+  u64 priority;
+  u64 value;
+} PriorityEntry;
+
+typedef struct C_PriorityQueue_u64 C_PriorityQueue_u64;
+
+C_PriorityQueue_u64* C_PriorityQueue_u64_new(void);
+void C_PriorityQueue_u64_destroy(void* self);
+
+PriorityHandle C_PriorityQueue_u64_push(
+  C_PriorityQueue_u64* self, u64 priority, u64 value);
+PriorityEntry C_PriorityQueue_u64_pop(C_PriorityQueue_u64* self);
+PriorityEntry C_PriorityQueue_u64_peek(C_PriorityQueue_u64* self);
+
+void C_PriorityQueue_u64_decrease_key(
+  C_PriorityQueue_u64* self, PriorityHandle handle, u64 priority);
+bool C_PriorityQueue_u64_contains(
+  C_PriorityQueue_u64* self, PriorityHandle handle);
+
+void C_PriorityQueue_u64_clear(C_PriorityQueue_u64* self);
+
+C_String* C_PriorityQueue_u64_to_str_format_R(void* self, C_String* format);
+C_String* C_PriorityQueue_u64_to_str_R(void* self);
+void C_PriorityQueue_u64_write_to(
+  void* self, C_StringBuilder* sink, C_Format* format);
+
+u32 C_PriorityQueue_u64_get_len(C_PriorityQueue_u64* self);
+
+#endif
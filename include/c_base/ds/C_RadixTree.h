@@ -0,0 +1,59 @@
+#ifndef RADIX_TREE_H
+#define RADIX_TREE_H
+
+#include <c_base/base/errors/errors.h>
+#include <c_base/base/strings/string_view.h>
+#include <c_base/base/strings/strings.h>
+#include <c_base/base/types.h>
+#include <c_base/ds/ds_base.h>
+
+/* an adaptive radix tree, maps byte strings to values.
+ * inner nodes grow from 4 to 16, 48 and 256 children and shrink back,
+ * the bytes shared by all keys below a node are stored once in the node */
+
+typedef struct C_RadixTree C_RadixTree;
+
+// return false to stop the iteration, key is valid during the call
+typedef bool (*RadixVisit)(StringView key, void* value, void* data);
+
+/******************************
+ * new/dest
+ ******************************/
+C_RadixTree* C_RadixTree_new(void);
+
+void C_RadixTree_destroy(void* self);
+
+/******************************
+ * logic
+ ******************************/
+// the key is copied into the tree
+void C_RadixTree_put_P(C_RadixTree* self, StringView key, void* value);
+
+void* C_RadixTree_at_B(C_RadixTree* self, StringView key);
+void* C_RadixTree_at_R(C_RadixTree* self, StringView key);
+
+bool C_RadixTree_contains(C_RadixTree* self, StringView key);
+
+void* C_RadixTree_remove_R(C_RadixTree* self, StringView key);
+
+/* value of the longest stored key that is a prefix of key, null when
+ * there is none. prefix_len is set to the length of that key */
+void* C_RadixTree_longest_prefix_B(
+  C_RadixTree* self, StringView key, u32* prefix_len);
+
+// visits the keys starting with prefix in byte order
+void C_RadixTree_foreach_prefix(
+  C_RadixTree* self, StringView prefix, RadixVisit visit, void* data);
+
+void C_RadixTree_clear(C_RadixTree* self);
+
+C_String* C_RadixTree_to_str_format_R(void* self, C_String* format);
+C_String* C_RadixTree_to_str_R(void* self);
+void C_RadixTree_write_to(void* self, C_StringBuilder* sink, C_Format* format);
+
+/******************************
+ * get/set
+ ******************************/
+u32 C_RadixTree_get_len(C_RadixTree* self);
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef ROARING_BIT_SET_H
+#define ROARING_BIT_SET_H
+
+#include <c_base/base/errors/errors.h>
+#include <c_base/base/strings/strings.h>
+#include <c_base/base/types.h>
+#include <c_base/ds/ds_base.h>
+
+/* a compressed set of u32 values. the values are split by their high 16
+ * bits into containers, a container holds up to 4096 low halves as a
+ * sorted u16 array and more as a bitmap of 65536 bits. sparse sets cost
+ * about 2 bytes per value, dense ones 1 bit */
+typedef struct C_RoaringBitSet C_RoaringBitSet;
+
+// returned by find_next when there is no further value
+#define RoaringBitSetEnd (1ull << 32)
+
+/******************************
+ * new/dest
+ ******************************/
+C_RoaringBitSet* C_RoaringBitSet_new(void);
+
+void C_RoaringBitSet_destroy(void* self);
+
+/******************************
+ * logic
+ ******************************/
+// false when value was already in the set
+bool C_RoaringBitSet_add(C_RoaringBitSet* self, u32 value);
+// false when value was not in the set
+bool C_RoaringBitSet_remove(C_RoaringBitSet* self, u32 value);
+bool C_RoaringBitSet_contains(C_RoaringBitSet* self, u32 value);
+
+// first value at or after from, RoaringBitSetEnd when there is none
+u64 C_RoaringBitSet_find_next(C_RoaringBitSet* self, u64 from);
+
+// new sets, a and b stay unchanged
+C_RoaringBitSet* C_RoaringBitSet_and_R(C_RoaringBitSet* a, C_RoaringBitSet* b);
+C_RoaringBitSet* C_RoaringBitSet_or_R(C_RoaringBitSet* a, C_RoaringBitSet* b);
+
+void C_RoaringBitSet_clear(C_RoaringBitSet* self);
+
+C_String* C_RoaringBitSet_to_str_format_R(void* self, C_String* format);
+C_String* C_RoaringBitSet_to_str_R(void* self);
+void C_RoaringBitSet_write_to(
+  void* self, C_StringBuilder* sink, C_Format* format);
+
+/******************************
+ * get/set
+ ******************************/
+// number of values
+u64 C_RoaringBitSet_get_len(C_RoaringBitSet* self);
+// bytes allocated by the set
+u64 C_RoaringBitSet_get_bytes(C_RoaringBitSet* self);
+
+#endif
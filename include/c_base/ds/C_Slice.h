@@ -0,0 +1,66 @@
+#ifndef SLICE_H
+#define SLICE_H
+
+#include <c_base/base/errors/errors.h>
+#include <c_base/base/strings/strings.h>
+#include <c_base/ds/C_Array.h>
+#include <c_base/ds/C_DArray.h>
+#include <c_base/ds/ds_base.h>
+
+#define C_SliceForeach(slice, code)                                            \
+  do {                                                                         \
+    for (u32 iter = 0; iter < C_Slice_get_len(slice); iter++) {                \
+      void* value = C_Slice_at_B(slice, iter);                                 \
+      {                                                                        \
+        code                                                                   \
+      }                                                                        \
+    }                                                                          \
+  } while (0)
+
+/* a view of the range [begin, end) of a C_Array, C_DArray or C_String.
+ * the slice references its parent instead of copying the values */
+typedef struct C_Slice C_Slice;
+
+/******************************
+ * new/dest
+ ******************************/
+C_Slice* C_Slice_new_array_P(C_Array* array, u32 begin, u32 end);
+C_Slice* C_Slice_new_darray_P(C_DArray* darray, u32 begin, u32 end);
+C_Slice* C_Slice_new_string_P(C_String* string, u32 begin, u32 end);
+
+void C_Slice_destroy(void* self);
+
+/******************************
+ * logic
+ ******************************/
+// begin and end are relative to self, the new slice shares the parent
+C_Slice* C_Slice_slice_R(C_Slice* self, u32 begin, u32 end);
+
+// array and darray slices
+void* C_Slice_at_B(C_Slice* self, u32 index);
+void* C_Slice_at_R(C_Slice* self, u32 index);
+// string slices
+ascii C_Slice_char_at(C_Slice* self, u32 index);
+
+C_Array* C_Slice_to_array_R(C_Slice* self);
+// a C_String sharing the chars of a string slice
+C_String* C_Slice_to_string_R(C_Slice* self);
+
+u32 C_Slice_hash(void* self);
+bool C_Slice_equals(void* a, void* b);
+
+C_String* C_Slice_to_str_format_R(void* self, C_String* format);
+C_String* C_Slice_to_str_R(void* self);
+void C_Slice_write_to(void* self, C_StringBuilder* sink, C_Format* format);
+
+/******************************
+ * get/set
+ ******************************/
+u32 C_Slice_get_len(C_Slice* self);
+bool C_Slice_is_string(C_Slice* self);
+void* C_Slice_get_parent_B(C_Slice* self);
+// valid until the parent changes
+void** C_Slice_get_data(C_Slice* self);
+ascii* C_Slice_get_chars(C_Slice* self);
+
+#endif
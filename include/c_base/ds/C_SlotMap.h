@@ -0,0 +1,69 @@
+#ifndef SLOT_MAP_H
+#define SLOT_MAP_H
+
+#include <c_base/base/errors/errors.h>
+#include <c_base/base/types.h>
+#include <c_base/ds/ds_base.h>
+
+/* stores values under u64 handles that stay valid until their value is
+ * removed. a handle is a slot index and the generation of the slot, a
+ * removal bumps the generation, so a stale handle finds nothing instead of
+ * a newer value in the same slot. the values are packed in a dense array,
+ * a removal moves the last value into the hole */
+typedef struct C_SlotMap C_SlotMap;
+
+// never returned by insert, a lookup of it finds nothing
+#define SlotMapNullHandle 0
+
+/* code sees handle and value of every value in dense order. the map must
+ * not be changed inside */
+#define C_SlotMapForeach(map, code)                                            \
+  do {                                                                         \
+    void** _values = C_SlotMap_get_values(map);                                \
+    for (u32 iter = 0; iter < C_SlotMap_get_len(map); iter++) {                \
+      u64 handle = C_SlotMap_handle_at(map, iter);                             \
+      void* value = _values[iter];                                             \
+      (void)handle;                                                            \
+      {                                                                        \
+        code                                                                   \
+      }                                                                        \
+    }                                                                          \
+  } while (0);
+
+/******************************
+ * new/dest
+ ******************************/
+C_SlotMap* C_SlotMap_new(void);
+C_SlotMap* C_SlotMap_new_cap(u32 cap);
+
+void C_SlotMap_destroy(void* self);
+
+/******************************
+ * logic
+ ******************************/
+// value must not be null
+u64 C_SlotMap_insert_P(C_SlotMap* self, void* value);
+
+// null when the handle was removed or never inserted
+void* C_SlotMap_at_B(C_SlotMap* self, u64 handle);
+void* C_SlotMap_at_R(C_SlotMap* self, u64 handle);
+bool C_SlotMap_contains(C_SlotMap* self, u64 handle);
+
+// null when the handle was removed or never inserted
+void* C_SlotMap_remove_R(C_SlotMap* self, u64 handle);
+
+// every handle becomes stale
+void C_SlotMap_clear(C_SlotMap* self);
+
+/******************************
+ * get/set
+ ******************************/
+u32 C_SlotMap_get_len(C_SlotMap* self);
+u32 C_SlotMap_get_cap(C_SlotMap* self);
+
+/* the values without holes, valid until the next insert, remove or
+ * clear. index i belongs to C_SlotMap_handle_at(self, i) */
+void** C_SlotMap_get_values(C_SlotMap* self);
+u64 C_SlotMap_handle_at(C_SlotMap* self, u32 index);
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <c_base/base/errors/errors.h>
+#include <c_base/base/types.h>
+#include <c_base/ds/ds_base.h>
+
+/* a bounded lock-free fifo between one producer and one consumer thread.
+ * the values are pointers that the queue does not reference, reference
+ * counts are not atomic, so a value is handed over with its reference
+ * and only the consumer touches it afterwards */
+typedef struct C_SpscQueue C_SpscQueue;
+
+/******************************
+ * new/dest
+ ******************************/
+// cap is rounded up to a power of two
+C_SpscQueue* C_SpscQueue_new(u32 cap);
+
+void C_SpscQueue_destroy(void* self);
+
+/******************************
+ * logic
+ ******************************/
+// producer only, false when the queue is full
+bool C_SpscQueue_push(C_SpscQueue* self, void* value);
+// consumer only, false when the queue is empty
+bool C_SpscQueue_pop(C_SpscQueue* self, void** value);
+
+/******************************
+ * get/set
+ ******************************/
+// a snapshot, stale as soon as the other thread pushes or pops
+u32 C_SpscQueue_get_len(C_SpscQueue* self);
+u32 C_SpscQueue_get_cap(C_SpscQueue* self);
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef UNROLLED_LIST_H
+#define UNROLLED_LIST_H
+
+#include <c_base/base/errors/errors.h>
+#include <c_base/base/strings/strings.h>
+#include <c_base/ds/C_Array.h>
+#include <c_base/ds/ds_base.h>
+
+#define UnrolledNodeCap 32
+
+#define C_UnrolledListForeach(list, code)                                      \
+  do {                                                                         \
+    UnrolledListCursor __cursor = UnrolledListCursor_construct(list);          \
+    for (u32 iter = 0; UnrolledListCursor_valid(&__cursor);                    \
+      iter++, UnrolledListCursor_next(&__cursor)) {                            \
+      void* value = UnrolledListCursor_get_B(&__cursor);                       \
+      {                                                                        \
+        code                                                                   \
+      }                                                                        \
+    }                                                                          \
+  } while (0)
+
+typedef struct UnrolledNode {
+  struct UnrolledNode* next;
+  struct UnrolledNode* prev;
+  u32 len;
+  void* values[UnrolledNodeCap];
+} UnrolledNode;
+
+typedef struct C_UnrolledList C_UnrolledList;
+
+/******************************
+ * UnrolledListCursor
+ ******************************/
+typedef struct {
+  UnrolledNode* node;
+  u32 index;
+} UnrolledListCursor;
+
+UnrolledListCursor UnrolledListCursor_construct(C_UnrolledList* list);
+
+bool UnrolledListCursor_valid(UnrolledListCursor* self);
+void UnrolledListCursor_next(UnrolledListCursor* self);
+
+void* UnrolledListCursor_get_B(UnrolledListCursor* self);
+void* UnrolledListCursor_get_R(UnrolledListCursor* self);
+
+/******************************
+ * new/dest
+ ******************************/
+C_UnrolledList* C_UnrolledList_new(void);
+void C_UnrolledList_destroy(void* self);
+
+/******************************
+ * logic
+ ******************************/
+C_Array* C_UnrolledList_to_array_PR(C_UnrolledList* self);
+
+void C_UnrolledList_push_P(C_UnrolledList* self, void* value);
+void C_UnrolledList_push_front_P(C_UnrolledList* self, void* value);
+
+void* C_UnrolledList_pop_R(C_UnrolledList* self);
+void* C_UnrolledList_pop_front_R(C_UnrolledList* self);
+
+void* C_UnrolledList_peek_B(C_UnrolledList* self);
+void* C_UnrolledList_peek_R(C_UnrolledList* self);
+
+void* C_UnrolledList_peek_front_B(C_UnrolledList* self);
+void* C_UnrolledList_peek_front_R(C_UnrolledList* self);
+
+void C_UnrolledList_add_P(C_UnrolledList* self, u32 index, void* value);
+
+void* C_UnrolledList_at_B(C_UnrolledList* self, u32 index);
+void* C_UnrolledList_at_R(C_UnrolledList* self, u32 index);
+
+void* C_UnrolledList_remove_R(C_UnrolledList* self, u32 index);
+
+void C_UnrolledList_clear(C_UnrolledList* self);
+
+u32 C_UnrolledList_hash(void* self);
+bool C_UnrolledList_equals(void* a, void* b);
+
+C_String* C_UnrolledList_to_str_format_R(void* self, C_String* format);
+C_String* C_UnrolledList_to_str_R(void* self);
+void C_UnrolledList_write_to(
+  void* self, C_StringBuilder* sink, C_Format* format);
+
+/******************************
+ * get/set
+ ******************************/
+u32 C_UnrolledList_get_len(C_UnrolledList* self);
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef VEC_H
+#define VEC_H
+
+#include <c_base/base/macros.h>
+#include <c_base/base/memory/handles.h>
+#include <c_base/base/strings/strings.h>
+#include <c_base/base/types.h>
+#include <c_base/ds/C_DArray.h>
+#include <c_base/ds/ds_base.h>
+
+#define VecMinCap 8
+
+/* unboxed dynamic arrays, the values are stored inline instead of as
+ * pointers to C_Handle objects so walking them touches contiguous memory */
+#define GenericType_C_Vec(T)                                                   \
+  typedef struct C_Vec_##T C_Vec_##T;                                          \
+                                                                               \
+  C_Vec_##T* Concat(C_Vec_##T, _new)(void);                                    \
+  C_Vec_##T* Concat(C_Vec_##T, _new_cap)(u32 cap);                             \
+  /* copies len values */                                                      \
+  C_Vec_##T* Concat(C_Vec_##T, _new_from)(T * values, u32 len);                \
+  /* values must be C_Handle_##T */                                            \
+  C_Vec_##T* Concat(C_Vec_##T, _from_darray_P)(C_DArray * darray);             \
+                                                                               \
+  void Concat(C_Vec_##T, _destroy)(void* self);                                \
+                                                                               \
+  C_DArray* Concat(C_Vec_##T, _to_darray_PR)(C_Vec_##T * self);                \
+                                                                               \
+  void Concat(C_Vec_##T, _push)(C_Vec_##T * self, T value);                    \
+  void Concat(C_Vec_##T, _push_many)(C_Vec_##T * self, T * values, u32 len);   \
+  T Concat(C_Vec_##T, _pop)(C_Vec_##T * self);                                 \
+  T Concat(C_Vec_##T, _at)(C_Vec_##T * self, u32 index);                       \
+  void Concat(C_Vec_##T, _put)(C_Vec_##T * self, u32 index, T value);          \
+                                                                               \
+  /* copies the values in [begin, end) into a new vec */                       \
+  C_Vec_##T* Concat(C_Vec_##T, _slice_R)(C_Vec_##T * self, u32 begin,          \
+                                         u32 end);                             \
+                                                                               \
+  /* changes len, new values are zero */                                       \
+  void Concat(C_Vec_##T, _resize)(C_Vec_##T * self, u32 len);                  \
+  void Concat(C_Vec_##T, _reserve)(C_Vec_##T * self, u32 cap);                 \
+  void Concat(C_Vec_##T, _clear)(C_Vec_##T * self);                            \
+                                                                               \
+  u32 Concat(C_Vec_##T, _hash)(void* self);                                    \
+  bool Concat(C_Vec_##T, _equals)(void* a, void* b);                           \
+                                                                               \
+  C_String* Concat(C_Vec_##T, _to_str_format_R)(void* self,                    \
+                                                C_String* format);             \
+  C_String* Concat(C_Vec_##T, _to_str_R)(void* self);                          \
+  void Concat(C_Vec_##T, _write_to)(void* self, C_StringBuilder* sink,        \
+                                    C_Format* format);                         \
+                                                                               \
+  u32 Concat(C_Vec_##T, _get_len)(C_Vec_##T * self);                           \
+  u32 Concat(C_Vec_##T, _get_cap)(C_Vec_##T * self);                           \
+  /* valid until the next push or resize */                                    \
+  T* Concat(C_Vec_##T, _get_data)(C_Vec_##T * self);
+
+GenericType_C_Vec(u8)
+GenericType_C_Vec(u32)
+GenericType_C_Vec(u64)
+GenericType_C_Vec(s64)
+GenericType_C_Vec(f32)
+GenericType_C_Vec(f64)
+
+#endif
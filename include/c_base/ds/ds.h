@@ -2,9 +2,28 @@
 #define DS_H
 
 #include <c_base/ds/C_Array.h>
+#include <c_base/ds/C_BitSet.h>
+#include <c_base/ds/C_BloomFilter.h>
+#include <c_base/ds/C_ClockCache.h>
+#include <c_base/ds/C_CuckooFilter.h>
 #include <c_base/ds/C_DArray.h>
+#include <c_base/ds/C_Deque.h>
 #include <c_base/ds/C_HashTable.h>
 #include <c_base/ds/C_List.h>
+#include <c_base/ds/C_LruCache.h>
+#include <c_base/ds/C_MpmcQueue.h>
+#include <c_base/ds/C_OrderedMap.h>
+#include <c_base/ds/C_PriorityQueue.h>
+#include <c_base/ds/C_RadixTree.h>
+#include <c_base/ds/C_RoaringBitSet.h>
+#include <c_base/ds/C_Slice.h>
+#include <c_base/ds/C_SlotMap.h>
+#include <c_base/ds/C_SpscQueue.h>
+#include <c_base/ds/C_UnrolledList.h>
+#include <c_base/ds/C_Vec.h>
 #include <c_base/ds/ds_base.h>
+#include <c_base/ds/ds_simd.h>
+#include <c_base/ds/ds_sort.h>
+#include <c_base/ds/ds_sorted.h>
 
 #endif
@@ -2,7 +2,12 @@
 #define DS_BASE_H
 
 #include <c_base/base/errors/errors.h>
+#include <c_base/base/types.h>
 
 GenericVal_ErrorCode(EG_Datastructures)
 
+/* spreads the bits of a hash over all 64 bits, IHashable hashes are only
+ * 32 bits and similar keys often have similar hashes */
+u64 ds_hash_mix(u64 hash);
+
 #endif
@@ -0,0 +1,58 @@
+#ifndef DS_SIMD_H
+#define DS_SIMD_H
+
+#include <c_base/base/macros.h>
+#include <c_base/base/types.h>
+
+/* bulk kernels over contiguous values, e.g. C_Vec_T_get_data.
+ * every kernel has a scalar, an sse2 and an avx2 version, the best one the
+ * cpu supports is picked on the first call */
+
+typedef enum {
+  SIMD_SCALAR,
+  SIMD_SSE2,
+  SIMD_AVX2,
+} SimdLevel;
+
+// the best level the cpu supports
+SimdLevel simd_detect_level(void);
+SimdLevel simd_get_level(void);
+// limits the kernels to level, capped at what the cpu supports
+SimdLevel simd_set_level(SimdLevel level);
+char* simd_level_name(SimdLevel level);
+
+/* u32 sums and dot products are accumulated in u64, the others wrap.
+ * float results depend on the level since the order of the adds does */
+#define GenericType_SimdKernels(T, A)                                          \
+  A Concat(simd_sum_, T)(T * data, u32 len);                                   \
+  /* crash when len is 0 */                                                    \
+  T Concat(simd_min_, T)(T * data, u32 len);                                   \
+  T Concat(simd_max_, T)(T * data, u32 len);                                   \
+  /* index of the first minimum */                                             \
+  u32 Concat(simd_argmin_, T)(T * data, u32 len);                              \
+                                                                               \
+  /* index of the first value equal to value, len when there is none */        \
+  u32 Concat(simd_find_, T)(T * data, u32 len, T value);                       \
+  u32 Concat(simd_count_, T)(T * data, u32 len, T value);                      \
+                                                                               \
+  A Concat(simd_dot_, T)(T * a, T * b, u32 len);                               \
+                                                                               \
+  /* dst[i] = a[i] op b[i], dst may be a or b */                               \
+  void Concat(simd_add_, T)(T * dst, T * a, T * b, u32 len);                   \
+  void Concat(simd_mul_, T)(T * dst, T * a, T * b, u32 len);                   \
+  void Concat(simd_scale_, T)(T * dst, T * a, T factor, u32 len);
+
+GenericType_SimdKernels(u32, u64)
+GenericType_SimdKernels(u64, u64)
+GenericType_SimdKernels(f32, f32)
+GenericType_SimdKernels(f64, f64)
+
+/* bit kernels over u64 words, e.g. the words of a C_BitSet.
+ * dst[i] = a[i] op b[i], dst may be a or b. andnot is a[i] & ~b[i] */
+u64 simd_popcount_bits(u64* data, u32 len);
+void simd_and_bits(u64* dst, u64* a, u64* b, u32 len);
+void simd_or_bits(u64* dst, u64* a, u64* b, u32 len);
+void simd_xor_bits(u64* dst, u64* a, u64* b, u32 len);
+void simd_andnot_bits(u64* dst, u64* a, u64* b, u32 len);
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef DS_SORT_H
+#define DS_SORT_H
+
+#include <c_base/base/types.h>
+
+typedef s32 (*CompareFunc)(void* a, void* b);
+
+/* pattern-defeating quicksort, O(n log n) worst case, not stable */
+void sort_pdq(void** data, u32 len, CompareFunc compare);
+
+/* sorts objects implementing IComparable with sort_pdq,
+ * when every value is the same kind of handle with a key function
+ * the values are sorted by their u64 keys without calling compare */
+void sort_pdq_comparable(void** data, u32 len);
+
+// below this length the parallel sorts run sort_pdq on the calling thread
+#define SortParallelMinLen 65536
+
+/* splits data into one chunk per thread, sorts the chunks with sort_pdq
+ * and merges them, every merge round is split between all threads.
+ * threads == 0 uses one thread per cpu, the calling thread is one of them.
+ * compare must be safe to call from several threads at once */
+void sort_pdq_parallel(void** data, u32 len, CompareFunc compare, u32 threads);
+void sort_pdq_comparable_parallel(void** data, u32 len, u32 threads);
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef DS_SORTED_H
+#define DS_SORTED_H
+
+#include <c_base/base/types.h>
+#include <c_base/ds/ds_sort.h>
+
+/* searches and set operations on void* arrays sorted by compare,
+ * IComparable_compare can be passed for IComparable values */
+
+// the values equal to a searched value are at [begin, end)
+typedef struct {
+  u32 begin;
+  u32 end;
+} SortedRange;
+
+// intersections gallop through the longer side when it is this many times
+// longer than the shorter one
+#define SortedGallopRatio 16
+
+// index of the first value not less than value, len when there is none
+u32 sorted_lower_bound(void** data, u32 len, void* value, CompareFunc compare);
+// index of the first value greater than value, len when there is none
+u32 sorted_upper_bound(void** data, u32 len, void* value, CompareFunc compare);
+SortedRange sorted_equal_range(
+  void** data, u32 len, void* value, CompareFunc compare);
+
+/* the set operations write to out and return how many values they wrote.
+ * duplicates are kept like in a multiset, a value that is in a n times and
+ * in b m times is written max(n, m), min(n, m) and n - m times.
+ * equal values are taken from a. the values are not referenced.
+ * out needs room for a_len + b_len, min(a_len, b_len) and a_len values */
+u32 sorted_union(void** a, u32 a_len, void** b, u32 b_len, void** out,
+  CompareFunc compare);
+u32 sorted_intersection(void** a, u32 a_len, void** b, u32 b_len, void** out,
+  CompareFunc compare);
+u32 sorted_difference(void** a, u32 a_len, void** b, u32 b_len, void** out,
+  CompareFunc compare);
+
+#endif
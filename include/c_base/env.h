@@ -41,6 +41,14 @@
   #warning "env.h -> unknown platform"
 #endif
 
+#if defined(__x86_64__) || defined(_M_X64)
+  #define ARCH_X86_64
+#elif defined(__aarch64__) || defined(_M_ARM64)
+  #define ARCH_ARM64
+#else
+  #warning "env.h -> unknown cpu architecture"
+#endif
+
 #if (defined(COMPILER_GCC) || defined(COMPILER_CLANG)) && defined(OPT_COMPILER_FEATURES)
   #define ATTR_Cleanup(func) __attribute__((cleanup(func)))
 #endif
@@ -3,8 +3,24 @@
 
 #include <c_base/base/types.h>
 
+// fields written by different threads are kept this far apart
+#define OSCacheLineSize 64
+
 bool os_atomic_u32_compare_exchange(u32* ptr, u32* expected, u32 desired);
 void os_atomic_u32_store(u32* ptr, u32 val);
 u32 os_atomic_u32_load(u32* ptr);
 
+/* later loads and stores are not moved before an acquire load, earlier ones
+ * are not moved after a release store. a thread that sees a released value
+ * also sees everything written before it */
+u64 os_atomic_u64_load_acquire(u64* ptr);
+void os_atomic_u64_store_release(u64* ptr, u64 val);
+// full barriers. on failure expected receives the current value
+bool os_atomic_u64_compare_exchange(u64* ptr, u64* expected, u64 desired);
+// returns the value before the add
+u64 os_atomic_u64_fetch_add(u64* ptr, u64 val);
+
+// spin wait hint, call it in loops that wait for another thread
+void os_atomic_pause(void);
+
 #endif
@@ -0,0 +1,13 @@
+#ifndef OS_CPU_H
+#define OS_CPU_H
+
+#include <c_base/base/types.h>
+
+#if defined(ARCH_X86_64)
+// regs receives eax, ebx, ecx, edx
+void os_cpuid(u32 leaf, u32 subleaf, u32* regs);
+// only valid when cpuid reports OSXSAVE
+u64 os_xgetbv(u32 index);
+#endif
+
+#endif
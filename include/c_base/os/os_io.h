@@ -2,6 +2,7 @@
 #define OS_IO_H
 
 #include <c_base/base/errors/C_Result.h>
+#include <c_base/base/strings/C_StringBuilder.h>
 #include <c_base/base/strings/strings.h>
 
 GenericVal_ErrorCode(EG_OS_IO)
@@ -20,6 +21,13 @@ C_String* console_read_ln_R(void);
 
 C_EmptyResult* console_set_raw_node(bool value);
 
+// chars a console or file sink keeps before it writes them
+#define IOSinkCap 4096
+
+/* a sink that writes to the console, IFormattable_write_to_PR streams
+ * into it. every flush is one locked write */
+C_StringBuilder* console_new_sink(void);
+
 /******************************
  * files
  ******************************/
@@ -42,6 +50,9 @@ void C_File_destroy(void* self);
 C_Result* /* u32 */ C_File_read_chars_R(C_File* self, ascii* chars, u32 len);
 C_Result* /* u32 */ C_File_write_chars_R(C_File* self, ascii* chars, u32 len);
 
+// the file is borrowed and has to stay open until the sink is destroyed
+C_StringBuilder* C_File_new_sink(C_File* self);
+
 void C_File_write_P(C_File* self, void* obj, ...);
 void C_File_write_ln_P(C_File* self, void* obj, ...);
 
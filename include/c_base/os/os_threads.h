@@ -36,9 +36,19 @@ C_Thread* C_Thread_new_stack_size(
 C_EmptyResult* C_Thread_run(C_Thread* self);
 void C_Thread_join(C_Thread* self);
 
-void C_Thread_join(C_Thread* self);
+// borrowed args passed to C_Thread_new
+C_Array* C_Thread_get_args_B(C_Thread* self);
+/* borrowed arg at index, meant for thread funcs. reference counts are not
+ * atomic, so unlike C_Array_at_B it does not touch them */
+void* C_Thread_get_arg_B(C_Thread* self, u32 index);
 
 C_EmptyResult* C_Thread_close(C_Thread* self);
 void C_Thread_destroy(void* self);
 
+// number of cpus this process can run on, at least 1
+u32 os_threads_cpu_count(void);
+
+// gives the cpu to another thread that is ready to run
+void os_threads_yield(void);
+
 #endif
@@ -18,6 +18,7 @@ typedef struct {
   u64 pos;
   AllocatorNode* head;
   Mutex lock;
+  u64 allocations;
 } Allocator;
 
 static Allocator allocator = {0};
@@ -27,6 +28,7 @@ Allocator Allocator_construct(void) {
 
   self.lock = Mutex_construct();
   self.pos = 0;
+  self.allocations = 0;
 
   MemoryResult reserve_result =
     global_memory_base->reserve(global_memory_base, AllocatorReserveSize);
@@ -67,18 +69,22 @@ void Allocator_commit(Allocator* self, u64 min_size) {
   AllocatorNode* new_node = (AllocatorNode*)(self->memory + self->commit_pos);
   new_node->next = null;
   new_node->size = commit_result.size;
-
-  AllocatorNode* new_head = self->head;
-  while (new_head->next) {
-    new_head = new_head->next;
-  }
+  new_node->used = false;
 
   AllocatorNode* last_node = self->head;
-  while (last_node->next) {
+  while (last_node && last_node->next) {
     last_node = last_node->next;
   }
 
-  last_node->next = new_node;
+  // extend a free block that ends where the new memory starts,
+  // so blocks at the end can grow past the commit boundary
+  if (last_node == null) {
+    self->head = new_node;
+  } else if ((b8*)last_node + last_node->size == (b8*)new_node) {
+    last_node->size += new_node->size;
+  } else {
+    last_node->next = new_node;
+  }
 
   self->commit_pos += commit_result.size;
 }
@@ -131,10 +137,61 @@ retry:
   goto retry;
 
 ret:
+  self->allocations++;
   Mutex_unlock(&self->lock);
   return result;
 }
 
+/* grows a used block by taking the free block right after it,
+ * commits more memory when the block is the last one */
+bool Allocator_grow(Allocator* self, AllocatorNode* node, u64 size) {
+  u64 needed = AllocatorNodeAligned + mem_align_forward(size, MemAlign);
+
+  for (;;) {
+    if (node->size >= needed) {
+      return true;
+    }
+
+    b8* end = self->memory + self->commit_pos;
+    AllocatorNode* next = (AllocatorNode*)((b8*)node + node->size);
+    if ((b8*)next == end) {
+      Allocator_commit(self, needed - node->size);
+      continue;
+    }
+    if (next->used) {
+      return false;
+    }
+
+    if ((b8*)next + next->size == end && node->size + next->size < needed) {
+      Allocator_commit(self, needed - node->size - next->size);
+      continue;
+    }
+    if (node->size + next->size < needed) {
+      return false;
+    }
+
+    AllocatorNode** prev_node = &self->head;
+    while (*prev_node != next) {
+      prev_node = &(*prev_node)->next;
+    }
+
+    u64 remaining = node->size + next->size - needed;
+    if (remaining >= AllocatorNodeAligned + MemAlign) {
+      AllocatorNode* rest = (AllocatorNode*)((b8*)node + needed);
+      rest->next = next->next;
+      rest->size = remaining;
+      rest->used = false;
+
+      *prev_node = rest;
+      node->size = needed;
+    } else {
+      *prev_node = next->next;
+      node->size += next->size;
+    }
+    return true;
+  }
+}
+
 void Allocator_deallocate(Allocator* self, void* ptr) {
   Mutex_lock(&self->lock);
   AllocatorNode* loop_node = self->head;
@@ -176,7 +233,9 @@ void Allocator_deallocate(Allocator* self, void* ptr) {
 
 void* allocate(u64 size) {
   Once({
-    if (allocator.head == null) {
+    // the free list can be empty when all memory is used,
+    // only memory tells if the allocator was constructed
+    if (allocator.memory == null) {
       allocator = Allocator_construct();
     }
   });
@@ -186,9 +245,18 @@ void* allocate(u64 size) {
 
 void deallocate(void* ptr) { Allocator_deallocate(&allocator, ptr); }
 
+u64 allocator_get_allocations(void) {
+  Mutex_lock(&allocator.lock);
+  u64 allocations = allocator.allocations;
+  Mutex_unlock(&allocator.lock);
+  return allocations;
+}
+
 void* reallocate(void* ptr, u64 size) {
   Once({
-    if (allocator.head == null) {
+    // the free list can be empty when all memory is used,
+    // only memory tells if the allocator was constructed
+    if (allocator.memory == null) {
       allocator = Allocator_construct();
     }
   });
@@ -198,6 +266,14 @@ void* reallocate(void* ptr, u64 size) {
   }
 
   AllocatorNode* ptr_node = (AllocatorNode*)((u8*)ptr - AllocatorNodeAligned);
+
+  Mutex_lock(&allocator.lock);
+  bool grown = Allocator_grow(&allocator, ptr_node, size);
+  Mutex_unlock(&allocator.lock);
+  if (grown) {
+    return ptr;
+  }
+
   u64 new_size = (ptr_node->size - AllocatorNodeAligned >= size)
                    ? ptr_node->size - AllocatorNodeAligned
                    : size;
@@ -1,18 +1,22 @@
 #include <c_base/base/memory/handles.h>
 
-GenericTypeImpl_C_Handle(u8, u8_to_str_R, u8_to_str_format_R)
-GenericTypeImpl_C_Handle(u16, u16_to_str_R, u16_to_str_format_R)
-GenericTypeImpl_C_Handle(u32, u32_to_str_R, u32_to_str_format_R)
-GenericTypeImpl_C_Handle(u64, u64_to_str_R, u64_to_str_format_R)
+GenericTypeImpl_C_Handle(u8, u8_to_str_R, u8_to_str_format_R, u8_write_to)
+GenericTypeImpl_C_Handle(u16, u16_to_str_R, u16_to_str_format_R, u16_write_to)
+GenericTypeImpl_C_Handle(u32, u32_to_str_R, u32_to_str_format_R, u32_write_to)
+GenericTypeImpl_C_Handle(u64, u64_to_str_R, u64_to_str_format_R, u64_write_to)
 
-GenericTypeImpl_C_Handle(s8, s8_to_str_R, s8_to_str_format_R)
-GenericTypeImpl_C_Handle(s16, s16_to_str_R, s16_to_str_format_R)
-GenericTypeImpl_C_Handle(s32, s32_to_str_R, s32_to_str_format_R)
-GenericTypeImpl_C_Handle(s64, s64_to_str_R, s64_to_str_format_R)
+GenericTypeImpl_C_Handle(s8, s8_to_str_R, s8_to_str_format_R, s8_write_to)
+GenericTypeImpl_C_Handle(s16, s16_to_str_R, s16_to_str_format_R, s16_write_to)
+GenericTypeImpl_C_Handle(s32, s32_to_str_R, s32_to_str_format_R, s32_write_to)
+GenericTypeImpl_C_Handle(s64, s64_to_str_R, s64_to_str_format_R, s64_write_to)
 
-GenericTypeImpl_C_Handle(b8, b8_to_str_R, b8_to_str_format_R)
-GenericTypeImpl_C_Handle(b16, b16_to_str_R, b16_to_str_format_R)
-GenericTypeImpl_C_Handle(b32, b32_to_str_R, b32_to_str_format_R)
-GenericTypeImpl_C_Handle(b64, b64_to_str_R, b64_to_str_format_R)
+GenericTypeImpl_C_Handle(f32, f32_to_str_R, f32_to_str_format_R, f32_write_to)
+GenericTypeImpl_C_Handle(f64, f64_to_str_R, f64_to_str_format_R, f64_write_to)
 
-GenericTypeImpl_C_Handle(bool, bool_to_str_R, bool_to_str_format_R)
+GenericTypeImpl_C_Handle(b8, b8_to_str_R, b8_to_str_format_R, b8_write_to)
+GenericTypeImpl_C_Handle(b16, b16_to_str_R, b16_to_str_format_R, b16_write_to)
+GenericTypeImpl_C_Handle(b32, b32_to_str_R, b32_to_str_format_R, b32_write_to)
+GenericTypeImpl_C_Handle(b64, b64_to_str_R, b64_to_str_format_R, b64_write_to)
+
+GenericTypeImpl_C_Handle(
+  bool, bool_to_str_R, bool_to_str_format_R, bool_write_to)
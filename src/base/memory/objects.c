@@ -184,6 +184,43 @@ u32 IHashable_hash(void* self) {
   return i_hashable->hash(self);
 }
 
+/******************************
+  IComparable
+ ******************************/
+IdImpl(IComparable)
+
+// construct
+IComparable IComparable_construct(s32 (*compare)(void* a, void* b)) {
+  return IComparable_construct_key(compare, null);
+}
+
+IComparable IComparable_construct_key(
+  s32 (*compare)(void* a, void* b), u64 (*key)(void* self)) {
+  IComparable self;
+  self.interface = Interface_construct(IComparable_id);
+
+  self.compare = compare;
+  self.key = key;
+
+  return self;
+}
+
+// methods
+s32 IComparable_compare(void* a, void* b) {
+  if (a == b)
+    return 0;
+
+  // null is smaller than everything
+  if (a == null)
+    return -1;
+  if (b == null)
+    return 1;
+
+  IComparable* i_comparable =
+    (IComparable*)ClassObject_get_interface(a, IComparable_id);
+  return i_comparable->compare(a, b);
+}
+
 /******************************
  * other
  ******************************/
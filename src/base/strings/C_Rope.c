@@ -0,0 +1,495 @@
+#include <c_base/base/errors/errors.h>
+#include <c_base/base/memory/allocator.h>
+#include <c_base/base/memory/memory.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/base/strings/C_Rope.h>
+#include <c_base/base/strings/C_StringBuilder.h>
+#include <c_base/system.h>
+
+// released nodes and chunks a rope keeps of each for reuse
+#define RopeSpareCap 64
+
+static Interface* C_Rope_interfaces[2];
+static IFormattable C_Rope_i_formattable = {0};
+
+/* a chunk has height 0 and RopeChunkSize chars after the node, the other
+ * nodes have both children. chunks are never empty, the empty rope has no
+ * root. a node with one reference belongs to a single path and is changed
+ * in place, shared nodes are copied or unpacked instead */
+typedef struct RopeNode RopeNode;
+struct RopeNode {
+  u64 len;
+  u32 refs;
+  u32 height;
+  RopeNode* left;
+  RopeNode* right;
+  ascii chars[];
+};
+
+struct C_Rope {
+  ClassObject base;
+
+  RopeNode* root;
+
+  /* released nodes and chunks, chained through left. the allocator walks
+   * its free list, reusing them keeps edits of large ropes O(log n) */
+  RopeNode* spare_nodes;
+  RopeNode* spare_chunks;
+  u32 spare_nodes_len;
+  u32 spare_chunks_len;
+};
+
+/******************************
+ * nodes
+ ******************************/
+static RopeNode* C_Rope_take_spare(
+  RopeNode** spare, u32* spare_len, u64 size) {
+  RopeNode* node = *spare;
+  if (!node) {
+    return allocate(size);
+  }
+
+  *spare = node->left;
+  (*spare_len)--;
+  return node;
+}
+
+static void C_Rope_release(C_Rope* rope, RopeNode* node) {
+  RopeNode** spare = node->height ? &rope->spare_nodes : &rope->spare_chunks;
+  u32* spare_len =
+    node->height ? &rope->spare_nodes_len : &rope->spare_chunks_len;
+  if (*spare_len >= RopeSpareCap) {
+    deallocate(node);
+    return;
+  }
+
+  node->left = *spare;
+  *spare = node;
+  (*spare_len)++;
+}
+
+static RopeNode* C_Rope_chunk_new(C_Rope* rope, ascii* chars, u64 len) {
+  RopeNode* self = C_Rope_take_spare(&rope->spare_chunks,
+    &rope->spare_chunks_len, sizeof(RopeNode) + RopeChunkSize);
+  self->len = len;
+  self->refs = 1;
+  self->height = 0;
+  self->left = null;
+  self->right = null;
+  mem_copy(self->chars, chars, len);
+  return self;
+}
+
+// takes the references of left and right
+static RopeNode* C_Rope_node_new(
+  C_Rope* rope, RopeNode* left, RopeNode* right) {
+  RopeNode* self = C_Rope_take_spare(
+    &rope->spare_nodes, &rope->spare_nodes_len, sizeof(RopeNode));
+  self->len = left->len + right->len;
+  self->refs = 1;
+  self->height = 1 + (left->height > right->height ? left->height
+                                                    : right->height);
+  self->left = left;
+  self->right = right;
+  return self;
+}
+
+static void C_Rope_unref(C_Rope* rope, RopeNode* self) {
+  if (!self || --self->refs) {
+    return;
+  }
+
+  if (self->height) {
+    C_Rope_unref(rope, self->left);
+    C_Rope_unref(rope, self->right);
+  }
+  C_Rope_release(rope, self);
+}
+
+// trades a reference of self for references of its children
+static void C_Rope_unpack(
+  C_Rope* rope, RopeNode* self, RopeNode** left, RopeNode** right) {
+  *left = self->left;
+  *right = self->right;
+
+  if (self->refs == 1) {
+    C_Rope_release(rope, self);
+  } else {
+    self->refs--;
+    (*left)->refs++;
+    (*right)->refs++;
+  }
+}
+
+/* the nodes on the taller side are rotated when the heights differ by 2,
+ * which is as far as C_Rope_join lets them drift */
+static RopeNode* C_Rope_balance(C_Rope* rope, RopeNode* a, RopeNode* b) {
+  RopeNode* x;
+  RopeNode* y;
+  RopeNode* y_left;
+  RopeNode* y_right;
+
+  if (a->height > b->height + 1) {
+    C_Rope_unpack(rope, a, &x, &y);
+    if (x->height >= y->height) {
+      return C_Rope_node_new(rope, x, C_Rope_node_new(rope, y, b));
+    }
+    C_Rope_unpack(rope, y, &y_left, &y_right);
+    return C_Rope_node_new(rope, C_Rope_node_new(rope, x, y_left),
+      C_Rope_node_new(rope, y_right, b));
+  }
+
+  if (b->height > a->height + 1) {
+    C_Rope_unpack(rope, b, &y, &x);
+    if (x->height >= y->height) {
+      return C_Rope_node_new(rope, C_Rope_node_new(rope, a, y), x);
+    }
+    C_Rope_unpack(rope, y, &y_left, &y_right);
+    return C_Rope_node_new(rope, C_Rope_node_new(rope, a, y_left),
+      C_Rope_node_new(rope, y_right, x));
+  }
+
+  return C_Rope_node_new(rope, a, b);
+}
+
+// takes both references, O(difference of the heights)
+static RopeNode* C_Rope_join(C_Rope* rope, RopeNode* a, RopeNode* b) {
+  if (!a) {
+    return b;
+  }
+  if (!b) {
+    return a;
+  }
+
+  RopeNode* left;
+  RopeNode* right;
+  if (a->height > b->height + 1) {
+    C_Rope_unpack(rope, a, &left, &right);
+    return C_Rope_balance(rope, left, C_Rope_join(rope, right, b));
+  }
+  if (b->height > a->height + 1) {
+    C_Rope_unpack(rope, b, &left, &right);
+    return C_Rope_balance(rope, C_Rope_join(rope, a, left), right);
+  }
+
+  // small neighbour chunks become one
+  if (!a->height && !b->height && a->len + b->len <= RopeChunkSize) {
+    if (a->refs != 1) {
+      RopeNode* copy = C_Rope_chunk_new(rope, a->chars, a->len);
+      C_Rope_unref(rope, a);
+      a = copy;
+    }
+    mem_copy(a->chars + a->len, b->chars, b->len);
+    a->len += b->len;
+    C_Rope_unref(rope, b);
+    return a;
+  }
+
+  return C_Rope_node_new(rope, a, b);
+}
+
+// takes the reference of self, left gets the first index chars
+static void C_Rope_split(C_Rope* rope, RopeNode* self, u64 index,
+  RopeNode** left, RopeNode** right) {
+  if (index == 0) {
+    *left = null;
+    *right = self;
+    return;
+  }
+  if (index == self->len) {
+    *left = self;
+    *right = null;
+    return;
+  }
+
+  if (!self->height) {
+    *right = C_Rope_chunk_new(rope, self->chars + index, self->len - index);
+    if (self->refs == 1) {
+      self->len = index;
+      *left = self;
+    } else {
+      *left = C_Rope_chunk_new(rope, self->chars, index);
+      C_Rope_unref(rope, self);
+    }
+    return;
+  }
+
+  RopeNode* a;
+  RopeNode* b;
+  RopeNode* middle;
+  C_Rope_unpack(rope, self, &a, &b);
+  if (index <= a->len) {
+    C_Rope_split(rope, a, index, left, &middle);
+    *right = C_Rope_join(rope, middle, b);
+  } else {
+    C_Rope_split(rope, b, index - a->len, &middle, right);
+    *left = C_Rope_join(rope, a, middle);
+  }
+}
+
+// full chunks, the halves differ by at most one chunk
+static RopeNode* C_Rope_build(C_Rope* rope, ascii* chars, u64 len) {
+  if (len == 0) {
+    return null;
+  }
+  if (len <= RopeChunkSize) {
+    return C_Rope_chunk_new(rope, chars, len);
+  }
+
+  u64 chunks = (len + RopeChunkSize - 1) / RopeChunkSize;
+  u64 half = chunks / 2 * RopeChunkSize;
+  return C_Rope_node_new(rope, C_Rope_build(rope, chars, half),
+    C_Rope_build(rope, chars + half, len - half));
+}
+
+/* the common case of an edit, text fits into the chunk at index and the
+ * path to it is not shared. false leaves the nodes unchanged */
+static bool rope_insert_in_place(RopeNode* self, u64 index, StringView text) {
+  if (self->refs != 1) {
+    return false;
+  }
+
+  if (self->height) {
+    bool done = index <= self->left->len
+                  ? rope_insert_in_place(self->left, index, text)
+                  : rope_insert_in_place(
+                      self->right, index - self->left->len, text);
+    if (done) {
+      self->len += text.len;
+    }
+    return done;
+  }
+
+  if (self->len + text.len > RopeChunkSize) {
+    return false;
+  }
+  mem_copy(self->chars + index + text.len, self->chars + index,
+    self->len - index);
+  mem_copy(self->chars + index, text.chars, text.len);
+  self->len += text.len;
+  return true;
+}
+
+static bool rope_delete_in_place(RopeNode* self, u64 index, u64 len) {
+  if (self->refs != 1) {
+    return false;
+  }
+
+  if (self->height) {
+    bool done = false;
+    if (index + len <= self->left->len) {
+      done = rope_delete_in_place(self->left, index, len);
+    } else if (index >= self->left->len) {
+      done = rope_delete_in_place(self->right, index - self->left->len, len);
+    }
+    if (done) {
+      self->len -= len;
+    }
+    return done;
+  }
+
+  // an empty chunk has to leave the tree
+  if (len == self->len) {
+    return false;
+  }
+  mem_copy(self->chars + index, self->chars + index + len,
+    self->len - index - len);
+  self->len -= len;
+  return true;
+}
+
+static void rope_flatten(RopeNode* self, ascii* chars) {
+  while (self->height) {
+    rope_flatten(self->left, chars);
+    chars += self->left->len;
+    self = self->right;
+  }
+  mem_copy(chars, self->chars, self->len);
+}
+
+static void rope_write(RopeNode* self, C_StringBuilder* sink) {
+  while (self->height) {
+    rope_write(self->left, sink);
+    self = self->right;
+  }
+  C_StringBuilder_append_view(
+    sink, StringView_construct(self->chars, self->len));
+}
+
+/******************************
+ * new/dest
+ ******************************/
+C_Rope* C_Rope_new(void) {
+  if (!Interface_initialized((Interface*)&C_Rope_i_formattable)) {
+    C_Rope_i_formattable = IFormattable_construct_format_write(
+      C_Rope_to_str_R, null, C_Rope_write_to);
+
+    C_Rope_interfaces[0] = (Interface*)&C_Rope_i_formattable;
+    C_Rope_interfaces[1] = null;
+  }
+
+  C_Rope* self = allocate(sizeof(C_Rope));
+  self->base = ClassObject_construct(C_Rope_destroy, C_Rope_interfaces);
+  self->root = null;
+  self->spare_nodes = null;
+  self->spare_chunks = null;
+  self->spare_nodes_len = 0;
+  self->spare_chunks_len = 0;
+
+  return self;
+}
+
+C_Rope* C_Rope_new_view(StringView view) {
+  C_Rope* self = C_Rope_new();
+  self->root = C_Rope_build(self, view.chars, view.len);
+  return self;
+}
+
+void C_Rope_destroy(void* self) {
+  C_Rope* self_cast = self;
+  C_Rope_unref(self_cast, self_cast->root);
+
+  RopeNode* spares[2] = {self_cast->spare_nodes, self_cast->spare_chunks};
+  for (u32 i = 0; i < 2; i++) {
+    while (spares[i]) {
+      RopeNode* next = spares[i]->left;
+      deallocate(spares[i]);
+      spares[i] = next;
+    }
+  }
+}
+
+/******************************
+ * logic
+ ******************************/
+void C_Rope_append(C_Rope* self, StringView text) {
+  C_Rope_insert(self, C_Rope_get_len(self), text);
+}
+
+void C_Rope_insert(C_Rope* self, u64 index, StringView text) {
+  if (index > C_Rope_get_len(self)) {
+    crash(E(EG_Strings, E_OutOfBounds,
+      SV("C_Rope_insert -> index is outside of the rope")));
+  }
+  if (text.len == 0) {
+    return;
+  }
+
+  if (self->root && rope_insert_in_place(self->root, index, text)) {
+    return;
+  }
+
+  RopeNode* left;
+  RopeNode* right;
+  C_Rope_split(self, self->root, index, &left, &right);
+  RopeNode* middle = C_Rope_build(self, text.chars, text.len);
+  self->root = C_Rope_join(self, C_Rope_join(self, left, middle), right);
+}
+
+void C_Rope_delete(C_Rope* self, u64 index, u64 len) {
+  u64 rope_len = C_Rope_get_len(self);
+  if (index > rope_len || len > rope_len - index) {
+    crash(E(EG_Strings, E_OutOfBounds,
+      SV("C_Rope_delete -> range is outside of the rope")));
+  }
+  if (len == 0 || rope_delete_in_place(self->root, index, len)) {
+    return;
+  }
+
+  RopeNode* left;
+  RopeNode* middle;
+  RopeNode* right;
+  C_Rope_split(self, self->root, index, &left, &right);
+  C_Rope_split(self, right, len, &middle, &right);
+  C_Rope_unref(self, middle);
+  self->root = C_Rope_join(self, left, right);
+}
+
+void C_Rope_append_rope_P(C_Rope* self, C_Rope* other) {
+  Ref(other);
+  if (other->root) {
+    other->root->refs++;
+    self->root = C_Rope_join(self, self->root, other->root);
+  }
+  Unref(other);
+}
+
+C_Rope* C_Rope_concat_PR(C_Rope* a, C_Rope* b) {
+  C_Rope* result = C_Rope_new();
+  C_Rope_append_rope_P(result, a);
+  C_Rope_append_rope_P(result, b);
+  return result;
+}
+
+C_Rope* C_Rope_substr_R(C_Rope* self, u64 index, u64 len) {
+  u64 rope_len = C_Rope_get_len(self);
+  if (index > rope_len || len > rope_len - index) {
+    crash(E(EG_Strings, E_OutOfBounds,
+      SV("C_Rope_substr_R -> range is outside of the rope")));
+  }
+
+  C_Rope* result = C_Rope_new();
+  if (len == 0) {
+    return result;
+  }
+
+  RopeNode* left;
+  RopeNode* right;
+  self->root->refs++;
+  C_Rope_split(self, self->root, index, &left, &right);
+  C_Rope_split(self, right, len, &result->root, &right);
+  C_Rope_unref(self, left);
+  C_Rope_unref(self, right);
+
+  return result;
+}
+
+ascii C_Rope_at(C_Rope* self, u64 index) {
+  if (index >= C_Rope_get_len(self)) {
+    crash(E(EG_Strings, E_OutOfBounds,
+      SV("C_Rope_at -> index is outside of the rope")));
+  }
+
+  RopeNode* node = self->root;
+  while (node->height) {
+    if (index < node->left->len) {
+      node = node->left;
+    } else {
+      index -= node->left->len;
+      node = node->right;
+    }
+  }
+  return node->chars[index];
+}
+
+C_String* C_Rope_to_str_R(void* self) {
+  C_Rope* self_cast = self;
+  u64 len = C_Rope_get_len(self_cast);
+  if (len > u32_MAX) {
+    crash(E(EG_Strings, E_OutOfBounds,
+      SV("C_Rope_to_str_R -> rope is too long for a C_String")));
+  }
+
+  C_String* result = C_String_new_empty(len);
+  if (len) {
+    rope_flatten(self_cast->root, C_String_get_chars(result));
+  }
+  return result;
+}
+
+void C_Rope_write_to(void* self, C_StringBuilder* sink, C_Format* format) {
+  (void)format;
+  C_Rope* self_cast = self;
+  if (self_cast->root) {
+    rope_write(self_cast->root, sink);
+  }
+}
+
+/******************************
+ * get/set
+ ******************************/
+u64 C_Rope_get_len(C_Rope* self) { return self->root ? self->root->len : 0; }
+
+u32 C_Rope_get_depth(C_Rope* self) {
+  return self->root ? self->root->height : 0;
+}
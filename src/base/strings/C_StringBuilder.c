@@ -0,0 +1,222 @@
+#include <c_base/base/errors/errors.h>
+#include <c_base/base/memory/allocator.h>
+#include <c_base/base/memory/memory.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/base/strings/C_StringBuilder.h>
+#include <c_base/base/strings/string_convert.h>
+#include <c_base/system.h>
+
+static Interface* C_StringBuilder_interfaces[2];
+static IFormattable C_StringBuilder_i_formattable = {0};
+
+struct C_StringBuilder {
+  ClassObject base;
+
+  // null until the first append after new_cap(0) or finish
+  ascii* chars;
+  u32 len;
+  u32 cap;
+
+  // set for sinks, which flush instead of growing
+  StringBuilderFlush flush;
+  void* target;
+};
+
+/******************************
+ * new/dest
+ ******************************/
+C_StringBuilder* C_StringBuilder_new(void) {
+  return C_StringBuilder_new_cap(StringBuilderStartCap);
+}
+
+C_StringBuilder* C_StringBuilder_new_cap(u32 cap) {
+  if (!Interface_initialized((Interface*)&C_StringBuilder_i_formattable)) {
+    C_StringBuilder_i_formattable = IFormattable_construct_format_write(
+      C_StringBuilder_to_str_R, null, C_StringBuilder_write_to);
+
+    C_StringBuilder_interfaces[0] =
+      (Interface*)&C_StringBuilder_i_formattable;
+    C_StringBuilder_interfaces[1] = null;
+  }
+
+  C_StringBuilder* self = allocate(sizeof(C_StringBuilder));
+  self->base =
+    ClassObject_construct(C_StringBuilder_destroy, C_StringBuilder_interfaces);
+  self->chars = cap ? allocate(cap) : null;
+  self->len = 0;
+  self->cap = cap;
+  self->flush = null;
+  self->target = null;
+
+  return self;
+}
+
+C_StringBuilder* C_StringBuilder_new_sink(
+  u32 cap, StringBuilderFlush flush, void* target) {
+  C_StringBuilder* self =
+    C_StringBuilder_new_cap(cap < NumberStrMaxLen ? NumberStrMaxLen : cap);
+  self->flush = flush;
+  self->target = target;
+  return self;
+}
+
+void C_StringBuilder_destroy(void* self) {
+  C_StringBuilder* self_cast = self;
+  C_StringBuilder_flush(self_cast);
+  if (self_cast->chars) {
+    deallocate(self_cast->chars);
+  }
+}
+
+/******************************
+ * logic
+ ******************************/
+void C_StringBuilder_reserve(C_StringBuilder* self, u32 len) {
+  u64 needed = (u64)self->len + len;
+  if (needed <= self->cap) {
+    return;
+  }
+
+  if (self->flush) {
+    if (len > self->cap) {
+      crash(E(EG_Strings, E_OutOfBounds,
+        SV("C_StringBuilder_reserve -> more than the sink holds")));
+    }
+    C_StringBuilder_flush(self);
+    return;
+  }
+
+  if (needed > u32_MAX) {
+    crash(E(EG_Strings, E_OutOfBounds,
+      SV("C_StringBuilder_reserve -> too long for a C_String")));
+  }
+
+  u64 cap = self->cap ? (u64)self->cap * 2 : StringBuilderStartCap;
+  if (cap < needed) {
+    cap = needed;
+  }
+  if (cap > u32_MAX) {
+    cap = u32_MAX;
+  }
+
+  self->chars = reallocate(self->chars, cap);
+  self->cap = cap;
+}
+
+void C_StringBuilder_append_char(C_StringBuilder* self, ascii character) {
+  if (self->len == self->cap) {
+    C_StringBuilder_reserve(self, 1);
+  }
+  self->chars[self->len++] = character;
+}
+
+void C_StringBuilder_append_view(C_StringBuilder* self, StringView view) {
+  // a sink passes what does not fit into its buffer straight on
+  if (self->flush && view.len > self->cap - self->len) {
+    C_StringBuilder_flush(self);
+    if (view.len > self->cap) {
+      self->flush(self->target, view);
+      return;
+    }
+  }
+
+  C_StringBuilder_reserve(self, view.len);
+  mem_copy(self->chars + self->len, view.chars, view.len);
+  self->len += view.len;
+}
+
+void C_StringBuilder_append_P(C_StringBuilder* self, C_String* string) {
+  Ref(string);
+  C_StringBuilder_append_view(self, C_String_get_view(string));
+  Unref(string);
+}
+
+void C_StringBuilder_append_str_P(C_StringBuilder* self, void* value) {
+  IFormattable_write_to_PR(value, self, null);
+}
+
+void C_StringBuilder_append_str_format_P(
+  C_StringBuilder* self, void* value, C_Format* format) {
+  IFormattable_write_to_PR(value, self, format);
+}
+
+void C_StringBuilder_append_u64(C_StringBuilder* self, u64 x) {
+  C_StringBuilder_reserve(self, NumberStrMaxLen);
+  self->len += u64_write(self->chars + self->len, x);
+}
+
+void C_StringBuilder_append_s64(C_StringBuilder* self, s64 x) {
+  C_StringBuilder_reserve(self, NumberStrMaxLen);
+  self->len += s64_write(self->chars + self->len, x);
+}
+
+void C_StringBuilder_append_f64(C_StringBuilder* self, f64 x) {
+  C_StringBuilder_reserve(self, NumberStrMaxLen);
+  self->len += f64_write(self->chars + self->len, x);
+}
+
+void C_StringBuilder_pop(C_StringBuilder* self, u32 len) {
+  if (len > self->len) {
+    crash(E(EG_Strings, E_OutOfBounds,
+      SV("C_StringBuilder_pop -> more chars than the builder has")));
+  }
+  self->len -= len;
+}
+
+void C_StringBuilder_clear(C_StringBuilder* self) { self->len = 0; }
+
+void C_StringBuilder_flush(C_StringBuilder* self) {
+  if (self->flush && self->len) {
+    self->flush(self->target, C_StringBuilder_get_view(self));
+    self->len = 0;
+  }
+}
+
+C_String* C_StringBuilder_to_str_R(void* self) {
+  C_StringBuilder* self_cast = self;
+  return C_String_new_view_copy(C_StringBuilder_get_view(self_cast));
+}
+
+void C_StringBuilder_write_to(
+  void* self, C_StringBuilder* sink, C_Format* format) {
+  (void)format;
+  C_StringBuilder* self_cast = self;
+
+  // reserved first, the chars move when a builder writes to itself
+  u32 len = self_cast->len;
+  if (!sink->flush) {
+    C_StringBuilder_reserve(sink, len);
+  }
+  C_StringBuilder_append_view(
+    sink, StringView_construct(self_cast->chars, len));
+}
+
+C_String* C_StringBuilder_finish_R(C_StringBuilder* self) {
+  if (!self->chars) {
+    return C_String_new_empty(0);
+  }
+
+  // a sink keeps its buffer
+  if (self->flush) {
+    C_String* result = C_StringBuilder_to_str_R(self);
+    self->len = 0;
+    return result;
+  }
+
+  C_String* result = C_String_new_owned(self->chars, self->len);
+  self->chars = null;
+  self->len = 0;
+  self->cap = 0;
+  return result;
+}
+
+/******************************
+ * get/set
+ ******************************/
+u32 C_StringBuilder_get_len(C_StringBuilder* self) { return self->len; }
+
+u32 C_StringBuilder_get_cap(C_StringBuilder* self) { return self->cap; }
+
+StringView C_StringBuilder_get_view(C_StringBuilder* self) {
+  return StringView_construct(self->chars, self->len);
+}
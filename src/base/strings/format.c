@@ -1,24 +1,174 @@
+#include <c_base/base/memory/allocator.h>
+#include <c_base/base/memory/memory.h>
 #include <c_base/base/memory/objects.h>
 #include <c_base/base/strings/format.h>
 #include <c_base/base/strings/strings.h>
-#include <c_base/ds/C_Array.h>
 
-C_String* format_get_value_PR(C_String* format, C_String* key) {
-  Ref(key);
-  C_Array* split1 = C_String_split_R(format, ';');
+typedef struct {
+  StringView key;
+  StringView value;
+} FormatPair;
+
+struct C_Format {
+  ClassObject base;
+
+  // null for the static formats, the views point into it otherwise
+  C_String* format;
+  StringView fields[FormatFieldCount];
+  bool set[FormatFieldCount];
+
+  FormatPair* pairs;
+  u32 len;
+};
+
+static const StringView format_field_names[FormatFieldCount] = {
+  StringViewLit("start"),
+  StringViewLit("end"),
+  StringViewLit("sep"),
+  StringViewLit("el_sep"),
+};
+
+// the static formats are never destroyed, they start with a reference
+#define FormatConstructStatic(start, end, sep, el_sep, has_el_sep)             \
+  {.base = {.references = 1},                                                  \
+    .format = null,                                                            \
+    .fields = {StringViewLit(start), StringViewLit(end), StringViewLit(sep),   \
+      StringViewLit(el_sep)},                                                  \
+    .set = {true, true, true, has_el_sep},                                     \
+    .pairs = null,                                                             \
+    .len = 0}
+
+static C_Format __C_FormatList =
+  FormatConstructStatic("[", "]", ", ", "", false);
+static C_Format __C_FormatSet =
+  FormatConstructStatic("{", "}", ", ", "", false);
+static C_Format __C_FormatMap =
+  FormatConstructStatic("[", "]", ", ", " : ", true);
+C_Format* C_FormatList = &__C_FormatList;
+C_Format* C_FormatSet = &__C_FormatSet;
+C_Format* C_FormatMap = &__C_FormatMap;
+
+static bool format_view_equals(StringView a, StringView b) {
+  return a.len == b.len && mem_equals(a.chars, b.chars, a.len);
+}
+
+/******************************
+ * new/dest
+ ******************************/
+C_Format* C_Format_new_P(C_String* format) {
+  Ref(format);
+  C_Format* self = allocate(sizeof(C_Format));
+  self->base = ClassObject_construct(C_Format_destroy, null);
+  self->format = Ref(format);
+  mem_set(self->set, 0, sizeof(self->set));
+  for (u32 i = 0; i < FormatFieldCount; i++) {
+    self->fields[i] = SV("");
+  }
+
+  ascii* chars = C_String_get_chars(format);
+  u32 len = C_String_get_len(format);
+
+  u32 pair_count = 1;
+  for (u32 i = 0; i < len; i++) {
+    pair_count += chars[i] == ';';
+  }
+  self->pairs = allocate(pair_count * sizeof(FormatPair));
+  self->len = 0;
+
+  // one pass, a pair ends at ';' and its key at the first '='
+  u32 start = 0;
+  while (start <= len) {
+    u32 end = start;
+    u32 equals = len;
+    while (end < len && chars[end] != ';') {
+      if (equals == len && chars[end] == '=') {
+        equals = end;
+      }
+      end++;
+    }
+    if (equals > end) {
+      equals = end;
+    }
+
+    if (end > start) {
+      FormatPair* pair = &self->pairs[self->len++];
+      pair->key = StringView_construct(chars + start, equals - start);
+      pair->value = equals < end ? StringView_construct(
+                                     chars + equals + 1, end - equals - 1)
+                                 : StringView_construct(chars + end, 0);
 
-  C_String* result;
+      for (u32 i = 0; i < FormatFieldCount; i++) {
+        if (format_view_equals(pair->key, format_field_names[i])) {
+          self->fields[i] = pair->value;
+          self->set[i] = true;
+          break;
+        }
+      }
+    }
+
+    start = end + 1;
+  }
 
-  C_ArrayForeach(split1, {
-    C_Array* split2 = C_String_split_R(value, '=');
-    if (C_String_equals(C_Array_at_B(split2, 0), key)) {
-      result = C_Array_at_R(split2, 1);
+  Unref(format);
+  return self;
+}
+
+void C_Format_destroy(void* self) {
+  C_Format* self_cast = self;
+  deallocate(self_cast->pairs);
+  Unref(self_cast->format);
+}
+
+/******************************
+ * logic
+ ******************************/
+StringView C_Format_get(C_Format* self, FormatField field) {
+  return self->fields[field];
+}
+
+bool C_Format_has(C_Format* self, FormatField field) {
+  return self->set[field];
+}
+
+C_String* C_Format_get_value_R(C_Format* self, StringView key) {
+  // the static formats have no pairs, only their fields
+  if (self->format == null) {
+    for (u32 i = 0; i < FormatFieldCount; i++) {
+      if (format_view_equals(key, format_field_names[i])) {
+        return self->set[i] ? C_String_new_view(self->fields[i]) : null;
+      }
+    }
+    return null;
+  }
+
+  // backwards, the last value of a key counts
+  for (u32 i = self->len; i > 0; i--) {
+    FormatPair* pair = &self->pairs[i - 1];
+    if (format_view_equals(pair->key, key)) {
+      ascii* chars = C_String_get_chars(self->format);
+      return C_String_substr_R(
+        self->format, pair->value.chars - chars, pair->value.len);
     }
+  }
+
+  return null;
+}
+
+/******************************
+ * get/set
+ ******************************/
+C_String* C_Format_get_format_B(C_Format* self) { return self->format; }
 
-    Unref(split2);
-  });
+u32 C_Format_get_len(C_Format* self) { return self->len; }
 
-  Unref(split1);
+/******************************
+ * format strings
+ ******************************/
+C_String* format_get_value_PR(C_String* format, C_String* key) {
+  Ref(key);
+  C_Format* compiled = C_Format_new_P(format);
+  C_String* result = C_Format_get_value_R(compiled, C_String_get_view(key));
+  Unref(compiled);
   Unref(key);
   return result;
 }
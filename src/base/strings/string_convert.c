@@ -2,26 +2,21 @@
 #include <c_base/base/math.h>
 #include <c_base/base/memory/allocator.h>
 #include <c_base/base/memory/handles.h>
+#include <c_base/base/memory/memory.h>
 #include <c_base/base/memory/objects.h>
+#include <c_base/base/strings/C_StringBuilder.h>
 #include <c_base/base/strings/string_convert.h>
 #include <c_base/base/strings/strings.h>
 #include <c_base/system.h>
 
 ascii digit_to_hex(u8 d) { return (d < 10) ? ('0' + d) : ('a' + (d - 10)); }
 
+/* the digits go through u64_write and s64_write, which count them in 64
+ * bits, so to_str and write_to make the same text */
 #define UToStr(T)                                                              \
   C_String* Concat(T, _to_str_R)(T x) {                                        \
-    s32 len = math_simple_log(x, 10) + ((x == 0) ? 1 : 0);                     \
-                                                                               \
-    C_String* result = C_String_new_empty(len);                                \
-                                                                               \
-    for (s32 i = len - 1; i >= 0; i--) {                                       \
-      u8 num = x % 10;                                                         \
-      C_String_put(result, i, num + '0');                                      \
-      x /= 10;                                                                 \
-    }                                                                          \
-                                                                               \
-    return result;                                                             \
+    ascii chars[NumberStrMaxLen];                                              \
+    return C_String_new_copy(chars, u64_write(chars, x));                      \
   }
 
 UToStr(u8)
@@ -31,26 +26,8 @@ UToStr(u64)
 
 #define SToStr(T)                                                              \
   C_String* Concat(T, _to_str_R)(T x) {                                        \
-    bool sign = x < 0;                                                         \
-                                                                               \
-    if (sign) {                                                                \
-      x *= -1;                                                                 \
-    }                                                                          \
-                                                                               \
-    s32 len = math_simple_log(x, 10) + sign + ((x == 0) ? 1 : 0);              \
-    C_String* result = C_String_new_empty(len);                                \
-                                                                               \
-    if (sign) {                                                                \
-      C_String_put(result, 0, '-');                                            \
-    }                                                                          \
-                                                                               \
-    for (s32 i = len - 1; i >= sign; i--) {                                    \
-      u8 num = x % 10;                                                         \
-      C_String_put(result, i, num + '0');                                      \
-      x /= 10;                                                                 \
-    }                                                                          \
-                                                                               \
-    return result;                                                             \
+    ascii chars[NumberStrMaxLen];                                              \
+    return C_String_new_copy(chars, s64_write(chars, x));                      \
   }
 
 SToStr(s8)
@@ -58,6 +35,103 @@ SToStr(s16)
 SToStr(s32)
 SToStr(s64)
 
+u32 u64_write(ascii* dest, u64 x) {
+  u32 len = 1;
+  for (u64 rest = x / 10; rest != 0; rest /= 10) {
+    len++;
+  }
+  for (s32 i = len - 1; i >= 0; i--) {
+    dest[i] = (x % 10) + '0';
+    x /= 10;
+  }
+  return len;
+}
+
+u32 s64_write(ascii* dest, s64 x) {
+  if (x >= 0) {
+    return u64_write(dest, x);
+  }
+
+  // negated as unsigned, -s64_MIN does not fit
+  dest[0] = '-';
+  return 1 + u64_write(dest + 1, -(u64)x);
+}
+
+/* fixed notation rounded to FloatToStrDigits fraction digits with trailing
+ * zeros trimmed, values too large for a u64 are printed as d.ddde+x */
+#define FloatToStrDigits 6
+#define FloatToStrScale 1000000
+
+u32 f64_write(ascii* dest, f64 x) {
+  if (x != x) {
+    mem_copy(dest, "nan", 3);
+    return 3;
+  }
+
+  bool sign = x < 0;
+  if (sign) {
+    x *= -1;
+  }
+
+  // only inf turns into nan here
+  if (x - x != x - x) {
+    if (sign) {
+      dest[0] = '-';
+    }
+    mem_copy(dest + sign, "inf", 3);
+    return sign + 3;
+  }
+
+  u32 exponent = 0;
+  if (x >= 1e19) {
+    while (x >= 10) {
+      x /= 10;
+      exponent++;
+    }
+  }
+
+  u64 whole = (u64)x;
+  u64 frac = (u64)((x - (f64)whole) * FloatToStrScale + 0.5);
+  if (frac >= FloatToStrScale) {
+    whole++;
+    frac -= FloatToStrScale;
+  }
+
+  u32 len = 0;
+
+  if (sign) {
+    dest[len++] = '-';
+  }
+  len += u64_write(dest + len, whole);
+  dest[len++] = '.';
+
+  u32 digits = FloatToStrDigits;
+  while (digits > 1 && frac % 10 == 0) {
+    frac /= 10;
+    digits--;
+  }
+  for (s32 i = digits - 1; i >= 0; i--) {
+    dest[len + i] = (frac % 10) + '0';
+    frac /= 10;
+  }
+  len += digits;
+
+  if (exponent != 0) {
+    dest[len++] = 'e';
+    dest[len++] = '+';
+    len += u64_write(dest + len, exponent);
+  }
+
+  return len;
+}
+
+C_String* f64_to_str_R(f64 x) {
+  ascii chars[NumberStrMaxLen];
+  return C_String_new_copy(chars, f64_write(chars, x));
+}
+
+C_String* f32_to_str_R(f32 x) { return f64_to_str_R(x); }
+
 /* AI generated :(*/
 C_String* ptr_to_str_R(void* ptr) {
   if (ptr == null) {
@@ -224,6 +298,41 @@ C_String* bool_to_str_R(bool x) {
   return S("false");
 }
 
+#define WriteTo(T, append_func)                                                \
+  void Concat(T, _write_to)(T x, C_StringBuilder * sink) {                     \
+    append_func(sink, x);                                                      \
+  }
+
+WriteTo(u8, C_StringBuilder_append_u64)
+WriteTo(u16, C_StringBuilder_append_u64)
+WriteTo(u32, C_StringBuilder_append_u64)
+WriteTo(u64, C_StringBuilder_append_u64)
+
+WriteTo(s8, C_StringBuilder_append_s64)
+WriteTo(s16, C_StringBuilder_append_s64)
+WriteTo(s32, C_StringBuilder_append_s64)
+WriteTo(s64, C_StringBuilder_append_s64)
+
+WriteTo(f32, C_StringBuilder_append_f64)
+WriteTo(f64, C_StringBuilder_append_f64)
+
+#define BWriteTo(T, bits)                                                      \
+  void Concat(T, _write_to)(T x, C_StringBuilder * sink) {                     \
+    C_StringBuilder_reserve(sink, bits);                                       \
+    for (u32 i = 0; i < bits; i++) {                                           \
+      C_StringBuilder_append_char(sink, ((x >> i) & 1) ? '1' : '0');           \
+    }                                                                          \
+  }
+
+BWriteTo(b8, 8)
+BWriteTo(b16, 16)
+BWriteTo(b32, 32)
+BWriteTo(b64, 64)
+
+void bool_write_to(bool x, C_StringBuilder* sink) {
+  C_StringBuilder_append_view(sink, x ? SV("true") : SV("false"));
+}
+
 #define ToStrFormatWrap(T)                                                     \
   C_String* Concat(T, _to_str_format_R)(T x, C_String * format) {              \
     (void)format;                                                              \
@@ -240,6 +349,9 @@ ToStrFormatWrap(s16)
 ToStrFormatWrap(s32)
 ToStrFormatWrap(s64)
 
+ToStrFormatWrap(f32)
+ToStrFormatWrap(f64)
+
 ToStrFormatWrap(b8)
 ToStrFormatWrap(b16)
 ToStrFormatWrap(b32)
@@ -2,6 +2,7 @@
 #include <c_base/base/memory/allocator.h>
 #include <c_base/base/memory/memory.h>
 #include <c_base/base/memory/objects.h>
+#include <c_base/base/strings/C_StringBuilder.h>
 #include <c_base/base/strings/format.h>
 #include <c_base/base/strings/string_convert.h>
 #include <c_base/base/strings/strings.h>
@@ -15,15 +16,20 @@ IdImpl(IFormattable)
 
 struct C_String {
   ClassObject base;
-  u32 len;
+  // points at inline_chars for short copies
   ascii* chars;
+  // set for substrings, keeps the chars alive
+  C_String* parent;
+  u32 len;
   bool allocated;
+  ascii inline_chars[StringInlineCap];
 };
 
 static const ClassObject __ClassObject_zero = {0};
 static C_String __C_StringEmpty = {.base = __ClassObject_zero,
-  .len = 0,
   .chars = "",
+  .parent = null,
+  .len = 0,
   .allocated = false};
 C_String* C_StringEmpty = &__C_StringEmpty;
 
@@ -31,19 +37,41 @@ C_String* C_StringEmpty = &__C_StringEmpty;
  * IFormattable
  ******************************/
 
-IFormattable IFormattable_construct_format(C_String* (*to_str_R)(void* self),
-  C_String* (*to_str_format_R)(void* self, C_String* format)) {
+IFormattable IFormattable_construct_format_write(
+  C_String* (*to_str_R)(void* self),
+  C_String* (*to_str_format_R)(void* self, C_String* format),
+  void (*write_to)(void* self, C_StringBuilder* sink, C_Format* format)) {
   IFormattable self;
   self.interface = Interface_construct(IFormattable_id);
   self.to_str_R = to_str_R;
   self.to_str_format_R = to_str_format_R;
+  self.write_to = write_to;
   return self;
 }
 
+IFormattable IFormattable_construct_format(C_String* (*to_str_R)(void* self),
+  C_String* (*to_str_format_R)(void* self, C_String* format)) {
+  return IFormattable_construct_format_write(to_str_R, to_str_format_R, null);
+}
+
 IFormattable IFormattable_construct(C_String* (*to_str_R)(void* self)) {
   return IFormattable_construct_format(to_str_R, null);
 }
 
+IFormattable IFormattable_construct_write(
+  void (*write_to)(void* self, C_StringBuilder* sink, C_Format* format)) {
+  return IFormattable_construct_format_write(null, null, write_to);
+}
+
+static C_String* IFormattable_write_str_R(
+  IFormattable* i_formattable, void* self, C_Format* format) {
+  C_StringBuilder* builder = C_StringBuilder_new();
+  i_formattable->write_to(self, builder, format);
+  C_String* result = C_StringBuilder_finish_R(builder);
+  Unref(builder);
+  return result;
+}
+
 C_String* IFormattable_to_str_PR(void* self) {
   Ref(self);
   C_String* result;
@@ -60,7 +88,12 @@ C_String* IFormattable_to_str_PR(void* self) {
 
   IFormattable* i_formattable =
     (IFormattable*)ClassObject_get_interface(self, IFormattable_id);
-  result = i_formattable->to_str_R(self);
+  if (i_formattable->to_str_R != null) {
+    result = i_formattable->to_str_R(self);
+    goto ret;
+  }
+
+  result = IFormattable_write_str_R(i_formattable, self, null);
 
 ret:
   Unref(self);
@@ -90,6 +123,13 @@ C_String* IFormattable_to_str_format_PR(void* self, C_String* format) {
     goto ret;
   }
 
+  if (i_formattable->write_to != null) {
+    C_Format* compiled = format ? C_Format_new_P(format) : null;
+    result = IFormattable_write_str_R(i_formattable, self, compiled);
+    Unref(compiled);
+    goto ret;
+  }
+
   result = i_formattable->to_str_R(self);
 
 ret:
@@ -97,11 +137,83 @@ ret:
   Unref(format);
   return result;
 }
+
+C_String* IFormattable_to_str_compiled_PR(void* self, C_Format* format) {
+  Ref(self);
+  Ref(format);
+
+  C_String* result;
+
+  if (self == null) {
+    result = S("null");
+    goto ret;
+  }
+
+  if (!ClassObject_contains_interface(self, IFormattable_id)) {
+    result = ptr_to_str_R(self);
+    goto ret;
+  }
+
+  IFormattable* i_formattable =
+    (IFormattable*)ClassObject_get_interface(self, IFormattable_id);
+  if (i_formattable->write_to != null) {
+    result = IFormattable_write_str_R(i_formattable, self, format);
+    goto ret;
+  }
+
+  C_String* source = format ? C_Format_get_format_B(format) : null;
+  result = source ? IFormattable_to_str_format_PR(self, source)
+                  : i_formattable->to_str_R(self);
+
+ret:
+  Unref(self);
+  Unref(format);
+  return result;
+}
+
+void IFormattable_write_to_PR(
+  void* self, C_StringBuilder* sink, C_Format* format) {
+  Ref(self);
+  Ref(format);
+
+  if (self == null) {
+    C_StringBuilder_append_view(sink, SV("null"));
+    goto ret;
+  }
+
+  if (!ClassObject_contains_interface(self, IFormattable_id)) {
+    C_StringBuilder_append_P(sink, Pass(ptr_to_str_R(self)));
+    goto ret;
+  }
+
+  IFormattable* i_formattable =
+    (IFormattable*)ClassObject_get_interface(self, IFormattable_id);
+  if (i_formattable->write_to != null) {
+    i_formattable->write_to(self, sink, format);
+    goto ret;
+  }
+
+  // types without write_to make a string and it is appended
+  C_String* source = format ? C_Format_get_format_B(format) : null;
+  C_StringBuilder_append_P(sink,
+    Pass(source != null ? IFormattable_to_str_format_PR(self, source)
+                        : i_formattable->to_str_R(self)));
+
+ret:
+  Unref(self);
+  Unref(format);
+}
+
 /******************************
  * interface impl
  ******************************/
 C_String* C_String_to_str_R(void* self) { return Ref(self); }
 
+void C_String_write_to(void* self, C_StringBuilder* sink, C_Format* format) {
+  (void)format;
+  C_StringBuilder_append_view(sink, C_String_get_view(self));
+}
+
 u32 C_String_hash(void* self) {
   C_String* self_cast = self;
   return hash(self_cast->chars, self_cast->len);
@@ -120,24 +232,59 @@ bool C_String_equals(void* a, void* b) {
   return mem_equals(a_cast->chars, b_cast->chars, a_cast->len);
 }
 
+s32 C_String_compare(void* a, void* b) {
+  C_String* a_cast = a;
+  C_String* b_cast = b;
+
+  u32 len = (a_cast->len < b_cast->len) ? a_cast->len : b_cast->len;
+  for (u32 i = 0; i < len; i++) {
+    u8 a_char = a_cast->chars[i];
+    u8 b_char = b_cast->chars[i];
+    if (a_char != b_char) {
+      return (a_char < b_char) ? -1 : 1;
+    }
+  }
+
+  return (a_cast->len > b_cast->len) - (a_cast->len < b_cast->len);
+}
+
 /******************************
  * new/dest
  ******************************/
-static Interface* C_String_interfaces[3];
+static Interface* C_String_interfaces[4];
 static IFormattable C_String_i_formattable = {0};
 static IHashable C_String_i_hashable = {0};
+static IComparable C_String_i_comparable = {0};
 
 static void C_String_init_interfaces(void) {
   if (!Interface_initialized((Interface*)&C_String_i_formattable)) {
-    C_String_i_formattable = IFormattable_construct(C_String_to_str_R);
+    // a string is its own text, to_str_R does not copy it
+    C_String_i_formattable = IFormattable_construct_format_write(
+      C_String_to_str_R, null, C_String_write_to);
     C_String_i_hashable = IHashable_construct(C_String_equals, C_String_hash);
+    C_String_i_comparable = IComparable_construct(C_String_compare);
 
     C_String_interfaces[0] = (Interface*)&C_String_i_formattable;
     C_String_interfaces[1] = (Interface*)&C_String_i_hashable;
-    C_String_interfaces[2] = null;
+    C_String_interfaces[2] = (Interface*)&C_String_i_comparable;
+    C_String_interfaces[3] = null;
   }
 }
 
+// short strings keep their chars inline, one allocation less
+static C_String* C_String_new_uninit(u32 len) {
+  C_String_init_interfaces();
+  C_String* self = allocate(sizeof(C_String));
+  self->base = ClassObject_construct(C_String_destroy, C_String_interfaces);
+
+  self->allocated = true;
+  self->chars = len <= StringInlineCap ? self->inline_chars : allocate(len);
+  self->len = len;
+  self->parent = null;
+
+  return self;
+}
+
 C_String* C_String_new(ascii* chars, u32 len) {
   C_String_init_interfaces();
   C_String* self = allocate(sizeof(C_String));
@@ -146,6 +293,7 @@ C_String* C_String_new(ascii* chars, u32 len) {
   self->allocated = false;
   self->chars = chars;
   self->len = len;
+  self->parent = null;
 
   return self;
 }
@@ -155,12 +303,14 @@ C_String* C_String_new_view(StringView view) {
 }
 
 C_String* C_String_new_copy(ascii* chars, u32 len) {
-  ascii* new_chars = allocate(len);
-  mem_copy(new_chars, chars, len);
+  C_String* self = C_String_new_uninit(len);
+  mem_copy(self->chars, chars, len);
+  return self;
+}
 
-  C_String* self = C_String_new(new_chars, len);
+C_String* C_String_new_owned(ascii* chars, u32 len) {
+  C_String* self = C_String_new(chars, len);
   self->allocated = true;
-
   return self;
 }
 
@@ -169,24 +319,17 @@ C_String* C_String_new_view_copy(StringView view) {
 }
 
 C_String* C_String_new_empty(u32 len) {
-  C_String_init_interfaces();
-  C_String* self = allocate(sizeof(C_String));
-  self->base = ClassObject_construct(C_String_destroy, C_String_interfaces);
-
-  self->allocated = true;
-  self->chars = allocate(len);
-  self->len = len;
-
+  C_String* self = C_String_new_uninit(len);
   mem_set(self->chars, 0, len);
-
   return self;
 }
 
 void C_String_destroy(void* self) {
   C_String* self_cast = self;
-  if (self_cast->allocated) {
+  if (self_cast->allocated && self_cast->chars != self_cast->inline_chars) {
     deallocate(self_cast->chars);
   }
+  Unref(self_cast->parent);
 }
 
 /******************************
@@ -220,7 +363,16 @@ C_String* C_String_substr_R(C_String* original, u32 index, u32 len) {
       SV("C_String_substr -> substring would be longer than the original")));
   }
 
-  return C_String_new(original->chars + index, len);
+  C_String* result = C_String_new(original->chars + index, len);
+
+  /* substrings of substrings point at the string owning the chars,
+   * C_StringEmpty is static and cannot be referenced */
+  if (original != C_StringEmpty) {
+    result->parent =
+      Ref(original->parent != null ? original->parent : original);
+  }
+
+  return result;
 }
 
 C_String* C_String_concat_PR(C_String* string, ...) {
@@ -292,6 +444,10 @@ ascii* C_String_get_chars(C_String* self) { return self->chars; }
 
 u32 C_String_get_len(C_String* self) { return self->len; }
 
+StringView C_String_get_view(C_String* self) {
+  return StringView_construct(self->chars, self->len);
+}
+
 /******************************
  * cstr conversion
  ******************************/
@@ -314,38 +470,24 @@ C_Ptr* C_String_to_cstr(C_String* self) {
   return result;
 }
 
-C_String* C_Array_to_str_format_R(void* self, C_String* format) {
-  C_String* start = format_get_value_PR(format, PS("start"));
-  C_String* end = format_get_value_PR(format, PS("end"));
-  C_String* sep = format_get_value_PR(format, PS("sep"));
-
-  C_List* str_list = C_List_new();
-  C_List_push_P(str_list, start);
+void C_Array_write_to(void* self, C_StringBuilder* sink, C_Format* format) {
+  format = format ? format : C_FormatList;
+  StringView start = C_Format_get(format, FormatStart);
+  StringView end = C_Format_get(format, FormatEnd);
+  StringView sep = C_Format_get(format, FormatSep);
 
+  C_StringBuilder_append_view(sink, start);
   C_ArrayForeach(self, {
-    C_List_push_P(str_list, Pass(IFormattable_to_str_PR(value)));
-    C_List_push_P(str_list, sep);
+    if (iter != 0) {
+      C_StringBuilder_append_view(sink, sep);
+    }
+    C_StringBuilder_append_str_P(sink, value);
   });
-
-  if (C_Array_get_len(self) != 0) {
-    Unref(C_List_pop_R(str_list));
-  }
-
-  C_List_push_P(str_list, end);
-
-  C_String* result = C_String_join_PR(Pass(C_List_to_array_PR(str_list)));
-
-  Unref(start);
-  Unref(end);
-  Unref(sep);
-  Unref(str_list);
-
-  return result;
+  C_StringBuilder_append_view(sink, end);
 }
 
-C_String* C_Array_to_str_R(void* self) {
-  C_String* format = S("start=[;end=];sep=, ");
-  C_String* result = C_Array_to_str_format_R(self, format);
-  Unref(format);
-  return result;
+C_String* C_Array_to_str_format_R(void* self, C_String* format) {
+  return IFormattable_to_str_format_PR(self, format);
 }
+
+C_String* C_Array_to_str_R(void* self) { return IFormattable_to_str_PR(self); }
@@ -10,10 +10,12 @@ static Interface* C_Array_interfaces[3];
 static IFormattable C_Array_i_formattable = {0};
 static IHashable C_Array_i_hashable = {0};
 
+/* the values are allocated together with the array, so an array costs a
+ * single allocation whatever its length */
 struct C_Array {
   ClassObject base;
-  void** data;
   u32 len;
+  void* data[];
 };
 
 /******************************
@@ -21,8 +23,7 @@ struct C_Array {
  ******************************/
 C_Array* C_Array_new(u32 len) {
   if (!Interface_initialized((Interface*)&C_Array_i_formattable)) {
-    C_Array_i_formattable =
-      IFormattable_construct_format(C_Array_to_str_R, C_Array_to_str_format_R);
+    C_Array_i_formattable = IFormattable_construct_write(C_Array_write_to);
 
     C_Array_i_hashable = IHashable_construct(C_Array_equals, C_Array_hash);
 
@@ -31,11 +32,10 @@ C_Array* C_Array_new(u32 len) {
     C_Array_interfaces[2] = null;
   }
 
-  C_Array* self = allocate(sizeof(C_Array));
+  C_Array* self = allocate(sizeof(C_Array) + len * sizeof(void*));
   self->base = ClassObject_construct(C_Array_destroy, C_Array_interfaces);
 
   self->len = len;
-  self->data = allocate(len * sizeof(void*));
 
   mem_set(self->data, 0, len * sizeof(void*));
 
@@ -45,8 +45,6 @@ C_Array* C_Array_new(u32 len) {
 void C_Array_destroy(void* self) {
   C_Array* self_cast = self;
   C_ArrayForeach(self_cast, { Unref(value); });
-
-  deallocate(self_cast->data);
 }
 
 /******************************
@@ -101,6 +99,21 @@ void C_Array_clear(C_Array* self) {
   }
 }
 
+void C_Array_sort(C_Array* self) { sort_pdq_comparable(self->data, self->len); }
+
+void C_Array_sort_by(C_Array* self, CompareFunc compare) {
+  sort_pdq(self->data, self->len, compare);
+}
+
+void C_Array_sort_parallel(C_Array* self, u32 threads) {
+  sort_pdq_comparable_parallel(self->data, self->len, threads);
+}
+
+void C_Array_sort_by_parallel(
+  C_Array* self, CompareFunc compare, u32 threads) {
+  sort_pdq_parallel(self->data, self->len, compare, threads);
+}
+
 u32 C_Array_hash(void* self) {
   u32 hash_code = 0;
   C_ArrayForeach(self, { hash_code = 31 * hash_code + IHashable_hash(value); });
@@ -129,6 +142,8 @@ bool C_Array_equals(void* a, void* b) {
  ******************************/
 u32 C_Array_get_len(C_Array* self) { return self->len; }
 
+void** C_Array_get_data(C_Array* self) { return self->data; }
+
 // {{{ _B _R wrappers
 /******************************
  * _B _R wrappers
@@ -0,0 +1,212 @@
+#include <c_base/base/errors/errors.h>
+#include <c_base/base/memory/allocator.h>
+#include <c_base/base/memory/memory.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/base/strings/C_StringBuilder.h>
+#include <c_base/base/strings/format.h>
+#include <c_base/base/strings/string_convert.h>
+#include <c_base/base/strings/strings.h>
+#include <c_base/ds/C_BitSet.h>
+#include <c_base/ds/C_List.h>
+#include <c_base/ds/ds_simd.h>
+#include <c_base/system.h>
+
+static Interface* C_BitSet_interfaces[3];
+static IFormattable C_BitSet_i_formattable = {0};
+static IHashable C_BitSet_i_hashable = {0};
+
+struct C_BitSet {
+  ClassObject base;
+
+  u64 len;
+  u32 word_len;
+  u64* words;
+};
+
+static void C_BitSet_check_index(C_BitSet* self, u64 index) {
+  if (index >= self->len) {
+    crash(E(EG_Datastructures, E_OutOfBounds,
+      SV("C_BitSet -> index is outside of the bitset")));
+  }
+}
+
+static void C_BitSet_check_len(C_BitSet* self, C_BitSet* other) {
+  if (self->len != other->len) {
+    crash(E(EG_Datastructures, E_InvalidArgument,
+      SV("C_BitSet -> the bitsets have a different len")));
+  }
+}
+
+/******************************
+ * new/dest
+ ******************************/
+C_BitSet* C_BitSet_new(u64 len) {
+  if (!Interface_initialized((Interface*)&C_BitSet_i_formattable)) {
+    C_BitSet_i_formattable = IFormattable_construct_write(C_BitSet_write_to);
+    C_BitSet_i_hashable = IHashable_construct(C_BitSet_equals, C_BitSet_hash);
+
+    C_BitSet_interfaces[0] = (Interface*)&C_BitSet_i_formattable;
+    C_BitSet_interfaces[1] = (Interface*)&C_BitSet_i_hashable;
+    C_BitSet_interfaces[2] = null;
+  }
+
+  u64 word_len = (len + 63) / 64;
+  if (word_len > u32_MAX) {
+    crash(E(EG_Datastructures, E_InvalidArgument,
+      SV("C_BitSet_new -> len is too large")));
+  }
+
+  C_BitSet* self = allocate(sizeof(C_BitSet));
+  self->base = ClassObject_construct(C_BitSet_destroy, C_BitSet_interfaces);
+
+  self->len = len;
+  self->word_len = (u32)word_len;
+  // one word for empty sets, so words is never an empty allocation
+  self->words = allocate((word_len ? word_len : 1) * sizeof(u64));
+  mem_set(self->words, 0, word_len * sizeof(u64));
+
+  return self;
+}
+
+C_BitSet* C_BitSet_new_copy(C_BitSet* other) {
+  C_BitSet* self = C_BitSet_new(other->len);
+  mem_copy(self->words, other->words, other->word_len * sizeof(u64));
+  return self;
+}
+
+void C_BitSet_destroy(void* self) {
+  C_BitSet* self_cast = self;
+  deallocate(self_cast->words);
+}
+
+/******************************
+ * logic
+ ******************************/
+void C_BitSet_set(C_BitSet* self, u64 index) {
+  C_BitSet_check_index(self, index);
+  self->words[index / 64] |= 1ull << (index % 64);
+}
+
+void C_BitSet_clear(C_BitSet* self, u64 index) {
+  C_BitSet_check_index(self, index);
+  self->words[index / 64] &= ~(1ull << (index % 64));
+}
+
+bool C_BitSet_test(C_BitSet* self, u64 index) {
+  C_BitSet_check_index(self, index);
+  return (self->words[index / 64] >> (index % 64)) & 1;
+}
+
+void C_BitSet_set_all(C_BitSet* self) {
+  mem_set(self->words, 0xff, self->word_len * sizeof(u64));
+  // the bits past len stay clear, count and equals rely on it
+  if (self->len % 64) {
+    self->words[self->word_len - 1] = (1ull << (self->len % 64)) - 1;
+  }
+}
+
+void C_BitSet_clear_all(C_BitSet* self) {
+  mem_set(self->words, 0, self->word_len * sizeof(u64));
+}
+
+u64 C_BitSet_find_next_set(C_BitSet* self, u64 from) {
+  if (from >= self->len) {
+    return self->len;
+  }
+
+  u32 word = (u32)(from / 64);
+  u64 bits = self->words[word] & (~0ull << (from % 64));
+  while (!bits) {
+    if (++word == self->word_len) {
+      return self->len;
+    }
+    bits = self->words[word];
+  }
+  return (u64)word * 64 + (u64)__builtin_ctzll(bits);
+}
+
+u64 C_BitSet_count(C_BitSet* self) {
+  return simd_popcount_bits(self->words, self->word_len);
+}
+
+u64 C_BitSet_rank(C_BitSet* self, u64 index) {
+  if (index > self->len) {
+    crash(E(EG_Datastructures, E_OutOfBounds,
+      SV("C_BitSet_rank -> index is outside of the bitset")));
+  }
+
+  u32 word = (u32)(index / 64);
+  u64 result = simd_popcount_bits(self->words, word);
+  if (index % 64) {
+    u64 below = self->words[word] & ((1ull << (index % 64)) - 1);
+    result += (u64)__builtin_popcountll(below);
+  }
+  return result;
+}
+
+void C_BitSet_and(C_BitSet* self, C_BitSet* other) {
+  C_BitSet_check_len(self, other);
+  simd_and_bits(self->words, self->words, other->words, self->word_len);
+}
+
+void C_BitSet_or(C_BitSet* self, C_BitSet* other) {
+  C_BitSet_check_len(self, other);
+  simd_or_bits(self->words, self->words, other->words, self->word_len);
+}
+
+void C_BitSet_xor(C_BitSet* self, C_BitSet* other) {
+  C_BitSet_check_len(self, other);
+  simd_xor_bits(self->words, self->words, other->words, self->word_len);
+}
+
+void C_BitSet_andnot(C_BitSet* self, C_BitSet* other) {
+  C_BitSet_check_len(self, other);
+  simd_andnot_bits(self->words, self->words, other->words, self->word_len);
+}
+
+u32 C_BitSet_hash(void* self) {
+  C_BitSet* self_cast = self;
+  return hash(self_cast->words, self_cast->word_len * sizeof(u64));
+}
+
+bool C_BitSet_equals(void* a, void* b) {
+  C_BitSet* a_cast = a;
+  C_BitSet* b_cast = b;
+  return a_cast->len == b_cast->len &&
+         mem_equals(
+           a_cast->words, b_cast->words, a_cast->word_len * sizeof(u64));
+}
+
+void C_BitSet_write_to(void* self, C_StringBuilder* sink, C_Format* format) {
+  C_BitSet* self_cast = self;
+  format = format ? format : C_FormatSet;
+  StringView start = C_Format_get(format, FormatStart);
+  StringView end = C_Format_get(format, FormatEnd);
+  StringView sep = C_Format_get(format, FormatSep);
+
+  C_StringBuilder_append_view(sink, start);
+  u64 index = C_BitSet_find_next_set(self_cast, 0);
+  while (index < self_cast->len) {
+    C_StringBuilder_append_u64(sink, index);
+    index = C_BitSet_find_next_set(self_cast, index + 1);
+    if (index < self_cast->len) {
+      C_StringBuilder_append_view(sink, sep);
+    }
+  }
+  C_StringBuilder_append_view(sink, end);
+}
+
+C_String* C_BitSet_to_str_format_R(void* self, C_String* format) {
+  return IFormattable_to_str_format_PR(self, format);
+}
+
+C_String* C_BitSet_to_str_R(void* self) { return IFormattable_to_str_PR(self); }
+
+/******************************
+ * get/set
+ ******************************/
+u64 C_BitSet_get_len(C_BitSet* self) { return self->len; }
+
+u64* C_BitSet_get_words(C_BitSet* self) { return self->words; }
+
+u32 C_BitSet_get_word_len(C_BitSet* self) { return self->word_len; }
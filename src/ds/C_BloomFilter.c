@@ -0,0 +1,178 @@
+#include <c_base/base/errors/errors.h>
+#include <c_base/base/memory/allocator.h>
+#include <c_base/base/memory/memory.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_BloomFilter.h>
+#include <c_base/ds/ds_simd.h>
+#include <c_base/env.h>
+#include <c_base/system.h>
+
+#if defined(ARCH_X86_64) && (defined(COMPILER_GCC) || defined(COMPILER_CLANG))
+  #define BLOOM_AVX2
+  #include <immintrin.h>
+  #define TargetAVX2 __attribute__((target("avx2")))
+#endif
+
+#define BloomBlockWords 8
+#define BloomBlockBytes (BloomBlockWords * sizeof(u32))
+
+typedef struct {
+  u32 words[BloomBlockWords];
+} BloomBlock;
+
+struct C_BloomFilter {
+  ClassObject base;
+
+  // aligned to a block, data is what was allocated
+  BloomBlock* blocks;
+  void* data;
+  u64 block_count;
+  u32 len;
+};
+
+// odd constants, word i of a block uses bit (key * salts[i]) >> 27
+static const u32 bloom_salts[BloomBlockWords] = {0x47b6137bu, 0x44974d91u,
+  0x8824ad5bu, 0xa2b7289du, 0x705495c7u, 0x2df1424bu, 0x9efc4947u,
+  0x5c6bfb31u};
+
+/******************************
+ * blocks
+ ******************************/
+// the high half of hash picks the block, the low half the bits in it
+static BloomBlock* C_BloomFilter_block(C_BloomFilter* self, u64 hash) {
+  return &self->blocks[((hash >> 32) * self->block_count) >> 32];
+}
+
+static void bloom_add_scalar(BloomBlock* block, u32 key) {
+  for (u32 i = 0; i < BloomBlockWords; i++) {
+    block->words[i] |= 1u << ((key * bloom_salts[i]) >> 27);
+  }
+}
+
+static bool bloom_contains_scalar(BloomBlock* block, u32 key) {
+  for (u32 i = 0; i < BloomBlockWords; i++) {
+    if (!(block->words[i] & (1u << ((key * bloom_salts[i]) >> 27)))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+#if defined(BLOOM_AVX2)
+// all 8 words at once, the shifts by the lanes need avx2
+static inline TargetAVX2 __m256i bloom_mask_avx2(u32 key) {
+  __m256i salts = _mm256_loadu_si256((__m256i*)bloom_salts);
+  __m256i bits = _mm256_mullo_epi32(_mm256_set1_epi32((s32)key), salts);
+  bits = _mm256_srli_epi32(bits, 27);
+  return _mm256_sllv_epi32(_mm256_set1_epi32(1), bits);
+}
+
+static TargetAVX2 void bloom_add_avx2(BloomBlock* block, u32 key) {
+  __m256i words = _mm256_load_si256((__m256i*)block);
+  words = _mm256_or_si256(words, bloom_mask_avx2(key));
+  _mm256_store_si256((__m256i*)block, words);
+}
+
+static TargetAVX2 bool bloom_contains_avx2(BloomBlock* block, u32 key) {
+  // testc is 1 when every bit of the mask is set in the block
+  __m256i words = _mm256_load_si256((__m256i*)block);
+  return _mm256_testc_si256(words, bloom_mask_avx2(key));
+}
+#endif
+
+/******************************
+ * new/dest
+ ******************************/
+C_BloomFilter* C_BloomFilter_new(u32 expected_len, u32 bits_per_key) {
+  if (bits_per_key == 0) {
+    crash(E(EG_Datastructures, E_InvalidArgument,
+      SV("C_BloomFilter_new -> bits_per_key must be larger than 0")));
+  }
+
+  C_BloomFilter* self = allocate(sizeof(C_BloomFilter));
+  self->base = ClassObject_construct(C_BloomFilter_destroy, null);
+
+  u64 bits = (u64)expected_len * bits_per_key;
+  self->block_count = (bits + BloomBlockBytes * 8 - 1) / (BloomBlockBytes * 8);
+  if (self->block_count == 0) {
+    self->block_count = 1;
+  }
+
+  // blocks are aligned to their size, so none crosses a cache line
+  u64 size = self->block_count * BloomBlockBytes;
+  self->data = allocate(size + BloomBlockBytes - 1);
+  self->blocks =
+    (BloomBlock*)mem_align_forward((u64)self->data, BloomBlockBytes);
+  mem_set(self->blocks, 0, size);
+  self->len = 0;
+
+  return self;
+}
+
+void C_BloomFilter_destroy(void* self) {
+  C_BloomFilter* self_cast = self;
+  deallocate(self_cast->data);
+}
+
+/******************************
+ * logic
+ ******************************/
+void C_BloomFilter_add_hash(C_BloomFilter* self, u64 hash) {
+  BloomBlock* block = C_BloomFilter_block(self, hash);
+  self->len++;
+
+#if defined(BLOOM_AVX2)
+  if (simd_get_level() == SIMD_AVX2) {
+    bloom_add_avx2(block, (u32)hash);
+    return;
+  }
+#endif
+  bloom_add_scalar(block, (u32)hash);
+}
+
+bool C_BloomFilter_contains_hash(C_BloomFilter* self, u64 hash) {
+  BloomBlock* block = C_BloomFilter_block(self, hash);
+
+#if defined(BLOOM_AVX2)
+  if (simd_get_level() == SIMD_AVX2) {
+    return bloom_contains_avx2(block, (u32)hash);
+  }
+#endif
+  return bloom_contains_scalar(block, (u32)hash);
+}
+
+void C_BloomFilter_add_P(C_BloomFilter* self, void* key) {
+  Ref(key);
+  C_BloomFilter_add_hash(self, ds_hash_mix(IHashable_hash(key)));
+  Unref(key);
+}
+
+bool C_BloomFilter_contains_P(C_BloomFilter* self, void* key) {
+  Ref(key);
+  bool result =
+    C_BloomFilter_contains_hash(self, ds_hash_mix(IHashable_hash(key)));
+  Unref(key);
+  return result;
+}
+
+void C_BloomFilter_add_bytes(C_BloomFilter* self, void* data, u64 size) {
+  C_BloomFilter_add_hash(self, ds_hash_mix(hash(data, size)));
+}
+
+bool C_BloomFilter_contains_bytes(C_BloomFilter* self, void* data, u64 size) {
+  return C_BloomFilter_contains_hash(self, ds_hash_mix(hash(data, size)));
+}
+
+void C_BloomFilter_clear(C_BloomFilter* self) {
+  mem_set(self->blocks, 0, self->block_count * BloomBlockBytes);
+  self->len = 0;
+}
+
+/******************************
+ * get/set
+ ******************************/
+u32 C_BloomFilter_get_len(C_BloomFilter* self) { return self->len; }
+
+u64 C_BloomFilter_get_bits(C_BloomFilter* self) {
+  return self->block_count * BloomBlockBytes * 8;
+}
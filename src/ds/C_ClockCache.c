@@ -0,0 +1,317 @@
+#include <c_base/base/errors/errors.h>
+#include <c_base/base/memory/allocator.h>
+#include <c_base/base/memory/memory.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_ClockCache.h>
+#include <c_base/os/os_atomic.h>
+#include <c_base/os/os_threads.h>
+#include <c_base/system.h>
+
+// end of a bucket chain or of the free list
+#define ClockNone u32_MAX
+#define ClockMaxShards 1024
+
+/* slots that are not used are chained through next as the free list */
+typedef struct {
+  ascii* key;
+  u32 key_len;
+  // next slot of the same bucket
+  u32 next;
+  u64 hash;
+  // set by a hit, cleared by the hand
+  bool referenced;
+} ClockSlot;
+
+typedef struct {
+  Mutex mutex;
+
+  ClockSlot* slots;
+  // value_size bytes per slot
+  u8* values;
+  u32* buckets;
+  u32 bucket_mask;
+
+  u32 len;
+  u32 free;
+  u32 hand;
+
+  CacheStats stats;
+
+  // shards are written by different threads
+  u8 pad[OSCacheLineSize];
+} ClockShard;
+
+struct C_ClockCache {
+  ClassObject base;
+
+  ClockShard* shards;
+  u32 shard_bits;
+  u32 shard_count;
+  u32 shard_cap;
+  u32 value_size;
+
+  ClockEvict evict;
+  void* evict_data;
+};
+
+/******************************
+ * shards
+ ******************************/
+static u64 clock_hash(StringView key) {
+  return ds_hash_mix(hash(key.chars, key.len));
+}
+
+static ClockShard* C_ClockCache_shard(C_ClockCache* self, u64 hash) {
+  // the low bits pick the bucket, the high ones the shard
+  return &self->shards[self->shard_bits ? hash >> (64 - self->shard_bits) : 0];
+}
+
+static void ClockShard_init(ClockShard* self, u32 cap, u32 value_size) {
+  self->mutex = Mutex_construct();
+
+  self->slots = allocate(cap * sizeof(ClockSlot));
+  for (u32 i = 0; i < cap; i++) {
+    self->slots[i].next = i + 1 < cap ? i + 1 : ClockNone;
+  }
+  self->values = allocate((u64)cap * value_size);
+
+  u32 bucket_count = 1;
+  while (bucket_count < cap) {
+    bucket_count <<= 1;
+  }
+  self->buckets = allocate(bucket_count * sizeof(u32));
+  mem_set(self->buckets, 0xff, bucket_count * sizeof(u32));
+  self->bucket_mask = bucket_count - 1;
+
+  self->len = 0;
+  self->free = 0;
+  self->hand = 0;
+  self->stats = (CacheStats){0};
+}
+
+// the link that points to the slot of key, or to ClockNone
+static u32* ClockShard_find(ClockShard* self, StringView key, u64 hash) {
+  u32* link = &self->buckets[hash & self->bucket_mask];
+  while (*link != ClockNone) {
+    ClockSlot* slot = &self->slots[*link];
+    if (slot->hash == hash && slot->key_len == key.len &&
+        mem_equals(slot->key, key.chars, key.len)) {
+      break;
+    }
+    link = &slot->next;
+  }
+  return link;
+}
+
+// frees the slot at *link and puts it on the free list
+static void ClockShard_drop(ClockShard* self, u32* link) {
+  u32 index = *link;
+  ClockSlot* slot = &self->slots[index];
+  *link = slot->next;
+
+  deallocate(slot->key);
+  slot->next = self->free;
+  self->free = index;
+  self->len--;
+}
+
+// a slot for a new entry, evicts when the shard is full
+static u32 C_ClockCache_take_slot(C_ClockCache* self, ClockShard* shard) {
+  if (shard->free == ClockNone) {
+    // every slot is used, the hand finds one without a second chance
+    while (shard->slots[shard->hand].referenced) {
+      shard->slots[shard->hand].referenced = false;
+      shard->hand = (shard->hand + 1) % self->shard_cap;
+    }
+
+    ClockSlot* victim = &shard->slots[shard->hand];
+    if (self->evict) {
+      StringView key = {victim->key, victim->key_len};
+      self->evict(key,
+        shard->values + (u64)shard->hand * self->value_size,
+        self->evict_data);
+    }
+    shard->stats.evictions++;
+
+    u32* link = &shard->buckets[victim->hash & shard->bucket_mask];
+    while (*link != shard->hand) {
+      link = &shard->slots[*link].next;
+    }
+    ClockShard_drop(shard, link);
+    shard->hand = (shard->hand + 1) % self->shard_cap;
+  }
+
+  u32 index = shard->free;
+  shard->free = shard->slots[index].next;
+  return index;
+}
+
+/******************************
+ * new/dest
+ ******************************/
+C_ClockCache* C_ClockCache_new(u32 cap, u32 shard_count, u32 value_size) {
+  if (cap == 0 || value_size == 0) {
+    crash(E(EG_Datastructures, E_InvalidArgument,
+      SV("C_ClockCache_new -> cap and value_size have to be at least 1")));
+  }
+  if (shard_count == 0 || shard_count > ClockMaxShards) {
+    crash(E(EG_Datastructures, E_InvalidArgument,
+      SV("C_ClockCache_new -> shard_count has to be between 1 and 1024")));
+  }
+
+  C_ClockCache* self = allocate(sizeof(C_ClockCache));
+  self->base = ClassObject_construct(C_ClockCache_destroy, null);
+
+  self->shard_bits = 0;
+  while ((1u << self->shard_bits) < shard_count) {
+    self->shard_bits++;
+  }
+  self->shard_count = 1u << self->shard_bits;
+  self->shard_cap = (cap + self->shard_count - 1) / self->shard_count;
+  self->value_size = value_size;
+  self->evict = null;
+  self->evict_data = null;
+
+  self->shards = allocate(self->shard_count * sizeof(ClockShard));
+  for (u32 i = 0; i < self->shard_count; i++) {
+    ClockShard_init(&self->shards[i], self->shard_cap, value_size);
+  }
+
+  return self;
+}
+
+void C_ClockCache_destroy(void* self) {
+  C_ClockCache* self_cast = self;
+  C_ClockCache_clear(self_cast);
+
+  for (u32 i = 0; i < self_cast->shard_count; i++) {
+    ClockShard* shard = &self_cast->shards[i];
+    deallocate(shard->slots);
+    deallocate(shard->values);
+    deallocate(shard->buckets);
+  }
+  deallocate(self_cast->shards);
+}
+
+/******************************
+ * logic
+ ******************************/
+void C_ClockCache_put(C_ClockCache* self, StringView key, void* value) {
+  u64 hash = clock_hash(key);
+  ClockShard* shard = C_ClockCache_shard(self, hash);
+  // the key is copied before the lock is taken
+  ascii* key_copy = allocate(key.len ? key.len : 1);
+  mem_copy(key_copy, key.chars, key.len);
+
+  Mutex_lock(&shard->mutex);
+
+  u32* link = ClockShard_find(shard, key, hash);
+  u32 index = *link;
+  if (index != ClockNone) {
+    deallocate(key_copy);
+  } else {
+    index = C_ClockCache_take_slot(self, shard);
+    ClockSlot* slot = &shard->slots[index];
+    slot->key = key_copy;
+    slot->key_len = key.len;
+    slot->hash = hash;
+    // a new entry gets its second chance from its first hit
+    slot->referenced = false;
+
+    u32* bucket = &shard->buckets[hash & shard->bucket_mask];
+    slot->next = *bucket;
+    *bucket = index;
+    shard->len++;
+  }
+  mem_copy(
+    shard->values + (u64)index * self->value_size, value, self->value_size);
+
+  Mutex_unlock(&shard->mutex);
+}
+
+bool C_ClockCache_get(C_ClockCache* self, StringView key, void* value) {
+  u64 hash = clock_hash(key);
+  ClockShard* shard = C_ClockCache_shard(self, hash);
+
+  Mutex_lock(&shard->mutex);
+
+  u32 index = *ClockShard_find(shard, key, hash);
+  bool found = index != ClockNone;
+  if (found) {
+    shard->slots[index].referenced = true;
+    mem_copy(
+      value, shard->values + (u64)index * self->value_size, self->value_size);
+    shard->stats.hits++;
+  } else {
+    shard->stats.misses++;
+  }
+
+  Mutex_unlock(&shard->mutex);
+  return found;
+}
+
+bool C_ClockCache_remove(C_ClockCache* self, StringView key) {
+  u64 hash = clock_hash(key);
+  ClockShard* shard = C_ClockCache_shard(self, hash);
+
+  Mutex_lock(&shard->mutex);
+
+  u32* link = ClockShard_find(shard, key, hash);
+  bool found = *link != ClockNone;
+  if (found) {
+    ClockShard_drop(shard, link);
+  }
+
+  Mutex_unlock(&shard->mutex);
+  return found;
+}
+
+void C_ClockCache_clear(C_ClockCache* self) {
+  for (u32 i = 0; i < self->shard_count; i++) {
+    ClockShard* shard = &self->shards[i];
+    Mutex_lock(&shard->mutex);
+
+    for (u32 b = 0; b <= shard->bucket_mask; b++) {
+      while (shard->buckets[b] != ClockNone) {
+        ClockShard_drop(shard, &shard->buckets[b]);
+      }
+    }
+    shard->hand = 0;
+
+    Mutex_unlock(&shard->mutex);
+  }
+}
+
+/******************************
+ * get/set
+ ******************************/
+u32 C_ClockCache_get_len(C_ClockCache* self) {
+  u32 len = 0;
+  for (u32 i = 0; i < self->shard_count; i++) {
+    Mutex_lock(&self->shards[i].mutex);
+    len += self->shards[i].len;
+    Mutex_unlock(&self->shards[i].mutex);
+  }
+  return len;
+}
+
+CacheStats C_ClockCache_get_stats(C_ClockCache* self) {
+  CacheStats stats = {0};
+  for (u32 i = 0; i < self->shard_count; i++) {
+    Mutex_lock(&self->shards[i].mutex);
+    stats.hits += self->shards[i].stats.hits;
+    stats.misses += self->shards[i].stats.misses;
+    stats.evictions += self->shards[i].stats.evictions;
+    Mutex_unlock(&self->shards[i].mutex);
+  }
+  return stats;
+}
+
+u32 C_ClockCache_get_cap(C_ClockCache* self) {
+  return self->shard_cap * self->shard_count;
+}
+
+void C_ClockCache_set_evict(C_ClockCache* self, ClockEvict evict, void* data) {
+  self->evict = evict;
+  self->evict_data = data;
+}
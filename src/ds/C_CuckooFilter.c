@@ -0,0 +1,245 @@
+#include <c_base/base/errors/errors.h>
+#include <c_base/base/memory/allocator.h>
+#include <c_base/base/memory/memory.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_CuckooFilter.h>
+#include <c_base/system.h>
+
+#define CuckooBucketSlots 4
+// moves before an add gives up
+#define CuckooMaxKicks 500
+
+// one bit pattern per 16 bit slot of a bucket
+#define CuckooLowBits 0x0001000100010001ull
+#define CuckooHighBits 0x8000800080008000ull
+
+/* a bucket is a u64 with 4 fingerprints, 0 is an empty slot.
+ * the victim is a fingerprint that found no bucket after CuckooMaxKicks
+ * moves, it is kept aside and the filter counts as full until a remove
+ * makes room for it */
+struct C_CuckooFilter {
+  ClassObject base;
+
+  u64* buckets;
+  u64 bucket_mask;
+  u32 len;
+
+  bool has_victim;
+  u16 victim;
+  u64 victim_index;
+
+  // picks the fingerprint that is moved, xorshift
+  u64 kick_state;
+};
+
+/******************************
+ * buckets
+ ******************************/
+static u16 cuckoo_fingerprint(u64 hash) {
+  u16 fingerprint = (u16)(hash >> 48);
+  return fingerprint ? fingerprint : 1;
+}
+
+// the other bucket of fingerprint, the same function maps it back
+static u64 C_CuckooFilter_alt_index(
+  C_CuckooFilter* self, u64 index, u16 fingerprint) {
+  return (index ^ ds_hash_mix(fingerprint)) & self->bucket_mask;
+}
+
+// compares all 4 slots at once, a slot equal to fingerprint xors to 0
+static bool cuckoo_bucket_has(u64 bucket, u16 fingerprint) {
+  u64 diff = bucket ^ (fingerprint * CuckooLowBits);
+  return ((diff - CuckooLowBits) & ~diff & CuckooHighBits) != 0;
+}
+
+static bool cuckoo_bucket_insert(u64* bucket, u16 fingerprint) {
+  for (u32 i = 0; i < CuckooBucketSlots; i++) {
+    if (!((*bucket >> (16 * i)) & 0xffff)) {
+      *bucket |= (u64)fingerprint << (16 * i);
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool cuckoo_bucket_remove(u64* bucket, u16 fingerprint) {
+  for (u32 i = 0; i < CuckooBucketSlots; i++) {
+    if (((*bucket >> (16 * i)) & 0xffff) == fingerprint) {
+      *bucket &= ~(0xffffull << (16 * i));
+      return true;
+    }
+  }
+  return false;
+}
+
+static u64 C_CuckooFilter_kick_rand(C_CuckooFilter* self) {
+  self->kick_state ^= self->kick_state << 13;
+  self->kick_state ^= self->kick_state >> 7;
+  self->kick_state ^= self->kick_state << 17;
+  return self->kick_state;
+}
+
+/******************************
+ * new/dest
+ ******************************/
+C_CuckooFilter* C_CuckooFilter_new(u32 cap) {
+  C_CuckooFilter* self = allocate(sizeof(C_CuckooFilter));
+  self->base = ClassObject_construct(C_CuckooFilter_destroy, null);
+
+  // a power of two of buckets, at most 90% full with cap keys
+  u64 needed = ((u64)cap * 10 / 9 + CuckooBucketSlots - 1) / CuckooBucketSlots;
+  u64 bucket_count = 1;
+  while (bucket_count < needed) {
+    bucket_count <<= 1;
+  }
+
+  self->buckets = allocate(bucket_count * sizeof(u64));
+  mem_set(self->buckets, 0, bucket_count * sizeof(u64));
+  self->bucket_mask = bucket_count - 1;
+  self->len = 0;
+  self->has_victim = false;
+  self->kick_state = 88172645463325252ull;
+
+  return self;
+}
+
+void C_CuckooFilter_destroy(void* self) {
+  C_CuckooFilter* self_cast = self;
+  deallocate(self_cast->buckets);
+}
+
+/******************************
+ * logic
+ ******************************/
+bool C_CuckooFilter_add_hash(C_CuckooFilter* self, u64 hash) {
+  if (self->has_victim) {
+    return false;
+  }
+
+  u16 fingerprint = cuckoo_fingerprint(hash);
+  u64 index = hash & self->bucket_mask;
+  u64 alt_index = C_CuckooFilter_alt_index(self, index, fingerprint);
+  self->len++;
+
+  if (cuckoo_bucket_insert(&self->buckets[index], fingerprint) ||
+      cuckoo_bucket_insert(&self->buckets[alt_index], fingerprint)) {
+    return true;
+  }
+
+  // both are full, a random fingerprint moves to its other bucket
+  index = C_CuckooFilter_kick_rand(self) & 1 ? index : alt_index;
+  for (u32 kick = 0; kick < CuckooMaxKicks; kick++) {
+    u32 shift = 16 * (C_CuckooFilter_kick_rand(self) % CuckooBucketSlots);
+    u64* bucket = &self->buckets[index];
+    u16 evicted = (u16)(*bucket >> shift);
+    *bucket = (*bucket & ~(0xffffull << shift)) | ((u64)fingerprint << shift);
+
+    fingerprint = evicted;
+    index = C_CuckooFilter_alt_index(self, index, fingerprint);
+    if (cuckoo_bucket_insert(&self->buckets[index], fingerprint)) {
+      return true;
+    }
+  }
+
+  self->has_victim = true;
+  self->victim = fingerprint;
+  self->victim_index = index;
+  return true;
+}
+
+bool C_CuckooFilter_contains_hash(C_CuckooFilter* self, u64 hash) {
+  u16 fingerprint = cuckoo_fingerprint(hash);
+  u64 index = hash & self->bucket_mask;
+  u64 alt_index = C_CuckooFilter_alt_index(self, index, fingerprint);
+
+  if (cuckoo_bucket_has(self->buckets[index], fingerprint) ||
+      cuckoo_bucket_has(self->buckets[alt_index], fingerprint)) {
+    return true;
+  }
+
+  return self->has_victim && self->victim == fingerprint &&
+         (self->victim_index == index || self->victim_index == alt_index);
+}
+
+bool C_CuckooFilter_remove_hash(C_CuckooFilter* self, u64 hash) {
+  u16 fingerprint = cuckoo_fingerprint(hash);
+  u64 index = hash & self->bucket_mask;
+  u64 alt_index = C_CuckooFilter_alt_index(self, index, fingerprint);
+
+  if (self->has_victim && self->victim == fingerprint &&
+      (self->victim_index == index || self->victim_index == alt_index)) {
+    self->has_victim = false;
+    self->len--;
+    return true;
+  }
+
+  if (!cuckoo_bucket_remove(&self->buckets[index], fingerprint) &&
+      !cuckoo_bucket_remove(&self->buckets[alt_index], fingerprint)) {
+    return false;
+  }
+  self->len--;
+
+  // the free slot may be one of the buckets of the victim
+  if (self->has_victim) {
+    u64 victim_alt =
+      C_CuckooFilter_alt_index(self, self->victim_index, self->victim);
+    u64* victim_bucket = &self->buckets[self->victim_index];
+    if (cuckoo_bucket_insert(victim_bucket, self->victim) ||
+        cuckoo_bucket_insert(&self->buckets[victim_alt], self->victim)) {
+      self->has_victim = false;
+    }
+  }
+  return true;
+}
+
+bool C_CuckooFilter_add_P(C_CuckooFilter* self, void* key) {
+  Ref(key);
+  bool result =
+    C_CuckooFilter_add_hash(self, ds_hash_mix(IHashable_hash(key)));
+  Unref(key);
+  return result;
+}
+
+bool C_CuckooFilter_contains_P(C_CuckooFilter* self, void* key) {
+  Ref(key);
+  bool result =
+    C_CuckooFilter_contains_hash(self, ds_hash_mix(IHashable_hash(key)));
+  Unref(key);
+  return result;
+}
+
+bool C_CuckooFilter_remove_P(C_CuckooFilter* self, void* key) {
+  Ref(key);
+  bool result =
+    C_CuckooFilter_remove_hash(self, ds_hash_mix(IHashable_hash(key)));
+  Unref(key);
+  return result;
+}
+
+bool C_CuckooFilter_add_bytes(C_CuckooFilter* self, void* data, u64 size) {
+  return C_CuckooFilter_add_hash(self, ds_hash_mix(hash(data, size)));
+}
+
+bool C_CuckooFilter_contains_bytes(
+  C_CuckooFilter* self, void* data, u64 size) {
+  return C_CuckooFilter_contains_hash(self, ds_hash_mix(hash(data, size)));
+}
+
+bool C_CuckooFilter_remove_bytes(C_CuckooFilter* self, void* data, u64 size) {
+  return C_CuckooFilter_remove_hash(self, ds_hash_mix(hash(data, size)));
+}
+
+void C_CuckooFilter_clear(C_CuckooFilter* self) {
+  mem_set(self->buckets, 0, (self->bucket_mask + 1) * sizeof(u64));
+  self->len = 0;
+  self->has_victim = false;
+}
+
+/******************************
+ * get/set
+ ******************************/
+u32 C_CuckooFilter_get_len(C_CuckooFilter* self) { return self->len; }
+
+u64 C_CuckooFilter_get_cap(C_CuckooFilter* self) {
+  return (self->bucket_mask + 1) * CuckooBucketSlots;
+}
@@ -1,3 +1,4 @@
+#include "c_base/base/strings/C_StringBuilder.h"
 #include "c_base/base/strings/format.h"
 #include "c_base/base/strings/strings.h"
 #include "c_base/ds/C_Array.h"
@@ -13,20 +14,51 @@ static Interface* C_DArray_interfaces[3];
 static IFormattable C_DArray_i_formattable = {0};
 static IHashable C_DArray_i_hashable = {0};
 
+/* data points at inline_data while cap <= DArrayInlineCap, short darrays
+ * never allocate their values separately */
 struct C_DArray {
   ClassObject base;
 
   u32 cap;
   u32 len;
   void** data;
+  DArrayGrowth growth;
+  void* inline_data[DArrayInlineCap];
 };
 
+/******************************
+ * DArrayGrowth
+ ******************************/
+u32 DArrayGrowth_double(u32 cap, u32 min_cap) {
+  u32 grown = cap * 2;
+  return grown > min_cap ? grown : min_cap;
+}
+
+u32 DArrayGrowth_one_half(u32 cap, u32 min_cap) {
+  u32 grown = cap + cap / 2 + 1;
+  return grown > min_cap ? grown : min_cap;
+}
+
+/* whole pages, growing by at least a quarter so appends stay amortized O(1),
+ * meant for big darrays that reallocate can grow in place */
+u32 DArrayGrowth_pages(u32 cap, u32 min_cap) {
+  u32 grown = cap + cap / 4;
+  grown = grown > min_cap ? grown : min_cap;
+  u64 bytes = mem_align_forward(grown * sizeof(void*), DArrayGrowthPage);
+  return bytes / sizeof(void*);
+}
+
+static void __C_DArray_reserve(C_DArray* self, u32 cap) {
+  if (cap > self->cap) {
+    C_DArray_resize(self, self->growth(self->cap, cap));
+  }
+}
+
 C_DArray* C_DArray_new(void) { return C_DArray_new_cap(1); }
 
 C_DArray* C_DArray_new_cap(u32 cap) {
   if (!Interface_initialized((Interface*)&C_DArray_i_formattable)) {
-    C_DArray_i_formattable = IFormattable_construct_format(
-      C_DArray_to_str_R, C_DArray_to_str_format_R);
+    C_DArray_i_formattable = IFormattable_construct_write(C_DArray_write_to);
     C_DArray_i_hashable = IHashable_construct(C_DArray_equals, IHashable_hash);
 
     C_DArray_interfaces[0] = (Interface*)&C_DArray_i_formattable;
@@ -39,7 +71,9 @@ C_DArray* C_DArray_new_cap(u32 cap) {
 
   self->cap = cap;
   self->len = 0;
-  self->data = allocate(self->cap * sizeof(void*));
+  self->data = cap <= DArrayInlineCap ? self->inline_data
+                                      : allocate(self->cap * sizeof(void*));
+  self->growth = DArrayGrowth_double;
 
   return self;
 }
@@ -47,7 +81,9 @@ C_DArray* C_DArray_new_cap(u32 cap) {
 void C_DArray_destroy(void* self) {
   C_DArray* self_cast = self;
   C_DArrayForeach(self_cast, { Unref(value); });
-  deallocate(self_cast->data);
+  if (self_cast->data != self_cast->inline_data) {
+    deallocate(self_cast->data);
+  }
 }
 
 C_Array* C_DArray_to_array_PR(C_DArray* self) {
@@ -61,9 +97,7 @@ C_Array* C_DArray_to_array_PR(C_DArray* self) {
 void C_DArray_push_P(C_DArray* self, void* value) {
   Ref(self);
 
-  if (self->len + 1 > self->cap) {
-    C_DArray_resize(self, self->cap * 2);
-  }
+  __C_DArray_reserve(self, self->len + 1);
 
   self->data[self->len] = Ref(value);
   self->len++;
@@ -71,11 +105,36 @@ void C_DArray_push_P(C_DArray* self, void* value) {
   Unref(self);
 }
 
-void C_DArray_push_front_P(C_DArray* self, void* value) {
+void C_DArray_push_many_P(C_DArray* self, void** values, u32 len) {
   Ref(self);
-  if (self->len + 1 > self->cap) {
-    C_DArray_resize(self, self->cap * 2);
+
+  // values may be the darray's own data, which the reserve can move
+  u64 offset = (u64)values - (u64)self->data;
+  bool own = offset < (u64)self->len * sizeof(void*);
+  __C_DArray_reserve(self, self->len + len);
+  if (own) {
+    values = (void**)((u64)self->data + offset);
+  }
+
+  void** dest = self->data + self->len;
+  mem_copy(dest, values, len * sizeof(void*));
+  for (u32 i = 0; i < len; i++) {
+    Ref(dest[i]);
   }
+  self->len += len;
+
+  Unref(self);
+}
+
+void C_DArray_push_array_P(C_DArray* self, C_Array* array) {
+  Ref(array);
+  C_DArray_push_many_P(self, C_Array_get_data(array), C_Array_get_len(array));
+  Unref(array);
+}
+
+void C_DArray_push_front_P(C_DArray* self, void* value) {
+  Ref(self);
+  __C_DArray_reserve(self, self->len + 1);
 
   mem_copy(self->data + 1, self->data, self->len * sizeof(void*));
   self->data[0] = Ref(value);
@@ -140,9 +199,7 @@ void C_DArray_add_P(C_DArray* self, u32 index, void* value) {
 
   Ref(self);
 
-  if (self->len + 1 > self->cap) {
-    C_DArray_resize(self, self->cap * 2);
-  }
+  __C_DArray_reserve(self, self->len + 1);
 
   mem_copy(self->data + index + 1, self->data + index,
     (self->len - index) * sizeof(void*));
@@ -168,10 +225,6 @@ void* C_DArray_remove_R(C_DArray* self, u32 index) {
       SV("C_DArray_remove_R -> index is outside of the darray")));
   }
 
-  if (self->len + 1 < self->cap) {
-    C_DArray_resize(self, self->cap * 2);
-  }
-
   void* result = self->data[index];
   mem_copy(self->data + index, self->data + index + 1,
     (self->len - index - 1) * sizeof(void*));
@@ -191,10 +244,26 @@ void C_DArray_resize(C_DArray* self, u32 cap) {
       SV("C_DArray_resize -> capacity must be at least one")));
   }
 
-  self->data = reallocate(self->data, cap * sizeof(void*));
+  bool is_inline = self->data == self->inline_data;
+  if (cap <= DArrayInlineCap) {
+    if (!is_inline) {
+      mem_copy(self->inline_data, self->data, self->len * sizeof(void*));
+      deallocate(self->data);
+      self->data = self->inline_data;
+    }
+  } else if (is_inline) {
+    self->data = allocate(cap * sizeof(void*));
+    mem_copy(self->data, self->inline_data, self->len * sizeof(void*));
+  } else {
+    self->data = reallocate(self->data, cap * sizeof(void*));
+  }
   self->cap = cap;
 }
 
+void C_DArray_reserve(C_DArray* self, u32 cap) {
+  __C_DArray_reserve(self, cap);
+}
+
 void C_DArray_compress(C_DArray* self) { C_DArray_resize(self, self->len); }
 
 void C_DArray_clear(C_DArray* self) {
@@ -204,6 +273,81 @@ void C_DArray_clear(C_DArray* self) {
   C_DArray_resize(self, 1);
 }
 
+void C_DArray_sort(C_DArray* self) {
+  sort_pdq_comparable(self->data, self->len);
+}
+
+void C_DArray_sort_by(C_DArray* self, CompareFunc compare) {
+  sort_pdq(self->data, self->len, compare);
+}
+
+void C_DArray_sort_parallel(C_DArray* self, u32 threads) {
+  sort_pdq_comparable_parallel(self->data, self->len, threads);
+}
+
+void C_DArray_sort_by_parallel(
+  C_DArray* self, CompareFunc compare, u32 threads) {
+  sort_pdq_parallel(self->data, self->len, compare, threads);
+}
+
+u32 C_DArray_lower_bound(C_DArray* self, void* value, CompareFunc compare) {
+  return sorted_lower_bound(self->data, self->len, value, compare);
+}
+
+u32 C_DArray_upper_bound(C_DArray* self, void* value, CompareFunc compare) {
+  return sorted_upper_bound(self->data, self->len, value, compare);
+}
+
+SortedRange C_DArray_equal_range(
+  C_DArray* self, void* value, CompareFunc compare) {
+  return sorted_equal_range(self->data, self->len, value, compare);
+}
+
+u32 C_DArray_insert_sorted_P(C_DArray* self, void* value, CompareFunc compare) {
+  u32 index = sorted_upper_bound(self->data, self->len, value, compare);
+  C_DArray_add_P(self, index, value);
+  return index;
+}
+
+/* the set operations write straight into the data of the result,
+ * which is sized for the largest possible output */
+static C_DArray* __C_DArray_new_result(u64 cap) {
+  if (cap > u32_MAX) {
+    crash(E(EG_Datastructures, E_OutOfBounds,
+      SV("__C_DArray_new_result -> result would be longer than u32_MAX")));
+  }
+  return C_DArray_new_cap(cap == 0 ? 1 : (u32)cap);
+}
+
+static void __C_DArray_ref_all(C_DArray* self) {
+  C_DArrayForeach(self, { Ref(value); });
+}
+
+C_DArray* C_DArray_union_R(C_DArray* a, C_DArray* b, CompareFunc compare) {
+  C_DArray* result = __C_DArray_new_result((u64)a->len + b->len);
+  result->len =
+    sorted_union(a->data, a->len, b->data, b->len, result->data, compare);
+  __C_DArray_ref_all(result);
+  return result;
+}
+
+C_DArray* C_DArray_intersection_R(
+  C_DArray* a, C_DArray* b, CompareFunc compare) {
+  C_DArray* result = __C_DArray_new_result(a->len < b->len ? a->len : b->len);
+  result->len = sorted_intersection(
+    a->data, a->len, b->data, b->len, result->data, compare);
+  __C_DArray_ref_all(result);
+  return result;
+}
+
+C_DArray* C_DArray_difference_R(C_DArray* a, C_DArray* b, CompareFunc compare) {
+  C_DArray* result = __C_DArray_new_result(a->len);
+  result->len =
+    sorted_difference(a->data, a->len, b->data, b->len, result->data, compare);
+  __C_DArray_ref_all(result);
+  return result;
+}
+
 u32 C_DArray_hash(void* self) {
   u32 hash_code = 0;
   C_DArrayForeach(
@@ -227,45 +371,38 @@ bool C_DArray_equals(void* a, void* b) {
   return true;
 }
 
-C_String* C_DArray_to_str_format_R(void* self, C_String* format) {
-  C_String* start = format_get_value_PR(format, PS("start"));
-  C_String* end = format_get_value_PR(format, PS("end"));
-  C_String* sep = format_get_value_PR(format, PS("sep"));
-
-  C_List* list = C_List_new();
-  C_List_push_P(list, start);
+void C_DArray_write_to(void* self, C_StringBuilder* sink, C_Format* format) {
+  format = format ? format : C_FormatList;
+  StringView start = C_Format_get(format, FormatStart);
+  StringView end = C_Format_get(format, FormatEnd);
+  StringView sep = C_Format_get(format, FormatSep);
 
+  C_StringBuilder_append_view(sink, start);
   C_DArrayForeach(self, {
-    C_List_push_P(list, Pass(IFormattable_to_str_PR(value)));
-    C_List_push_P(list, sep);
+    if (iter != 0) {
+      C_StringBuilder_append_view(sink, sep);
+    }
+    C_StringBuilder_append_str_P(sink, value);
   });
-
-  if (C_DArray_get_len(self) != 0) {
-    Unref(C_List_pop_R(list));
-  }
-
-  C_List_push_P(list, end);
-
-  C_String* result = C_String_join_PR(Pass(C_List_to_array_PR(Pass(list))));
-
-  Unref(start);
-  Unref(end);
-  Unref(sep);
-
-  return result;
+  C_StringBuilder_append_view(sink, end);
 }
 
-C_String* C_DArray_to_str_R(void* self) {
-  C_String* format = S("start=[;end=];sep=, ");
-  C_String* result = C_DArray_to_str_format_R(self, format);
-  Unref(format);
-  return result;
+C_String* C_DArray_to_str_format_R(void* self, C_String* format) {
+  return IFormattable_to_str_format_PR(self, format);
 }
 
+C_String* C_DArray_to_str_R(void* self) { return IFormattable_to_str_PR(self); }
+
 u32 C_DArray_get_cap(C_DArray* self) { return self->cap; }
 
 u32 C_DArray_get_len(C_DArray* self) { return self->len; }
 
+void** C_DArray_get_data(C_DArray* self) { return self->data; }
+
+void C_DArray_set_growth(C_DArray* self, DArrayGrowth growth) {
+  self->growth = growth;
+}
+
 // {{{ _R _B wrappers
 void* C_DArray_peek_R(C_DArray* self) {
   void* result = __C_DArray_peek(self);
@@ -0,0 +1,286 @@
+#include <c_base/base/errors/errors.h>
+#include <c_base/base/memory/allocator.h>
+#include <c_base/base/memory/memory.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/base/strings/C_StringBuilder.h>
+#include <c_base/base/strings/format.h>
+#include <c_base/base/strings/strings.h>
+#include <c_base/ds/C_Deque.h>
+#include <c_base/ds/C_List.h>
+#include <c_base/system.h>
+
+#define DequeMinCap 8
+
+static Interface* C_Deque_interfaces[3];
+static IFormattable C_Deque_i_formattable = {0};
+static IHashable C_Deque_i_hashable = {0};
+
+/* circular buffer, the values are at data[(head + i) & (cap - 1)].
+ * cap is always a power of two so wrapping is a mask instead of a modulo */
+struct C_Deque {
+  ClassObject base;
+
+  void** data;
+  u32 head;
+  u32 len;
+  u32 cap;
+};
+
+static u32 __C_Deque_slot(C_Deque* self, u32 index) {
+  return (self->head + index) & (self->cap - 1);
+}
+
+/* doubles the buffer and moves the values so they start at 0 again.
+ * 2^31 is the largest power of two in a u32, it can not double */
+static void __C_Deque_grow(C_Deque* self) {
+  if (self->cap >= 1u << 31) {
+    crash(E(EG_Datastructures, E_OutOfBounds,
+      SV("__C_Deque_grow -> a deque holds at most 2^31 values")));
+  }
+
+  u32 cap = self->cap * 2;
+  void** data = allocate(cap * sizeof(void*));
+
+  u32 first = self->cap - self->head;
+  if (first > self->len) {
+    first = self->len;
+  }
+  mem_copy(data, self->data + self->head, first * sizeof(void*));
+  mem_copy(data + first, self->data, (self->len - first) * sizeof(void*));
+
+  deallocate(self->data);
+  self->data = data;
+  self->head = 0;
+  self->cap = cap;
+}
+
+/******************************
+ * new/dest
+ ******************************/
+C_Deque* C_Deque_new(void) { return C_Deque_new_cap(DequeMinCap); }
+
+C_Deque* C_Deque_new_cap(u32 cap) {
+  // a larger cap would round up past 2^31, which grow does not go beyond
+  if (cap > (1u << 31)) {
+    crash(E(EG_Datastructures, E_InvalidArgument,
+      SV("C_Deque_new_cap -> cap has to be at most 2^31")));
+  }
+
+  if (!Interface_initialized((Interface*)&C_Deque_i_formattable)) {
+    C_Deque_i_formattable = IFormattable_construct_write(C_Deque_write_to);
+    C_Deque_i_hashable = IHashable_construct(C_Deque_equals, C_Deque_hash);
+
+    C_Deque_interfaces[0] = (Interface*)&C_Deque_i_formattable;
+    C_Deque_interfaces[1] = (Interface*)&C_Deque_i_hashable;
+    C_Deque_interfaces[2] = null;
+  }
+
+  C_Deque* self = allocate(sizeof(C_Deque));
+  self->base = ClassObject_construct(C_Deque_destroy, C_Deque_interfaces);
+
+  self->cap = DequeMinCap;
+  while (self->cap < cap) {
+    self->cap *= 2;
+  }
+  self->head = 0;
+  self->len = 0;
+  self->data = allocate(self->cap * sizeof(void*));
+
+  return self;
+}
+
+void C_Deque_destroy(void* self) {
+  C_Deque* self_cast = self;
+  C_DequeForeach(self_cast, { Unref(value); });
+  deallocate(self_cast->data);
+}
+
+/******************************
+ * logic
+ ******************************/
+C_Array* C_Deque_to_array_PR(C_Deque* self) {
+  Ref(self);
+  C_Array* array = C_Array_new(self->len);
+  C_DequeForeach(self, { C_Array_put_P(array, iter, value); });
+  Unref(self);
+  return array;
+}
+
+void C_Deque_push_P(C_Deque* self, void* value) {
+  if (self->len == self->cap) {
+    __C_Deque_grow(self);
+  }
+
+  self->data[__C_Deque_slot(self, self->len)] = Ref(value);
+  self->len++;
+}
+
+void C_Deque_push_front_P(C_Deque* self, void* value) {
+  if (self->len == self->cap) {
+    __C_Deque_grow(self);
+  }
+
+  self->head = (self->head - 1) & (self->cap - 1);
+  self->data[self->head] = Ref(value);
+  self->len++;
+}
+
+void* C_Deque_pop_R(C_Deque* self) {
+  if (self->len == 0) {
+    crash(E(EG_Datastructures, E_OutOfBounds,
+      SV("C_Deque_pop_R -> deque is empty")));
+  }
+
+  u32 slot = __C_Deque_slot(self, self->len - 1);
+  void* value = self->data[slot];
+  self->data[slot] = null;
+  self->len--;
+  return value;
+}
+
+void* C_Deque_pop_front_R(C_Deque* self) {
+  if (self->len == 0) {
+    crash(E(EG_Datastructures, E_OutOfBounds,
+      SV("C_Deque_pop_front_R -> deque is empty")));
+  }
+
+  void* value = self->data[self->head];
+  self->data[self->head] = null;
+  self->head = (self->head + 1) & (self->cap - 1);
+  self->len--;
+  return value;
+}
+
+static void* __C_Deque_peek(C_Deque* self) {
+  if (self->len == 0) {
+    crash(E(EG_Datastructures, E_OutOfBounds,
+      SV("__C_Deque_peek -> deque is empty")));
+  }
+
+  return Ref(self->data[__C_Deque_slot(self, self->len - 1)]);
+}
+
+static void* __C_Deque_peek_front(C_Deque* self) {
+  if (self->len == 0) {
+    crash(E(EG_Datastructures, E_OutOfBounds,
+      SV("__C_Deque_peek_front -> deque is empty")));
+  }
+
+  return Ref(self->data[self->head]);
+}
+
+static void* __C_Deque_at(C_Deque* self, u32 index) {
+  if (index >= self->len) {
+    crash(E(EG_Datastructures, E_OutOfBounds,
+      SV("__C_Deque_at -> index is outside of the deque")));
+  }
+
+  return Ref(self->data[__C_Deque_slot(self, index)]);
+}
+
+void C_Deque_put_P(C_Deque* self, u32 index, void* value) {
+  if (index >= self->len) {
+    crash(E(EG_Datastructures, E_OutOfBounds,
+      SV("C_Deque_put_P -> index is outside of the deque")));
+  }
+
+  u32 slot = __C_Deque_slot(self, index);
+  Ref(value);
+  Unref(self->data[slot]);
+  self->data[slot] = value;
+}
+
+void C_Deque_clear(C_Deque* self) {
+  C_DequeForeach(self, { Unref(value); });
+
+  self->head = 0;
+  self->len = 0;
+}
+
+u32 C_Deque_hash(void* self) {
+  u32 hash_code = 0;
+  C_DequeForeach(
+    self, { hash_code = 31 * hash_code + IHashable_hash(value); });
+  return hash_code;
+}
+
+bool C_Deque_equals(void* a, void* b) {
+  C_Deque* a_cast = a;
+  C_Deque* b_cast = b;
+
+  if (a_cast->len != b_cast->len) {
+    return false;
+  }
+
+  C_DequeForeach(a_cast, {
+    if (!IHashable_equals(C_Deque_at_B(b_cast, iter), value)) {
+      return false;
+    }
+  });
+  return true;
+}
+
+void C_Deque_write_to(void* self, C_StringBuilder* sink, C_Format* format) {
+  format = format ? format : C_FormatList;
+  StringView start = C_Format_get(format, FormatStart);
+  StringView end = C_Format_get(format, FormatEnd);
+  StringView sep = C_Format_get(format, FormatSep);
+
+  C_StringBuilder_append_view(sink, start);
+  C_DequeForeach(self, {
+    if (iter != 0) {
+      C_StringBuilder_append_view(sink, sep);
+    }
+    C_StringBuilder_append_str_P(sink, value);
+  });
+  C_StringBuilder_append_view(sink, end);
+}
+
+C_String* C_Deque_to_str_format_R(void* self, C_String* format) {
+  return IFormattable_to_str_format_PR(self, format);
+}
+
+C_String* C_Deque_to_str_R(void* self) { return IFormattable_to_str_PR(self); }
+
+/******************************
+ * get/set
+ ******************************/
+u32 C_Deque_get_len(C_Deque* self) { return self->len; }
+
+u32 C_Deque_get_cap(C_Deque* self) { return self->cap; }
+
+// {{{ _R _B wrappers
+void* C_Deque_peek_B(C_Deque* self) {
+  void* result = __C_Deque_peek(self);
+  Unref(result);
+  return result;
+}
+
+void* C_Deque_peek_R(C_Deque* self) {
+  void* result = __C_Deque_peek(self);
+  return result;
+}
+
+void* C_Deque_peek_front_B(C_Deque* self) {
+  void* result = __C_Deque_peek_front(self);
+  Unref(result);
+  return result;
+}
+
+void* C_Deque_peek_front_R(C_Deque* self) {
+  void* result = __C_Deque_peek_front(self);
+  return result;
+}
+
+void* C_Deque_at_B(C_Deque* self, u32 index) {
+  void* result = __C_Deque_at(self, index);
+  Unref(result);
+  return result;
+}
+
+void* C_Deque_at_R(C_Deque* self, u32 index) {
+  void* result = __C_Deque_at(self, index);
+  return result;
+}
+
+// }}}
@@ -1,4 +1,5 @@
 #include "c_base/base/memory/handles.h"
+#include "c_base/base/strings/C_StringBuilder.h"
 #include "c_base/base/strings/format.h"
 #include "c_base/base/strings/strings.h"
 #include <c_base/base/errors/errors.h>
@@ -72,8 +73,8 @@ C_HashTable* C_HashTable_new(void) {
 
 C_HashTable* C_HashTable_new_cap(u32 cap) {
   if (!Interface_initialized((Interface*)&C_HashTable_i_formattable)) {
-    C_HashTable_i_formattable = IFormattable_construct_format(
-      C_HashTable_to_str_R, C_HashTable_to_str_format_R);
+    C_HashTable_i_formattable =
+      IFormattable_construct_write(C_HashTable_write_to);
     C_HashTable_i_hashable =
       IHashable_construct(C_HashTable_equals, C_HashTable_hash);
 
@@ -191,14 +192,16 @@ void* C_HashTable_remove_PR(C_HashTable* self, void* key) {
       SV("C_HashTable_remove_R -> key is not in the hash table")));
   }
 
-  C_ListForeach(list, {
-    C_KeyValue* key_value = value;
+  ListCursor cursor = ListCursor_construct(list);
+  while (ListCursor_valid(&cursor)) {
+    C_KeyValue* key_value = ListCursor_get_B(&cursor);
     if (IHashable_equals(key_value->key, key)) {
       result = Ref(key_value->value);
-      Unref(C_List_remove_R(list, iter));
+      Unref(C_List_remove_cursor_R(list, &cursor));
       goto ret;
     }
-  });
+    ListCursor_next(&cursor);
+  }
 
   if (result == null) {
     crash(E(EG_Datastructures, E_InvalidPointer,
@@ -237,17 +240,18 @@ bool C_HashTable_equals(void* a, void* b) {
   return true;
 }
 
-C_String* C_HashTable_to_str_format_R(void* self, C_String* format) {
+void C_HashTable_write_to(
+  void* self, C_StringBuilder* sink, C_Format* format) {
   C_HashTable* self_cast = self;
 
-  C_String* start = format_get_value_PR(format, PS("start"));
-  C_String* sep = format_get_value_PR(format, PS("sep"));
-  C_String* el_sep = format_get_value_PR(format, PS("el_sep"));
-  C_String* end = format_get_value_PR(format, PS("end"));
-
-  C_List* list = C_List_new();
-  C_List_push_P(list, start);
+  format = format ? format : C_FormatMap;
+  StringView start = C_Format_get(format, FormatStart);
+  StringView sep = C_Format_get(format, FormatSep);
+  StringView el_sep = C_Format_get(format, FormatElSep);
+  StringView end = C_Format_get(format, FormatEnd);
 
+  C_StringBuilder_append_view(sink, start);
+  bool first = true;
   C_ArrayForeach(self_cast->data, {
     C_List* l = value;
 
@@ -258,33 +262,24 @@ C_String* C_HashTable_to_str_format_R(void* self, C_String* format) {
     C_ListForeach(l, {
       C_KeyValue* kvp = value;
 
-      C_List_push_P(list, Pass(IFormattable_to_str_PR(kvp->key)));
-      C_List_push_P(list, el_sep);
-      C_List_push_P(list, Pass(IFormattable_to_str_PR(kvp->value)));
-      C_List_push_P(list, sep);
+      if (!first) {
+        C_StringBuilder_append_view(sink, sep);
+      }
+      first = false;
+      C_StringBuilder_append_str_P(sink, kvp->key);
+      C_StringBuilder_append_view(sink, el_sep);
+      C_StringBuilder_append_str_P(sink, kvp->value);
     });
   });
+  C_StringBuilder_append_view(sink, end);
+}
 
-  if (C_List_get_len(list) != 1) {
-    Unref(C_List_pop_R(list));
-  }
-
-  C_List_push_P(list, end);
-
-  C_String* result = C_String_join_PR(Pass(C_List_to_array_PR(Pass(list))));
-  Unref(start);
-  Unref(sep);
-  Unref(el_sep);
-  Unref(end);
-
-  return result;
+C_String* C_HashTable_to_str_format_R(void* self, C_String* format) {
+  return IFormattable_to_str_format_PR(self, format);
 }
 
 C_String* C_HashTable_to_str_R(void* self) {
-  C_String* format = S("start=[;end=];sep=, ;el_sep= : ");
-  C_String* result = C_HashTable_to_str_format_R(self, format);
-  Unref(format);
-  return result;
+  return IFormattable_to_str_PR(self);
 }
 
 // {{{ _R _B wrappers
@@ -1,6 +1,7 @@
 #include <c_base/base/errors/errors.h>
 #include <c_base/base/memory/allocator.h>
 #include <c_base/base/memory/objects.h>
+#include <c_base/base/strings/C_StringBuilder.h>
 #include <c_base/base/strings/format.h>
 #include <c_base/base/strings/strings.h>
 #include <c_base/ds/C_Array.h>
@@ -15,16 +16,105 @@ struct C_List {
   Node* head;
   Node* tail;
   u32 len;
+
+  // released nodes kept for reuse, linked through next
+  Node* spare;
+  u32 spare_len;
+  u32 spare_cap;
+  ListStats stats;
 };
 
+/******************************
+ * ListCursor
+ ******************************/
+ListCursor ListCursor_construct(C_List* list) {
+  ListCursor self;
+  self.prev = null;
+  self.node = list->head;
+  return self;
+}
+
+bool ListCursor_valid(ListCursor* self) { return self->node != null; }
+
+void ListCursor_next(ListCursor* self) {
+  if (self->node == null) {
+    crash(E(EG_Datastructures, E_OutOfBounds,
+      SV("ListCursor_next -> cursor is past the end of the list")));
+  }
+
+  self->prev = self->node;
+  self->node = self->node->next;
+}
+
+static void* __ListCursor_get(ListCursor* self) {
+  if (self->node == null) {
+    crash(E(EG_Datastructures, E_OutOfBounds,
+      SV("__ListCursor_get -> cursor is past the end of the list")));
+  }
+
+  return Ref(self->node->value);
+}
+
+/******************************
+ * ListStats
+ ******************************/
+f64 ListStats_hit_rate(ListStats* self) {
+  u64 total = self->node_hits + self->node_misses;
+  if (total == 0) {
+    return 0;
+  }
+
+  return (f64)self->node_hits / (f64)total;
+}
+
+/******************************
+ * nodes
+ ******************************/
+static Node* __C_List_node_new(C_List* self, void* value) {
+  Node* node;
+
+  if (self->spare != null) {
+    node = self->spare;
+    self->spare = node->next;
+    self->spare_len--;
+    self->stats.node_hits++;
+  } else {
+    node = allocate(sizeof(Node));
+    self->stats.node_misses++;
+  }
+
+  node->value = value;
+  node->next = null;
+  return node;
+}
+
+static void __C_List_node_release(C_List* self, Node* node) {
+  if (self->spare_len >= self->spare_cap) {
+    deallocate(node);
+    return;
+  }
+
+  node->next = self->spare;
+  self->spare = node;
+  self->spare_len++;
+}
+
+static void __C_List_trim_spare(C_List* self, u32 cap) {
+  while (self->spare_len > cap) {
+    Node* node = self->spare;
+    self->spare = node->next;
+    self->spare_len--;
+    deallocate(node);
+  }
+}
+
 /******************************
  * new/dest
  ******************************/
 C_List* C_List_new(void) {
   if (!Interface_initialized((Interface*)&C_List_i_hashable)) {
     C_List_i_hashable = IHashable_construct(C_List_equals, C_List_hash);
-    C_List_i_formattable =
-      IFormattable_construct_format(C_List_to_str_R, C_List_to_str_format_R);
+    C_List_i_formattable = IFormattable_construct_write(C_List_write_to);
 
     C_List_interfaces[0] = (Interface*)&C_List_i_hashable;
     C_List_interfaces[1] = (Interface*)&C_List_i_formattable;
@@ -38,6 +128,11 @@ C_List* C_List_new(void) {
   self->head = null;
   self->tail = null;
 
+  self->spare = null;
+  self->spare_len = 0;
+  self->spare_cap = ListNodeCacheCap;
+  self->stats = (ListStats){0};
+
   return self;
 }
 
@@ -53,6 +148,8 @@ void C_List_destroy(void* self) {
     Unref(remove_node->value);
     deallocate(remove_node);
   }
+
+  __C_List_trim_spare(self_cast, 0);
 }
 
 /******************************
@@ -61,8 +158,7 @@ void C_List_destroy(void* self) {
 C_Array* C_List_to_array_PR(C_List* self) {
   Ref(self);
   C_Array* array = C_Array_new(self->len);
-  C_ArrayForeach(
-    array, { C_Array_put_P(array, iter, C_List_at_B(self, iter)); });
+  C_ListForeach(self, { C_Array_put_P(array, iter, value); });
   Unref(self);
   return array;
 }
@@ -70,23 +166,14 @@ C_Array* C_List_to_array_PR(C_List* self) {
 void C_List_push_P(C_List* self, void* value) {
   Ref(value);
   Ref(self);
-  Node* new_node = allocate(sizeof(Node));
-  new_node->value = value;
-  new_node->next = null;
+  Node* new_node = __C_List_node_new(self, value);
 
-  switch (self->len) {
-  case 0:
+  if (self->len == 0) {
     self->head = new_node;
-    break;
-  case 1:
-    self->tail = new_node;
-    self->head->next = self->tail;
-    break;
-  default:
+  } else {
     self->tail->next = new_node;
-    self->tail = new_node;
-    break;
   }
+  self->tail = new_node;
 
   self->len++;
   Unref(self);
@@ -95,12 +182,11 @@ void C_List_push_P(C_List* self, void* value) {
 void C_List_push_front_P(C_List* self, void* value) {
   Ref(value);
   Ref(self);
-  Node* new_node = allocate(sizeof(Node));
-  new_node->value = value;
+  Node* new_node = __C_List_node_new(self, value);
   new_node->next = self->head;
 
-  if (self->len == 1) {
-    self->tail = self->head;
+  if (self->len == 0) {
+    self->tail = new_node;
   }
 
   self->head = new_node;
@@ -121,6 +207,7 @@ void* C_List_pop_R(C_List* self) {
   case 1:
     pop_node = self->head;
     self->head = null;
+    self->tail = null;
     break;
   default: {
     pop_node = self->tail;
@@ -138,7 +225,7 @@ void* C_List_pop_R(C_List* self) {
   self->len--;
 
   void* value = pop_node->value;
-  deallocate(pop_node);
+  __C_List_node_release(self, pop_node);
 
   return value;
 }
@@ -151,11 +238,14 @@ void* C_List_pop_front_R(C_List* self) {
 
   Node* pop_node = self->head;
   self->head = self->head->next;
+  if (self->head == null) {
+    self->tail = null;
+  }
 
   void* value = pop_node->value;
 
   self->len--;
-  deallocate(pop_node);
+  __C_List_node_release(self, pop_node);
   return value;
 }
 
@@ -195,8 +285,7 @@ void C_List_add_P(C_List* self, u32 index, void* value) {
 
   Ref(value);
 
-  Node* new_node = allocate(sizeof(Node));
-  new_node->value = value;
+  Node* new_node = __C_List_node_new(self, value);
 
   Node* loop_node = self->head;
   for (u32 i = 0; i < index - 1; i++) {
@@ -261,16 +350,39 @@ void* C_List_remove_R(C_List* self, u32 index) {
     goto ret;
   }
 
-  Node* node = self->head;
-  for (u32 i = 0; i < index - 1; i++) {
-    node = node->next;
+  ListCursor cursor = ListCursor_construct(self);
+  for (u32 i = 0; i < index; i++) {
+    ListCursor_next(&cursor);
   }
-  result = node->next->value;
+  result = C_List_remove_cursor_R(self, &cursor);
 
-  node->next = node->next->next;
+ret:
+  return result;
+}
 
+void* C_List_remove_cursor_R(C_List* self, ListCursor* cursor) {
+  if (cursor->node == null) {
+    crash(E(EG_Datastructures, E_OutOfBounds,
+      SV("C_List_remove_cursor_R -> cursor is past the end of the list")));
+  }
+
+  Node* remove_node = cursor->node;
+
+  if (cursor->prev == null) {
+    self->head = remove_node->next;
+  } else {
+    cursor->prev->next = remove_node->next;
+  }
+
+  if (remove_node == self->tail) {
+    self->tail = cursor->prev;
+  }
+
+  cursor->node = remove_node->next;
   self->len--;
-ret:
+
+  void* result = remove_node->value;
+  __C_List_node_release(self, remove_node);
   return result;
 }
 
@@ -280,7 +392,7 @@ void C_List_clear(C_List* self) {
     Node* remove_node = node;
     node = node->next;
     Unref(remove_node->value);
-    deallocate(remove_node);
+    __C_List_node_release(self, remove_node);
   }
 
   self->len = 0;
@@ -288,6 +400,67 @@ void C_List_clear(C_List* self) {
   self->tail = null;
 }
 
+void C_List_sort(C_List* self) { C_List_sort_by(self, IComparable_compare); }
+
+// bottom up merge sort relinking the nodes, runs of width 1, 2, 4...
+// are merged in place so no extra memory is needed
+void C_List_sort_by(C_List* self, CompareFunc compare) {
+  if (self->len < 2) {
+    return;
+  }
+
+  Node* list = self->head;
+  Node* tail = null;
+  for (u32 width = 1; width < self->len; width *= 2) {
+    Node* a = list;
+    list = null;
+    tail = null;
+
+    while (a) {
+      Node* b = a;
+      u32 a_len = 0;
+      while (b && a_len < width) {
+        b = b->next;
+        a_len++;
+      }
+      u32 b_len = width;
+
+      while (a_len > 0 || (b_len > 0 && b)) {
+        Node* next;
+        // taking from a on equal values keeps the sort stable
+        if (a_len == 0) {
+          next = b;
+          b = b->next;
+          b_len--;
+        } else if (b_len == 0 || b == null ||
+                   compare(a->value, b->value) <= 0) {
+          next = a;
+          a = a->next;
+          a_len--;
+        } else {
+          next = b;
+          b = b->next;
+          b_len--;
+        }
+
+        if (tail) {
+          tail->next = next;
+        } else {
+          list = next;
+        }
+        tail = next;
+      }
+
+      a = b;
+    }
+
+    tail->next = null;
+  }
+
+  self->head = list;
+  self->tail = tail;
+}
+
 u32 C_List_hash(void* self) {
   u32 hash_code = 0;
   C_ListForeach(self, { hash_code = 31 * hash_code + IHashable_hash(value); });
@@ -301,52 +474,51 @@ bool C_List_equals(void* a, void* b) {
   if (a_cast->len != b_cast->len)
     return false;
 
+  ListCursor b_cursor = ListCursor_construct(b_cast);
   C_ListForeach(a_cast, {
-    if (!IHashable_equals(C_List_at_B(b_cast, iter), value)) {
+    if (!IHashable_equals(ListCursor_get_B(&b_cursor), value)) {
       return false;
     }
+    ListCursor_next(&b_cursor);
   });
 
   return true;
 }
 
-C_String* C_List_to_str_format_R(void* self, C_String* format) {
-  C_String* start = format_get_value_PR(format, PS("start"));
-  C_String* end = format_get_value_PR(format, PS("end"));
-  C_String* sepparator = format_get_value_PR(format, PS("sep"));
-
-  C_List* str_list = C_List_new();
-
-  C_List_push_P(str_list, start);
+void C_List_write_to(void* self, C_StringBuilder* sink, C_Format* format) {
+  format = format ? format : C_FormatList;
+  StringView start = C_Format_get(format, FormatStart);
+  StringView end = C_Format_get(format, FormatEnd);
+  StringView sep = C_Format_get(format, FormatSep);
 
+  C_StringBuilder_append_view(sink, start);
   C_ListForeach(self, {
-    C_List_push_P(str_list, Pass(IFormattable_to_str_PR(value)));
-    C_List_push_P(str_list, sepparator);
+    if (iter != 0) {
+      C_StringBuilder_append_view(sink, sep);
+    }
+    C_StringBuilder_append_str_P(sink, value);
   });
+  C_StringBuilder_append_view(sink, end);
+}
 
-  if (C_List_get_len(self) != 0) {
-    Unref(C_List_pop_R(str_list));
-  }
-  C_List_push_P(str_list, end);
-
-  C_String* result = C_String_join_PR(Pass(C_List_to_array_PR(str_list)));
+C_String* C_List_to_str_format_R(void* self, C_String* format) {
+  return IFormattable_to_str_format_PR(self, format);
+}
 
-  Unref(start);
-  Unref(end);
-  Unref(sepparator);
-  Unref(str_list);
+C_String* C_List_to_str_R(void* self) { return IFormattable_to_str_PR(self); }
 
+// {{{ _R _B wrappers
+void* ListCursor_get_B(ListCursor* self) {
+  void* result = __ListCursor_get(self);
+  Unref(result);
   return result;
 }
 
-C_String* C_List_to_str_R(void* self) {
-  C_String* format = S("start=[;end=];sep=, ");
-  C_String* result = C_List_to_str_format_R(self, format);
-  Unref(format);
+void* ListCursor_get_R(ListCursor* self) {
+  void* result = __ListCursor_get(self);
   return result;
 }
 
-// {{{ _R _B wrappers
 void* C_List_peek_B(C_List* self) {
   void* result = __C_List_peek(self);
   Unref(result);
@@ -386,3 +558,14 @@ void* C_List_at_R(C_List* self, u32 index) {
  * get/set
  ******************************/
 u32 C_List_get_len(C_List* self) { return self->len; }
+
+ListStats C_List_get_stats(C_List* self) {
+  ListStats stats = self->stats;
+  stats.spare_nodes = self->spare_len;
+  return stats;
+}
+
+void C_List_set_node_cache_cap(C_List* self, u32 cap) {
+  self->spare_cap = cap;
+  __C_List_trim_spare(self, cap);
+}
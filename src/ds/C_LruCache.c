@@ -0,0 +1,347 @@
+#include <c_base/base/errors/errors.h>
+#include <c_base/base/memory/allocator.h>
+#include <c_base/base/memory/memory.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_LruCache.h>
+#include <c_base/system.h>
+
+#define LruStartBuckets 16
+
+typedef struct LruEntry LruEntry;
+struct LruEntry {
+  void* key;
+  void* value;
+  u64 hash;
+  u64 cost;
+
+  // recency list, newer towards the newest entry
+  LruEntry* newer;
+  LruEntry* older;
+  // next entry of the same bucket, or of the spare list
+  LruEntry* chain;
+};
+
+struct C_LruCache {
+  ClassObject base;
+
+  LruEntry** buckets;
+  u64 bucket_mask;
+
+  LruEntry* newest;
+  LruEntry* oldest;
+  // released entries, reused by the next put, at most LruSpareCap
+  LruEntry* spare;
+  u32 spare_len;
+
+  u32 len;
+  u64 budget;
+  u64 used;
+
+  CacheCallbacks callbacks;
+  CacheStats stats;
+};
+
+/******************************
+ * CacheStats
+ ******************************/
+f64 CacheStats_hit_rate(CacheStats* self) {
+  u64 total = self->hits + self->misses;
+  if (total == 0) {
+    return 0;
+  }
+
+  return (f64)self->hits / (f64)total;
+}
+
+/******************************
+ * entries
+ ******************************/
+static u64 lru_hash(void* key) { return ds_hash_mix(IHashable_hash(key)); }
+
+static LruEntry** C_LruCache_find(C_LruCache* self, void* key, u64 hash) {
+  LruEntry** link = &self->buckets[hash & self->bucket_mask];
+  while (*link &&
+         ((*link)->hash != hash || !IHashable_equals((*link)->key, key))) {
+    link = &(*link)->chain;
+  }
+  return link;
+}
+
+// the link that points to entry, entry is in the index
+static LruEntry** C_LruCache_link_of(C_LruCache* self, LruEntry* entry) {
+  LruEntry** link = &self->buckets[entry->hash & self->bucket_mask];
+  while (*link != entry) {
+    link = &(*link)->chain;
+  }
+  return link;
+}
+
+static void C_LruCache_unlink(C_LruCache* self, LruEntry* entry) {
+  if (entry->newer) {
+    entry->newer->older = entry->older;
+  } else {
+    self->newest = entry->older;
+  }
+
+  if (entry->older) {
+    entry->older->newer = entry->newer;
+  } else {
+    self->oldest = entry->newer;
+  }
+}
+
+static void C_LruCache_push_newest(C_LruCache* self, LruEntry* entry) {
+  entry->newer = null;
+  entry->older = self->newest;
+  if (self->newest) {
+    self->newest->newer = entry;
+  } else {
+    self->oldest = entry;
+  }
+  self->newest = entry;
+}
+
+static void C_LruCache_grow(C_LruCache* self) {
+  u64 bucket_count = (self->bucket_mask + 1) * 2;
+  LruEntry** buckets = allocate(bucket_count * sizeof(LruEntry*));
+  mem_set(buckets, 0, bucket_count * sizeof(LruEntry*));
+
+  for (u64 i = 0; i <= self->bucket_mask; i++) {
+    LruEntry* entry = self->buckets[i];
+    while (entry) {
+      LruEntry* next = entry->chain;
+      LruEntry** bucket = &buckets[entry->hash & (bucket_count - 1)];
+      entry->chain = *bucket;
+      *bucket = entry;
+      entry = next;
+    }
+  }
+
+  deallocate(self->buckets);
+  self->buckets = buckets;
+  self->bucket_mask = bucket_count - 1;
+}
+
+// takes the entry out of the index and the list, the caller releases it
+static void C_LruCache_detach(
+  C_LruCache* self, LruEntry** link, LruEntry* entry) {
+  *link = entry->chain;
+  C_LruCache_unlink(self, entry);
+  self->len--;
+  self->used -= entry->cost;
+}
+
+static void C_LruCache_release(C_LruCache* self, LruEntry* entry) {
+  Unref(entry->key);
+  Unref(entry->value);
+  if (self->spare_len >= LruSpareCap) {
+    deallocate(entry);
+    return;
+  }
+
+  entry->chain = self->spare;
+  self->spare = entry;
+  self->spare_len++;
+}
+
+static void C_LruCache_evict_oldest(C_LruCache* self) {
+  LruEntry* entry = self->oldest;
+  C_LruCache_detach(self, C_LruCache_link_of(self, entry), entry);
+
+  if (self->callbacks.evict) {
+    self->callbacks.evict(entry->key, entry->value, self->callbacks.data);
+  }
+  self->stats.evictions++;
+  C_LruCache_release(self, entry);
+}
+
+static u64 C_LruCache_cost(C_LruCache* self, void* key, void* value) {
+  if (!self->callbacks.cost) {
+    return 1;
+  }
+  return self->callbacks.cost(key, value, self->callbacks.data);
+}
+
+/******************************
+ * new/dest
+ ******************************/
+C_LruCache* C_LruCache_new(u64 budget) {
+  if (budget == 0) {
+    crash(E(EG_Datastructures, E_InvalidArgument,
+      SV("C_LruCache_new -> budget is 0")));
+  }
+
+  C_LruCache* self = allocate(sizeof(C_LruCache));
+  self->base = ClassObject_construct(C_LruCache_destroy, null);
+
+  self->buckets = allocate(LruStartBuckets * sizeof(LruEntry*));
+  mem_set(self->buckets, 0, LruStartBuckets * sizeof(LruEntry*));
+  self->bucket_mask = LruStartBuckets - 1;
+
+  self->newest = null;
+  self->oldest = null;
+  self->spare = null;
+  self->spare_len = 0;
+
+  self->len = 0;
+  self->budget = budget;
+  self->used = 0;
+
+  self->callbacks = (CacheCallbacks){0};
+  self->stats = (CacheStats){0};
+
+  return self;
+}
+
+void C_LruCache_destroy(void* self) {
+  C_LruCache* self_cast = self;
+  C_LruCache_clear(self_cast);
+
+  while (self_cast->spare) {
+    LruEntry* next = self_cast->spare->chain;
+    deallocate(self_cast->spare);
+    self_cast->spare = next;
+  }
+  deallocate(self_cast->buckets);
+}
+
+/******************************
+ * logic
+ ******************************/
+void C_LruCache_put_P(C_LruCache* self, void* key, void* value) {
+  Ref(key);
+  Ref(value);
+
+  u64 hash = lru_hash(key);
+  LruEntry** link = C_LruCache_find(self, key, hash);
+  LruEntry* entry = *link;
+
+  if (entry) {
+    // the stored key stays, the new one is not needed
+    Unref(key);
+    Unref(entry->value);
+    entry->value = value;
+    self->used -= entry->cost;
+    C_LruCache_unlink(self, entry);
+  } else {
+    if (self->spare) {
+      entry = self->spare;
+      self->spare = entry->chain;
+      self->spare_len--;
+    } else {
+      entry = allocate(sizeof(LruEntry));
+    }
+    entry->key = key;
+    entry->value = value;
+    entry->hash = hash;
+    entry->chain = *link;
+    *link = entry;
+    self->len++;
+  }
+
+  entry->cost = C_LruCache_cost(self, entry->key, value);
+  self->used += entry->cost;
+  C_LruCache_push_newest(self, entry);
+
+  // an entry that costs more than the budget is evicted right away
+  while (self->used > self->budget) {
+    C_LruCache_evict_oldest(self);
+  }
+
+  if (self->len > self->bucket_mask + 1) {
+    C_LruCache_grow(self);
+  }
+}
+
+void* C_LruCache_get_PB(C_LruCache* self, void* key) {
+  Ref(key);
+  LruEntry* entry = *C_LruCache_find(self, key, lru_hash(key));
+  Unref(key);
+
+  if (!entry) {
+    self->stats.misses++;
+    return null;
+  }
+
+  self->stats.hits++;
+  if (entry != self->newest) {
+    C_LruCache_unlink(self, entry);
+    C_LruCache_push_newest(self, entry);
+  }
+  return entry->value;
+}
+
+void* C_LruCache_get_or_load_PR(C_LruCache* self, void* key) {
+  Ref(key);
+  void* value = C_LruCache_get_PR(self, key);
+  if (value || !self->callbacks.load) {
+    Unref(key);
+    return value;
+  }
+
+  value = self->callbacks.load(key, self->callbacks.data);
+  if (value) {
+    C_LruCache_put_P(self, key, value);
+  }
+  Unref(key);
+  return value;
+}
+
+bool C_LruCache_contains_P(C_LruCache* self, void* key) {
+  Ref(key);
+  bool result = *C_LruCache_find(self, key, lru_hash(key)) != null;
+  Unref(key);
+  return result;
+}
+
+void* C_LruCache_remove_PR(C_LruCache* self, void* key) {
+  Ref(key);
+  LruEntry** link = C_LruCache_find(self, key, lru_hash(key));
+  Unref(key);
+
+  LruEntry* entry = *link;
+  if (!entry) {
+    return null;
+  }
+
+  C_LruCache_detach(self, link, entry);
+  void* value = Ref(entry->value);
+  C_LruCache_release(self, entry);
+  return value;
+}
+
+void C_LruCache_clear(C_LruCache* self) {
+  LruEntry* entry = self->newest;
+  while (entry) {
+    LruEntry* older = entry->older;
+    C_LruCache_release(self, entry);
+    entry = older;
+  }
+
+  mem_set(self->buckets, 0, (self->bucket_mask + 1) * sizeof(LruEntry*));
+  self->newest = null;
+  self->oldest = null;
+  self->len = 0;
+  self->used = 0;
+}
+
+/******************************
+ * get/set
+ ******************************/
+u32 C_LruCache_get_len(C_LruCache* self) { return self->len; }
+
+u64 C_LruCache_get_used(C_LruCache* self) { return self->used; }
+
+u64 C_LruCache_get_budget(C_LruCache* self) { return self->budget; }
+
+CacheStats C_LruCache_get_stats(C_LruCache* self) { return self->stats; }
+
+void C_LruCache_set_callbacks(C_LruCache* self, CacheCallbacks callbacks) {
+  self->callbacks = callbacks;
+}
+
+// {{{ _R _B wrappers
+void* C_LruCache_get_PR(C_LruCache* self, void* key) {
+  return Ref(C_LruCache_get_PB(self, key));
+}
+// }}}
@@ -0,0 +1,135 @@
+#include <c_base/base/errors/errors.h>
+#include <c_base/base/memory/allocator.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_MpmcQueue.h>
+#include <c_base/os/os_atomic.h>
+#include <c_base/system.h>
+
+/* slot i starts with sequence i. the push at position pos waits for
+ * sequence pos and leaves pos + 1, the pop at pos waits for pos + 1 and
+ * leaves pos + cap, which is what the push one round later waits for */
+typedef struct {
+  u64 sequence;
+  void* value;
+} MpmcSlot;
+
+struct C_MpmcQueue {
+  ClassObject base;
+
+  MpmcSlot* slots;
+  u64 mask;
+
+  u8 pad0[OSCacheLineSize];
+
+  // next push position
+  u64 tail;
+
+  u8 pad1[OSCacheLineSize];
+
+  // next pop position
+  u64 head;
+
+  u8 pad2[OSCacheLineSize];
+};
+
+/******************************
+ * new/dest
+ ******************************/
+C_MpmcQueue* C_MpmcQueue_new(u32 cap) {
+  if (cap == 0 || cap > (1u << 31)) {
+    crash(E(EG_Datastructures, E_InvalidArgument,
+      SV("C_MpmcQueue_new -> cap has to be between 1 and 2^31")));
+  }
+
+  C_MpmcQueue* self = allocate(sizeof(C_MpmcQueue));
+  self->base = ClassObject_construct(C_MpmcQueue_destroy, null);
+
+  // with a single slot a filled and a free sequence would be the same
+  u64 slot_count = 2;
+  while (slot_count < cap) {
+    slot_count <<= 1;
+  }
+  self->slots = allocate(slot_count * sizeof(MpmcSlot));
+  for (u64 i = 0; i < slot_count; i++) {
+    self->slots[i].sequence = i;
+    self->slots[i].value = null;
+  }
+  self->mask = slot_count - 1;
+
+  self->tail = 0;
+  self->head = 0;
+
+  return self;
+}
+
+void C_MpmcQueue_destroy(void* self) {
+  C_MpmcQueue* self_cast = self;
+  deallocate(self_cast->slots);
+}
+
+/******************************
+ * logic
+ ******************************/
+bool C_MpmcQueue_push(C_MpmcQueue* self, void* value) {
+  u64 pos = os_atomic_u64_load_acquire(&self->tail);
+  MpmcSlot* slot;
+
+  while (true) {
+    slot = &self->slots[pos & self->mask];
+    s64 diff = (s64)(os_atomic_u64_load_acquire(&slot->sequence) - pos);
+
+    if (diff == 0) {
+      // the slot is free, claim the position. on failure pos is updated
+      if (os_atomic_u64_compare_exchange(&self->tail, &pos, pos + 1)) {
+        break;
+      }
+    } else if (diff < 0) {
+      // the pop of the last round has not freed the slot yet
+      return false;
+    } else {
+      // another push took pos
+      pos = os_atomic_u64_load_acquire(&self->tail);
+    }
+  }
+
+  slot->value = value;
+  os_atomic_u64_store_release(&slot->sequence, pos + 1);
+  return true;
+}
+
+bool C_MpmcQueue_pop(C_MpmcQueue* self, void** value) {
+  u64 pos = os_atomic_u64_load_acquire(&self->head);
+  MpmcSlot* slot;
+
+  while (true) {
+    slot = &self->slots[pos & self->mask];
+    s64 diff = (s64)(os_atomic_u64_load_acquire(&slot->sequence) - (pos + 1));
+
+    if (diff == 0) {
+      if (os_atomic_u64_compare_exchange(&self->head, &pos, pos + 1)) {
+        break;
+      }
+    } else if (diff < 0) {
+      // the push of this round has not filled the slot yet
+      return false;
+    } else {
+      pos = os_atomic_u64_load_acquire(&self->head);
+    }
+  }
+
+  *value = slot->value;
+  os_atomic_u64_store_release(&slot->sequence, pos + self->mask + 1);
+  return true;
+}
+
+/******************************
+ * get/set
+ ******************************/
+u32 C_MpmcQueue_get_len(C_MpmcQueue* self) {
+  // head first, a pop never claims a position the tail has not passed
+  u64 head = os_atomic_u64_load_acquire(&self->head);
+  u64 tail = os_atomic_u64_load_acquire(&self->tail);
+  return (u32)(tail - head);
+}
+
+u32 C_MpmcQueue_get_cap(C_MpmcQueue* self) { return (u32)(self->mask + 1); }
@@ -0,0 +1,622 @@
+#include <c_base/base/errors/errors.h>
+#include <c_base/base/memory/allocator.h>
+#include <c_base/base/memory/memory.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/base/strings/C_StringBuilder.h>
+#include <c_base/base/strings/format.h>
+#include <c_base/base/strings/strings.h>
+#include <c_base/ds/C_List.h>
+#include <c_base/ds/C_OrderedMap.h>
+#include <c_base/ds/ds_sorted.h>
+#include <c_base/system.h>
+
+// fewer keys or children than this and a node borrows from or merges with
+// a sibling, only the root may be smaller
+#define MapLeafMin (MapLeafCap / 2)
+#define MapBranchMin (MapBranchCap / 2)
+
+static Interface* C_OrderedMap_interfaces[3];
+static IFormattable C_OrderedMap_i_formattable = {0};
+static IHashable C_OrderedMap_i_hashable = {0};
+
+/* len is the number of keys of a leaf and the number of children of a
+ * branch, a branch has one key less than children */
+typedef struct {
+  u32 len;
+  bool leaf;
+} MapNode;
+
+/* the arrays have one extra slot, a full node takes the new entry first
+ * and then splits in half */
+struct MapLeaf {
+  MapNode node;
+  MapLeaf* next;
+  void* keys[MapLeafCap + 1];
+  void* values[MapLeafCap + 1];
+};
+
+/* the keys in children[i + 1] are not less than keys[i] and the keys in
+ * children[i] are less. the keys are referenced copies of leaf keys, they
+ * stay valid when the leaf key is removed */
+typedef struct {
+  MapNode node;
+  void* keys[MapBranchCap];
+  MapNode* children[MapBranchCap + 1];
+} MapBranch;
+
+struct C_OrderedMap {
+  ClassObject base;
+
+  MapNode* root;
+  u32 len;
+  u32 depth;
+  CompareFunc compare;
+};
+
+// a node that split, key moves up to the parent with its reference
+typedef struct {
+  void* key;
+  MapNode* right;
+} MapSplit;
+
+/******************************
+ * nodes
+ ******************************/
+static MapNode* MapLeaf_new(void) {
+  MapLeaf* self = allocate(sizeof(MapLeaf));
+  self->node.len = 0;
+  self->node.leaf = true;
+  self->next = null;
+  return &self->node;
+}
+
+static MapBranch* MapBranch_new(void) {
+  MapBranch* self = allocate(sizeof(MapBranch));
+  self->node.len = 0;
+  self->node.leaf = false;
+  return self;
+}
+
+static void MapNode_free(MapNode* node) {
+  if (node->leaf) {
+    MapLeaf* leaf = (MapLeaf*)node;
+    for (u32 i = 0; i < node->len; i++) {
+      Unref(leaf->keys[i]);
+      Unref(leaf->values[i]);
+    }
+  } else {
+    MapBranch* branch = (MapBranch*)node;
+    for (u32 i = 0; i < node->len; i++) {
+      if (i > 0) {
+        Unref(branch->keys[i - 1]);
+      }
+      MapNode_free(branch->children[i]);
+    }
+  }
+  deallocate(node);
+}
+
+static u32 MapBranch_child(MapBranch* self, void* key, CompareFunc compare) {
+  return sorted_upper_bound(self->keys, self->node.len - 1, key, compare);
+}
+
+static MapLeaf* __C_OrderedMap_find_leaf(C_OrderedMap* self, void* key) {
+  MapNode* node = self->root;
+  while (!node->leaf) {
+    MapBranch* branch = (MapBranch*)node;
+    node = branch->children[MapBranch_child(branch, key, self->compare)];
+  }
+  return (MapLeaf*)node;
+}
+
+/******************************
+ * MapCursor
+ ******************************/
+// only the root leaf can be empty, so at most one step is needed
+static void __MapCursor_skip_end(MapCursor* self) {
+  if (self->leaf != null && self->index >= self->leaf->node.len) {
+    self->leaf = self->leaf->next;
+    self->index = 0;
+  }
+}
+
+MapCursor MapCursor_construct(C_OrderedMap* map) {
+  MapNode* node = map->root;
+  while (!node->leaf) {
+    node = ((MapBranch*)node)->children[0];
+  }
+
+  MapCursor self;
+  self.leaf = (MapLeaf*)node;
+  self.index = 0;
+  __MapCursor_skip_end(&self);
+  return self;
+}
+
+bool MapCursor_valid(MapCursor* self) { return self->leaf != null; }
+
+void MapCursor_next(MapCursor* self) {
+  if (self->leaf == null) {
+    crash(E(EG_Datastructures, E_OutOfBounds,
+      SV("MapCursor_next -> cursor is past the end of the map")));
+  }
+
+  self->index++;
+  __MapCursor_skip_end(self);
+}
+
+void* MapCursor_get_key_B(MapCursor* self) {
+  if (self->leaf == null) {
+    crash(E(EG_Datastructures, E_OutOfBounds,
+      SV("MapCursor_get_key_B -> cursor is past the end of the map")));
+  }
+
+  return self->leaf->keys[self->index];
+}
+
+static void* __MapCursor_get_value(MapCursor* self) {
+  if (self->leaf == null) {
+    crash(E(EG_Datastructures, E_OutOfBounds,
+      SV("__MapCursor_get_value -> cursor is past the end of the map")));
+  }
+
+  return Ref(self->leaf->values[self->index]);
+}
+
+/******************************
+ * new/dest
+ ******************************/
+C_OrderedMap* C_OrderedMap_new(void) {
+  return C_OrderedMap_new_by(IComparable_compare);
+}
+
+C_OrderedMap* C_OrderedMap_new_by(CompareFunc compare) {
+  if (!Interface_initialized((Interface*)&C_OrderedMap_i_formattable)) {
+    C_OrderedMap_i_formattable =
+      IFormattable_construct_write(C_OrderedMap_write_to);
+    C_OrderedMap_i_hashable =
+      IHashable_construct(C_OrderedMap_equals, C_OrderedMap_hash);
+
+    C_OrderedMap_interfaces[0] = (Interface*)&C_OrderedMap_i_formattable;
+    C_OrderedMap_interfaces[1] = (Interface*)&C_OrderedMap_i_hashable;
+    C_OrderedMap_interfaces[2] = null;
+  }
+
+  C_OrderedMap* self = allocate(sizeof(C_OrderedMap));
+  self->base =
+    ClassObject_construct(C_OrderedMap_destroy, C_OrderedMap_interfaces);
+
+  self->root = MapLeaf_new();
+  self->len = 0;
+  self->depth = 0;
+  self->compare = compare;
+
+  return self;
+}
+
+void C_OrderedMap_destroy(void* self) {
+  C_OrderedMap* self_cast = self;
+  MapNode_free(self_cast->root);
+}
+
+/******************************
+ * insert
+ ******************************/
+static MapSplit __MapLeaf_insert(
+  C_OrderedMap* self, MapLeaf* leaf, void* key, void* value) {
+  MapSplit split = {null, null};
+
+  u32 len = leaf->node.len;
+  u32 pos = sorted_lower_bound(leaf->keys, len, key, self->compare);
+  if (pos < len && self->compare(leaf->keys[pos], key) == 0) {
+    crash(E(EG_Datastructures, E_InvalidPointer,
+      SV("C_OrderedMap_put_P -> key is already in the map")));
+  }
+
+  mem_copy(leaf->keys + pos + 1, leaf->keys + pos, (len - pos) * sizeof(void*));
+  mem_copy(
+    leaf->values + pos + 1, leaf->values + pos, (len - pos) * sizeof(void*));
+  leaf->keys[pos] = Ref(key);
+  leaf->values[pos] = Ref(value);
+  leaf->node.len++;
+
+  if (leaf->node.len > MapLeafCap) {
+    MapLeaf* right = (MapLeaf*)MapLeaf_new();
+    u32 half = leaf->node.len / 2;
+
+    right->node.len = leaf->node.len - half;
+    mem_copy(right->keys, leaf->keys + half, right->node.len * sizeof(void*));
+    mem_copy(
+      right->values, leaf->values + half, right->node.len * sizeof(void*));
+    leaf->node.len = half;
+
+    right->next = leaf->next;
+    leaf->next = right;
+
+    split.key = Ref(right->keys[0]);
+    split.right = &right->node;
+  }
+
+  return split;
+}
+
+static MapSplit __C_OrderedMap_insert(
+  C_OrderedMap* self, MapNode* node, void* key, void* value) {
+  if (node->leaf) {
+    return __MapLeaf_insert(self, (MapLeaf*)node, key, value);
+  }
+
+  MapSplit split = {null, null};
+  MapBranch* branch = (MapBranch*)node;
+  u32 index = MapBranch_child(branch, key, self->compare);
+
+  MapSplit child =
+    __C_OrderedMap_insert(self, branch->children[index], key, value);
+  if (child.right == null) {
+    return split;
+  }
+
+  u32 moved = branch->node.len - 1 - index;
+  mem_copy(branch->keys + index + 1, branch->keys + index,
+    moved * sizeof(void*));
+  mem_copy(branch->children + index + 2, branch->children + index + 1,
+    moved * sizeof(MapNode*));
+  branch->keys[index] = child.key;
+  branch->children[index + 1] = child.right;
+  branch->node.len++;
+
+  if (branch->node.len > MapBranchCap) {
+    MapBranch* right = MapBranch_new();
+    u32 half = branch->node.len / 2;
+
+    right->node.len = branch->node.len - half;
+    mem_copy(right->children, branch->children + half,
+      right->node.len * sizeof(MapNode*));
+    mem_copy(right->keys, branch->keys + half,
+      (right->node.len - 1) * sizeof(void*));
+    branch->node.len = half;
+
+    split.key = branch->keys[half - 1];
+    split.right = &right->node;
+  }
+
+  return split;
+}
+
+void C_OrderedMap_put_P(C_OrderedMap* self, void* key, void* value) {
+  Ref(key);
+  Ref(value);
+
+  MapSplit split = __C_OrderedMap_insert(self, self->root, key, value);
+  if (split.right != null) {
+    MapBranch* root = MapBranch_new();
+    root->node.len = 2;
+    root->keys[0] = split.key;
+    root->children[0] = self->root;
+    root->children[1] = split.right;
+
+    self->root = &root->node;
+    self->depth++;
+  }
+  self->len++;
+
+  Unref(key);
+  Unref(value);
+}
+
+/******************************
+ * remove
+ ******************************/
+// moves the last entry of children[index - 1] to the front of children[index]
+static void __MapBranch_borrow_left(MapBranch* self, u32 index) {
+  MapNode* left = self->children[index - 1];
+  MapNode* child = self->children[index];
+
+  if (child->leaf) {
+    MapLeaf* left_leaf = (MapLeaf*)left;
+    MapLeaf* child_leaf = (MapLeaf*)child;
+
+    mem_copy(
+      child_leaf->keys + 1, child_leaf->keys, child->len * sizeof(void*));
+    mem_copy(
+      child_leaf->values + 1, child_leaf->values, child->len * sizeof(void*));
+    child_leaf->keys[0] = left_leaf->keys[left->len - 1];
+    child_leaf->values[0] = left_leaf->values[left->len - 1];
+
+    Unref(self->keys[index - 1]);
+    self->keys[index - 1] = Ref(child_leaf->keys[0]);
+  } else {
+    MapBranch* left_branch = (MapBranch*)left;
+    MapBranch* child_branch = (MapBranch*)child;
+
+    mem_copy(child_branch->keys + 1, child_branch->keys,
+      (child->len - 1) * sizeof(void*));
+    mem_copy(child_branch->children + 1, child_branch->children,
+      child->len * sizeof(MapNode*));
+    child_branch->keys[0] = self->keys[index - 1];
+    child_branch->children[0] = left_branch->children[left->len - 1];
+
+    self->keys[index - 1] = left_branch->keys[left->len - 2];
+  }
+
+  left->len--;
+  child->len++;
+}
+
+// moves the first entry of children[index + 1] to the end of children[index]
+static void __MapBranch_borrow_right(MapBranch* self, u32 index) {
+  MapNode* child = self->children[index];
+  MapNode* right = self->children[index + 1];
+
+  if (child->leaf) {
+    MapLeaf* child_leaf = (MapLeaf*)child;
+    MapLeaf* right_leaf = (MapLeaf*)right;
+
+    child_leaf->keys[child->len] = right_leaf->keys[0];
+    child_leaf->values[child->len] = right_leaf->values[0];
+    mem_copy(
+      right_leaf->keys, right_leaf->keys + 1, (right->len - 1) * sizeof(void*));
+    mem_copy(right_leaf->values, right_leaf->values + 1,
+      (right->len - 1) * sizeof(void*));
+
+    Unref(self->keys[index]);
+    self->keys[index] = Ref(right_leaf->keys[0]);
+  } else {
+    MapBranch* child_branch = (MapBranch*)child;
+    MapBranch* right_branch = (MapBranch*)right;
+
+    child_branch->keys[child->len - 1] = self->keys[index];
+    child_branch->children[child->len] = right_branch->children[0];
+
+    self->keys[index] = right_branch->keys[0];
+    mem_copy(right_branch->keys, right_branch->keys + 1,
+      (right->len - 2) * sizeof(void*));
+    mem_copy(right_branch->children, right_branch->children + 1,
+      (right->len - 1) * sizeof(MapNode*));
+  }
+
+  child->len++;
+  right->len--;
+}
+
+// moves children[index + 1] into children[index] and frees it
+static void __MapBranch_merge(MapBranch* self, u32 index) {
+  MapNode* left = self->children[index];
+  MapNode* right = self->children[index + 1];
+
+  if (left->leaf) {
+    MapLeaf* left_leaf = (MapLeaf*)left;
+    MapLeaf* right_leaf = (MapLeaf*)right;
+
+    mem_copy(left_leaf->keys + left->len, right_leaf->keys,
+      right->len * sizeof(void*));
+    mem_copy(left_leaf->values + left->len, right_leaf->values,
+      right->len * sizeof(void*));
+    left_leaf->next = right_leaf->next;
+
+    Unref(self->keys[index]);
+  } else {
+    MapBranch* left_branch = (MapBranch*)left;
+    MapBranch* right_branch = (MapBranch*)right;
+
+    left_branch->keys[left->len - 1] = self->keys[index];
+    mem_copy(left_branch->keys + left->len, right_branch->keys,
+      (right->len - 1) * sizeof(void*));
+    mem_copy(left_branch->children + left->len, right_branch->children,
+      right->len * sizeof(MapNode*));
+  }
+
+  left->len += right->len;
+  deallocate(right);
+
+  u32 moved = self->node.len - 2 - index;
+  mem_copy(self->keys + index, self->keys + index + 1, moved * sizeof(void*));
+  mem_copy(self->children + index + 1, self->children + index + 2,
+    moved * sizeof(MapNode*));
+  self->node.len--;
+}
+
+static void __MapBranch_fix_child(MapBranch* self, u32 index) {
+  MapNode* child = self->children[index];
+  u32 min = child->leaf ? MapLeafMin : MapBranchMin;
+  if (child->len >= min) {
+    return;
+  }
+
+  MapNode* left = index > 0 ? self->children[index - 1] : null;
+  MapNode* right =
+    index + 1 < self->node.len ? self->children[index + 1] : null;
+
+  if (left != null && left->len > min) {
+    __MapBranch_borrow_left(self, index);
+  } else if (right != null && right->len > min) {
+    __MapBranch_borrow_right(self, index);
+  } else if (left != null) {
+    __MapBranch_merge(self, index - 1);
+  } else {
+    __MapBranch_merge(self, index);
+  }
+}
+
+static void* __C_OrderedMap_remove(
+  C_OrderedMap* self, MapNode* node, void* key) {
+  if (!node->leaf) {
+    MapBranch* branch = (MapBranch*)node;
+    u32 index = MapBranch_child(branch, key, self->compare);
+    void* value = __C_OrderedMap_remove(self, branch->children[index], key);
+    __MapBranch_fix_child(branch, index);
+    return value;
+  }
+
+  MapLeaf* leaf = (MapLeaf*)node;
+  u32 pos = sorted_lower_bound(leaf->keys, node->len, key, self->compare);
+  if (pos == node->len || self->compare(leaf->keys[pos], key) != 0) {
+    crash(E(EG_Datastructures, E_InvalidPointer,
+      SV("C_OrderedMap_remove_PR -> key is not in the map")));
+  }
+
+  void* value = leaf->values[pos];
+  Unref(leaf->keys[pos]);
+
+  u32 moved = node->len - 1 - pos;
+  mem_copy(leaf->keys + pos, leaf->keys + pos + 1, moved * sizeof(void*));
+  mem_copy(leaf->values + pos, leaf->values + pos + 1, moved * sizeof(void*));
+  node->len--;
+
+  return value;
+}
+
+void* C_OrderedMap_remove_PR(C_OrderedMap* self, void* key) {
+  Ref(key);
+
+  void* value = __C_OrderedMap_remove(self, self->root, key);
+  if (!self->root->leaf && self->root->len == 1) {
+    MapNode* root = self->root;
+    self->root = ((MapBranch*)root)->children[0];
+    deallocate(root);
+    self->depth--;
+  }
+  self->len--;
+
+  Unref(key);
+  return value;
+}
+
+/******************************
+ * lookup
+ ******************************/
+static void* __C_OrderedMap_at_P(C_OrderedMap* self, void* key) {
+  Ref(key);
+
+  MapLeaf* leaf = __C_OrderedMap_find_leaf(self, key);
+  u32 pos = sorted_lower_bound(leaf->keys, leaf->node.len, key, self->compare);
+  if (pos == leaf->node.len || self->compare(leaf->keys[pos], key) != 0) {
+    crash(E(EG_Datastructures, E_InvalidPointer,
+      SV("__C_OrderedMap_at_P -> key is not in the map")));
+  }
+
+  Unref(key);
+  return Ref(leaf->values[pos]);
+}
+
+bool C_OrderedMap_contains_P(C_OrderedMap* self, void* key) {
+  Ref(key);
+
+  MapLeaf* leaf = __C_OrderedMap_find_leaf(self, key);
+  u32 pos = sorted_lower_bound(leaf->keys, leaf->node.len, key, self->compare);
+  bool result =
+    pos < leaf->node.len && self->compare(leaf->keys[pos], key) == 0;
+
+  Unref(key);
+  return result;
+}
+
+MapCursor C_OrderedMap_lower_bound_P(C_OrderedMap* self, void* key) {
+  Ref(key);
+
+  MapCursor cursor;
+  cursor.leaf = __C_OrderedMap_find_leaf(self, key);
+  cursor.index =
+    sorted_lower_bound(cursor.leaf->keys, cursor.leaf->node.len, key,
+      self->compare);
+  // the keys of the next leaf are not less than the separator above it
+  __MapCursor_skip_end(&cursor);
+
+  Unref(key);
+  return cursor;
+}
+
+void C_OrderedMap_clear(C_OrderedMap* self) {
+  MapNode_free(self->root);
+  self->root = MapLeaf_new();
+  self->len = 0;
+  self->depth = 0;
+}
+
+u32 C_OrderedMap_hash(void* self) {
+  u32 hash_code = 0;
+  C_OrderedMapForeach(self, {
+    hash_code = 31 * hash_code + IHashable_hash(key);
+    hash_code = 31 * hash_code + IHashable_hash(value);
+  });
+  return hash_code;
+}
+
+bool C_OrderedMap_equals(void* a, void* b) {
+  C_OrderedMap* a_cast = a;
+  C_OrderedMap* b_cast = b;
+
+  if (a_cast->len != b_cast->len) {
+    return false;
+  }
+
+  MapCursor b_cursor = MapCursor_construct(b_cast);
+  C_OrderedMapForeach(a_cast, {
+    if (!IHashable_equals(key, MapCursor_get_key_B(&b_cursor)) ||
+        !IHashable_equals(value, MapCursor_get_value_B(&b_cursor))) {
+      return false;
+    }
+    MapCursor_next(&b_cursor);
+  });
+
+  return true;
+}
+
+void C_OrderedMap_write_to(
+  void* self, C_StringBuilder* sink, C_Format* format) {
+  format = format ? format : C_FormatMap;
+  StringView start = C_Format_get(format, FormatStart);
+  StringView sep = C_Format_get(format, FormatSep);
+  StringView el_sep = C_Format_get(format, FormatElSep);
+  StringView end = C_Format_get(format, FormatEnd);
+
+  C_StringBuilder_append_view(sink, start);
+  C_OrderedMapForeach(self, {
+    if (iter != 0) {
+      C_StringBuilder_append_view(sink, sep);
+    }
+    C_StringBuilder_append_str_P(sink, key);
+    C_StringBuilder_append_view(sink, el_sep);
+    C_StringBuilder_append_str_P(sink, value);
+  });
+  C_StringBuilder_append_view(sink, end);
+}
+
+C_String* C_OrderedMap_to_str_format_R(void* self, C_String* format) {
+  return IFormattable_to_str_format_PR(self, format);
+}
+
+C_String* C_OrderedMap_to_str_R(void* self) {
+  return IFormattable_to_str_PR(self);
+}
+
+/******************************
+ * get/set
+ ******************************/
+u32 C_OrderedMap_get_len(C_OrderedMap* self) { return self->len; }
+
+u32 C_OrderedMap_get_depth(C_OrderedMap* self) { return self->depth; }
+
+// {{{ _R _B wrappers
+void* MapCursor_get_value_B(MapCursor* self) {
+  void* result = __MapCursor_get_value(self);
+  Unref(result);
+  return result;
+}
+
+void* MapCursor_get_value_R(MapCursor* self) {
+  void* result = __MapCursor_get_value(self);
+  return result;
+}
+
+void* C_OrderedMap_at_PB(C_OrderedMap* self, void* key) {
+  void* result = __C_OrderedMap_at_P(self, key);
+  Unref(result);
+  return result;
+}
+
+void* C_OrderedMap_at_PR(C_OrderedMap* self, void* key) {
+  void* result = __C_OrderedMap_at_P(self, key);
+  return result;
+}
+// }}}
@@ -0,0 +1,489 @@
+#include <c_base/base/errors/errors.h>
+#include <c_base/base/memory/allocator.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/base/strings/C_StringBuilder.h>
+#include <c_base/base/strings/format.h>
+#include <c_base/base/strings/string_convert.h>
+#include <c_base/base/strings/strings.h>
+#include <c_base/ds/C_List.h>
+#include <c_base/ds/C_PriorityQueue.h>
+#include <c_base/system.h>
+
+/* four children per node, the children of a node share one or two cache
+ * lines and the heap is half as deep as a binary one */
+#define PriorityArity 4
+#define PriorityMinCap 16
+// position of a handle that is not in use
+#define PriorityNoPosition ((u32)-1)
+
+/******************************
+ * handles
+ ******************************/
+/* positions maps every slot to the index of its node in the heap.
+ * popped slots are kept in free and reused first, so there are never
+ * more slots than the most values the heap held at once. a handle is a
+ * slot and its generation, which a pop bumps, so the handle of a popped
+ * value does not match the value that reuses its slot */
+typedef struct {
+  u32* positions;
+  u32* generations;
+  u32* free;
+  u32 count;
+  u32 free_len;
+} PriorityHandles;
+
+static PriorityHandles PriorityHandles_construct(u32 cap) {
+  PriorityHandles self;
+  self.positions = allocate(cap * sizeof(u32));
+  self.generations = allocate(cap * sizeof(u32));
+  self.free = allocate(cap * sizeof(u32));
+  self.count = 0;
+  self.free_len = 0;
+  return self;
+}
+
+static void PriorityHandles_destruct(PriorityHandles* self) {
+  deallocate(self->positions);
+  deallocate(self->generations);
+  deallocate(self->free);
+}
+
+static void PriorityHandles_grow(PriorityHandles* self, u32 cap) {
+  self->positions = reallocate(self->positions, cap * sizeof(u32));
+  self->generations = reallocate(self->generations, cap * sizeof(u32));
+  self->free = reallocate(self->free, cap * sizeof(u32));
+}
+
+static PriorityHandle PriorityHandles_take(PriorityHandles* self) {
+  u32 slot;
+  if (self->free_len > 0) {
+    slot = self->free[--self->free_len];
+  } else {
+    slot = self->count++;
+    self->generations[slot] = 1;
+  }
+  return (u64)self->generations[slot] << 32 | slot;
+}
+
+static void PriorityHandles_release(PriorityHandles* self, u32 slot) {
+  self->positions[slot] = PriorityNoPosition;
+  // 0 is skipped, a handle is never 0 in its high bits
+  if (++self->generations[slot] == 0) {
+    self->generations[slot] = 1;
+  }
+  self->free[self->free_len++] = slot;
+}
+
+static bool PriorityHandles_contains(
+  PriorityHandles* self, PriorityHandle handle) {
+  u32 slot = (u32)handle;
+  return slot < self->count && self->positions[slot] != PriorityNoPosition &&
+         self->generations[slot] == handle >> 32;
+}
+
+// every slot is freed, so the handles from before stay invalid
+static void PriorityHandles_clear(PriorityHandles* self) {
+  self->free_len = 0;
+  for (u32 slot = self->count; slot > 0; slot--) {
+    if (self->positions[slot - 1] != PriorityNoPosition) {
+      PriorityHandles_release(self, slot - 1);
+    } else {
+      self->free[self->free_len++] = slot - 1;
+    }
+  }
+}
+
+/******************************
+ * heap
+ ******************************/
+/* sifts for a heap of Node in self->heap, less(self, a, b) orders two nodes.
+ * the moving node is held aside and written once at its final index */
+#define PriorityHeapImpl(Self, Node, less)                                     \
+  static void __##Self##_place(Self* self, u32 index, Node node) {             \
+    self->heap[index] = node;                                                  \
+    self->handles.positions[node.slot] = index;                                \
+  }                                                                            \
+                                                                               \
+  static void __##Self##_sift_up(Self* self, u32 index) {                      \
+    Node node = self->heap[index];                                             \
+    while (index > 0) {                                                        \
+      u32 parent = (index - 1) / PriorityArity;                                \
+      if (!less(self, node, self->heap[parent])) {                             \
+        break;                                                                 \
+      }                                                                        \
+      __##Self##_place(self, index, self->heap[parent]);                       \
+      index = parent;                                                          \
+    }                                                                          \
+    __##Self##_place(self, index, node);                                       \
+  }                                                                            \
+                                                                               \
+  static void __##Self##_sift_down(Self* self, u32 index) {                    \
+    Node node = self->heap[index];                                             \
+    for (;;) {                                                                 \
+      u32 first = index * PriorityArity + 1;                                   \
+      if (first >= self->len) {                                                \
+        break;                                                                 \
+      }                                                                        \
+      u32 last = first + PriorityArity;                                        \
+      if (last > self->len) {                                                  \
+        last = self->len;                                                      \
+      }                                                                        \
+                                                                               \
+      u32 best = first;                                                        \
+      for (u32 child = first + 1; child < last; child++) {                     \
+        if (less(self, self->heap[child], self->heap[best])) {                 \
+          best = child;                                                        \
+        }                                                                      \
+      }                                                                        \
+      if (!less(self, self->heap[best], node)) {                               \
+        break;                                                                 \
+      }                                                                        \
+      __##Self##_place(self, index, self->heap[best]);                         \
+      index = best;                                                            \
+    }                                                                          \
+    __##Self##_place(self, index, node);                                       \
+  }                                                                            \
+                                                                               \
+  static void __##Self##_reserve(Self* self) {                                 \
+    if (self->len == self->cap) {                                              \
+      self->cap *= 2;                                                          \
+      self->heap = reallocate(self->heap, self->cap * sizeof(Node));           \
+      PriorityHandles_grow(&self->handles, self->cap);                         \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  static PriorityHandle __##Self##_insert(Self* self, Node node) {             \
+    __##Self##_reserve(self);                                                  \
+    PriorityHandle handle = PriorityHandles_take(&self->handles);              \
+    node.slot = (u32)handle;                                                   \
+    self->heap[self->len] = node;                                              \
+    self->len++;                                                               \
+    __##Self##_sift_up(self, self->len - 1);                                   \
+    return handle;                                                             \
+  }                                                                            \
+                                                                               \
+  static Node __##Self##_remove_root(Self* self) {                             \
+    Node root = self->heap[0];                                                 \
+    PriorityHandles_release(&self->handles, root.slot);                        \
+    self->len--;                                                               \
+    if (self->len > 0) {                                                       \
+      self->heap[0] = self->heap[self->len];                                   \
+      __##Self##_sift_down(self, 0);                                           \
+    }                                                                          \
+    return root;                                                               \
+  }
+
+/******************************
+ * C_PriorityQueue
+ ******************************/
+static Interface* C_PriorityQueue_interfaces[2];
+static IFormattable C_PriorityQueue_i_formattable = {0};
+
+typedef struct {
+  void* value;
+  u32 slot;
+} PriorityNode;
+
+struct C_PriorityQueue {
+  ClassObject base;
+
+  PriorityNode* heap;
+  u32 len;
+  u32 cap;
+  PriorityHandles handles;
+  CompareFunc compare;
+};
+
+#define C_PriorityQueue_less(self, a, b)                                       \
+  ((self)->compare((a).value, (b).value) < 0)
+
+PriorityHeapImpl(C_PriorityQueue, PriorityNode, C_PriorityQueue_less)
+
+C_PriorityQueue* C_PriorityQueue_new(void) {
+  return C_PriorityQueue_new_by(IComparable_compare);
+}
+
+C_PriorityQueue* C_PriorityQueue_new_by(CompareFunc compare) {
+  if (!Interface_initialized((Interface*)&C_PriorityQueue_i_formattable)) {
+    C_PriorityQueue_i_formattable =
+      IFormattable_construct_write(C_PriorityQueue_write_to);
+
+    C_PriorityQueue_interfaces[0] =
+      (Interface*)&C_PriorityQueue_i_formattable;
+    C_PriorityQueue_interfaces[1] = null;
+  }
+
+  C_PriorityQueue* self = allocate(sizeof(C_PriorityQueue));
+  self->base = ClassObject_construct(
+    C_PriorityQueue_destroy, C_PriorityQueue_interfaces);
+
+  self->cap = PriorityMinCap;
+  self->len = 0;
+  self->heap = allocate(self->cap * sizeof(PriorityNode));
+  self->handles = PriorityHandles_construct(self->cap);
+  self->compare = compare;
+
+  return self;
+}
+
+void C_PriorityQueue_destroy(void* self) {
+  C_PriorityQueue* self_cast = self;
+  for (u32 i = 0; i < self_cast->len; i++) {
+    Unref(self_cast->heap[i].value);
+  }
+  deallocate(self_cast->heap);
+  PriorityHandles_destruct(&self_cast->handles);
+}
+
+PriorityHandle C_PriorityQueue_push_P(C_PriorityQueue* self, void* value) {
+  PriorityNode node;
+  node.value = Ref(value);
+  return __C_PriorityQueue_insert(self, node);
+}
+
+void* C_PriorityQueue_pop_R(C_PriorityQueue* self) {
+  if (self->len == 0) {
+    crash(E(EG_Datastructures, E_OutOfBounds,
+      SV("C_PriorityQueue_pop_R -> queue is empty")));
+  }
+
+  return __C_PriorityQueue_remove_root(self).value;
+}
+
+static void* __C_PriorityQueue_peek(C_PriorityQueue* self) {
+  if (self->len == 0) {
+    crash(E(EG_Datastructures, E_OutOfBounds,
+      SV("__C_PriorityQueue_peek -> queue is empty")));
+  }
+
+  return Ref(self->heap[0].value);
+}
+
+void C_PriorityQueue_decrease_key_P(
+  C_PriorityQueue* self, PriorityHandle handle, void* value) {
+  if (!PriorityHandles_contains(&self->handles, handle)) {
+    crash(E(EG_Datastructures, E_InvalidArgument,
+      SV("C_PriorityQueue_decrease_key_P -> handle is not in the queue")));
+  }
+
+  u32 index = self->handles.positions[(u32)handle];
+  if (self->compare(value, self->heap[index].value) > 0) {
+    crash(E(EG_Datastructures, E_InvalidArgument,
+      SV("C_PriorityQueue_decrease_key_P -> value is greater than the old "
+         "one")));
+  }
+
+  Ref(value);
+  Unref(self->heap[index].value);
+  self->heap[index].value = value;
+  __C_PriorityQueue_sift_up(self, index);
+}
+
+bool C_PriorityQueue_contains(C_PriorityQueue* self, PriorityHandle handle) {
+  return PriorityHandles_contains(&self->handles, handle);
+}
+
+C_Array* C_PriorityQueue_to_array_PR(C_PriorityQueue* self) {
+  Ref(self);
+  C_Array* array = C_Array_new(self->len);
+  for (u32 i = 0; i < self->len; i++) {
+    C_Array_put_P(array, i, self->heap[i].value);
+  }
+  Unref(self);
+  return array;
+}
+
+void C_PriorityQueue_clear(C_PriorityQueue* self) {
+  for (u32 i = 0; i < self->len; i++) {
+    Unref(self->heap[i].value);
+  }
+  self->len = 0;
+  PriorityHandles_clear(&self->handles);
+}
+
+void C_PriorityQueue_write_to(
+  void* self, C_StringBuilder* sink, C_Format* format) {
+  C_PriorityQueue* self_cast = self;
+
+  format = format ? format : C_FormatList;
+  StringView start = C_Format_get(format, FormatStart);
+  StringView end = C_Format_get(format, FormatEnd);
+  StringView sep = C_Format_get(format, FormatSep);
+
+  C_StringBuilder_append_view(sink, start);
+  for (u32 i = 0; i < self_cast->len; i++) {
+    if (i != 0) {
+      C_StringBuilder_append_view(sink, sep);
+    }
+    C_StringBuilder_append_str_P(sink, self_cast->heap[i].value);
+  }
+  C_StringBuilder_append_view(sink, end);
+}
+
+C_String* C_PriorityQueue_to_str_format_R(void* self, C_String* format) {
+  return IFormattable_to_str_format_PR(self, format);
+}
+
+C_String* C_PriorityQueue_to_str_R(void* self) {
+  return IFormattable_to_str_PR(self);
+}
+
+u32 C_PriorityQueue_get_len(C_PriorityQueue* self) { return self->len; }
+
+// {{{ _R _B wrappers
+void* C_PriorityQueue_peek_B(C_PriorityQueue* self) {
+  void* result = __C_PriorityQueue_peek(self);
+  Unref(result);
+  return result;
+}
+
+void* C_PriorityQueue_peek_R(C_PriorityQueue* self) {
+  void* result = __C_PriorityQueue_peek(self);
+  return result;
+}
+// }}}
+
+/******************************
+ * C_PriorityQueue_u64
+ ******************************/
+static Interface* C_PriorityQueue_u64_interfaces[2];
+static IFormattable C_PriorityQueue_u64_i_formattable = {0};
+
+typedef struct {
+  u64 priority;
+  u64 value;
+  u32 slot;
+} PriorityNode_u64;
+
+struct C_PriorityQueue_u64 {
+  ClassObject base;
+
+  PriorityNode_u64* heap;
+  u32 len;
+  u32 cap;
+  PriorityHandles handles;
+};
+
+#define C_PriorityQueue_u64_less(self, a, b) ((a).priority < (b).priority)
+
+PriorityHeapImpl(
+  C_PriorityQueue_u64, PriorityNode_u64, C_PriorityQueue_u64_less)
+
+C_PriorityQueue_u64* C_PriorityQueue_u64_new(void) {
+  if (!Interface_initialized((Interface*)&C_PriorityQueue_u64_i_formattable)) {
+    C_PriorityQueue_u64_i_formattable =
+      IFormattable_construct_write(C_PriorityQueue_u64_write_to);
+
+    C_PriorityQueue_u64_interfaces[0] =
+      (Interface*)&C_PriorityQueue_u64_i_formattable;
+    C_PriorityQueue_u64_interfaces[1] = null;
+  }
+
+  C_PriorityQueue_u64* self = allocate(sizeof(C_PriorityQueue_u64));
+  self->base = ClassObject_construct(
+    C_PriorityQueue_u64_destroy, C_PriorityQueue_u64_interfaces);
+
+  self->cap = PriorityMinCap;
+  self->len = 0;
+  self->heap = allocate(self->cap * sizeof(PriorityNode_u64));
+  self->handles = PriorityHandles_construct(self->cap);
+
+  return self;
+}
+
+void C_PriorityQueue_u64_destroy(void* self) {
+  C_PriorityQueue_u64* self_cast = self;
+  deallocate(self_cast->heap);
+  PriorityHandles_destruct(&self_cast->handles);
+}
+
+PriorityHandle C_PriorityQueue_u64_push(
+  C_PriorityQueue_u64* self, u64 priority, u64 value) {
+  PriorityNode_u64 node;
+  node.priority = priority;
+  node.value = value;
+  return __C_PriorityQueue_u64_insert(self, node);
+}
+
+PriorityEntry C_PriorityQueue_u64_pop(C_PriorityQueue_u64* self) {
+  if (self->len == 0) {
+    crash(E(EG_Datastructures, E_OutOfBounds,
+      SV("C_PriorityQueue_u64_pop -> queue is empty")));
+  }
+
+  PriorityNode_u64 node = __C_PriorityQueue_u64_remove_root(self);
+  PriorityEntry entry = {node.priority, node.value};
+  return entry;
+}
+
+PriorityEntry C_PriorityQueue_u64_peek(C_PriorityQueue_u64* self) {
+  if (self->len == 0) {
+    crash(E(EG_Datastructures, E_OutOfBounds,
+      SV("C_PriorityQueue_u64_peek -> queue is empty")));
+  }
+
+  PriorityEntry entry = {self->heap[0].priority, self->heap[0].value};
+  return entry;
+}
+
+void C_PriorityQueue_u64_decrease_key(
+  C_PriorityQueue_u64* self, PriorityHandle handle, u64 priority) {
+  if (!PriorityHandles_contains(&self->handles, handle)) {
+    crash(E(EG_Datastructures, E_InvalidArgument,
+      SV("C_PriorityQueue_u64_decrease_key -> handle is not in the queue")));
+  }
+
+  u32 index = self->handles.positions[(u32)handle];
+  if (priority > self->heap[index].priority) {
+    crash(E(EG_Datastructures, E_InvalidArgument,
+      SV("C_PriorityQueue_u64_decrease_key -> priority is greater than the "
+         "old one")));
+  }
+
+  self->heap[index].priority = priority;
+  __C_PriorityQueue_u64_sift_up(self, index);
+}
+
+bool C_PriorityQueue_u64_contains(
+  C_PriorityQueue_u64* self, PriorityHandle handle) {
+  return PriorityHandles_contains(&self->handles, handle);
+}
+
+void C_PriorityQueue_u64_clear(C_PriorityQueue_u64* self) {
+  self->len = 0;
+  PriorityHandles_clear(&self->handles);
+}
+
+// entries are written as priority:value
+void C_PriorityQueue_u64_write_to(
+  void* self, C_StringBuilder* sink, C_Format* format) {
+  C_PriorityQueue_u64* self_cast = self;
+
+  format = format ? format : C_FormatList;
+  StringView start = C_Format_get(format, FormatStart);
+  StringView end = C_Format_get(format, FormatEnd);
+  StringView sep = C_Format_get(format, FormatSep);
+
+  C_StringBuilder_append_view(sink, start);
+  for (u32 i = 0; i < self_cast->len; i++) {
+    if (i != 0) {
+      C_StringBuilder_append_view(sink, sep);
+    }
+    C_StringBuilder_append_u64(sink, self_cast->heap[i].priority);
+    C_StringBuilder_append_char(sink, ':');
+    C_StringBuilder_append_u64(sink, self_cast->heap[i].value);
+  }
+  C_StringBuilder_append_view(sink, end);
+}
+
+C_String* C_PriorityQueue_u64_to_str_format_R(void* self, C_String* format) {
+  return IFormattable_to_str_format_PR(self, format);
+}
+
+C_String* C_PriorityQueue_u64_to_str_R(void* self) {
+  return IFormattable_to_str_PR(self);
+}
+
+u32 C_PriorityQueue_u64_get_len(C_PriorityQueue_u64* self) {
+  return self->len;
+}
@@ -0,0 +1,942 @@
+#include <c_base/base/errors/errors.h>
+#include <c_base/base/memory/allocator.h>
+#include <c_base/base/memory/memory.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/base/strings/C_StringBuilder.h>
+#include <c_base/base/strings/format.h>
+#include <c_base/base/strings/strings.h>
+#include <c_base/ds/C_List.h>
+#include <c_base/ds/C_RadixTree.h>
+#include <c_base/env.h>
+#include <c_base/system.h>
+
+// sse2 is part of x86_64, no runtime dispatch needed
+#if defined(ARCH_X86_64) && (defined(COMPILER_GCC) || defined(COMPILER_CLANG))
+  #define RADIX_SSE2
+  #include <emmintrin.h>
+#endif
+
+// longer prefixes are allocated separately
+#define RadixPrefixInline 8
+
+/* a node shrinks to the next smaller type once its children drop to this,
+ * below the capacity of the smaller type so adding and removing the same
+ * child does not resize the node every time */
+#define Radix16Shrink 3
+#define Radix48Shrink 12
+#define Radix256Shrink 37
+
+static Interface* C_RadixTree_interfaces[2];
+static IFormattable C_RadixTree_i_formattable = {0};
+
+typedef enum {
+  RadixLeafType,
+  Radix4Type,
+  Radix16Type,
+  Radix48Type,
+  Radix256Type,
+} RadixType;
+
+// first member of leaves and nodes, children point at it
+typedef struct {
+  u8 type;
+} RadixHeader;
+
+// leaves store the whole key, the path to them only covers a part of it
+typedef struct {
+  RadixHeader header;
+  u32 len;
+  void* value;
+  u8 key[];
+} RadixLeaf;
+
+/* count is the number of children. end is the leaf of the key that ends
+ * after the prefix of this node, it is not counted as a child */
+typedef struct {
+  RadixHeader header;
+  u16 count;
+  u32 prefix_len;
+  union {
+    u8 bytes[RadixPrefixInline];
+    u8* heap;
+  } prefix;
+  RadixLeaf* end;
+} RadixNode;
+
+// keys are sorted, children[i] belongs to keys[i]
+typedef struct {
+  RadixNode node;
+  u8 keys[4];
+  RadixHeader* children[4];
+} RadixNode4;
+
+typedef struct {
+  RadixNode node;
+  u8 keys[16];
+  RadixHeader* children[16];
+} RadixNode16;
+
+// index is the slot in children plus one for every byte, 0 is empty
+typedef struct {
+  RadixNode node;
+  u8 index[256];
+  RadixHeader* children[48];
+} RadixNode48;
+
+typedef struct {
+  RadixNode node;
+  RadixHeader* children[256];
+} RadixNode256;
+
+struct C_RadixTree {
+  ClassObject base;
+
+  RadixHeader* root;
+  u32 len;
+};
+
+/******************************
+ * leaves
+ ******************************/
+static RadixLeaf* RadixLeaf_new(StringView key, void* value) {
+  RadixLeaf* self = allocate(sizeof(RadixLeaf) + key.len);
+  self->header.type = RadixLeafType;
+  self->len = key.len;
+  self->value = value;
+  mem_copy(self->key, key.chars, key.len);
+  return self;
+}
+
+static StringView RadixLeaf_view(RadixLeaf* self) {
+  return StringView_construct((ascii*)self->key, self->len);
+}
+
+// the first depth bytes are already matched by the path to the leaf
+static bool RadixLeaf_matches(RadixLeaf* self, StringView key, u32 depth) {
+  return self->len == key.len &&
+         mem_equals(self->key + depth, key.chars + depth, key.len - depth);
+}
+
+/******************************
+ * nodes
+ ******************************/
+static RadixNode* RadixNode_new(RadixType type) {
+  u64 size = 0;
+  switch (type) {
+    case Radix4Type: size = sizeof(RadixNode4); break;
+    case Radix16Type: size = sizeof(RadixNode16); break;
+    case Radix48Type: size = sizeof(RadixNode48); break;
+    case Radix256Type: size = sizeof(RadixNode256); break;
+    case RadixLeafType: break;
+  }
+
+  RadixNode* self = allocate(size);
+  mem_set(self, 0, size);
+  self->header.type = type;
+  return self;
+}
+
+static u8* RadixNode_get_prefix(RadixNode* self) {
+  return self->prefix_len > RadixPrefixInline ? self->prefix.heap
+                                              : self->prefix.bytes;
+}
+
+// bytes may point into the current prefix of self
+static void RadixNode_set_prefix(RadixNode* self, u8* bytes, u32 len) {
+  u8* old_heap =
+    self->prefix_len > RadixPrefixInline ? self->prefix.heap : null;
+
+  if (len > RadixPrefixInline) {
+    u8* heap = allocate(len);
+    mem_copy(heap, bytes, len);
+    self->prefix.heap = heap;
+  } else {
+    mem_copy(self->prefix.bytes, bytes, len);
+  }
+  self->prefix_len = len;
+
+  if (old_heap) {
+    deallocate(old_heap);
+  }
+}
+
+// number of prefix bytes that match key from depth on
+static u32 RadixNode_prefix_match(RadixNode* self, StringView key, u32 depth) {
+  u8* prefix = RadixNode_get_prefix(self);
+  u8* bytes = (u8*)key.chars + depth;
+  u32 limit = key.len - depth;
+  limit = limit < self->prefix_len ? limit : self->prefix_len;
+
+  u32 i = 0;
+  while (i < limit && prefix[i] == bytes[i]) {
+    i++;
+  }
+  return i;
+}
+
+static bool RadixNode_prefix_matches(
+  RadixNode* self, StringView key, u32 depth) {
+  return key.len - depth >= self->prefix_len &&
+         mem_equals(
+           RadixNode_get_prefix(self), key.chars + depth, self->prefix_len);
+}
+
+// frees the node itself, not its children
+static void RadixNode_free(RadixNode* self) {
+  if (self->prefix_len > RadixPrefixInline) {
+    deallocate(self->prefix.heap);
+  }
+  deallocate(self);
+}
+
+// the node of the same size class with count, prefix and end of from
+static RadixNode* RadixNode_new_from(RadixType type, RadixNode* from) {
+  RadixNode* self = RadixNode_new(type);
+  self->count = from->count;
+  self->prefix_len = from->prefix_len;
+  self->prefix = from->prefix;
+  self->end = from->end;
+  return self;
+}
+
+/******************************
+ * node16 search
+ ******************************/
+static s32 RadixNode16_find(RadixNode16* self, u8 byte) {
+#if defined(RADIX_SSE2)
+  __m128i keys = _mm_loadu_si128((__m128i*)self->keys);
+  __m128i equal = _mm_cmpeq_epi8(keys, _mm_set1_epi8((char)byte));
+  u32 mask = (u32)_mm_movemask_epi8(equal) & ((1u << self->node.count) - 1);
+  return mask ? (s32)__builtin_ctz(mask) : -1;
+#else
+  for (u32 i = 0; i < self->node.count; i++) {
+    if (self->keys[i] == byte) {
+      return (s32)i;
+    }
+  }
+  return -1;
+#endif
+}
+
+// index of the first key not less than byte
+static u32 RadixNode16_position(RadixNode16* self, u8 byte) {
+#if defined(RADIX_SSE2)
+  // sse2 only compares signed bytes, flipping the top bit keeps the order
+  __m128i bias = _mm_set1_epi8((char)0x80);
+  __m128i keys = _mm_xor_si128(_mm_loadu_si128((__m128i*)self->keys), bias);
+  __m128i needle = _mm_xor_si128(_mm_set1_epi8((char)byte), bias);
+  __m128i less = _mm_cmplt_epi8(keys, needle);
+  u32 mask = (u32)_mm_movemask_epi8(less) & ((1u << self->node.count) - 1);
+  return (u32)__builtin_popcount(mask);
+#else
+  u32 i = 0;
+  while (i < self->node.count && self->keys[i] < byte) {
+    i++;
+  }
+  return i;
+#endif
+}
+
+/******************************
+ * children
+ ******************************/
+static RadixHeader** RadixNode_find(RadixNode* self, u8 byte) {
+  switch (self->header.type) {
+    case Radix4Type: {
+      RadixNode4* node = (RadixNode4*)self;
+      for (u32 i = 0; i < self->count; i++) {
+        if (node->keys[i] == byte) {
+          return &node->children[i];
+        }
+      }
+      return null;
+    }
+    case Radix16Type: {
+      RadixNode16* node = (RadixNode16*)self;
+      s32 index = RadixNode16_find(node, byte);
+      return index < 0 ? null : &node->children[index];
+    }
+    case Radix48Type: {
+      RadixNode48* node = (RadixNode48*)self;
+      u8 slot = node->index[byte];
+      return slot ? &node->children[slot - 1] : null;
+    }
+    case Radix256Type: {
+      RadixNode256* node = (RadixNode256*)self;
+      return node->children[byte] ? &node->children[byte] : null;
+    }
+  }
+  return null;
+}
+
+// the next child in byte order, pos starts at 0. null after the last one
+static RadixHeader* RadixNode_next(RadixNode* self, u32* pos) {
+  switch (self->header.type) {
+    case Radix4Type:
+      return *pos < self->count ? ((RadixNode4*)self)->children[(*pos)++]
+                                : null;
+    case Radix16Type:
+      return *pos < self->count ? ((RadixNode16*)self)->children[(*pos)++]
+                                : null;
+    case Radix48Type: {
+      RadixNode48* node = (RadixNode48*)self;
+      while (*pos < 256) {
+        u8 slot = node->index[(*pos)++];
+        if (slot) {
+          return node->children[slot - 1];
+        }
+      }
+      return null;
+    }
+    case Radix256Type: {
+      RadixNode256* node = (RadixNode256*)self;
+      while (*pos < 256) {
+        RadixHeader* child = node->children[(*pos)++];
+        if (child) {
+          return child;
+        }
+      }
+      return null;
+    }
+  }
+  return null;
+}
+
+static void radix_sorted_insert(u8* keys, RadixHeader** children, u32 count,
+  u32 pos, u8 byte, RadixHeader* child) {
+  mem_copy(keys + pos + 1, keys + pos, count - pos);
+  mem_copy(
+    children + pos + 1, children + pos, (count - pos) * sizeof(RadixHeader*));
+  keys[pos] = byte;
+  children[pos] = child;
+}
+
+static void radix_sorted_remove(
+  u8* keys, RadixHeader** children, u32 count, u32 pos) {
+  mem_copy(keys + pos, keys + pos + 1, count - pos - 1);
+  mem_copy(children + pos, children + pos + 1,
+    (count - pos - 1) * sizeof(RadixHeader*));
+}
+
+// moves the children into the next larger type
+static RadixNode* RadixNode_grow(RadixNode* self) {
+  RadixNode* result = RadixNode_new_from(self->header.type + 1, self);
+
+  switch (self->header.type) {
+    case Radix4Type: {
+      RadixNode4* from = (RadixNode4*)self;
+      RadixNode16* to = (RadixNode16*)result;
+      mem_copy(to->keys, from->keys, self->count);
+      mem_copy(to->children, from->children,
+        self->count * sizeof(RadixHeader*));
+      break;
+    }
+    case Radix16Type: {
+      RadixNode16* from = (RadixNode16*)self;
+      RadixNode48* to = (RadixNode48*)result;
+      for (u32 i = 0; i < self->count; i++) {
+        to->index[from->keys[i]] = (u8)(i + 1);
+        to->children[i] = from->children[i];
+      }
+      break;
+    }
+    case Radix48Type: {
+      RadixNode48* from = (RadixNode48*)self;
+      RadixNode256* to = (RadixNode256*)result;
+      for (u32 byte = 0; byte < 256; byte++) {
+        if (from->index[byte]) {
+          to->children[byte] = from->children[from->index[byte] - 1];
+        }
+      }
+      break;
+    }
+  }
+
+  deallocate(self);
+  return result;
+}
+
+// moves the children into the next smaller type
+static RadixNode* RadixNode_shrink(RadixNode* self) {
+  RadixNode* result = RadixNode_new_from(self->header.type - 1, self);
+
+  switch (self->header.type) {
+    case Radix16Type: {
+      RadixNode16* from = (RadixNode16*)self;
+      RadixNode4* to = (RadixNode4*)result;
+      mem_copy(to->keys, from->keys, self->count);
+      mem_copy(to->children, from->children,
+        self->count * sizeof(RadixHeader*));
+      break;
+    }
+    case Radix48Type: {
+      RadixNode48* from = (RadixNode48*)self;
+      RadixNode16* to = (RadixNode16*)result;
+      u32 pos = 0;
+      for (u32 byte = 0; byte < 256; byte++) {
+        if (from->index[byte]) {
+          to->keys[pos] = (u8)byte;
+          to->children[pos++] = from->children[from->index[byte] - 1];
+        }
+      }
+      break;
+    }
+    case Radix256Type: {
+      RadixNode256* from = (RadixNode256*)self;
+      RadixNode48* to = (RadixNode48*)result;
+      u32 slot = 0;
+      for (u32 byte = 0; byte < 256; byte++) {
+        if (from->children[byte]) {
+          to->index[byte] = (u8)(slot + 1);
+          to->children[slot++] = from->children[byte];
+        }
+      }
+      break;
+    }
+  }
+
+  deallocate(self);
+  return result;
+}
+
+// ref is the slot of the node, a full node is replaced by a larger one
+static void RadixNode_add(RadixHeader** ref, u8 byte, RadixHeader* child) {
+  RadixNode* self = (RadixNode*)*ref;
+
+  switch (self->header.type) {
+    case Radix4Type: {
+      if (self->count == 4) {
+        break;
+      }
+      RadixNode4* node = (RadixNode4*)self;
+      u32 pos = 0;
+      while (pos < self->count && node->keys[pos] < byte) {
+        pos++;
+      }
+      radix_sorted_insert(
+        node->keys, node->children, self->count, pos, byte, child);
+      self->count++;
+      return;
+    }
+    case Radix16Type: {
+      if (self->count == 16) {
+        break;
+      }
+      RadixNode16* node = (RadixNode16*)self;
+      u32 pos = RadixNode16_position(node, byte);
+      radix_sorted_insert(
+        node->keys, node->children, self->count, pos, byte, child);
+      self->count++;
+      return;
+    }
+    case Radix48Type: {
+      if (self->count == 48) {
+        break;
+      }
+      // removed children leave holes, there is one while count < 48
+      RadixNode48* node = (RadixNode48*)self;
+      u32 slot = 0;
+      while (node->children[slot]) {
+        slot++;
+      }
+      node->children[slot] = child;
+      node->index[byte] = (u8)(slot + 1);
+      self->count++;
+      return;
+    }
+    case Radix256Type: {
+      ((RadixNode256*)self)->children[byte] = child;
+      self->count++;
+      return;
+    }
+  }
+
+  *ref = &RadixNode_grow(self)->header;
+  RadixNode_add(ref, byte, child);
+}
+
+static void RadixNode_remove(RadixHeader** ref, u8 byte) {
+  RadixNode* self = (RadixNode*)*ref;
+  u32 shrink = 0;
+
+  switch (self->header.type) {
+    case Radix4Type: {
+      RadixNode4* node = (RadixNode4*)self;
+      u32 pos = (u32)(RadixNode_find(self, byte) - node->children);
+      radix_sorted_remove(node->keys, node->children, self->count, pos);
+      self->count--;
+      return;
+    }
+    case Radix16Type: {
+      RadixNode16* node = (RadixNode16*)self;
+      u32 pos = (u32)RadixNode16_find(node, byte);
+      radix_sorted_remove(node->keys, node->children, self->count, pos);
+      shrink = Radix16Shrink;
+      break;
+    }
+    case Radix48Type: {
+      RadixNode48* node = (RadixNode48*)self;
+      node->children[node->index[byte] - 1] = null;
+      node->index[byte] = 0;
+      shrink = Radix48Shrink;
+      break;
+    }
+    case Radix256Type: {
+      ((RadixNode256*)self)->children[byte] = null;
+      shrink = Radix256Shrink;
+      break;
+    }
+  }
+
+  self->count--;
+  if (self->count <= shrink) {
+    *ref = &RadixNode_shrink(self)->header;
+  }
+}
+
+/* a node left with a single child or only the end leaf is replaced by it,
+ * an inner child takes over the prefix and the byte of the node.
+ * only node4 get down to one child, the others shrink before */
+static void RadixNode_collapse(RadixHeader** ref) {
+  RadixNode* self = (RadixNode*)*ref;
+  if (self->count + (self->end != null) > 1) {
+    return;
+  }
+
+  if (self->end) {
+    *ref = &self->end->header;
+    RadixNode_free(self);
+    return;
+  }
+
+  RadixNode4* node = (RadixNode4*)self;
+  RadixHeader* child = node->children[0];
+  if (child->type != RadixLeafType) {
+    RadixNode* inner = (RadixNode*)child;
+    u32 len = self->prefix_len + 1 + inner->prefix_len;
+    u8* joined = allocate(len);
+    mem_copy(joined, RadixNode_get_prefix(self), self->prefix_len);
+    joined[self->prefix_len] = node->keys[0];
+    mem_copy(joined + self->prefix_len + 1, RadixNode_get_prefix(inner),
+      inner->prefix_len);
+    RadixNode_set_prefix(inner, joined, len);
+    deallocate(joined);
+  }
+
+  *ref = child;
+  RadixNode_free(self);
+}
+
+// the leaf goes to the end slot or becomes the child at its byte after depth
+static void RadixNode_place(RadixHeader** ref, RadixLeaf* leaf, u32 depth) {
+  RadixNode* self = (RadixNode*)*ref;
+  if (leaf->len == depth) {
+    self->end = leaf;
+  } else {
+    RadixNode_add(ref, leaf->key[depth], &leaf->header);
+  }
+}
+
+static void RadixHeader_free(RadixHeader* self) {
+  if (self->type == RadixLeafType) {
+    RadixLeaf* leaf = (RadixLeaf*)self;
+    Unref(leaf->value);
+    deallocate(leaf);
+    return;
+  }
+
+  RadixNode* node = (RadixNode*)self;
+  if (node->end) {
+    RadixHeader_free(&node->end->header);
+  }
+  u32 pos = 0;
+  RadixHeader* child;
+  while ((child = RadixNode_next(node, &pos))) {
+    RadixHeader_free(child);
+  }
+  RadixNode_free(node);
+}
+
+// the end leaf first, then the children by byte, which is key order
+static bool RadixHeader_visit(
+  RadixHeader* self, RadixVisit visit, void* data) {
+  if (self->type == RadixLeafType) {
+    RadixLeaf* leaf = (RadixLeaf*)self;
+    return visit(RadixLeaf_view(leaf), leaf->value, data);
+  }
+
+  RadixNode* node = (RadixNode*)self;
+  if (node->end &&
+      !visit(RadixLeaf_view(node->end), node->end->value, data)) {
+    return false;
+  }
+  u32 pos = 0;
+  RadixHeader* child;
+  while ((child = RadixNode_next(node, &pos))) {
+    if (!RadixHeader_visit(child, visit, data)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/******************************
+ * new/dest
+ ******************************/
+C_RadixTree* C_RadixTree_new(void) {
+  if (!Interface_initialized((Interface*)&C_RadixTree_i_formattable)) {
+    C_RadixTree_i_formattable =
+      IFormattable_construct_write(C_RadixTree_write_to);
+
+    C_RadixTree_interfaces[0] = (Interface*)&C_RadixTree_i_formattable;
+    C_RadixTree_interfaces[1] = null;
+  }
+
+  C_RadixTree* self = allocate(sizeof(C_RadixTree));
+  self->base =
+    ClassObject_construct(C_RadixTree_destroy, C_RadixTree_interfaces);
+
+  self->root = null;
+  self->len = 0;
+
+  return self;
+}
+
+void C_RadixTree_destroy(void* self) {
+  C_RadixTree* self_cast = self;
+  if (self_cast->root) {
+    RadixHeader_free(self_cast->root);
+  }
+}
+
+/******************************
+ * logic
+ ******************************/
+static RadixLeaf* C_RadixTree_find(C_RadixTree* self, StringView key) {
+  RadixHeader* header = self->root;
+  u32 depth = 0;
+
+  while (header) {
+    if (header->type == RadixLeafType) {
+      RadixLeaf* leaf = (RadixLeaf*)header;
+      return RadixLeaf_matches(leaf, key, depth) ? leaf : null;
+    }
+
+    RadixNode* node = (RadixNode*)header;
+    if (!RadixNode_prefix_matches(node, key, depth)) {
+      return null;
+    }
+    depth += node->prefix_len;
+    if (depth == key.len) {
+      return node->end;
+    }
+
+    RadixHeader** child = RadixNode_find(node, (u8)key.chars[depth]);
+    if (!child) {
+      return null;
+    }
+    header = *child;
+    depth++;
+  }
+
+  return null;
+}
+
+void C_RadixTree_put_P(C_RadixTree* self, StringView key, void* value) {
+  RadixLeaf* leaf = RadixLeaf_new(key, Ref(value));
+  u8* bytes = (u8*)key.chars;
+  RadixHeader** ref = &self->root;
+  u32 depth = 0;
+  self->len++;
+
+  while (*ref) {
+    if ((*ref)->type == RadixLeafType) {
+      // both leaves go below a new node with the bytes they share
+      RadixLeaf* other = (RadixLeaf*)*ref;
+      if (RadixLeaf_matches(other, key, depth)) {
+        break;
+      }
+      u32 limit = (other->len < key.len ? other->len : key.len) - depth;
+      u32 common = 0;
+      while (common < limit &&
+             other->key[depth + common] == bytes[depth + common]) {
+        common++;
+      }
+
+      RadixNode* node = RadixNode_new(Radix4Type);
+      RadixNode_set_prefix(node, bytes + depth, common);
+      *ref = &node->header;
+      RadixNode_place(ref, other, depth + common);
+      RadixNode_place(ref, leaf, depth + common);
+      return;
+    }
+
+    RadixNode* node = (RadixNode*)*ref;
+    u32 match = RadixNode_prefix_match(node, key, depth);
+    if (match < node->prefix_len) {
+      // the key leaves the prefix, the node moves below a new parent
+      RadixNode* parent = RadixNode_new(Radix4Type);
+      u8* prefix = RadixNode_get_prefix(node);
+      RadixNode_set_prefix(parent, prefix, match);
+      u8 byte = prefix[match];
+      RadixNode_set_prefix(
+        node, prefix + match + 1, node->prefix_len - match - 1);
+
+      *ref = &parent->header;
+      RadixNode_add(ref, byte, &node->header);
+      RadixNode_place(ref, leaf, depth + match);
+      return;
+    }
+
+    depth += node->prefix_len;
+    if (depth == key.len) {
+      if (node->end) {
+        break;
+      }
+      node->end = leaf;
+      return;
+    }
+
+    RadixHeader** child = RadixNode_find(node, bytes[depth]);
+    if (!child) {
+      RadixNode_add(ref, bytes[depth], &leaf->header);
+      return;
+    }
+    ref = child;
+    depth++;
+  }
+
+  if (*ref) {
+    crash(E(EG_Datastructures, E_InvalidPointer,
+      SV("C_RadixTree_put_P -> key already exists")));
+  }
+  *ref = &leaf->header;
+}
+
+static void* __C_RadixTree_at(C_RadixTree* self, StringView key) {
+  RadixLeaf* leaf = C_RadixTree_find(self, key);
+  if (!leaf) {
+    crash(E(EG_Datastructures, E_InvalidPointer,
+      SV("C_RadixTree_at -> key not found")));
+  }
+
+  return Ref(leaf->value);
+}
+
+bool C_RadixTree_contains(C_RadixTree* self, StringView key) {
+  return C_RadixTree_find(self, key) != null;
+}
+
+static void* C_RadixTree_take(C_RadixTree* self, RadixLeaf* leaf) {
+  void* value = leaf->value;
+  deallocate(leaf);
+  self->len--;
+  return value;
+}
+
+void* C_RadixTree_remove_R(C_RadixTree* self, StringView key) {
+  RadixHeader** ref = &self->root;
+  u32 depth = 0;
+
+  while (*ref) {
+    if ((*ref)->type == RadixLeafType) {
+      // only when the root is a leaf, other leaves are removed by the parent
+      RadixLeaf* leaf = (RadixLeaf*)*ref;
+      if (!RadixLeaf_matches(leaf, key, depth)) {
+        break;
+      }
+      *ref = null;
+      return C_RadixTree_take(self, leaf);
+    }
+
+    RadixNode* node = (RadixNode*)*ref;
+    if (!RadixNode_prefix_matches(node, key, depth)) {
+      break;
+    }
+    depth += node->prefix_len;
+    if (depth == key.len) {
+      RadixLeaf* leaf = node->end;
+      if (!leaf) {
+        break;
+      }
+      node->end = null;
+      RadixNode_collapse(ref);
+      return C_RadixTree_take(self, leaf);
+    }
+
+    u8 byte = (u8)key.chars[depth];
+    RadixHeader** child = RadixNode_find(node, byte);
+    if (!child) {
+      break;
+    }
+    if ((*child)->type == RadixLeafType) {
+      RadixLeaf* leaf = (RadixLeaf*)*child;
+      if (!RadixLeaf_matches(leaf, key, depth + 1)) {
+        break;
+      }
+      RadixNode_remove(ref, byte);
+      RadixNode_collapse(ref);
+      return C_RadixTree_take(self, leaf);
+    }
+    ref = child;
+    depth++;
+  }
+
+  crash(E(EG_Datastructures, E_InvalidPointer,
+    SV("C_RadixTree_remove_R -> key not found")));
+  return null;
+}
+
+void* C_RadixTree_longest_prefix_B(
+  C_RadixTree* self, StringView key, u32* prefix_len) {
+  RadixLeaf* best = null;
+  RadixHeader* header = self->root;
+  u32 depth = 0;
+
+  while (header) {
+    if (header->type == RadixLeafType) {
+      RadixLeaf* leaf = (RadixLeaf*)header;
+      if (leaf->len <= key.len &&
+          mem_equals(leaf->key + depth, key.chars + depth, leaf->len - depth)) {
+        best = leaf;
+      }
+      break;
+    }
+
+    RadixNode* node = (RadixNode*)header;
+    if (!RadixNode_prefix_matches(node, key, depth)) {
+      break;
+    }
+    depth += node->prefix_len;
+    if (node->end) {
+      best = node->end;
+    }
+    if (depth == key.len) {
+      break;
+    }
+
+    RadixHeader** child = RadixNode_find(node, (u8)key.chars[depth]);
+    if (!child) {
+      break;
+    }
+    header = *child;
+    depth++;
+  }
+
+  if (!best) {
+    return null;
+  }
+  if (prefix_len) {
+    *prefix_len = best->len;
+  }
+  return best->value;
+}
+
+void C_RadixTree_foreach_prefix(
+  C_RadixTree* self, StringView prefix, RadixVisit visit, void* data) {
+  RadixHeader* header = self->root;
+  u32 depth = 0;
+
+  while (header) {
+    if (header->type == RadixLeafType) {
+      RadixLeaf* leaf = (RadixLeaf*)header;
+      if (leaf->len >= prefix.len &&
+          mem_equals(
+            leaf->key + depth, prefix.chars + depth, prefix.len - depth)) {
+        visit(RadixLeaf_view(leaf), leaf->value, data);
+      }
+      return;
+    }
+
+    // every key below the node starts with prefix once it is used up
+    RadixNode* node = (RadixNode*)header;
+    u32 rest = prefix.len - depth;
+    u32 match = RadixNode_prefix_match(node, prefix, depth);
+    if (rest <= node->prefix_len) {
+      if (match == rest) {
+        RadixHeader_visit(header, visit, data);
+      }
+      return;
+    }
+    if (match < node->prefix_len) {
+      return;
+    }
+    depth += node->prefix_len;
+
+    RadixHeader** child = RadixNode_find(node, (u8)prefix.chars[depth]);
+    if (!child) {
+      return;
+    }
+    header = *child;
+    depth++;
+  }
+}
+
+void C_RadixTree_clear(C_RadixTree* self) {
+  if (self->root) {
+    RadixHeader_free(self->root);
+  }
+  self->root = null;
+  self->len = 0;
+}
+
+typedef struct {
+  C_StringBuilder* sink;
+  StringView sep;
+  StringView el_sep;
+  bool first;
+} RadixStrData;
+
+static bool C_RadixTree_visit_str(StringView key, void* value, void* data) {
+  RadixStrData* str_data = data;
+  if (!str_data->first) {
+    C_StringBuilder_append_view(str_data->sink, str_data->sep);
+  }
+  str_data->first = false;
+  C_StringBuilder_append_view(str_data->sink, key);
+  C_StringBuilder_append_view(str_data->sink, str_data->el_sep);
+  C_StringBuilder_append_str_P(str_data->sink, value);
+  return true;
+}
+
+void C_RadixTree_write_to(void* self, C_StringBuilder* sink, C_Format* format) {
+  C_RadixTree* self_cast = self;
+  format = format ? format : C_FormatMap;
+  StringView start = C_Format_get(format, FormatStart);
+  StringView sep = C_Format_get(format, FormatSep);
+  StringView el_sep = C_Format_get(format, FormatElSep);
+  StringView end = C_Format_get(format, FormatEnd);
+
+  C_StringBuilder_append_view(sink, start);
+  RadixStrData data = {sink, sep, el_sep, true};
+  if (self_cast->root) {
+    RadixHeader_visit(self_cast->root, C_RadixTree_visit_str, &data);
+  }
+  C_StringBuilder_append_view(sink, end);
+}
+
+C_String* C_RadixTree_to_str_format_R(void* self, C_String* format) {
+  return IFormattable_to_str_format_PR(self, format);
+}
+
+C_String* C_RadixTree_to_str_R(void* self) {
+  return IFormattable_to_str_PR(self);
+}
+
+/******************************
+ * get/set
+ ******************************/
+u32 C_RadixTree_get_len(C_RadixTree* self) { return self->len; }
+
+// {{{ _R _B wrappers
+void* C_RadixTree_at_B(C_RadixTree* self, StringView key) {
+  void* result = __C_RadixTree_at(self, key);
+  Unref(result);
+  return result;
+}
+
+void* C_RadixTree_at_R(C_RadixTree* self, StringView key) {
+  void* result = __C_RadixTree_at(self, key);
+  return result;
+}
+// }}}
@@ -0,0 +1,578 @@
+#include <c_base/base/errors/errors.h>
+#include <c_base/base/memory/allocator.h>
+#include <c_base/base/memory/memory.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/base/strings/C_StringBuilder.h>
+#include <c_base/base/strings/format.h>
+#include <c_base/base/strings/string_convert.h>
+#include <c_base/base/strings/strings.h>
+#include <c_base/ds/C_List.h>
+#include <c_base/ds/C_RoaringBitSet.h>
+#include <c_base/ds/ds_simd.h>
+#include <c_base/system.h>
+
+// an array container with more values becomes a bitmap
+#define RoaringArrayMax 4096
+#define RoaringBitmapWords 1024
+// returned by the container searches when there is no value
+#define RoaringContainerEnd 65536
+
+static Interface* C_RoaringBitSet_interfaces[2];
+static IFormattable C_RoaringBitSet_i_formattable = {0};
+
+/* the values of one high half. data is len sorted u16 with room for cap,
+ * or RoaringBitmapWords words. a stored container is never empty */
+typedef struct {
+  u16 key;
+  bool bitmap;
+  u32 len;
+  u32 cap;
+  void* data;
+} RoaringContainer;
+
+struct C_RoaringBitSet {
+  ClassObject base;
+
+  // sorted by key
+  RoaringContainer* containers;
+  u32 container_len;
+  u32 container_cap;
+
+  u64 len;
+};
+
+/******************************
+ * containers
+ ******************************/
+static RoaringContainer roaring_array_new(u16 key, u32 cap) {
+  RoaringContainer container = {key, false, 0, cap, null};
+  container.data = allocate(cap * sizeof(u16));
+  return container;
+}
+
+static RoaringContainer roaring_bitmap_new(u16 key) {
+  RoaringContainer container = {key, true, 0, 0, null};
+  container.data = allocate(RoaringBitmapWords * sizeof(u64));
+  mem_set(container.data, 0, RoaringBitmapWords * sizeof(u64));
+  return container;
+}
+
+// index of the first value >= value
+static u32 roaring_array_find(u16* values, u32 len, u16 value) {
+  u32 low = 0;
+  u32 high = len;
+  while (low < high) {
+    u32 mid = low + (high - low) / 2;
+    if (values[mid] < value) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return low;
+}
+
+static void roaring_bitmap_set(u64* words, u16 value) {
+  words[value / 64] |= 1ull << (value % 64);
+}
+
+static bool roaring_bitmap_test(u64* words, u16 value) {
+  return (words[value / 64] >> (value % 64)) & 1;
+}
+
+// writes the set bits as sorted values, returns their number
+static u32 roaring_bitmap_values(u64* words, u16* values) {
+  u32 len = 0;
+  for (u32 w = 0; w < RoaringBitmapWords; w++) {
+    u64 bits = words[w];
+    while (bits) {
+      values[len++] = (u16)(w * 64 + (u32)__builtin_ctzll(bits));
+      bits &= bits - 1;
+    }
+  }
+  return len;
+}
+
+static void roaring_container_to_bitmap(RoaringContainer* container) {
+  RoaringContainer bitmap = roaring_bitmap_new(container->key);
+  u16* values = container->data;
+  for (u32 i = 0; i < container->len; i++) {
+    roaring_bitmap_set(bitmap.data, values[i]);
+  }
+  bitmap.len = container->len;
+
+  deallocate(container->data);
+  *container = bitmap;
+}
+
+// the container has at least one value
+static void roaring_container_to_array(RoaringContainer* container) {
+  RoaringContainer array = roaring_array_new(container->key, container->len);
+  array.len = roaring_bitmap_values(container->data, array.data);
+
+  deallocate(container->data);
+  *container = array;
+}
+
+// bitmaps with few values become arrays, empty ones are freed
+static void roaring_container_shrink(RoaringContainer* container) {
+  if (!container->len) {
+    deallocate(container->data);
+    container->data = null;
+  } else if (container->bitmap && container->len <= RoaringArrayMax) {
+    roaring_container_to_array(container);
+  }
+}
+
+static RoaringContainer roaring_container_copy(RoaringContainer* container) {
+  RoaringContainer copy = *container;
+  u64 size = container->bitmap ? RoaringBitmapWords * sizeof(u64)
+                               : container->len * sizeof(u16);
+  copy.cap = container->bitmap ? 0 : container->len;
+  copy.data = allocate(size);
+  mem_copy(copy.data, container->data, size);
+  return copy;
+}
+
+static bool roaring_container_contains(RoaringContainer* container, u16 low) {
+  if (container->bitmap) {
+    return roaring_bitmap_test(container->data, low);
+  }
+
+  u16* values = container->data;
+  u32 index = roaring_array_find(values, container->len, low);
+  return index < container->len && values[index] == low;
+}
+
+static bool roaring_container_add(RoaringContainer* container, u16 low) {
+  if (container->bitmap) {
+    if (roaring_bitmap_test(container->data, low)) {
+      return false;
+    }
+    roaring_bitmap_set(container->data, low);
+    container->len++;
+    return true;
+  }
+
+  u16* values = container->data;
+  u32 index = roaring_array_find(values, container->len, low);
+  if (index < container->len && values[index] == low) {
+    return false;
+  }
+
+  if (container->len == RoaringArrayMax) {
+    roaring_container_to_bitmap(container);
+    return roaring_container_add(container, low);
+  }
+
+  if (container->len == container->cap) {
+    container->cap *= 2;
+    if (container->cap > RoaringArrayMax) {
+      container->cap = RoaringArrayMax;
+    }
+    container->data =
+      reallocate(container->data, container->cap * sizeof(u16));
+    values = container->data;
+  }
+
+  mem_copy(values + index + 1, values + index,
+    (container->len - index) * sizeof(u16));
+  values[index] = low;
+  container->len++;
+  return true;
+}
+
+static bool roaring_container_remove(RoaringContainer* container, u16 low) {
+  if (container->bitmap) {
+    if (!roaring_bitmap_test(container->data, low)) {
+      return false;
+    }
+    ((u64*)container->data)[low / 64] &= ~(1ull << (low % 64));
+    container->len--;
+    roaring_container_shrink(container);
+    return true;
+  }
+
+  u16* values = container->data;
+  u32 index = roaring_array_find(values, container->len, low);
+  if (index == container->len || values[index] != low) {
+    return false;
+  }
+
+  mem_copy(values + index, values + index + 1,
+    (container->len - index - 1) * sizeof(u16));
+  container->len--;
+  roaring_container_shrink(container);
+  return true;
+}
+
+// first value >= low, RoaringContainerEnd when there is none
+static u32 roaring_container_next(RoaringContainer* container, u32 low) {
+  if (container->bitmap) {
+    u64* words = container->data;
+    u32 word = low / 64;
+    u64 bits = words[word] & (~0ull << (low % 64));
+    while (!bits) {
+      if (++word == RoaringBitmapWords) {
+        return RoaringContainerEnd;
+      }
+      bits = words[word];
+    }
+    return word * 64 + (u32)__builtin_ctzll(bits);
+  }
+
+  u16* values = container->data;
+  u32 index = roaring_array_find(values, container->len, (u16)low);
+  return index < container->len ? values[index] : RoaringContainerEnd;
+}
+
+static RoaringContainer roaring_container_and(
+  RoaringContainer* a, RoaringContainer* b) {
+  if (a->bitmap && b->bitmap) {
+    RoaringContainer result = roaring_bitmap_new(a->key);
+    simd_and_bits(result.data, a->data, b->data, RoaringBitmapWords);
+    result.len = (u32)simd_popcount_bits(result.data, RoaringBitmapWords);
+    roaring_container_shrink(&result);
+    return result;
+  }
+
+  // an array is the smaller side, the result fits into it
+  if (a->bitmap) {
+    RoaringContainer* swap = a;
+    a = b;
+    b = swap;
+  }
+
+  RoaringContainer result = roaring_array_new(a->key, a->len);
+  u16* values = a->data;
+  u16* result_values = result.data;
+
+  if (b->bitmap) {
+    for (u32 i = 0; i < a->len; i++) {
+      if (roaring_bitmap_test(b->data, values[i])) {
+        result_values[result.len++] = values[i];
+      }
+    }
+  } else {
+    u16* other = b->data;
+    u32 i = 0;
+    u32 j = 0;
+    while (i < a->len && j < b->len) {
+      if (values[i] < other[j]) {
+        i++;
+      } else if (values[i] > other[j]) {
+        j++;
+      } else {
+        result_values[result.len++] = values[i];
+        i++;
+        j++;
+      }
+    }
+  }
+
+  roaring_container_shrink(&result);
+  return result;
+}
+
+static RoaringContainer roaring_container_or(
+  RoaringContainer* a, RoaringContainer* b) {
+  if (a->bitmap && b->bitmap) {
+    RoaringContainer result = roaring_bitmap_new(a->key);
+    simd_or_bits(result.data, a->data, b->data, RoaringBitmapWords);
+    result.len = (u32)simd_popcount_bits(result.data, RoaringBitmapWords);
+    return result;
+  }
+
+  if (a->bitmap || b->bitmap) {
+    RoaringContainer* array = a->bitmap ? b : a;
+    RoaringContainer result = roaring_container_copy(a->bitmap ? a : b);
+    u16* values = array->data;
+    for (u32 i = 0; i < array->len; i++) {
+      if (!roaring_bitmap_test(result.data, values[i])) {
+        roaring_bitmap_set(result.data, values[i]);
+        result.len++;
+      }
+    }
+    return result;
+  }
+
+  if (a->len + b->len > RoaringArrayMax) {
+    RoaringContainer result = roaring_container_copy(a);
+    roaring_container_to_bitmap(&result);
+    u16* values = b->data;
+    for (u32 i = 0; i < b->len; i++) {
+      roaring_bitmap_set(result.data, values[i]);
+    }
+    result.len = (u32)simd_popcount_bits(result.data, RoaringBitmapWords);
+    roaring_container_shrink(&result);
+    return result;
+  }
+
+  RoaringContainer result = roaring_array_new(a->key, a->len + b->len);
+  u16* values = a->data;
+  u16* other = b->data;
+  u16* result_values = result.data;
+  u32 i = 0;
+  u32 j = 0;
+  while (i < a->len || j < b->len) {
+    if (j == b->len || (i < a->len && values[i] < other[j])) {
+      result_values[result.len++] = values[i++];
+    } else if (i == a->len || other[j] < values[i]) {
+      result_values[result.len++] = other[j++];
+    } else {
+      result_values[result.len++] = values[i];
+      i++;
+      j++;
+    }
+  }
+  return result;
+}
+
+/******************************
+ * container array
+ ******************************/
+// index of the first container with a key >= key
+static u32 C_RoaringBitSet_find_container(C_RoaringBitSet* self, u16 key) {
+  u32 low = 0;
+  u32 high = self->container_len;
+  while (low < high) {
+    u32 mid = low + (high - low) / 2;
+    if (self->containers[mid].key < key) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return low;
+}
+
+static void C_RoaringBitSet_insert_container(
+  C_RoaringBitSet* self, u32 index, RoaringContainer container) {
+  if (self->container_len == self->container_cap) {
+    self->container_cap = self->container_cap ? self->container_cap * 2 : 4;
+    self->containers = reallocate(
+      self->containers, self->container_cap * sizeof(RoaringContainer));
+  }
+
+  mem_copy(self->containers + index + 1, self->containers + index,
+    (self->container_len - index) * sizeof(RoaringContainer));
+  self->containers[index] = container;
+  self->container_len++;
+  self->len += container.len;
+}
+
+static void C_RoaringBitSet_remove_container(
+  C_RoaringBitSet* self, u32 index) {
+  mem_copy(self->containers + index, self->containers + index + 1,
+    (self->container_len - index - 1) * sizeof(RoaringContainer));
+  self->container_len--;
+}
+
+// takes container, empty ones are dropped
+static void C_RoaringBitSet_push_container(
+  C_RoaringBitSet* self, RoaringContainer container) {
+  if (container.len) {
+    C_RoaringBitSet_insert_container(self, self->container_len, container);
+  }
+}
+
+/******************************
+ * new/dest
+ ******************************/
+C_RoaringBitSet* C_RoaringBitSet_new(void) {
+  if (!Interface_initialized((Interface*)&C_RoaringBitSet_i_formattable)) {
+    C_RoaringBitSet_i_formattable =
+      IFormattable_construct_write(C_RoaringBitSet_write_to);
+
+    C_RoaringBitSet_interfaces[0] =
+      (Interface*)&C_RoaringBitSet_i_formattable;
+    C_RoaringBitSet_interfaces[1] = null;
+  }
+
+  C_RoaringBitSet* self = allocate(sizeof(C_RoaringBitSet));
+  self->base =
+    ClassObject_construct(C_RoaringBitSet_destroy, C_RoaringBitSet_interfaces);
+
+  self->containers = null;
+  self->container_len = 0;
+  self->container_cap = 0;
+  self->len = 0;
+
+  return self;
+}
+
+void C_RoaringBitSet_destroy(void* self) {
+  C_RoaringBitSet* self_cast = self;
+  C_RoaringBitSet_clear(self_cast);
+  if (self_cast->containers) {
+    deallocate(self_cast->containers);
+  }
+}
+
+/******************************
+ * logic
+ ******************************/
+bool C_RoaringBitSet_add(C_RoaringBitSet* self, u32 value) {
+  u16 key = (u16)(value >> 16);
+  u32 index = C_RoaringBitSet_find_container(self, key);
+  if (index == self->container_len || self->containers[index].key != key) {
+    C_RoaringBitSet_insert_container(self, index, roaring_array_new(key, 4));
+  }
+
+  if (!roaring_container_add(&self->containers[index], (u16)value)) {
+    return false;
+  }
+  self->len++;
+  return true;
+}
+
+bool C_RoaringBitSet_remove(C_RoaringBitSet* self, u32 value) {
+  u16 key = (u16)(value >> 16);
+  u32 index = C_RoaringBitSet_find_container(self, key);
+  if (index == self->container_len || self->containers[index].key != key) {
+    return false;
+  }
+
+  RoaringContainer* container = &self->containers[index];
+  if (!roaring_container_remove(container, (u16)value)) {
+    return false;
+  }
+  self->len--;
+
+  if (!container->len) {
+    C_RoaringBitSet_remove_container(self, index);
+  }
+  return true;
+}
+
+bool C_RoaringBitSet_contains(C_RoaringBitSet* self, u32 value) {
+  u16 key = (u16)(value >> 16);
+  u32 index = C_RoaringBitSet_find_container(self, key);
+  return index < self->container_len &&
+         self->containers[index].key == key &&
+         roaring_container_contains(&self->containers[index], (u16)value);
+}
+
+u64 C_RoaringBitSet_find_next(C_RoaringBitSet* self, u64 from) {
+  if (from >= RoaringBitSetEnd) {
+    return RoaringBitSetEnd;
+  }
+
+  u16 key = (u16)(from >> 16);
+  u32 index = C_RoaringBitSet_find_container(self, key);
+  for (; index < self->container_len; index++) {
+    RoaringContainer* container = &self->containers[index];
+    // later containers are searched from their first value
+    u32 low = container->key == key ? (u32)(from & 0xffff) : 0;
+    u32 found = roaring_container_next(container, low);
+    if (found != RoaringContainerEnd) {
+      return ((u64)container->key << 16) | found;
+    }
+  }
+  return RoaringBitSetEnd;
+}
+
+C_RoaringBitSet* C_RoaringBitSet_and_R(
+  C_RoaringBitSet* a, C_RoaringBitSet* b) {
+  C_RoaringBitSet* result = C_RoaringBitSet_new();
+
+  u32 i = 0;
+  u32 j = 0;
+  while (i < a->container_len && j < b->container_len) {
+    RoaringContainer* container_a = &a->containers[i];
+    RoaringContainer* container_b = &b->containers[j];
+    if (container_a->key < container_b->key) {
+      i++;
+    } else if (container_a->key > container_b->key) {
+      j++;
+    } else {
+      C_RoaringBitSet_push_container(
+        result, roaring_container_and(container_a, container_b));
+      i++;
+      j++;
+    }
+  }
+
+  return result;
+}
+
+C_RoaringBitSet* C_RoaringBitSet_or_R(C_RoaringBitSet* a, C_RoaringBitSet* b) {
+  C_RoaringBitSet* result = C_RoaringBitSet_new();
+
+  u32 i = 0;
+  u32 j = 0;
+  while (i < a->container_len || j < b->container_len) {
+    RoaringContainer* container_a = i < a->container_len ? &a->containers[i]
+                                                         : null;
+    RoaringContainer* container_b = j < b->container_len ? &b->containers[j]
+                                                         : null;
+    if (!container_b || (container_a && container_a->key < container_b->key)) {
+      C_RoaringBitSet_push_container(
+        result, roaring_container_copy(container_a));
+      i++;
+    } else if (!container_a || container_b->key < container_a->key) {
+      C_RoaringBitSet_push_container(
+        result, roaring_container_copy(container_b));
+      j++;
+    } else {
+      C_RoaringBitSet_push_container(
+        result, roaring_container_or(container_a, container_b));
+      i++;
+      j++;
+    }
+  }
+
+  return result;
+}
+
+void C_RoaringBitSet_clear(C_RoaringBitSet* self) {
+  for (u32 i = 0; i < self->container_len; i++) {
+    deallocate(self->containers[i].data);
+  }
+  self->container_len = 0;
+  self->len = 0;
+}
+
+void C_RoaringBitSet_write_to(
+  void* self, C_StringBuilder* sink, C_Format* format) {
+  C_RoaringBitSet* self_cast = self;
+  format = format ? format : C_FormatSet;
+  StringView start = C_Format_get(format, FormatStart);
+  StringView end = C_Format_get(format, FormatEnd);
+  StringView sep = C_Format_get(format, FormatSep);
+
+  C_StringBuilder_append_view(sink, start);
+  u64 value = C_RoaringBitSet_find_next(self_cast, 0);
+  while (value != RoaringBitSetEnd) {
+    C_StringBuilder_append_u64(sink, value);
+    value = C_RoaringBitSet_find_next(self_cast, value + 1);
+    if (value != RoaringBitSetEnd) {
+      C_StringBuilder_append_view(sink, sep);
+    }
+  }
+  C_StringBuilder_append_view(sink, end);
+}
+
+C_String* C_RoaringBitSet_to_str_format_R(void* self, C_String* format) {
+  return IFormattable_to_str_format_PR(self, format);
+}
+
+C_String* C_RoaringBitSet_to_str_R(void* self) {
+  return IFormattable_to_str_PR(self);
+}
+
+/******************************
+ * get/set
+ ******************************/
+u64 C_RoaringBitSet_get_len(C_RoaringBitSet* self) { return self->len; }
+
+u64 C_RoaringBitSet_get_bytes(C_RoaringBitSet* self) {
+  u64 bytes = sizeof(C_RoaringBitSet) +
+              self->container_cap * sizeof(RoaringContainer);
+  for (u32 i = 0; i < self->container_len; i++) {
+    RoaringContainer* container = &self->containers[i];
+    bytes += container->bitmap ? RoaringBitmapWords * sizeof(u64)
+                               : container->cap * sizeof(u16);
+  }
+  return bytes;
+}
@@ -0,0 +1,250 @@
+#include <c_base/base/errors/errors.h>
+#include <c_base/base/memory/allocator.h>
+#include <c_base/base/memory/memory.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/base/strings/C_StringBuilder.h>
+#include <c_base/base/strings/format.h>
+#include <c_base/base/strings/strings.h>
+#include <c_base/ds/C_List.h>
+#include <c_base/ds/C_Slice.h>
+#include <c_base/system.h>
+
+static Interface* C_Slice_interfaces[3];
+static IFormattable C_Slice_i_formattable = {0};
+static IHashable C_Slice_i_hashable = {0};
+
+typedef enum {
+  SLICE_ARRAY,
+  SLICE_DARRAY,
+  SLICE_STRING,
+} SliceKind;
+
+/* the parent is looked up on every access instead of caching its data
+ * pointer, a darray moves its values when it grows */
+struct C_Slice {
+  ClassObject base;
+
+  void* parent;
+  SliceKind kind;
+  u32 begin;
+  u32 len;
+};
+
+static u32 __C_Slice_parent_len(void* parent, SliceKind kind) {
+  switch (kind) {
+  case SLICE_ARRAY:
+    return C_Array_get_len(parent);
+  case SLICE_DARRAY:
+    return C_DArray_get_len(parent);
+  default:
+    return C_String_get_len(parent);
+  }
+}
+
+static C_Slice* __C_Slice_new(
+  void* parent, SliceKind kind, u32 begin, u32 end) {
+  if (!Interface_initialized((Interface*)&C_Slice_i_formattable)) {
+    C_Slice_i_formattable = IFormattable_construct_write(C_Slice_write_to);
+    C_Slice_i_hashable = IHashable_construct(C_Slice_equals, C_Slice_hash);
+
+    C_Slice_interfaces[0] = (Interface*)&C_Slice_i_formattable;
+    C_Slice_interfaces[1] = (Interface*)&C_Slice_i_hashable;
+    C_Slice_interfaces[2] = null;
+  }
+
+  Ref(parent);
+  if (begin > end || end > __C_Slice_parent_len(parent, kind)) {
+    crash(E(EG_Datastructures, E_OutOfBounds,
+      SV("C_Slice_new -> range is outside of the parent")));
+  }
+
+  C_Slice* self = allocate(sizeof(C_Slice));
+  self->base = ClassObject_construct(C_Slice_destroy, C_Slice_interfaces);
+
+  self->parent = parent;
+  self->kind = kind;
+  self->begin = begin;
+  self->len = end - begin;
+
+  return self;
+}
+
+/* a darray can shrink under its slices */
+static void __C_Slice_check_parent(C_Slice* self) {
+  u32 parent_len = __C_Slice_parent_len(self->parent, self->kind);
+  if (self->begin + self->len > parent_len) {
+    crash(E(EG_Datastructures, E_OutOfBounds,
+      SV("C_Slice -> parent is shorter than the slice")));
+  }
+}
+
+/******************************
+ * new/dest
+ ******************************/
+C_Slice* C_Slice_new_array_P(C_Array* array, u32 begin, u32 end) {
+  return __C_Slice_new(array, SLICE_ARRAY, begin, end);
+}
+
+C_Slice* C_Slice_new_darray_P(C_DArray* darray, u32 begin, u32 end) {
+  return __C_Slice_new(darray, SLICE_DARRAY, begin, end);
+}
+
+C_Slice* C_Slice_new_string_P(C_String* string, u32 begin, u32 end) {
+  return __C_Slice_new(string, SLICE_STRING, begin, end);
+}
+
+void C_Slice_destroy(void* self) {
+  C_Slice* self_cast = self;
+  Unref(self_cast->parent);
+}
+
+/******************************
+ * logic
+ ******************************/
+C_Slice* C_Slice_slice_R(C_Slice* self, u32 begin, u32 end) {
+  if (begin > end || end > self->len) {
+    crash(E(EG_Datastructures, E_OutOfBounds,
+      SV("C_Slice_slice_R -> range is outside of the slice")));
+  }
+
+  return __C_Slice_new(
+    self->parent, self->kind, self->begin + begin, self->begin + end);
+}
+
+void* C_Slice_at_B(C_Slice* self, u32 index) {
+  if (index >= self->len) {
+    crash(E(EG_Datastructures, E_OutOfBounds,
+      SV("C_Slice_at -> index out of bounds")));
+  }
+
+  return C_Slice_get_data(self)[index];
+}
+
+void* C_Slice_at_R(C_Slice* self, u32 index) {
+  return Ref(C_Slice_at_B(self, index));
+}
+
+ascii C_Slice_char_at(C_Slice* self, u32 index) {
+  if (index >= self->len) {
+    crash(E(EG_Datastructures, E_OutOfBounds,
+      SV("C_Slice_char_at -> index out of bounds")));
+  }
+
+  return C_Slice_get_chars(self)[index];
+}
+
+C_Array* C_Slice_to_array_R(C_Slice* self) {
+  C_Array* array = C_Array_new(self->len);
+  C_SliceForeach(self, { C_Array_put_P(array, iter, value); });
+  return array;
+}
+
+C_String* C_Slice_to_string_R(C_Slice* self) {
+  if (self->kind != SLICE_STRING) {
+    crash(E(EG_Datastructures, E_InvalidArgument,
+      SV("C_Slice_to_string_R -> not a string slice")));
+  }
+
+  return C_String_substr_R(self->parent, self->begin, self->len);
+}
+
+u32 C_Slice_hash(void* self) {
+  C_Slice* self_cast = self;
+  if (self_cast->kind == SLICE_STRING) {
+    return hash(C_Slice_get_chars(self_cast), self_cast->len);
+  }
+
+  u32 hash_code = 0;
+  C_SliceForeach(
+    self_cast, { hash_code = 31 * hash_code + IHashable_hash(value); });
+  return hash_code;
+}
+
+bool C_Slice_equals(void* a, void* b) {
+  C_Slice* a_cast = a;
+  C_Slice* b_cast = b;
+
+  if (a_cast->len != b_cast->len) {
+    return false;
+  }
+
+  bool a_string = a_cast->kind == SLICE_STRING;
+  bool b_string = b_cast->kind == SLICE_STRING;
+  if (a_string != b_string) {
+    return false;
+  }
+  if (a_string) {
+    return mem_equals(
+      C_Slice_get_chars(a_cast), C_Slice_get_chars(b_cast), a_cast->len);
+  }
+
+  C_SliceForeach(a_cast, {
+    if (!IHashable_equals(C_Slice_at_B(b_cast, iter), value)) {
+      return false;
+    }
+  });
+
+  return true;
+}
+
+void C_Slice_write_to(void* self, C_StringBuilder* sink, C_Format* format) {
+  C_Slice* self_cast = self;
+  if (self_cast->kind == SLICE_STRING) {
+    C_StringBuilder_append_view(sink,
+      StringView_construct(C_Slice_get_chars(self_cast), self_cast->len));
+    return;
+  }
+
+  format = format ? format : C_FormatList;
+  StringView start = C_Format_get(format, FormatStart);
+  StringView end = C_Format_get(format, FormatEnd);
+  StringView sep = C_Format_get(format, FormatSep);
+
+  C_StringBuilder_append_view(sink, start);
+  C_SliceForeach(self, {
+    if (iter != 0) {
+      C_StringBuilder_append_view(sink, sep);
+    }
+    C_StringBuilder_append_str_P(sink, value);
+  });
+  C_StringBuilder_append_view(sink, end);
+}
+
+C_String* C_Slice_to_str_format_R(void* self, C_String* format) {
+  return IFormattable_to_str_format_PR(self, format);
+}
+
+C_String* C_Slice_to_str_R(void* self) { return IFormattable_to_str_PR(self); }
+
+/******************************
+ * get/set
+ ******************************/
+u32 C_Slice_get_len(C_Slice* self) { return self->len; }
+
+bool C_Slice_is_string(C_Slice* self) { return self->kind == SLICE_STRING; }
+
+void* C_Slice_get_parent_B(C_Slice* self) { return self->parent; }
+
+void** C_Slice_get_data(C_Slice* self) {
+  __C_Slice_check_parent(self);
+
+  switch (self->kind) {
+  case SLICE_ARRAY:
+    return C_Array_get_data(self->parent) + self->begin;
+  case SLICE_DARRAY:
+    return C_DArray_get_data(self->parent) + self->begin;
+  default:
+    crash(E(EG_Datastructures, E_InvalidArgument,
+      SV("C_Slice_get_data -> string slices have no values")));
+    return null;
+  }
+}
+
+ascii* C_Slice_get_chars(C_Slice* self) {
+  if (self->kind != SLICE_STRING) {
+    crash(E(EG_Datastructures, E_InvalidArgument,
+      SV("C_Slice_get_chars -> not a string slice")));
+  }
+
+  return C_String_get_chars(self->parent) + self->begin;
+}
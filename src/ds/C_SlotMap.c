@@ -0,0 +1,208 @@
+#include <c_base/base/errors/errors.h>
+#include <c_base/base/memory/allocator.h>
+#include <c_base/base/memory/memory.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_SlotMap.h>
+#include <c_base/system.h>
+
+// end of the free list
+#define SlotMapNone u32_MAX
+
+typedef struct {
+  // dense index of the value while used, next free slot while free
+  u32 index;
+  /* odd while used, even while free. it starts at 1 and is bumped by
+   * every insert and removal. a slot whose generation wraps to 0 is
+   * retired, so 0 is never part of a handle */
+  u32 generation;
+} SlotMapSlot;
+
+/* values and value_slots are the dense arrays, slots the sparse one. the
+ * dense arrays never hold more than the slots, all three share cap */
+struct C_SlotMap {
+  ClassObject base;
+
+  void** values;
+  // slot of every dense value
+  u32* value_slots;
+  u32 len;
+
+  SlotMapSlot* slots;
+  u32 slot_len;
+  u32 cap;
+  u32 free;
+};
+
+/******************************
+ * handles
+ ******************************/
+static u64 slot_map_handle(u32 slot, u32 generation) {
+  return (u64)generation << 32 | slot;
+}
+
+// the slot of handle, null when the handle is stale
+static SlotMapSlot* C_SlotMap_slot(C_SlotMap* self, u64 handle) {
+  u32 slot = (u32)handle;
+  if (slot >= self->slot_len) {
+    return null;
+  }
+
+  /* a free slot has an even generation, so a handle that was never
+   * returned cannot reach its free list link */
+  SlotMapSlot* result = &self->slots[slot];
+  return result->generation == handle >> 32 && (result->generation & 1)
+           ? result
+           : null;
+}
+
+static void C_SlotMap_grow(C_SlotMap* self) {
+  if (self->cap == u32_MAX) {
+    crash(E(EG_Datastructures, E_OutOfBounds,
+      SV("C_SlotMap_insert_P -> no slots left")));
+  }
+
+  u64 cap = (u64)self->cap * 2;
+  self->cap = cap < u32_MAX ? (u32)cap : u32_MAX;
+  self->values = reallocate(self->values, self->cap * sizeof(void*));
+  self->value_slots = reallocate(self->value_slots, self->cap * sizeof(u32));
+  self->slots = reallocate(self->slots, self->cap * sizeof(SlotMapSlot));
+}
+
+// bumps the generation to even and puts the slot on the free list
+static void C_SlotMap_release_slot(C_SlotMap* self, u32 slot) {
+  SlotMapSlot* entry = &self->slots[slot];
+  entry->generation++;
+  if (entry->generation == 0) {
+    // every handle of the slot was used, it is not reused
+    return;
+  }
+
+  entry->index = self->free;
+  self->free = slot;
+}
+
+/******************************
+ * new/dest
+ ******************************/
+C_SlotMap* C_SlotMap_new(void) { return C_SlotMap_new_cap(8); }
+
+C_SlotMap* C_SlotMap_new_cap(u32 cap) {
+  C_SlotMap* self = allocate(sizeof(C_SlotMap));
+  self->base = ClassObject_construct(C_SlotMap_destroy, null);
+
+  self->cap = cap ? cap : 1;
+  self->values = allocate(self->cap * sizeof(void*));
+  self->value_slots = allocate(self->cap * sizeof(u32));
+  self->len = 0;
+
+  self->slots = allocate(self->cap * sizeof(SlotMapSlot));
+  self->slot_len = 0;
+  self->free = SlotMapNone;
+
+  return self;
+}
+
+void C_SlotMap_destroy(void* self) {
+  C_SlotMap* self_cast = self;
+  for (u32 i = 0; i < self_cast->len; i++) {
+    Unref(self_cast->values[i]);
+  }
+
+  deallocate(self_cast->values);
+  deallocate(self_cast->value_slots);
+  deallocate(self_cast->slots);
+}
+
+/******************************
+ * logic
+ ******************************/
+u64 C_SlotMap_insert_P(C_SlotMap* self, void* value) {
+  if (!value) {
+    crash(E(EG_Datastructures, E_InvalidArgument,
+      SV("C_SlotMap_insert_P -> value is null")));
+  }
+
+  u32 slot = self->free;
+  if (slot != SlotMapNone) {
+    self->free = self->slots[slot].index;
+    self->slots[slot].generation++;
+  } else {
+    if (self->slot_len == self->cap) {
+      C_SlotMap_grow(self);
+    }
+    slot = self->slot_len++;
+    self->slots[slot].generation = 1;
+  }
+
+  // a free slot means len < slot_len <= cap, the dense arrays have room
+  self->slots[slot].index = self->len;
+  self->values[self->len] = Ref(value);
+  self->value_slots[self->len] = slot;
+  self->len++;
+
+  return slot_map_handle(slot, self->slots[slot].generation);
+}
+
+void* C_SlotMap_at_B(C_SlotMap* self, u64 handle) {
+  SlotMapSlot* slot = C_SlotMap_slot(self, handle);
+  return slot ? self->values[slot->index] : null;
+}
+
+bool C_SlotMap_contains(C_SlotMap* self, u64 handle) {
+  return C_SlotMap_slot(self, handle) != null;
+}
+
+void* C_SlotMap_remove_R(C_SlotMap* self, u64 handle) {
+  SlotMapSlot* slot = C_SlotMap_slot(self, handle);
+  if (!slot) {
+    return null;
+  }
+
+  u32 index = slot->index;
+  void* value = self->values[index];
+
+  // the last value fills the hole
+  self->len--;
+  if (index != self->len) {
+    u32 moved = self->value_slots[self->len];
+    self->values[index] = self->values[self->len];
+    self->value_slots[index] = moved;
+    self->slots[moved].index = index;
+  }
+
+  C_SlotMap_release_slot(self, (u32)handle);
+  return value;
+}
+
+void C_SlotMap_clear(C_SlotMap* self) {
+  for (u32 i = 0; i < self->len; i++) {
+    Unref(self->values[i]);
+    C_SlotMap_release_slot(self, self->value_slots[i]);
+  }
+  self->len = 0;
+}
+
+/******************************
+ * get/set
+ ******************************/
+u32 C_SlotMap_get_len(C_SlotMap* self) { return self->len; }
+
+u32 C_SlotMap_get_cap(C_SlotMap* self) { return self->cap; }
+
+void** C_SlotMap_get_values(C_SlotMap* self) { return self->values; }
+
+u64 C_SlotMap_handle_at(C_SlotMap* self, u32 index) {
+  if (index >= self->len) {
+    crash(E(EG_Datastructures, E_OutOfBounds,
+      SV("C_SlotMap_handle_at -> index out of bounds")));
+  }
+
+  u32 slot = self->value_slots[index];
+  return slot_map_handle(slot, self->slots[slot].generation);
+}
+
+// {{{ _R _B wrappers
+void* C_SlotMap_at_R(C_SlotMap* self, u64 handle) {
+  return Ref(C_SlotMap_at_B(self, handle));
+}
+// }}}
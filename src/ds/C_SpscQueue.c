@@ -0,0 +1,107 @@
+#include <c_base/base/errors/errors.h>
+#include <c_base/base/memory/allocator.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_SpscQueue.h>
+#include <c_base/os/os_atomic.h>
+#include <c_base/system.h>
+
+/* head and tail count every pop and push and are never wrapped, the slot
+ * is the count masked. each side keeps a copy of the other side's index
+ * and only reads the shared one when the copy says full or empty, so a
+ * busy queue moves the other cache line once per batch, not per value */
+struct C_SpscQueue {
+  ClassObject base;
+
+  void** slots;
+  u64 mask;
+
+  u8 pad0[OSCacheLineSize];
+
+  // written by the producer
+  u64 tail;
+  u64 head_cache;
+
+  u8 pad1[OSCacheLineSize];
+
+  // written by the consumer
+  u64 head;
+  u64 tail_cache;
+
+  u8 pad2[OSCacheLineSize];
+};
+
+/******************************
+ * new/dest
+ ******************************/
+C_SpscQueue* C_SpscQueue_new(u32 cap) {
+  if (cap == 0 || cap > (1u << 31)) {
+    crash(E(EG_Datastructures, E_InvalidArgument,
+      SV("C_SpscQueue_new -> cap has to be between 1 and 2^31")));
+  }
+
+  C_SpscQueue* self = allocate(sizeof(C_SpscQueue));
+  self->base = ClassObject_construct(C_SpscQueue_destroy, null);
+
+  u64 slot_count = 1;
+  while (slot_count < cap) {
+    slot_count <<= 1;
+  }
+  self->slots = allocate(slot_count * sizeof(void*));
+  self->mask = slot_count - 1;
+
+  self->tail = 0;
+  self->head_cache = 0;
+  self->head = 0;
+  self->tail_cache = 0;
+
+  return self;
+}
+
+void C_SpscQueue_destroy(void* self) {
+  C_SpscQueue* self_cast = self;
+  deallocate(self_cast->slots);
+}
+
+/******************************
+ * logic
+ ******************************/
+bool C_SpscQueue_push(C_SpscQueue* self, void* value) {
+  u64 tail = self->tail;
+  if (tail - self->head_cache > self->mask) {
+    self->head_cache = os_atomic_u64_load_acquire(&self->head);
+    if (tail - self->head_cache > self->mask) {
+      return false;
+    }
+  }
+
+  self->slots[tail & self->mask] = value;
+  // publishes the slot
+  os_atomic_u64_store_release(&self->tail, tail + 1);
+  return true;
+}
+
+bool C_SpscQueue_pop(C_SpscQueue* self, void** value) {
+  u64 head = self->head;
+  if (head == self->tail_cache) {
+    self->tail_cache = os_atomic_u64_load_acquire(&self->tail);
+    if (head == self->tail_cache) {
+      return false;
+    }
+  }
+
+  *value = self->slots[head & self->mask];
+  // hands the slot back to the producer
+  os_atomic_u64_store_release(&self->head, head + 1);
+  return true;
+}
+
+/******************************
+ * get/set
+ ******************************/
+u32 C_SpscQueue_get_len(C_SpscQueue* self) {
+  u64 head = os_atomic_u64_load_acquire(&self->head);
+  u64 tail = os_atomic_u64_load_acquire(&self->tail);
+  return (u32)(tail - head);
+}
+
+u32 C_SpscQueue_get_cap(C_SpscQueue* self) { return (u32)(self->mask + 1); }
@@ -0,0 +1,468 @@
+#include <c_base/base/errors/errors.h>
+#include <c_base/base/memory/allocator.h>
+#include <c_base/base/memory/memory.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/base/strings/C_StringBuilder.h>
+#include <c_base/base/strings/format.h>
+#include <c_base/base/strings/strings.h>
+#include <c_base/ds/C_Array.h>
+#include <c_base/ds/C_List.h>
+#include <c_base/ds/C_UnrolledList.h>
+#include <c_base/system.h>
+
+static Interface* C_UnrolledList_interfaces[3];
+static IHashable C_UnrolledList_i_hashable = {0};
+static IFormattable C_UnrolledList_i_formattable = {0};
+struct C_UnrolledList {
+  ClassObject base;
+  UnrolledNode* head;
+  UnrolledNode* tail;
+  u32 len;
+};
+
+/******************************
+ * UnrolledListCursor
+ ******************************/
+UnrolledListCursor UnrolledListCursor_construct(C_UnrolledList* list) {
+  UnrolledListCursor self;
+  self.node = list->head;
+  self.index = 0;
+  return self;
+}
+
+bool UnrolledListCursor_valid(UnrolledListCursor* self) {
+  return self->node != null;
+}
+
+void UnrolledListCursor_next(UnrolledListCursor* self) {
+  if (self->node == null) {
+    crash(E(EG_Datastructures, E_OutOfBounds,
+      SV("UnrolledListCursor_next -> cursor is past the end of the list")));
+  }
+
+  self->index++;
+  if (self->index >= self->node->len) {
+    self->node = self->node->next;
+    self->index = 0;
+  }
+}
+
+static void* __UnrolledListCursor_get(UnrolledListCursor* self) {
+  if (self->node == null) {
+    crash(E(EG_Datastructures, E_OutOfBounds,
+      SV("__UnrolledListCursor_get -> cursor is past the end of the list")));
+  }
+
+  return Ref(self->node->values[self->index]);
+}
+
+/******************************
+ * nodes
+ ******************************/
+static UnrolledNode* __UnrolledNode_new(void) {
+  UnrolledNode* node = allocate(sizeof(UnrolledNode));
+  node->next = null;
+  node->prev = null;
+  node->len = 0;
+  return node;
+}
+
+static void __C_UnrolledList_link_after(
+  C_UnrolledList* self, UnrolledNode* node, UnrolledNode* new_node) {
+  new_node->prev = node;
+
+  if (node == null) {
+    new_node->next = self->head;
+    self->head = new_node;
+  } else {
+    new_node->next = node->next;
+    node->next = new_node;
+  }
+
+  if (new_node->next == null) {
+    self->tail = new_node;
+  } else {
+    new_node->next->prev = new_node;
+  }
+}
+
+static void __C_UnrolledList_unlink(C_UnrolledList* self, UnrolledNode* node) {
+  if (node->prev == null) {
+    self->head = node->next;
+  } else {
+    node->prev->next = node->next;
+  }
+
+  if (node->next == null) {
+    self->tail = node->prev;
+  } else {
+    node->next->prev = node->prev;
+  }
+
+  deallocate(node);
+}
+
+// walks from the closer end of the list
+static UnrolledNode* __C_UnrolledList_locate(
+  C_UnrolledList* self, u32 index, u32* offset) {
+  UnrolledNode* node;
+
+  if (index < self->len / 2) {
+    node = self->head;
+    while (index >= node->len) {
+      index -= node->len;
+      node = node->next;
+    }
+  } else {
+    u32 from_end = self->len - index;
+    node = self->tail;
+    while (from_end > node->len) {
+      from_end -= node->len;
+      node = node->prev;
+    }
+    index = node->len - from_end;
+  }
+
+  *offset = index;
+  return node;
+}
+
+/******************************
+ * new/dest
+ ******************************/
+C_UnrolledList* C_UnrolledList_new(void) {
+  if (!Interface_initialized((Interface*)&C_UnrolledList_i_hashable)) {
+    C_UnrolledList_i_hashable =
+      IHashable_construct(C_UnrolledList_equals, C_UnrolledList_hash);
+    C_UnrolledList_i_formattable =
+      IFormattable_construct_write(C_UnrolledList_write_to);
+
+    C_UnrolledList_interfaces[0] = (Interface*)&C_UnrolledList_i_hashable;
+    C_UnrolledList_interfaces[1] = (Interface*)&C_UnrolledList_i_formattable;
+    C_UnrolledList_interfaces[2] = null;
+  }
+
+  C_UnrolledList* self = allocate(sizeof(C_UnrolledList));
+  self->base =
+    ClassObject_construct(C_UnrolledList_destroy, C_UnrolledList_interfaces);
+
+  self->len = 0;
+  self->head = null;
+  self->tail = null;
+
+  return self;
+}
+
+void C_UnrolledList_destroy(void* self) { C_UnrolledList_clear(self); }
+
+/******************************
+ * logic
+ ******************************/
+C_Array* C_UnrolledList_to_array_PR(C_UnrolledList* self) {
+  Ref(self);
+  C_Array* array = C_Array_new(self->len);
+  C_UnrolledListForeach(self, { C_Array_put_P(array, iter, value); });
+  Unref(self);
+  return array;
+}
+
+void C_UnrolledList_push_P(C_UnrolledList* self, void* value) {
+  Ref(value);
+  Ref(self);
+
+  if (self->tail == null || self->tail->len == UnrolledNodeCap) {
+    __C_UnrolledList_link_after(self, self->tail, __UnrolledNode_new());
+  }
+
+  self->tail->values[self->tail->len] = value;
+  self->tail->len++;
+
+  self->len++;
+  Unref(self);
+}
+
+void C_UnrolledList_push_front_P(C_UnrolledList* self, void* value) {
+  Ref(value);
+  Ref(self);
+
+  if (self->head == null || self->head->len == UnrolledNodeCap) {
+    __C_UnrolledList_link_after(self, null, __UnrolledNode_new());
+  }
+
+  UnrolledNode* node = self->head;
+  mem_copy(node->values + 1, node->values, node->len * sizeof(void*));
+  node->values[0] = value;
+  node->len++;
+
+  self->len++;
+  Unref(self);
+}
+
+void* C_UnrolledList_pop_R(C_UnrolledList* self) {
+  if (self->len == 0) {
+    crash(E(EG_Datastructures, E_OutOfBounds,
+      SV("C_UnrolledList_pop_R -> list is empty")));
+  }
+
+  UnrolledNode* node = self->tail;
+  node->len--;
+  void* value = node->values[node->len];
+
+  if (node->len == 0) {
+    __C_UnrolledList_unlink(self, node);
+  }
+
+  self->len--;
+  return value;
+}
+
+void* C_UnrolledList_pop_front_R(C_UnrolledList* self) {
+  if (self->len == 0) {
+    crash(E(EG_Datastructures, E_OutOfBounds,
+      SV("C_UnrolledList_pop_front_R -> list is empty")));
+  }
+
+  UnrolledNode* node = self->head;
+  void* value = node->values[0];
+  node->len--;
+  mem_copy(node->values, node->values + 1, node->len * sizeof(void*));
+
+  if (node->len == 0) {
+    __C_UnrolledList_unlink(self, node);
+  }
+
+  self->len--;
+  return value;
+}
+
+static void* __C_UnrolledList_peek(C_UnrolledList* self) {
+  if (self->len == 0) {
+    crash(E(EG_Datastructures, E_OutOfBounds,
+      SV("__C_UnrolledList_peek -> list is empty")));
+  }
+
+  return Ref(self->tail->values[self->tail->len - 1]);
+}
+
+static void* __C_UnrolledList_peek_front(C_UnrolledList* self) {
+  if (self->len == 0) {
+    crash(E(EG_Datastructures, E_OutOfBounds,
+      SV("__C_UnrolledList_peek_front -> list is empty")));
+  }
+
+  return Ref(self->head->values[0]);
+}
+
+void C_UnrolledList_add_P(C_UnrolledList* self, u32 index, void* value) {
+  if (index > self->len) {
+    crash(E(EG_Datastructures, E_OutOfBounds,
+      SV("C_UnrolledList_add_P -> index is outside of the list")));
+  }
+
+  Ref(self);
+
+  if (index == self->len) {
+    C_UnrolledList_push_P(self, value);
+    goto ret;
+  } else if (index == 0) {
+    C_UnrolledList_push_front_P(self, value);
+    goto ret;
+  }
+
+  Ref(value);
+
+  u32 offset;
+  UnrolledNode* node = __C_UnrolledList_locate(self, index, &offset);
+
+  // full node is split in half, the value goes into one of the halves
+  if (node->len == UnrolledNodeCap) {
+    UnrolledNode* new_node = __UnrolledNode_new();
+    u32 half = UnrolledNodeCap / 2;
+
+    mem_copy(new_node->values, node->values + half,
+      (UnrolledNodeCap - half) * sizeof(void*));
+    new_node->len = UnrolledNodeCap - half;
+    node->len = half;
+
+    __C_UnrolledList_link_after(self, node, new_node);
+
+    if (offset > half) {
+      node = new_node;
+      offset -= half;
+    }
+  }
+
+  mem_copy(node->values + offset + 1, node->values + offset,
+    (node->len - offset) * sizeof(void*));
+  node->values[offset] = value;
+  node->len++;
+
+  self->len++;
+
+ret:
+  Unref(self);
+}
+
+static void* __C_UnrolledList_at(C_UnrolledList* self, u32 index) {
+  if (index >= self->len) {
+    crash(E(EG_Datastructures, E_OutOfBounds,
+      SV("__C_UnrolledList_at -> index is outside of the list")));
+  }
+
+  u32 offset;
+  UnrolledNode* node = __C_UnrolledList_locate(self, index, &offset);
+  return Ref(node->values[offset]);
+}
+
+void* C_UnrolledList_remove_R(C_UnrolledList* self, u32 index) {
+  if (index >= self->len) {
+    crash(E(EG_Datastructures, E_OutOfBounds,
+      SV("C_UnrolledList_remove_R -> index is outside of the list")));
+  }
+
+  u32 offset;
+  UnrolledNode* node = __C_UnrolledList_locate(self, index, &offset);
+
+  void* result = node->values[offset];
+  node->len--;
+  mem_copy(node->values + offset, node->values + offset + 1,
+    (node->len - offset) * sizeof(void*));
+
+  self->len--;
+
+  if (node->len == 0) {
+    __C_UnrolledList_unlink(self, node);
+    return result;
+  }
+
+  // merge with the next node so removals do not leave near empty nodes behind
+  UnrolledNode* next = node->next;
+  if (node->len < UnrolledNodeCap / 2 && next != null &&
+      node->len + next->len <= UnrolledNodeCap) {
+    mem_copy(
+      node->values + node->len, next->values, next->len * sizeof(void*));
+    node->len += next->len;
+    __C_UnrolledList_unlink(self, next);
+  }
+
+  return result;
+}
+
+void C_UnrolledList_clear(C_UnrolledList* self) {
+  UnrolledNode* node = self->head;
+  while (node) {
+    UnrolledNode* remove_node = node;
+    node = node->next;
+
+    for (u32 i = 0; i < remove_node->len; i++) {
+      Unref(remove_node->values[i]);
+    }
+    deallocate(remove_node);
+  }
+
+  self->len = 0;
+  self->head = null;
+  self->tail = null;
+}
+
+u32 C_UnrolledList_hash(void* self) {
+  u32 hash_code = 0;
+  C_UnrolledListForeach(
+    self, { hash_code = 31 * hash_code + IHashable_hash(value); });
+  return hash_code;
+}
+
+bool C_UnrolledList_equals(void* a, void* b) {
+  C_UnrolledList* a_cast = a;
+  C_UnrolledList* b_cast = b;
+
+  if (a_cast->len != b_cast->len)
+    return false;
+
+  UnrolledListCursor b_cursor = UnrolledListCursor_construct(b_cast);
+  C_UnrolledListForeach(a_cast, {
+    if (!IHashable_equals(UnrolledListCursor_get_B(&b_cursor), value)) {
+      return false;
+    }
+    UnrolledListCursor_next(&b_cursor);
+  });
+
+  return true;
+}
+
+void C_UnrolledList_write_to(
+  void* self, C_StringBuilder* sink, C_Format* format) {
+  format = format ? format : C_FormatList;
+  StringView start = C_Format_get(format, FormatStart);
+  StringView end = C_Format_get(format, FormatEnd);
+  StringView sep = C_Format_get(format, FormatSep);
+
+  C_StringBuilder_append_view(sink, start);
+  C_UnrolledListForeach(self, {
+    if (iter != 0) {
+      C_StringBuilder_append_view(sink, sep);
+    }
+    C_StringBuilder_append_str_P(sink, value);
+  });
+  C_StringBuilder_append_view(sink, end);
+}
+
+C_String* C_UnrolledList_to_str_format_R(void* self, C_String* format) {
+  return IFormattable_to_str_format_PR(self, format);
+}
+
+C_String* C_UnrolledList_to_str_R(void* self) {
+  return IFormattable_to_str_PR(self);
+}
+
+// {{{ _R _B wrappers
+void* UnrolledListCursor_get_B(UnrolledListCursor* self) {
+  void* result = __UnrolledListCursor_get(self);
+  Unref(result);
+  return result;
+}
+
+void* UnrolledListCursor_get_R(UnrolledListCursor* self) {
+  void* result = __UnrolledListCursor_get(self);
+  return result;
+}
+
+void* C_UnrolledList_peek_B(C_UnrolledList* self) {
+  void* result = __C_UnrolledList_peek(self);
+  Unref(result);
+  return result;
+}
+
+void* C_UnrolledList_peek_R(C_UnrolledList* self) {
+  void* result = __C_UnrolledList_peek(self);
+  return result;
+}
+
+void* C_UnrolledList_peek_front_B(C_UnrolledList* self) {
+  void* result = __C_UnrolledList_peek_front(self);
+  Unref(result);
+  return result;
+}
+
+void* C_UnrolledList_peek_front_R(C_UnrolledList* self) {
+  void* result = __C_UnrolledList_peek_front(self);
+  return result;
+}
+
+void* C_UnrolledList_at_B(C_UnrolledList* self, u32 index) {
+  void* result = __C_UnrolledList_at(self, index);
+  Unref(result);
+  return result;
+}
+
+void* C_UnrolledList_at_R(C_UnrolledList* self, u32 index) {
+  void* result = __C_UnrolledList_at(self, index);
+  return result;
+}
+
+// }}}
+
+/******************************
+ * get/set
+ ******************************/
+u32 C_UnrolledList_get_len(C_UnrolledList* self) { return self->len; }
@@ -0,0 +1,239 @@
+#include <c_base/base/errors/errors.h>
+#include <c_base/base/memory/allocator.h>
+#include <c_base/base/memory/handles.h>
+#include <c_base/base/memory/memory.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/base/strings/C_StringBuilder.h>
+#include <c_base/base/strings/format.h>
+#include <c_base/base/strings/string_convert.h>
+#include <c_base/base/strings/strings.h>
+#include <c_base/ds/C_List.h>
+#include <c_base/ds/C_Vec.h>
+#include <c_base/system.h>
+
+#define GenericTypeImpl_C_Vec(T, write_func)                                   \
+  struct C_Vec_##T {                                                           \
+    ClassObject base;                                                          \
+                                                                               \
+    T* data;                                                                   \
+    u32 len;                                                                   \
+    u32 cap;                                                                   \
+  };                                                                           \
+  static IHashable Concat(C_Vec_##T, _i_hashable) = {0};                       \
+  static IFormattable Concat(C_Vec_##T, _i_formattable) = {0};                 \
+  static Interface* Concat(C_Vec_##T, _interfaces)[3];                         \
+                                                                               \
+  static void Concat(__C_Vec_##T, _grow)(C_Vec_##T * self, u32 cap) {          \
+    if (cap <= self->cap) {                                                    \
+      return;                                                                  \
+    }                                                                          \
+                                                                               \
+    u32 new_cap = self->cap * 2;                                               \
+    if (new_cap < cap) {                                                       \
+      new_cap = cap;                                                           \
+    }                                                                          \
+    self->data = reallocate(self->data, new_cap * sizeof(T));                  \
+    self->cap = new_cap;                                                       \
+  }                                                                            \
+                                                                               \
+  /****************************** new/dest ******************************/     \
+  C_Vec_##T* Concat(C_Vec_##T, _new)(void) {                                   \
+    return Concat(C_Vec_##T, _new_cap)(VecMinCap);                             \
+  }                                                                            \
+                                                                               \
+  C_Vec_##T* Concat(C_Vec_##T, _new_cap)(u32 cap) {                            \
+    if (!Interface_initialized(                                                \
+          (Interface*)&Concat(C_Vec_##T, _i_formattable))) {                   \
+      Concat(C_Vec_##T, _i_formattable) =                                      \
+        IFormattable_construct_write(Concat(C_Vec_##T, _write_to));            \
+      Concat(C_Vec_##T, _i_hashable) = IHashable_construct(                    \
+        Concat(C_Vec_##T, _equals), Concat(C_Vec_##T, _hash));                 \
+                                                                               \
+      Concat(C_Vec_##T, _interfaces)[0] =                                      \
+        (Interface*)&Concat(C_Vec_##T, _i_formattable);                        \
+      Concat(C_Vec_##T, _interfaces)[1] =                                      \
+        (Interface*)&Concat(C_Vec_##T, _i_hashable);                           \
+      Concat(C_Vec_##T, _interfaces)[2] = null;                                \
+    }                                                                          \
+                                                                               \
+    C_Vec_##T* self = allocate(sizeof(C_Vec_##T));                             \
+    self->base = ClassObject_construct(                                        \
+      Concat(C_Vec_##T, _destroy), Concat(C_Vec_##T, _interfaces));            \
+                                                                               \
+    self->cap = (cap < VecMinCap) ? VecMinCap : cap;                           \
+    self->len = 0;                                                             \
+    self->data = allocate(self->cap * sizeof(T));                              \
+                                                                               \
+    return self;                                                               \
+  }                                                                            \
+                                                                               \
+  C_Vec_##T* Concat(C_Vec_##T, _new_from)(T * values, u32 len) {               \
+    C_Vec_##T* self = Concat(C_Vec_##T, _new_cap)(len);                        \
+    mem_copy(self->data, values, len * sizeof(T));                             \
+    self->len = len;                                                           \
+    return self;                                                               \
+  }                                                                            \
+                                                                               \
+  C_Vec_##T* Concat(C_Vec_##T, _from_darray_P)(C_DArray * darray) {            \
+    Ref(darray);                                                               \
+    u32 len = C_DArray_get_len(darray);                                        \
+    C_Vec_##T* self = Concat(C_Vec_##T, _new_cap)(len);                        \
+                                                                               \
+    C_DArrayForeach(darray, {                                                  \
+      if (value == null) {                                                     \
+        crash(E(EG_Datastructures, E_InvalidArgument,                          \
+          SV("C_Vec_from_darray_P -> darray contains null")));                 \
+      }                                                                        \
+      self->data[iter] = Concat(C_Handle_##T, _get_value)(value);              \
+    });                                                                        \
+    self->len = len;                                                           \
+                                                                               \
+    Unref(darray);                                                             \
+    return self;                                                               \
+  }                                                                            \
+                                                                               \
+  void Concat(C_Vec_##T, _destroy)(void* self) {                               \
+    C_Vec_##T* self_cast = self;                                               \
+    deallocate(self_cast->data);                                               \
+  }                                                                            \
+                                                                               \
+  /****************************** logic ******************************/        \
+  C_DArray* Concat(C_Vec_##T, _to_darray_PR)(C_Vec_##T * self) {               \
+    Ref(self);                                                                 \
+    C_DArray* darray = C_DArray_new_cap(self->len == 0 ? 1 : self->len);       \
+                                                                               \
+    for (u32 i = 0; i < self->len; i++) {                                      \
+      C_DArray_push_P(                                                         \
+        darray, Pass(Concat(C_Handle_##T, _new)(self->data[i])));              \
+    }                                                                          \
+                                                                               \
+    Unref(self);                                                               \
+    return darray;                                                             \
+  }                                                                            \
+                                                                               \
+  void Concat(C_Vec_##T, _push)(C_Vec_##T * self, T value) {                   \
+    if (self->len == self->cap) {                                              \
+      Concat(__C_Vec_##T, _grow)(self, self->len + 1);                         \
+    }                                                                          \
+    self->data[self->len++] = value;                                           \
+  }                                                                            \
+                                                                               \
+  void Concat(C_Vec_##T, _push_many)(C_Vec_##T * self, T * values, u32 len) {  \
+    if (len > u32_MAX - self->len) {                                           \
+      crash(E(EG_Datastructures, E_OutOfBounds,                                \
+        SV("C_Vec_push_many -> vec would be longer than u32_MAX")));           \
+    }                                                                          \
+                                                                               \
+    /* values may be the vec's own data, which the grow can move */            \
+    u64 offset = (u64)values - (u64)self->data;                                \
+    bool own = offset < (u64)self->len * sizeof(T);                            \
+    Concat(__C_Vec_##T, _grow)(self, self->len + len);                         \
+    if (own) {                                                                 \
+      values = (T*)((u64)self->data + offset);                                 \
+    }                                                                          \
+    mem_copy(self->data + self->len, values, len * sizeof(T));                 \
+    self->len += len;                                                          \
+  }                                                                            \
+                                                                               \
+  T Concat(C_Vec_##T, _pop)(C_Vec_##T * self) {                                \
+    if (self->len == 0) {                                                      \
+      crash(E(EG_Datastructures, E_OutOfBounds,                                \
+        SV("C_Vec_pop -> vec is empty")));                                     \
+    }                                                                          \
+    return self->data[--self->len];                                            \
+  }                                                                            \
+                                                                               \
+  T Concat(C_Vec_##T, _at)(C_Vec_##T * self, u32 index) {                      \
+    if (index >= self->len) {                                                  \
+      crash(E(EG_Datastructures, E_OutOfBounds,                                \
+        SV("C_Vec_at -> index out of bounds")));                               \
+    }                                                                          \
+    return self->data[index];                                                  \
+  }                                                                            \
+                                                                               \
+  void Concat(C_Vec_##T, _put)(C_Vec_##T * self, u32 index, T value) {         \
+    if (index >= self->len) {                                                  \
+      crash(E(EG_Datastructures, E_OutOfBounds,                                \
+        SV("C_Vec_put -> index out of bounds")));                              \
+    }                                                                          \
+    self->data[index] = value;                                                 \
+  }                                                                            \
+                                                                               \
+  C_Vec_##T* Concat(C_Vec_##T, _slice_R)(C_Vec_##T * self, u32 begin,          \
+                                         u32 end) {                            \
+    if (begin > end || end > self->len) {                                      \
+      crash(E(EG_Datastructures, E_OutOfBounds,                                \
+        SV("C_Vec_slice_R -> range out of bounds")));                          \
+    }                                                                          \
+    return Concat(C_Vec_##T, _new_from)(self->data + begin, end - begin);      \
+  }                                                                            \
+                                                                               \
+  void Concat(C_Vec_##T, _resize)(C_Vec_##T * self, u32 len) {                 \
+    Concat(__C_Vec_##T, _grow)(self, len);                                     \
+    if (len > self->len) {                                                     \
+      mem_set(self->data + self->len, 0, (len - self->len) * sizeof(T));       \
+    }                                                                          \
+    self->len = len;                                                           \
+  }                                                                            \
+                                                                               \
+  void Concat(C_Vec_##T, _reserve)(C_Vec_##T * self, u32 cap) {                \
+    Concat(__C_Vec_##T, _grow)(self, cap);                                     \
+  }                                                                            \
+                                                                               \
+  void Concat(C_Vec_##T, _clear)(C_Vec_##T * self) { self->len = 0; }          \
+                                                                               \
+  u32 Concat(C_Vec_##T, _hash)(void* self) {                                   \
+    C_Vec_##T* self_cast = self;                                               \
+    return hash(self_cast->data, self_cast->len * sizeof(T));                  \
+  }                                                                            \
+                                                                               \
+  bool Concat(C_Vec_##T, _equals)(void* a, void* b) {                          \
+    C_Vec_##T* a_cast = a;                                                     \
+    C_Vec_##T* b_cast = b;                                                     \
+                                                                               \
+    if (a_cast->len != b_cast->len) {                                          \
+      return false;                                                            \
+    }                                                                          \
+    return mem_equals(a_cast->data, b_cast->data, a_cast->len * sizeof(T));    \
+  }                                                                            \
+                                                                               \
+  void Concat(C_Vec_##T, _write_to)(void* self, C_StringBuilder* sink,         \
+                                    C_Format* format) {                        \
+    C_Vec_##T* self_cast = self;                                               \
+    format = format ? format : C_FormatList;                                   \
+    StringView start = C_Format_get(format, FormatStart);                      \
+    StringView end = C_Format_get(format, FormatEnd);                          \
+    StringView sep = C_Format_get(format, FormatSep);                          \
+                                                                               \
+    C_StringBuilder_append_view(sink, start);                                  \
+    for (u32 i = 0; i < self_cast->len; i++) {                                 \
+      if (i != 0) {                                                            \
+        C_StringBuilder_append_view(sink, sep);                                \
+      }                                                                        \
+      write_func(self_cast->data[i], sink);                                    \
+    }                                                                          \
+    C_StringBuilder_append_view(sink, end);                                    \
+  }                                                                            \
+                                                                               \
+  C_String* Concat(C_Vec_##T, _to_str_format_R)(void* self,                    \
+                                                C_String* format) {            \
+    return IFormattable_to_str_format_PR(self, format);                        \
+  }                                                                            \
+                                                                               \
+  C_String* Concat(C_Vec_##T, _to_str_R)(void* self) {                         \
+    return IFormattable_to_str_PR(self);                                       \
+  }                                                                            \
+                                                                               \
+  /****************************** get/set ******************************/      \
+  u32 Concat(C_Vec_##T, _get_len)(C_Vec_##T * self) { return self->len; }      \
+                                                                               \
+  u32 Concat(C_Vec_##T, _get_cap)(C_Vec_##T * self) { return self->cap; }      \
+                                                                               \
+  T* Concat(C_Vec_##T, _get_data)(C_Vec_##T * self) { return self->data; }
+
+GenericTypeImpl_C_Vec(u8, u8_write_to)
+GenericTypeImpl_C_Vec(u32, u32_write_to)
+GenericTypeImpl_C_Vec(u64, u64_write_to)
+GenericTypeImpl_C_Vec(s64, s64_write_to)
+GenericTypeImpl_C_Vec(f32, f32_write_to)
+GenericTypeImpl_C_Vec(f64, f64_write_to)
@@ -1,3 +1,11 @@
 #include <c_base/ds/ds.h>
 
 GenericValImpl_ErrorCode(EG_Datastructures)
+
+// the finalizer of splitmix64
+u64 ds_hash_mix(u64 hash) {
+  hash += 0x9e3779b97f4a7c15ull;
+  hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ull;
+  hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebull;
+  return hash ^ (hash >> 31);
+}
@@ -0,0 +1,725 @@
+#include <c_base/base/errors/errors.h>
+#include <c_base/base/macros.h>
+#include <c_base/ds/ds_base.h>
+#include <c_base/ds/ds_simd.h>
+#include <c_base/env.h>
+#include <c_base/os/os_cpu.h>
+#include <c_base/system.h>
+
+#if defined(ARCH_X86_64) && (defined(COMPILER_GCC) || defined(COMPILER_CLANG))
+  #define SIMD_X86
+  #include <immintrin.h>
+#endif
+
+static SimdLevel simd_level = SIMD_SCALAR;
+static bool simd_level_detected = false;
+
+/******************************
+ * level
+ ******************************/
+SimdLevel simd_detect_level(void) {
+#if defined(SIMD_X86)
+  u32 regs[4];
+  os_cpuid(0, 0, regs);
+  u32 max_leaf = regs[0];
+
+  os_cpuid(1, 0, regs);
+  if (!(regs[3] & (1 << 26))) {
+    return SIMD_SCALAR;
+  }
+
+  /* avx needs the os to save the ymm registers,
+   * xcr0 bits 1 and 2 are the xmm and ymm state */
+  bool osxsave = (regs[2] & (1 << 27)) != 0;
+  bool avx = (regs[2] & (1 << 28)) != 0;
+  if (max_leaf < 7 || !osxsave || !avx || (os_xgetbv(0) & 6) != 6) {
+    return SIMD_SSE2;
+  }
+
+  os_cpuid(7, 0, regs);
+  return (regs[1] & (1 << 5)) ? SIMD_AVX2 : SIMD_SSE2;
+#else
+  return SIMD_SCALAR;
+#endif
+}
+
+SimdLevel simd_get_level(void) {
+  if (!simd_level_detected) {
+    simd_level = simd_detect_level();
+    simd_level_detected = true;
+  }
+  return simd_level;
+}
+
+SimdLevel simd_set_level(SimdLevel level) {
+  SimdLevel max = simd_detect_level();
+  simd_level = (level > max) ? max : level;
+  simd_level_detected = true;
+  return simd_level;
+}
+
+char* simd_level_name(SimdLevel level) {
+  switch (level) {
+  case SIMD_AVX2:
+    return "avx2";
+  case SIMD_SSE2:
+    return "sse2";
+  default:
+    return "scalar";
+  }
+}
+
+/******************************
+ * scalar
+ ******************************/
+#define ScalarKernelsImpl(T, A)                                                \
+  static A scalar_sum_##T(T* data, u32 len) {                                  \
+    A result = 0;                                                              \
+    for (u32 i = 0; i < len; i++) {                                            \
+      result += data[i];                                                       \
+    }                                                                          \
+    return result;                                                             \
+  }                                                                            \
+                                                                               \
+  static T scalar_min_##T(T* data, u32 len) {                                  \
+    T result = data[0];                                                        \
+    for (u32 i = 1; i < len; i++) {                                            \
+      if (data[i] < result) {                                                  \
+        result = data[i];                                                      \
+      }                                                                        \
+    }                                                                          \
+    return result;                                                             \
+  }                                                                            \
+                                                                               \
+  static T scalar_max_##T(T* data, u32 len) {                                  \
+    T result = data[0];                                                        \
+    for (u32 i = 1; i < len; i++) {                                            \
+      if (data[i] > result) {                                                  \
+        result = data[i];                                                      \
+      }                                                                        \
+    }                                                                          \
+    return result;                                                             \
+  }                                                                            \
+                                                                               \
+  static u32 scalar_find_##T(T* data, u32 len, T value) {                      \
+    for (u32 i = 0; i < len; i++) {                                            \
+      if (data[i] == value) {                                                  \
+        return i;                                                              \
+      }                                                                        \
+    }                                                                          \
+    return len;                                                                \
+  }                                                                            \
+                                                                               \
+  static u32 scalar_count_##T(T* data, u32 len, T value) {                     \
+    u32 count = 0;                                                             \
+    for (u32 i = 0; i < len; i++) {                                            \
+      count += data[i] == value;                                               \
+    }                                                                          \
+    return count;                                                              \
+  }                                                                            \
+                                                                               \
+  static A scalar_dot_##T(T* a, T* b, u32 len) {                               \
+    A result = 0;                                                              \
+    for (u32 i = 0; i < len; i++) {                                            \
+      result += (A)a[i] * b[i];                                                \
+    }                                                                          \
+    return result;                                                             \
+  }                                                                            \
+                                                                               \
+  static void scalar_add_##T(T* dst, T* a, T* b, u32 len) {                    \
+    for (u32 i = 0; i < len; i++) {                                            \
+      dst[i] = a[i] + b[i];                                                    \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  static void scalar_mul_##T(T* dst, T* a, T* b, u32 len) {                    \
+    for (u32 i = 0; i < len; i++) {                                            \
+      dst[i] = a[i] * b[i];                                                    \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  static void scalar_scale_##T(T* dst, T* a, T factor, u32 len) {              \
+    for (u32 i = 0; i < len; i++) {                                            \
+      dst[i] = a[i] * factor;                                                  \
+    }                                                                          \
+  }
+
+ScalarKernelsImpl(u32, u64)
+ScalarKernelsImpl(u64, u64)
+ScalarKernelsImpl(f32, f32)
+ScalarKernelsImpl(f64, f64)
+
+#define ScalarBitsImpl(name, op)                                               \
+  static void scalar_##name##_bits(u64* dst, u64* a, u64* b, u32 len) {        \
+    for (u32 i = 0; i < len; i++) {                                            \
+      dst[i] = op;                                                             \
+    }                                                                          \
+  }
+
+ScalarBitsImpl(and, a[i] & b[i])
+ScalarBitsImpl(or, a[i] | b[i])
+ScalarBitsImpl(xor, a[i] ^ b[i])
+ScalarBitsImpl(andnot, a[i] & ~b[i])
+
+static u64 scalar_popcount_bits(u64* data, u32 len) {
+  u64 count = 0;
+  for (u32 i = 0; i < len; i++) {
+    count += (u64)__builtin_popcountll(data[i]);
+  }
+  return count;
+}
+
+#if defined(SIMD_X86)
+
+  // the helpers are inlined in debug builds too
+  #define SimdInline static inline __attribute__((always_inline))
+  #define TargetSSE2 __attribute__((target("sse2")))
+  #define TargetAVX2 __attribute__((target("avx2")))
+
+/******************************
+ * vector kernels
+ ******************************/
+  /* the kernels are written once against a set of ops per level and type,
+   * SimdOp(SSE2, u32, Load) expands to SSE2_u32_Load. ops:
+   * Vec, Width, Load, Store, Set1, Zero, Add, Mul, Min, Max,
+   * Eq (bitmask of the equal lanes), SumStep and DotStep (add into an
+   * accumulator holding A lanes) */
+  #define SimdOp(ISA, T, op) ISA##_##T##_##op
+
+  #define SimdMinMaxImpl(isa, ISA, T, name, Op, cmp)                           \
+    static Target##ISA T isa##_##name##_##T(T* data, u32 len) {               \
+      T result = data[0];                                                      \
+      u32 i = 0;                                                               \
+                                                                               \
+      if (len >= SimdOp(ISA, T, Width)) {                                      \
+        SimdOp(ISA, T, Vec) acc = SimdOp(ISA, T, Load)(data);                  \
+        for (i = SimdOp(ISA, T, Width); i + SimdOp(ISA, T, Width) <= len;      \
+             i += SimdOp(ISA, T, Width)) {                                     \
+          acc = SimdOp(ISA, T, Op)(acc, SimdOp(ISA, T, Load)(data + i));       \
+        }                                                                      \
+                                                                               \
+        T lanes[SimdOp(ISA, T, Width)];                                        \
+        SimdOp(ISA, T, Store)(lanes, acc);                                     \
+        for (u32 l = 0; l < SimdOp(ISA, T, Width); l++) {                      \
+          if (lanes[l] cmp result) {                                           \
+            result = lanes[l];                                                 \
+          }                                                                    \
+        }                                                                      \
+      }                                                                        \
+                                                                               \
+      for (; i < len; i++) {                                                   \
+        if (data[i] cmp result) {                                              \
+          result = data[i];                                                    \
+        }                                                                      \
+      }                                                                        \
+      return result;                                                           \
+    }
+
+  #define SimdElementwiseImpl(isa, ISA, T, name, Op, op)                       \
+    static Target##ISA void isa##_##name##_##T(                                \
+      T* dst, T* a, T* b, u32 len) {                                           \
+      u32 i = 0;                                                               \
+      for (; i + SimdOp(ISA, T, Width) <= len; i += SimdOp(ISA, T, Width)) {   \
+        SimdOp(ISA, T, Store)(dst + i,                                         \
+          SimdOp(ISA, T, Op)(                                                  \
+            SimdOp(ISA, T, Load)(a + i), SimdOp(ISA, T, Load)(b + i)));        \
+      }                                                                        \
+      for (; i < len; i++) {                                                   \
+        dst[i] = a[i] op b[i];                                                 \
+      }                                                                        \
+    }
+
+  #define SimdKernelsImpl(isa, ISA, T, A)                                      \
+    static Target##ISA A isa##_sum_##T(T* data, u32 len) {                     \
+      SimdOp(ISA, T, Vec) acc = SimdOp(ISA, T, Zero)();                        \
+      u32 i = 0;                                                               \
+      for (; i + SimdOp(ISA, T, Width) <= len; i += SimdOp(ISA, T, Width)) {   \
+        acc = SimdOp(ISA, T, SumStep)(acc, SimdOp(ISA, T, Load)(data + i));    \
+      }                                                                        \
+                                                                               \
+      A lanes[sizeof(acc) / sizeof(A)];                                        \
+      SimdOp(ISA, T, Store)(lanes, acc);                                       \
+      A result = 0;                                                            \
+      for (u32 l = 0; l < sizeof(acc) / sizeof(A); l++) {                      \
+        result += lanes[l];                                                    \
+      }                                                                        \
+      for (; i < len; i++) {                                                   \
+        result += data[i];                                                     \
+      }                                                                        \
+      return result;                                                           \
+    }                                                                          \
+                                                                               \
+    SimdMinMaxImpl(isa, ISA, T, min, Min, <)                                   \
+    SimdMinMaxImpl(isa, ISA, T, max, Max, >)                                   \
+                                                                               \
+    static Target##ISA u32 isa##_find_##T(T* data, u32 len, T value) {         \
+      SimdOp(ISA, T, Vec) needle = SimdOp(ISA, T, Set1)(value);                \
+      u32 i = 0;                                                               \
+      for (; i + SimdOp(ISA, T, Width) <= len; i += SimdOp(ISA, T, Width)) {   \
+        s32 mask = SimdOp(ISA, T, Eq)(SimdOp(ISA, T, Load)(data + i), needle); \
+        if (mask != 0) {                                                       \
+          return i + __builtin_ctz(mask);                                      \
+        }                                                                      \
+      }                                                                        \
+      for (; i < len; i++) {                                                   \
+        if (data[i] == value) {                                                \
+          return i;                                                            \
+        }                                                                      \
+      }                                                                        \
+      return len;                                                              \
+    }                                                                          \
+                                                                               \
+    static Target##ISA u32 isa##_count_##T(T* data, u32 len, T value) {        \
+      SimdOp(ISA, T, Vec) needle = SimdOp(ISA, T, Set1)(value);                \
+      u32 count = 0;                                                           \
+      u32 i = 0;                                                               \
+      for (; i + SimdOp(ISA, T, Width) <= len; i += SimdOp(ISA, T, Width)) {   \
+        count += __builtin_popcount(                                           \
+          SimdOp(ISA, T, Eq)(SimdOp(ISA, T, Load)(data + i), needle));         \
+      }                                                                        \
+      for (; i < len; i++) {                                                   \
+        count += data[i] == value;                                             \
+      }                                                                        \
+      return count;                                                            \
+    }                                                                          \
+                                                                               \
+    static Target##ISA A isa##_dot_##T(T* a, T* b, u32 len) {                  \
+      SimdOp(ISA, T, Vec) acc = SimdOp(ISA, T, Zero)();                        \
+      u32 i = 0;                                                               \
+      for (; i + SimdOp(ISA, T, Width) <= len; i += SimdOp(ISA, T, Width)) {   \
+        acc = SimdOp(ISA, T, DotStep)(                                         \
+          acc, SimdOp(ISA, T, Load)(a + i), SimdOp(ISA, T, Load)(b + i));      \
+      }                                                                        \
+                                                                               \
+      A lanes[sizeof(acc) / sizeof(A)];                                        \
+      SimdOp(ISA, T, Store)(lanes, acc);                                       \
+      A result = 0;                                                            \
+      for (u32 l = 0; l < sizeof(acc) / sizeof(A); l++) {                      \
+        result += lanes[l];                                                    \
+      }                                                                        \
+      for (; i < len; i++) {                                                   \
+        result += (A)a[i] * b[i];                                              \
+      }                                                                        \
+      return result;                                                           \
+    }                                                                          \
+                                                                               \
+    SimdElementwiseImpl(isa, ISA, T, add, Add, +)                              \
+    SimdElementwiseImpl(isa, ISA, T, mul, Mul, *)                              \
+                                                                               \
+    static Target##ISA void isa##_scale_##T(                                   \
+      T* dst, T* a, T factor, u32 len) {                                       \
+      SimdOp(ISA, T, Vec) factors = SimdOp(ISA, T, Set1)(factor);              \
+      u32 i = 0;                                                               \
+      for (; i + SimdOp(ISA, T, Width) <= len; i += SimdOp(ISA, T, Width)) {   \
+        SimdOp(ISA, T, Store)(dst + i,                                         \
+          SimdOp(ISA, T, Mul)(SimdOp(ISA, T, Load)(a + i), factors));          \
+      }                                                                        \
+      for (; i < len; i++) {                                                   \
+        dst[i] = a[i] * factor;                                                \
+      }                                                                        \
+    }
+
+/******************************
+ * sse2
+ ******************************/
+/* sse2 has no unsigned compares, no 64 bit compares and no 32 bit low
+ * multiply, they are built from the signed and 32x32->64 versions */
+SimdInline TargetSSE2 __m128i sse2_select(
+  __m128i mask, __m128i a, __m128i b) {
+  return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+SimdInline TargetSSE2 __m128i sse2_gt_u32(__m128i a, __m128i b) {
+  __m128i sign = _mm_set1_epi32((s32)0x80000000);
+  return _mm_cmpgt_epi32(_mm_xor_si128(a, sign), _mm_xor_si128(b, sign));
+}
+
+/* a 64 bit lane is greater when its high half is, or the high halves are
+ * equal and the low half is. the result is copied to both halves */
+SimdInline TargetSSE2 __m128i sse2_gt_u64(__m128i a, __m128i b) {
+  __m128i sign = _mm_set1_epi32((s32)0x80000000);
+  a = _mm_xor_si128(a, sign);
+  b = _mm_xor_si128(b, sign);
+
+  __m128i gt = _mm_cmpgt_epi32(a, b);
+  __m128i eq = _mm_cmpeq_epi32(a, b);
+  __m128i gt_low = _mm_shuffle_epi32(gt, 0xa0);
+  __m128i result = _mm_or_si128(gt, _mm_and_si128(eq, gt_low));
+  return _mm_shuffle_epi32(result, 0xf5);
+}
+
+SimdInline TargetSSE2 s32 sse2_eq_u64(__m128i a, __m128i b) {
+  __m128i eq = _mm_cmpeq_epi32(a, b);
+  eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, 0xb1));
+  return _mm_movemask_pd(_mm_castsi128_pd(eq));
+}
+
+SimdInline TargetSSE2 __m128i sse2_vmul_u32(__m128i a, __m128i b) {
+  __m128i even = _mm_mul_epu32(a, b);
+  __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+  return _mm_unpacklo_epi32(
+    _mm_shuffle_epi32(even, 0x08), _mm_shuffle_epi32(odd, 0x08));
+}
+
+// the high halves multiplied with each other only reach past bit 64
+SimdInline TargetSSE2 __m128i sse2_vmul_u64(__m128i a, __m128i b) {
+  __m128i low = _mm_mul_epu32(a, b);
+  __m128i cross = _mm_add_epi64(_mm_mul_epu32(_mm_srli_epi64(a, 32), b),
+    _mm_mul_epu32(a, _mm_srli_epi64(b, 32)));
+  return _mm_add_epi64(low, _mm_slli_epi64(cross, 32));
+}
+
+SimdInline TargetSSE2 __m128i sse2_sum_step_u32(__m128i acc, __m128i v) {
+  __m128i zero = _mm_setzero_si128();
+  return _mm_add_epi64(acc,
+    _mm_add_epi64(_mm_unpacklo_epi32(v, zero), _mm_unpackhi_epi32(v, zero)));
+}
+
+SimdInline TargetSSE2 __m128i sse2_dot_step_u32(
+  __m128i acc, __m128i a, __m128i b) {
+  __m128i even = _mm_mul_epu32(a, b);
+  __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+  return _mm_add_epi64(acc, _mm_add_epi64(even, odd));
+}
+
+  #define SSE2_u32_Vec __m128i
+  #define SSE2_u32_Width 4
+  #define SSE2_u32_Load(p) _mm_loadu_si128((__m128i*)(p))
+  #define SSE2_u32_Store(p, v) _mm_storeu_si128((__m128i*)(p), v)
+  #define SSE2_u32_Set1(x) _mm_set1_epi32((s32)(x))
+  #define SSE2_u32_Zero() _mm_setzero_si128()
+  #define SSE2_u32_Add(a, b) _mm_add_epi32(a, b)
+  #define SSE2_u32_Mul(a, b) sse2_vmul_u32(a, b)
+  #define SSE2_u32_Min(a, b) sse2_select(sse2_gt_u32(a, b), b, a)
+  #define SSE2_u32_Max(a, b) sse2_select(sse2_gt_u32(a, b), a, b)
+  #define SSE2_u32_Eq(a, b)                                                    \
+    _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b)))
+  #define SSE2_u32_SumStep(acc, v) sse2_sum_step_u32(acc, v)
+  #define SSE2_u32_DotStep(acc, a, b) sse2_dot_step_u32(acc, a, b)
+
+  #define SSE2_u64_Vec __m128i
+  #define SSE2_u64_Width 2
+  #define SSE2_u64_Load(p) _mm_loadu_si128((__m128i*)(p))
+  #define SSE2_u64_Store(p, v) _mm_storeu_si128((__m128i*)(p), v)
+  #define SSE2_u64_Set1(x) _mm_set1_epi64x((s64)(x))
+  #define SSE2_u64_Zero() _mm_setzero_si128()
+  #define SSE2_u64_Add(a, b) _mm_add_epi64(a, b)
+  #define SSE2_u64_Mul(a, b) sse2_vmul_u64(a, b)
+  #define SSE2_u64_Min(a, b) sse2_select(sse2_gt_u64(a, b), b, a)
+  #define SSE2_u64_Max(a, b) sse2_select(sse2_gt_u64(a, b), a, b)
+  #define SSE2_u64_Eq(a, b) sse2_eq_u64(a, b)
+  #define SSE2_u64_SumStep(acc, v) _mm_add_epi64(acc, v)
+  #define SSE2_u64_DotStep(acc, a, b) _mm_add_epi64(acc, sse2_vmul_u64(a, b))
+
+  #define SSE2_f32_Vec __m128
+  #define SSE2_f32_Width 4
+  #define SSE2_f32_Load(p) _mm_loadu_ps((f32*)(p))
+  #define SSE2_f32_Store(p, v) _mm_storeu_ps((f32*)(p), v)
+  #define SSE2_f32_Set1(x) _mm_set1_ps(x)
+  #define SSE2_f32_Zero() _mm_setzero_ps()
+  #define SSE2_f32_Add(a, b) _mm_add_ps(a, b)
+  #define SSE2_f32_Mul(a, b) _mm_mul_ps(a, b)
+  #define SSE2_f32_Min(a, b) _mm_min_ps(a, b)
+  #define SSE2_f32_Max(a, b) _mm_max_ps(a, b)
+  #define SSE2_f32_Eq(a, b) _mm_movemask_ps(_mm_cmpeq_ps(a, b))
+  #define SSE2_f32_SumStep(acc, v) _mm_add_ps(acc, v)
+  #define SSE2_f32_DotStep(acc, a, b) _mm_add_ps(acc, _mm_mul_ps(a, b))
+
+  #define SSE2_f64_Vec __m128d
+  #define SSE2_f64_Width 2
+  #define SSE2_f64_Load(p) _mm_loadu_pd((f64*)(p))
+  #define SSE2_f64_Store(p, v) _mm_storeu_pd((f64*)(p), v)
+  #define SSE2_f64_Set1(x) _mm_set1_pd(x)
+  #define SSE2_f64_Zero() _mm_setzero_pd()
+  #define SSE2_f64_Add(a, b) _mm_add_pd(a, b)
+  #define SSE2_f64_Mul(a, b) _mm_mul_pd(a, b)
+  #define SSE2_f64_Min(a, b) _mm_min_pd(a, b)
+  #define SSE2_f64_Max(a, b) _mm_max_pd(a, b)
+  #define SSE2_f64_Eq(a, b) _mm_movemask_pd(_mm_cmpeq_pd(a, b))
+  #define SSE2_f64_SumStep(acc, v) _mm_add_pd(acc, v)
+  #define SSE2_f64_DotStep(acc, a, b) _mm_add_pd(acc, _mm_mul_pd(a, b))
+
+SimdKernelsImpl(sse2, SSE2, u32, u64)
+SimdKernelsImpl(sse2, SSE2, u64, u64)
+SimdKernelsImpl(sse2, SSE2, f32, f32)
+SimdKernelsImpl(sse2, SSE2, f64, f64)
+
+/******************************
+ * avx2
+ ******************************/
+/* avx2 has unsigned 32 bit min/max and a signed 64 bit compare,
+ * 64 bit multiplies are still built from 32x32->64 */
+SimdInline TargetAVX2 __m256i avx2_gt_u64(__m256i a, __m256i b) {
+  __m256i sign = _mm256_set1_epi64x((s64)((u64)1 << 63));
+  return _mm256_cmpgt_epi64(
+    _mm256_xor_si256(a, sign), _mm256_xor_si256(b, sign));
+}
+
+SimdInline TargetAVX2 __m256i avx2_vmul_u64(__m256i a, __m256i b) {
+  __m256i low = _mm256_mul_epu32(a, b);
+  __m256i cross =
+    _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), b),
+      _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+  return _mm256_add_epi64(low, _mm256_slli_epi64(cross, 32));
+}
+
+SimdInline TargetAVX2 __m256i avx2_sum_step_u32(__m256i acc, __m256i v) {
+  __m256i zero = _mm256_setzero_si256();
+  return _mm256_add_epi64(acc, _mm256_add_epi64(_mm256_unpacklo_epi32(v, zero),
+                                 _mm256_unpackhi_epi32(v, zero)));
+}
+
+SimdInline TargetAVX2 __m256i avx2_dot_step_u32(
+  __m256i acc, __m256i a, __m256i b) {
+  __m256i even = _mm256_mul_epu32(a, b);
+  __m256i odd =
+    _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+  return _mm256_add_epi64(acc, _mm256_add_epi64(even, odd));
+}
+
+  #define AVX2_u32_Vec __m256i
+  #define AVX2_u32_Width 8
+  #define AVX2_u32_Load(p) _mm256_loadu_si256((__m256i*)(p))
+  #define AVX2_u32_Store(p, v) _mm256_storeu_si256((__m256i*)(p), v)
+  #define AVX2_u32_Set1(x) _mm256_set1_epi32((s32)(x))
+  #define AVX2_u32_Zero() _mm256_setzero_si256()
+  #define AVX2_u32_Add(a, b) _mm256_add_epi32(a, b)
+  #define AVX2_u32_Mul(a, b) _mm256_mullo_epi32(a, b)
+  #define AVX2_u32_Min(a, b) _mm256_min_epu32(a, b)
+  #define AVX2_u32_Max(a, b) _mm256_max_epu32(a, b)
+  #define AVX2_u32_Eq(a, b)                                                    \
+    _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)))
+  #define AVX2_u32_SumStep(acc, v) avx2_sum_step_u32(acc, v)
+  #define AVX2_u32_DotStep(acc, a, b) avx2_dot_step_u32(acc, a, b)
+
+  #define AVX2_u64_Vec __m256i
+  #define AVX2_u64_Width 4
+  #define AVX2_u64_Load(p) _mm256_loadu_si256((__m256i*)(p))
+  #define AVX2_u64_Store(p, v) _mm256_storeu_si256((__m256i*)(p), v)
+  #define AVX2_u64_Set1(x) _mm256_set1_epi64x((s64)(x))
+  #define AVX2_u64_Zero() _mm256_setzero_si256()
+  #define AVX2_u64_Add(a, b) _mm256_add_epi64(a, b)
+  #define AVX2_u64_Mul(a, b) avx2_vmul_u64(a, b)
+  #define AVX2_u64_Min(a, b) _mm256_blendv_epi8(a, b, avx2_gt_u64(a, b))
+  #define AVX2_u64_Max(a, b) _mm256_blendv_epi8(b, a, avx2_gt_u64(a, b))
+  #define AVX2_u64_Eq(a, b)                                                    \
+    _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(a, b)))
+  #define AVX2_u64_SumStep(acc, v) _mm256_add_epi64(acc, v)
+  #define AVX2_u64_DotStep(acc, a, b)                                          \
+    _mm256_add_epi64(acc, avx2_vmul_u64(a, b))
+
+  #define AVX2_f32_Vec __m256
+  #define AVX2_f32_Width 8
+  #define AVX2_f32_Load(p) _mm256_loadu_ps((f32*)(p))
+  #define AVX2_f32_Store(p, v) _mm256_storeu_ps((f32*)(p), v)
+  #define AVX2_f32_Set1(x) _mm256_set1_ps(x)
+  #define AVX2_f32_Zero() _mm256_setzero_ps()
+  #define AVX2_f32_Add(a, b) _mm256_add_ps(a, b)
+  #define AVX2_f32_Mul(a, b) _mm256_mul_ps(a, b)
+  #define AVX2_f32_Min(a, b) _mm256_min_ps(a, b)
+  #define AVX2_f32_Max(a, b) _mm256_max_ps(a, b)
+  #define AVX2_f32_Eq(a, b) _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ))
+  #define AVX2_f32_SumStep(acc, v) _mm256_add_ps(acc, v)
+  #define AVX2_f32_DotStep(acc, a, b) _mm256_add_ps(acc, _mm256_mul_ps(a, b))
+
+  #define AVX2_f64_Vec __m256d
+  #define AVX2_f64_Width 4
+  #define AVX2_f64_Load(p) _mm256_loadu_pd((f64*)(p))
+  #define AVX2_f64_Store(p, v) _mm256_storeu_pd((f64*)(p), v)
+  #define AVX2_f64_Set1(x) _mm256_set1_pd(x)
+  #define AVX2_f64_Zero() _mm256_setzero_pd()
+  #define AVX2_f64_Add(a, b) _mm256_add_pd(a, b)
+  #define AVX2_f64_Mul(a, b) _mm256_mul_pd(a, b)
+  #define AVX2_f64_Min(a, b) _mm256_min_pd(a, b)
+  #define AVX2_f64_Max(a, b) _mm256_max_pd(a, b)
+  #define AVX2_f64_Eq(a, b) _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ))
+  #define AVX2_f64_SumStep(acc, v) _mm256_add_pd(acc, v)
+  #define AVX2_f64_DotStep(acc, a, b) _mm256_add_pd(acc, _mm256_mul_pd(a, b))
+
+SimdKernelsImpl(avx2, AVX2, u32, u64)
+SimdKernelsImpl(avx2, AVX2, u64, u64)
+SimdKernelsImpl(avx2, AVX2, f32, f32)
+SimdKernelsImpl(avx2, AVX2, f64, f64)
+
+/******************************
+ * bit kernels
+ ******************************/
+  #define SimdBitsImpl(isa, ISA, Vec, Load, Store, name, Op, op)               \
+    static Target##ISA void isa##_##name##_bits(                               \
+      u64* dst, u64* a, u64* b, u32 len) {                                     \
+      u32 width = sizeof(Vec) / sizeof(u64);                                   \
+      u32 i = 0;                                                               \
+      for (; i + width <= len; i += width) {                                   \
+        Store((Vec*)(dst + i), Op(Load((Vec*)(a + i)), Load((Vec*)(b + i))));  \
+      }                                                                        \
+      for (; i < len; i++) {                                                   \
+        dst[i] = op;                                                           \
+      }                                                                        \
+    }
+
+  // andnot of the intrinsics negates the first operand
+  #define SSE2_AndNot(a, b) _mm_andnot_si128(b, a)
+  #define AVX2_AndNot(a, b) _mm256_andnot_si256(b, a)
+
+  #define SimdBitsOpsImpl(isa, ISA, Vec, Load, Store, And, Or, Xor, AndNot)    \
+    SimdBitsImpl(isa, ISA, Vec, Load, Store, and, And, a[i] & b[i])           \
+    SimdBitsImpl(isa, ISA, Vec, Load, Store, or, Or, a[i] | b[i])             \
+    SimdBitsImpl(isa, ISA, Vec, Load, Store, xor, Xor, a[i] ^ b[i])           \
+    SimdBitsImpl(isa, ISA, Vec, Load, Store, andnot, AndNot, a[i] & ~b[i])
+
+SimdBitsOpsImpl(sse2, SSE2, __m128i, _mm_loadu_si128, _mm_storeu_si128,
+  _mm_and_si128, _mm_or_si128, _mm_xor_si128, SSE2_AndNot)
+SimdBitsOpsImpl(avx2, AVX2, __m256i, _mm256_loadu_si256, _mm256_storeu_si256,
+  _mm256_and_si256, _mm256_or_si256, _mm256_xor_si256, AVX2_AndNot)
+
+/* sse2 has no byte shuffle, the bits are added up in place: pairs, then
+ * nibbles, then bytes, and psadbw sums the 8 bytes of each 64 bit lane */
+static TargetSSE2 u64 sse2_popcount_bits(u64* data, u32 len) {
+  __m128i m1 = _mm_set1_epi8(0x55);
+  __m128i m2 = _mm_set1_epi8(0x33);
+  __m128i m4 = _mm_set1_epi8(0x0f);
+  __m128i acc = _mm_setzero_si128();
+
+  u32 i = 0;
+  for (; i + 2 <= len; i += 2) {
+    __m128i v = _mm_loadu_si128((__m128i*)(data + i));
+    v = _mm_sub_epi8(v, _mm_and_si128(_mm_srli_epi64(v, 1), m1));
+    v = _mm_add_epi8(
+      _mm_and_si128(v, m2), _mm_and_si128(_mm_srli_epi64(v, 2), m2));
+    v = _mm_and_si128(_mm_add_epi8(v, _mm_srli_epi64(v, 4)), m4);
+    acc = _mm_add_epi64(acc, _mm_sad_epu8(v, _mm_setzero_si128()));
+  }
+
+  u64 lanes[2];
+  _mm_storeu_si128((__m128i*)lanes, acc);
+  return lanes[0] + lanes[1] + scalar_popcount_bits(data + i, len - i);
+}
+
+/* the bit count of every nibble from a 16 entry table with vpshufb,
+ * vpsadbw sums the bytes of each 64 bit lane */
+static TargetAVX2 u64 avx2_popcount_bits(u64* data, u32 len) {
+  __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3,
+    3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+  __m256i low = _mm256_set1_epi8(0x0f);
+  __m256i acc = _mm256_setzero_si256();
+
+  u32 i = 0;
+  for (; i + 4 <= len; i += 4) {
+    __m256i v = _mm256_loadu_si256((__m256i*)(data + i));
+    __m256i counts = _mm256_add_epi8(
+      _mm256_shuffle_epi8(table, _mm256_and_si256(v, low)),
+      _mm256_shuffle_epi8(
+        table, _mm256_and_si256(_mm256_srli_epi16(v, 4), low)));
+    acc = _mm256_add_epi64(
+      acc, _mm256_sad_epu8(counts, _mm256_setzero_si256()));
+  }
+
+  u64 lanes[4];
+  _mm256_storeu_si256((__m256i*)lanes, acc);
+  return lanes[0] + lanes[1] + lanes[2] + lanes[3] +
+         scalar_popcount_bits(data + i, len - i);
+}
+
+  #define SimdSelect(name, T, args)                                            \
+    switch (simd_get_level()) {                                                \
+    case SIMD_AVX2:                                                            \
+      return avx2_##name##_##T args;                                           \
+    case SIMD_SSE2:                                                            \
+      return sse2_##name##_##T args;                                           \
+    default:                                                                   \
+      return scalar_##name##_##T args;                                         \
+    }
+
+  #define SimdSelectVoid(name, T, args)                                        \
+    switch (simd_get_level()) {                                                \
+    case SIMD_AVX2:                                                            \
+      avx2_##name##_##T args;                                                  \
+      return;                                                                  \
+    case SIMD_SSE2:                                                            \
+      sse2_##name##_##T args;                                                  \
+      return;                                                                  \
+    default:                                                                   \
+      scalar_##name##_##T args;                                                \
+      return;                                                                  \
+    }
+
+#else
+
+  #define SimdSelect(name, T, args) return scalar_##name##_##T args;
+  #define SimdSelectVoid(name, T, args) scalar_##name##_##T args;
+
+#endif
+
+/******************************
+ * dispatch
+ ******************************/
+#define SimdDispatchImpl(T, A)                                                 \
+  A simd_sum_##T(T* data, u32 len) { SimdSelect(sum, T, (data, len)) }         \
+                                                                               \
+  T simd_min_##T(T* data, u32 len) {                                           \
+    if (len == 0) {                                                            \
+      crash(E(EG_Datastructures, E_OutOfBounds,                                \
+        SV("simd_min -> len must be at least one")));                          \
+    }                                                                          \
+    SimdSelect(min, T, (data, len))                                            \
+  }                                                                            \
+                                                                               \
+  T simd_max_##T(T* data, u32 len) {                                           \
+    if (len == 0) {                                                            \
+      crash(E(EG_Datastructures, E_OutOfBounds,                                \
+        SV("simd_max -> len must be at least one")));                          \
+    }                                                                          \
+    SimdSelect(max, T, (data, len))                                            \
+  }                                                                            \
+                                                                               \
+  /* two passes, both vectorized, instead of tracking indices per lane */     \
+  u32 simd_argmin_##T(T* data, u32 len) {                                      \
+    return simd_find_##T(data, len, simd_min_##T(data, len));                  \
+  }                                                                            \
+                                                                               \
+  u32 simd_find_##T(T* data, u32 len, T value) {                               \
+    SimdSelect(find, T, (data, len, value))                                    \
+  }                                                                            \
+                                                                               \
+  u32 simd_count_##T(T* data, u32 len, T value) {                              \
+    SimdSelect(count, T, (data, len, value))                                   \
+  }                                                                            \
+                                                                               \
+  A simd_dot_##T(T* a, T* b, u32 len) { SimdSelect(dot, T, (a, b, len)) }      \
+                                                                               \
+  void simd_add_##T(T* dst, T* a, T* b, u32 len) {                             \
+    SimdSelectVoid(add, T, (dst, a, b, len))                                   \
+  }                                                                            \
+                                                                               \
+  void simd_mul_##T(T* dst, T* a, T* b, u32 len) {                             \
+    SimdSelectVoid(mul, T, (dst, a, b, len))                                   \
+  }                                                                            \
+                                                                               \
+  void simd_scale_##T(T* dst, T* a, T factor, u32 len) {                       \
+    SimdSelectVoid(scale, T, (dst, a, factor, len))                            \
+  }
+
+SimdDispatchImpl(u32, u64)
+SimdDispatchImpl(u64, u64)
+SimdDispatchImpl(f32, f32)
+SimdDispatchImpl(f64, f64)
+
+u64 simd_popcount_bits(u64* data, u32 len) {
+  SimdSelect(popcount, bits, (data, len))
+}
+
+void simd_and_bits(u64* dst, u64* a, u64* b, u32 len) {
+  SimdSelectVoid(and, bits, (dst, a, b, len))
+}
+
+void simd_or_bits(u64* dst, u64* a, u64* b, u32 len) {
+  SimdSelectVoid(or, bits, (dst, a, b, len))
+}
+
+void simd_xor_bits(u64* dst, u64* a, u64* b, u32 len) {
+  SimdSelectVoid(xor, bits, (dst, a, b, len))
+}
+
+void simd_andnot_bits(u64* dst, u64* a, u64* b, u32 len) {
+  SimdSelectVoid(andnot, bits, (dst, a, b, len))
+}
@@ -0,0 +1,685 @@
+#include <c_base/base/errors/C_EmptyResult.h>
+#include <c_base/base/memory/allocator.h>
+#include <c_base/base/memory/memory.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_Array.h>
+#include <c_base/ds/ds_sort.h>
+#include <c_base/os/os_threads.h>
+
+#define SortInsertionThreshold 24
+#define SortNintherThreshold 128
+#define SortPartialInsertionLimit 8
+
+typedef struct {
+  u64 key;
+  void* value;
+} SortKey;
+
+/* one piece of work for a sorting thread,
+ * the element type of src and dst depends on run */
+typedef struct SortJob {
+  ClassObject base;
+  void (*run)(struct SortJob* self);
+  CompareFunc compare;
+
+  void* src;
+  void* dst;
+
+  // range of src to sort, or of the merged output when merging
+  u64 begin;
+  u64 end;
+
+  // two neighbouring sorted runs in src, merged into the same place in dst
+  u64 a_begin;
+  u64 b_begin;
+  u64 b_end;
+
+  // key extraction, all values must share these interfaces
+  Interface** interfaces;
+  IComparable* i_comparable;
+  bool failed;
+} SortJob;
+
+/* pdqsort by Orson Peters, instantiated for every element type that needs it.
+ * Less(a, b) may use the compare parameter of the generated functions */
+#define PdqSortImpl(name, T, Less)                                             \
+  static void name##_swap(T* a, T* b) {                                        \
+    T tmp = *a;                                                                \
+    *a = *b;                                                                   \
+    *b = tmp;                                                                  \
+  }                                                                            \
+                                                                               \
+  static void name##_sort2(T* a, T* b, CompareFunc compare) {                  \
+    (void)compare;                                                             \
+    if (Less(*b, *a)) {                                                        \
+      name##_swap(a, b);                                                       \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  static void name##_sort3(T* a, T* b, T* c, CompareFunc compare) {            \
+    name##_sort2(a, b, compare);                                               \
+    name##_sort2(b, c, compare);                                               \
+    name##_sort2(a, b, compare);                                               \
+  }                                                                            \
+                                                                               \
+  static void name##_insertion(T* begin, T* end, CompareFunc compare) {        \
+    (void)compare;                                                             \
+    if (begin == end) {                                                        \
+      return;                                                                  \
+    }                                                                          \
+    for (T* cur = begin + 1; cur != end; cur++) {                              \
+      T* sift = cur;                                                           \
+      T* sift_1 = cur - 1;                                                     \
+      if (Less(*sift, *sift_1)) {                                              \
+        T tmp = *sift;                                                         \
+        do {                                                                   \
+          *sift-- = *sift_1;                                                   \
+        } while (sift != begin && Less(tmp, *--sift_1));                       \
+        *sift = tmp;                                                           \
+      }                                                                        \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  /* the element before begin must be smaller or equal to all elements */      \
+  static void name##_unguarded_insertion(                                      \
+    T* begin, T* end, CompareFunc compare) {                                   \
+    (void)compare;                                                             \
+    if (begin == end) {                                                        \
+      return;                                                                  \
+    }                                                                          \
+    for (T* cur = begin + 1; cur != end; cur++) {                              \
+      T* sift = cur;                                                           \
+      T* sift_1 = cur - 1;                                                     \
+      if (Less(*sift, *sift_1)) {                                              \
+        T tmp = *sift;                                                         \
+        do {                                                                   \
+          *sift-- = *sift_1;                                                   \
+        } while (Less(tmp, *--sift_1));                                        \
+        *sift = tmp;                                                           \
+      }                                                                        \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  /* gives up after moving SortPartialInsertionLimit elements */               \
+  static bool name##_partial_insertion(                                        \
+    T* begin, T* end, CompareFunc compare) {                                   \
+    (void)compare;                                                             \
+    if (begin == end) {                                                        \
+      return true;                                                             \
+    }                                                                          \
+    u64 moved = 0;                                                             \
+    for (T* cur = begin + 1; cur != end; cur++) {                              \
+      T* sift = cur;                                                           \
+      T* sift_1 = cur - 1;                                                     \
+      if (Less(*sift, *sift_1)) {                                              \
+        T tmp = *sift;                                                         \
+        do {                                                                   \
+          *sift-- = *sift_1;                                                   \
+        } while (sift != begin && Less(tmp, *--sift_1));                       \
+        *sift = tmp;                                                           \
+        moved += cur - sift;                                                   \
+      }                                                                        \
+      if (moved > SortPartialInsertionLimit) {                                 \
+        return false;                                                          \
+      }                                                                        \
+    }                                                                          \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  /* pivot is *begin, elements equal to the pivot go right */                  \
+  static T* name##_partition_right(                                            \
+    T* begin, T* end, bool* already_partitioned, CompareFunc compare) {        \
+    (void)compare;                                                             \
+    T pivot = *begin;                                                          \
+    T* first = begin;                                                          \
+    T* last = end;                                                             \
+                                                                               \
+    while (Less(*++first, pivot)) {                                            \
+    }                                                                          \
+    if (first - 1 == begin) {                                                  \
+      while (first < last && !Less(*--last, pivot)) {                          \
+      }                                                                        \
+    } else {                                                                   \
+      while (!Less(*--last, pivot)) {                                          \
+      }                                                                        \
+    }                                                                          \
+                                                                               \
+    *already_partitioned = first >= last;                                      \
+                                                                               \
+    while (first < last) {                                                     \
+      name##_swap(first, last);                                                \
+      while (Less(*++first, pivot)) {                                          \
+      }                                                                        \
+      while (!Less(*--last, pivot)) {                                          \
+      }                                                                        \
+    }                                                                          \
+                                                                               \
+    T* pivot_pos = first - 1;                                                  \
+    *begin = *pivot_pos;                                                       \
+    *pivot_pos = pivot;                                                        \
+    return pivot_pos;                                                          \
+  }                                                                            \
+                                                                               \
+  /* pivot is *begin, elements equal to the pivot go left */                   \
+  static T* name##_partition_left(T* begin, T* end, CompareFunc compare) {     \
+    (void)compare;                                                             \
+    T pivot = *begin;                                                          \
+    T* first = begin;                                                          \
+    T* last = end;                                                             \
+                                                                               \
+    while (Less(pivot, *--last)) {                                             \
+    }                                                                          \
+    if (last + 1 == end) {                                                     \
+      while (first < last && !Less(pivot, *++first)) {                         \
+      }                                                                        \
+    } else {                                                                   \
+      while (!Less(pivot, *++first)) {                                         \
+      }                                                                        \
+    }                                                                          \
+                                                                               \
+    while (first < last) {                                                     \
+      name##_swap(first, last);                                                \
+      while (Less(pivot, *--last)) {                                           \
+      }                                                                        \
+      while (!Less(pivot, *++first)) {                                         \
+      }                                                                        \
+    }                                                                          \
+                                                                               \
+    T* pivot_pos = last;                                                       \
+    *begin = *pivot_pos;                                                       \
+    *pivot_pos = pivot;                                                        \
+    return pivot_pos;                                                          \
+  }                                                                            \
+                                                                               \
+  static void name##_sift_down(                                                \
+    T* data, u64 root, u64 len, CompareFunc compare) {                         \
+    (void)compare;                                                             \
+    for (;;) {                                                                 \
+      u64 child = 2 * root + 1;                                                \
+      if (child >= len) {                                                      \
+        return;                                                                \
+      }                                                                        \
+      if (child + 1 < len && Less(data[child], data[child + 1])) {             \
+        child++;                                                               \
+      }                                                                        \
+      if (!Less(data[root], data[child])) {                                    \
+        return;                                                                \
+      }                                                                        \
+      name##_swap(&data[root], &data[child]);                                  \
+      root = child;                                                            \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  static void name##_heapsort(T* begin, T* end, CompareFunc compare) {         \
+    u64 len = end - begin;                                                     \
+    for (u64 i = len / 2; i-- > 0;) {                                          \
+      name##_sift_down(begin, i, len, compare);                                \
+    }                                                                          \
+    for (u64 i = len; i-- > 1;) {                                              \
+      name##_swap(&begin[0], &begin[i]);                                       \
+      name##_sift_down(begin, 0, i, compare);                                  \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  static void name##_loop(T* begin, T* end, s32 bad_allowed, bool leftmost,    \
+    CompareFunc compare) {                                                     \
+    (void)compare;                                                             \
+    for (;;) {                                                                 \
+      u64 size = end - begin;                                                  \
+                                                                               \
+      if (size < SortInsertionThreshold) {                                     \
+        if (leftmost) {                                                        \
+          name##_insertion(begin, end, compare);                               \
+        } else {                                                               \
+          name##_unguarded_insertion(begin, end, compare);                     \
+        }                                                                      \
+        return;                                                                \
+      }                                                                        \
+                                                                               \
+      /* median of 3 or pseudo median of 9 goes to *begin */                   \
+      u64 s2 = size / 2;                                                       \
+      if (size > SortNintherThreshold) {                                       \
+        name##_sort3(begin, begin + s2, end - 1, compare);                     \
+        name##_sort3(begin + 1, begin + (s2 - 1), end - 2, compare);           \
+        name##_sort3(begin + 2, begin + (s2 + 1), end - 3, compare);           \
+        name##_sort3(                                                          \
+          begin + (s2 - 1), begin + s2, begin + (s2 + 1), compare);            \
+        name##_swap(begin, begin + s2);                                        \
+      } else {                                                                 \
+        name##_sort3(begin + s2, begin, end - 1, compare);                     \
+      }                                                                        \
+                                                                               \
+      /* pivot equal to the element before the range, */                       \
+      /* skip all elements equal to it */                                      \
+      if (!leftmost && !Less(*(begin - 1), *begin)) {                          \
+        begin = name##_partition_left(begin, end, compare) + 1;                \
+        continue;                                                              \
+      }                                                                        \
+                                                                               \
+      bool already_partitioned;                                                \
+      T* pivot_pos =                                                           \
+        name##_partition_right(begin, end, &already_partitioned, compare);     \
+                                                                               \
+      u64 l_size = pivot_pos - begin;                                          \
+      u64 r_size = end - (pivot_pos + 1);                                      \
+      bool highly_unbalanced = l_size < size / 8 || r_size < size / 8;         \
+                                                                               \
+      if (highly_unbalanced) {                                                 \
+        if (--bad_allowed == 0) {                                              \
+          name##_heapsort(begin, end, compare);                                \
+          return;                                                              \
+        }                                                                      \
+                                                                               \
+        /* break up patterns that caused the bad partition */                  \
+        if (l_size >= SortInsertionThreshold) {                                \
+          name##_swap(begin, begin + l_size / 4);                              \
+          name##_swap(pivot_pos - 1, pivot_pos - l_size / 4);                  \
+          if (l_size > SortNintherThreshold) {                                 \
+            name##_swap(begin + 1, begin + (l_size / 4 + 1));                  \
+            name##_swap(begin + 2, begin + (l_size / 4 + 2));                  \
+            name##_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));          \
+            name##_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));          \
+          }                                                                    \
+        }                                                                      \
+        if (r_size >= SortInsertionThreshold) {                                \
+          name##_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));            \
+          name##_swap(end - 1, end - r_size / 4);                              \
+          if (r_size > SortNintherThreshold) {                                 \
+            name##_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));          \
+            name##_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));          \
+            name##_swap(end - 2, end - (1 + r_size / 4));                      \
+            name##_swap(end - 3, end - (2 + r_size / 4));                      \
+          }                                                                    \
+        }                                                                      \
+      } else if (already_partitioned &&                                        \
+                 name##_partial_insertion(begin, pivot_pos, compare) &&        \
+                 name##_partial_insertion(pivot_pos + 1, end, compare)) {      \
+        return;                                                                \
+      }                                                                        \
+                                                                               \
+      /* recurse into the left part, loop on the right one */                  \
+      name##_loop(begin, pivot_pos, bad_allowed, leftmost, compare);           \
+      begin = pivot_pos + 1;                                                   \
+      leftmost = false;                                                        \
+    }                                                                          \
+  }
+
+static s32 sort_log2(u64 len) {
+  s32 log = 0;
+  while (len >>= 1) {
+    log++;
+  }
+  return log;
+}
+
+/******************************
+ * SortJob
+ ******************************/
+static void SortJob_destroy(void* self) { (void)self; }
+
+static SortJob* SortJob_new(void (*run)(SortJob* self), CompareFunc compare) {
+  SortJob* self = allocate(sizeof(SortJob));
+  self->base = ClassObject_construct(SortJob_destroy, null);
+  self->run = run;
+  self->compare = compare;
+  self->failed = false;
+  return self;
+}
+
+static void sort_thread_func(C_Thread* thread) {
+  SortJob* job = C_Thread_get_arg_B(thread, 0);
+  job->run(job);
+}
+
+/* runs every job on its own thread, the first one on the calling thread,
+ * and unrefs them when all are done.
+ * if a thread cannot be started its job runs on the calling thread */
+static void sort_run_jobs(SortJob** jobs, u32 count) {
+  C_Thread** threads = allocate(count * sizeof(C_Thread*));
+  C_Array** args = allocate(count * sizeof(C_Array*));
+
+  for (u32 i = 1; i < count; i++) {
+    args[i] = C_Array_new(1);
+    C_Array_put_P(args[i], 0, jobs[i]);
+
+    threads[i] = C_Thread_new(sort_thread_func, args[i]);
+    C_EmptyResult* result = C_Thread_run(threads[i]);
+    if (!C_EmptyResult_get_ok(result)) {
+      Unref(threads[i]);
+      threads[i] = null;
+      jobs[i]->run(jobs[i]);
+    }
+    Unref(result);
+  }
+
+  if (count > 0) {
+    jobs[0]->run(jobs[0]);
+  }
+
+  for (u32 i = 1; i < count; i++) {
+    if (threads[i]) {
+      C_Thread_join(threads[i]);
+      Unref(threads[i]);
+    }
+    Unref(args[i]);
+  }
+
+  for (u32 i = 0; i < count; i++) {
+    Unref(jobs[i]);
+  }
+
+  deallocate(args);
+  deallocate(threads);
+}
+
+#define PtrLess(a, b) (compare((a), (b)) < 0)
+#define KeyLess(a, b) ((a).key < (b).key)
+
+/* parallel merge sort parts of the pdqsort instantiated as name */
+#define ParallelSortImpl(name, T, Less)                                        \
+  static void name##_sort_job(SortJob* job) {                                  \
+    T* data = job->src;                                                        \
+    u64 len = job->end - job->begin;                                           \
+    if (len > 1) {                                                             \
+      name##_loop(data + job->begin, data + job->end, sort_log2(len), true,    \
+        job->compare);                                                         \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  /* how many values of a are in the first k values of the stable merge */     \
+  static u64 name##_co_rank(                                                   \
+    u64 k, T* a, u64 a_len, T* b, u64 b_len, CompareFunc compare) {            \
+    (void)compare;                                                             \
+    u64 lo = k > b_len ? k - b_len : 0;                                        \
+    u64 hi = k < a_len ? k : a_len;                                            \
+    while (lo < hi) {                                                          \
+      u64 i = lo + (hi - lo) / 2;                                              \
+      u64 j = k - i;                                                           \
+      if (j > 0 && i < a_len && !Less(b[j - 1], a[i])) {                       \
+        lo = i + 1;                                                            \
+      } else {                                                                 \
+        hi = i;                                                                \
+      }                                                                        \
+    }                                                                          \
+    return lo;                                                                 \
+  }                                                                            \
+                                                                               \
+  /* merges the output range begin..end of the runs a and b */                 \
+  static void name##_merge_job(SortJob* job) {                                 \
+    CompareFunc compare = job->compare;                                        \
+    (void)compare;                                                             \
+    T* src = job->src;                                                         \
+    T* a = src + job->a_begin;                                                 \
+    T* b = src + job->b_begin;                                                 \
+    u64 a_len = job->b_begin - job->a_begin;                                   \
+    u64 b_len = job->b_end - job->b_begin;                                     \
+                                                                               \
+    u64 i = name##_co_rank(job->begin, a, a_len, b, b_len, compare);           \
+    u64 j = job->begin - i;                                                    \
+    u64 a_end = name##_co_rank(job->end, a, a_len, b, b_len, compare);         \
+    u64 b_end = job->end - a_end;                                              \
+                                                                               \
+    T* out = (T*)job->dst + job->a_begin + job->begin;                         \
+    while (i < a_end && j < b_end) {                                           \
+      if (Less(b[j], a[i])) {                                                  \
+        *out++ = b[j++];                                                       \
+      } else {                                                                 \
+        *out++ = a[i++];                                                       \
+      }                                                                        \
+    }                                                                          \
+    while (i < a_end) {                                                        \
+      *out++ = a[i++];                                                         \
+    }                                                                          \
+    while (j < b_end) {                                                        \
+      *out++ = b[j++];                                                         \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  /* merges the sorted runs between bounds until one is left in data */        \
+  static void name##_merge_runs(T* data, u64 len, u64* bounds, u32 runs,       \
+    u32 threads, CompareFunc compare) {                                        \
+    T* src = data;                                                             \
+    T* dst = allocate(len * sizeof(T));                                        \
+    T* tmp = dst;                                                              \
+    SortJob** jobs = allocate(threads * 2 * sizeof(SortJob*));                 \
+                                                                               \
+    while (runs > 1) {                                                         \
+      u32 job_count = 0;                                                       \
+      for (u32 run = 0; run < runs; run += 2) {                                \
+        u64 a_begin = bounds[run];                                             \
+        u64 b_begin = bounds[run + 1];                                         \
+        u64 b_end = run + 2 <= runs ? bounds[run + 2] : b_begin;               \
+                                                                               \
+        /* split every merge so each thread gets about the same output */      \
+        u64 out_len = b_end - a_begin;                                         \
+        u64 parts = threads * out_len / len;                                   \
+        parts = parts == 0 ? 1 : parts;                                        \
+        for (u64 part = 0; part < parts; part++) {                             \
+          SortJob* job = SortJob_new(name##_merge_job, compare);               \
+          job->src = src;                                                      \
+          job->dst = dst;                                                      \
+          job->a_begin = a_begin;                                              \
+          job->b_begin = b_begin;                                              \
+          job->b_end = b_end;                                                  \
+          job->begin = out_len * part / parts;                                 \
+          job->end = out_len * (part + 1) / parts;                             \
+          jobs[job_count++] = job;                                             \
+        }                                                                      \
+      }                                                                        \
+                                                                               \
+      sort_run_jobs(jobs, job_count);                                          \
+                                                                               \
+      u32 merged = 0;                                                          \
+      for (u32 run = 0; run < runs; run += 2) {                                \
+        bounds[merged++] = bounds[run];                                        \
+      }                                                                        \
+      bounds[merged] = len;                                                    \
+      runs = merged;                                                           \
+                                                                               \
+      T* swap = src;                                                           \
+      src = dst;                                                               \
+      dst = swap;                                                              \
+    }                                                                          \
+                                                                               \
+    if (src != data) {                                                         \
+      mem_copy(data, src, len * sizeof(T));                                    \
+    }                                                                          \
+                                                                               \
+    deallocate(jobs);                                                          \
+    deallocate(tmp);                                                           \
+  }
+
+PdqSortImpl(pdq_ptr, void*, PtrLess)
+PdqSortImpl(pdq_key, SortKey, KeyLess)
+ParallelSortImpl(pdq_ptr, void*, PtrLess)
+ParallelSortImpl(pdq_key, SortKey, KeyLess)
+
+void sort_pdq(void** data, u32 len, CompareFunc compare) {
+  if (len < 2) {
+    return;
+  }
+
+  pdq_ptr_loop(data, data + len, sort_log2(len), true, compare);
+}
+
+static bool sort_pdq_keys(void** data, u32 len) {
+  ClassObject* first = data[0];
+  if (first == null || !ClassObject_contains_interface(first, IComparable_id)) {
+    return false;
+  }
+
+  IComparable* i_comparable =
+    (IComparable*)ClassObject_get_interface(first, IComparable_id);
+  if (i_comparable->key == null) {
+    return false;
+  }
+
+  // same interface array means same type, the keys are comparable
+  for (u32 i = 1; i < len; i++) {
+    ClassObject* value = data[i];
+    if (value == null || value->interfaces != first->interfaces) {
+      return false;
+    }
+  }
+
+  SortKey* keys = allocate(len * sizeof(SortKey));
+  for (u32 i = 0; i < len; i++) {
+    keys[i].key = i_comparable->key(data[i]);
+    keys[i].value = data[i];
+  }
+
+  pdq_key_loop(keys, keys + len, sort_log2(len), true, null);
+
+  for (u32 i = 0; i < len; i++) {
+    data[i] = keys[i].value;
+  }
+
+  deallocate(keys);
+  return true;
+}
+
+void sort_pdq_comparable(void** data, u32 len) {
+  if (len < 2) {
+    return;
+  }
+
+  if (!sort_pdq_keys(data, len)) {
+    sort_pdq(data, len, IComparable_compare);
+  }
+}
+
+/******************************
+ * parallel
+ ******************************/
+static u32 sort_thread_count(u32 len, u32 threads) {
+  if (threads == 0) {
+    threads = os_threads_cpu_count();
+  }
+
+  // keep chunks long enough to be worth a thread
+  u32 max_threads = len / (SortParallelMinLen / 4);
+  return threads < max_threads ? threads : max_threads;
+}
+
+static u64* sort_chunk_bounds(u32 len, u32 chunks) {
+  u64* bounds = allocate((chunks + 1) * sizeof(u64));
+  for (u32 i = 0; i <= chunks; i++) {
+    bounds[i] = (u64)len * i / chunks;
+  }
+  return bounds;
+}
+
+void sort_pdq_parallel(void** data, u32 len, CompareFunc compare, u32 threads) {
+  threads = sort_thread_count(len, threads);
+  if (len < SortParallelMinLen || threads < 2) {
+    sort_pdq(data, len, compare);
+    return;
+  }
+
+  u64* bounds = sort_chunk_bounds(len, threads);
+  SortJob** jobs = allocate(threads * sizeof(SortJob*));
+  for (u32 i = 0; i < threads; i++) {
+    jobs[i] = SortJob_new(pdq_ptr_sort_job, compare);
+    jobs[i]->src = data;
+    jobs[i]->begin = bounds[i];
+    jobs[i]->end = bounds[i + 1];
+  }
+  sort_run_jobs(jobs, threads);
+
+  pdq_ptr_merge_runs(data, len, bounds, threads, threads, compare);
+
+  deallocate(jobs);
+  deallocate(bounds);
+}
+
+static void sort_key_job(SortJob* job) {
+  void** data = job->src;
+  SortKey* keys = job->dst;
+
+  for (u64 i = job->begin; i < job->end; i++) {
+    ClassObject* value = data[i];
+    if (value == null || value->interfaces != job->interfaces) {
+      job->failed = true;
+      return;
+    }
+    keys[i].key = job->i_comparable->key(value);
+    keys[i].value = value;
+  }
+
+  // the chunk of keys is sorted the same way as a chunk of values
+  job->src = keys;
+  pdq_key_sort_job(job);
+}
+
+static void sort_unkey_job(SortJob* job) {
+  SortKey* keys = job->src;
+  void** data = job->dst;
+
+  for (u64 i = job->begin; i < job->end; i++) {
+    data[i] = keys[i].value;
+  }
+}
+
+void sort_pdq_comparable_parallel(void** data, u32 len, u32 threads) {
+  threads = sort_thread_count(len, threads);
+  if (len < SortParallelMinLen || threads < 2) {
+    sort_pdq_comparable(data, len);
+    return;
+  }
+
+  ClassObject* first = data[0];
+  IComparable* i_comparable = null;
+  if (first != null && ClassObject_contains_interface(first, IComparable_id)) {
+    i_comparable =
+      (IComparable*)ClassObject_get_interface(first, IComparable_id);
+  }
+  if (i_comparable == null || i_comparable->key == null) {
+    sort_pdq_parallel(data, len, IComparable_compare, threads);
+    return;
+  }
+
+  // the chunks extract their own keys, so the check for a single keyed type
+  // is spread over the threads too
+  u64* bounds = sort_chunk_bounds(len, threads);
+  SortKey* keys = allocate(len * sizeof(SortKey));
+  SortJob** jobs = allocate(threads * sizeof(SortJob*));
+  for (u32 i = 0; i < threads; i++) {
+    jobs[i] = Ref(SortJob_new(sort_key_job, null));
+    jobs[i]->src = data;
+    jobs[i]->dst = keys;
+    jobs[i]->begin = bounds[i];
+    jobs[i]->end = bounds[i + 1];
+    jobs[i]->interfaces = first->interfaces;
+    jobs[i]->i_comparable = i_comparable;
+  }
+  sort_run_jobs(jobs, threads);
+
+  bool failed = false;
+  for (u32 i = 0; i < threads; i++) {
+    failed |= jobs[i]->failed;
+    Unref(jobs[i]);
+  }
+
+  if (failed) {
+    deallocate(keys);
+    deallocate(jobs);
+    deallocate(bounds);
+    sort_pdq_parallel(data, len, IComparable_compare, threads);
+    return;
+  }
+
+  pdq_key_merge_runs(keys, len, bounds, threads, threads, null);
+
+  for (u32 i = 0; i < threads; i++) {
+    jobs[i] = SortJob_new(sort_unkey_job, null);
+    jobs[i]->src = keys;
+    jobs[i]->dst = data;
+    jobs[i]->begin = (u64)len * i / threads;
+    jobs[i]->end = (u64)len * (i + 1) / threads;
+  }
+  sort_run_jobs(jobs, threads);
+
+  deallocate(keys);
+  deallocate(jobs);
+  deallocate(bounds);
+}
@@ -0,0 +1,171 @@
+#include <c_base/ds/ds_sorted.h>
+
+/******************************
+ * search
+ ******************************/
+u32 sorted_lower_bound(void** data, u32 len, void* value, CompareFunc compare) {
+  u32 first = 0;
+  while (len > 0) {
+    u32 half = len / 2;
+    if (compare(data[first + half], value) < 0) {
+      first += half + 1;
+      len -= half + 1;
+    } else {
+      len = half;
+    }
+  }
+  return first;
+}
+
+u32 sorted_upper_bound(void** data, u32 len, void* value, CompareFunc compare) {
+  u32 first = 0;
+  while (len > 0) {
+    u32 half = len / 2;
+    if (compare(data[first + half], value) <= 0) {
+      first += half + 1;
+      len -= half + 1;
+    } else {
+      len = half;
+    }
+  }
+  return first;
+}
+
+SortedRange sorted_equal_range(
+  void** data, u32 len, void* value, CompareFunc compare) {
+  SortedRange range;
+  range.begin = sorted_lower_bound(data, len, value, compare);
+  range.end = range.begin + sorted_upper_bound(data + range.begin,
+                              len - range.begin, value, compare);
+  return range;
+}
+
+/* lower bound of value in data[start, len), found by doubling the step
+ * from start and then searching the last step. O(log distance) */
+static u32 sorted_gallop(
+  void** data, u32 start, u32 len, void* value, CompareFunc compare) {
+  u32 low = start;
+  u32 high = start;
+  u32 step = 1;
+
+  while (high < len && compare(data[high], value) < 0) {
+    low = high + 1;
+    high += step;
+    step *= 2;
+  }
+  if (high > len) {
+    high = len;
+  }
+
+  return low + sorted_lower_bound(data + low, high - low, value, compare);
+}
+
+/******************************
+ * set operations
+ ******************************/
+u32 sorted_union(void** a, u32 a_len, void** b, u32 b_len, void** out,
+  CompareFunc compare) {
+  u32 i = 0;
+  u32 j = 0;
+  u32 len = 0;
+
+  while (i < a_len && j < b_len) {
+    s32 order = compare(a[i], b[j]);
+    if (order < 0) {
+      out[len++] = a[i++];
+    } else if (order > 0) {
+      out[len++] = b[j++];
+    } else {
+      out[len++] = a[i++];
+      j++;
+    }
+  }
+
+  while (i < a_len) {
+    out[len++] = a[i++];
+  }
+  while (j < b_len) {
+    out[len++] = b[j++];
+  }
+
+  return len;
+}
+
+/* every value of the short side is looked up by galloping from where the
+ * previous one was found, O(short * log(long / short)) */
+static u32 sorted_intersection_gallop(void** a, u32 a_len, void** b,
+  u32 b_len, void** out, CompareFunc compare) {
+  u32 len = 0;
+
+  if (a_len <= b_len) {
+    u32 j = 0;
+    for (u32 i = 0; i < a_len && j < b_len; i++) {
+      j = sorted_gallop(b, j, b_len, a[i], compare);
+      if (j < b_len && compare(a[i], b[j]) == 0) {
+        out[len++] = a[i];
+        j++;
+      }
+    }
+  } else {
+    u32 i = 0;
+    for (u32 j = 0; j < b_len && i < a_len; j++) {
+      i = sorted_gallop(a, i, a_len, b[j], compare);
+      if (i < a_len && compare(a[i], b[j]) == 0) {
+        out[len++] = a[i++];
+      }
+    }
+  }
+
+  return len;
+}
+
+u32 sorted_intersection(void** a, u32 a_len, void** b, u32 b_len, void** out,
+  CompareFunc compare) {
+  if ((u64)a_len * SortedGallopRatio < b_len ||
+      (u64)b_len * SortedGallopRatio < a_len) {
+    return sorted_intersection_gallop(a, a_len, b, b_len, out, compare);
+  }
+
+  u32 i = 0;
+  u32 j = 0;
+  u32 len = 0;
+
+  while (i < a_len && j < b_len) {
+    s32 order = compare(a[i], b[j]);
+    if (order < 0) {
+      i++;
+    } else if (order > 0) {
+      j++;
+    } else {
+      out[len++] = a[i++];
+      j++;
+    }
+  }
+
+  return len;
+}
+
+u32 sorted_difference(void** a, u32 a_len, void** b, u32 b_len, void** out,
+  CompareFunc compare) {
+  u32 i = 0;
+  u32 j = 0;
+  u32 len = 0;
+
+  while (i < a_len && j < b_len) {
+    s32 order = compare(a[i], b[j]);
+    if (order < 0) {
+      out[len++] = a[i++];
+    } else if (order > 0) {
+      j++;
+    } else {
+      i++;
+      j++;
+    }
+  }
+
+  while (i < a_len) {
+    out[len++] = a[i++];
+  }
+
+  return len;
+}
@@ -30,12 +30,13 @@ struct C_Thread {
 
   // atomic
   u32 done;
+  // cleared by the kernel once the thread stopped using its stack
+  pid_t tid;
 
   u64 stack_size;
   u8* stack;
   C_Array* args;
   void (*thread_func)(C_Thread* self);
-  pid_t tid;
 };
 
 static s32 futex(u32* uaddr, int futex_op, u32 val,
@@ -45,32 +46,49 @@ static s32 futex(u32* uaddr, int futex_op, u32 val,
 
 Mutex Mutex_construct(void) { return (Mutex){0}; }
 
+/* ftx is 0 when unlocked, 1 when locked and 2 when locked with threads
+ * that may be waiting. only an unlock of 2 needs the futex wake call */
 void Mutex_lock(Mutex* self) {
-  u32 unlocked = 0;
-  while (!os_atomic_u32_compare_exchange(&self->ftx, &unlocked, 1)) {
-    unlocked = 0;
+  u32 state = 0;
+  if (os_atomic_u32_compare_exchange(&self->ftx, &state, 1)) {
+    return;
+  }
+
+  while (true) {
+    if (state == 0) {
+      // taken as 2, other threads may still be waiting
+      if (os_atomic_u32_compare_exchange(&self->ftx, &state, 2)) {
+        return;
+      }
+      continue;
+    }
+    if (state == 1 &&
+        !os_atomic_u32_compare_exchange(&self->ftx, &state, 2)) {
+      continue;
+    }
 
-    s32 s = futex(&self->ftx, FUTEX_WAIT, 1, null, null, 0);
+    s32 s = futex(&self->ftx, FUTEX_WAIT, 2, null, null, 0);
 
     if (s < -1 && errno != EAGAIN) {
       crash(E(EG_OS_THREADS, E_Unspecified, SV("Mutex_lock -> failed")));
     }
+    state = os_atomic_u32_load(&self->ftx);
   }
 }
 
 void Mutex_unlock(Mutex* self) {
   u32 locked = 1;
   if (os_atomic_u32_compare_exchange(&self->ftx, &locked, 0)) {
-    futex(&self->ftx, FUTEX_WAKE, 1, null, null, 0);
+    return;
   }
+
+  os_atomic_u32_store(&self->ftx, 0);
+  futex(&self->ftx, FUTEX_WAKE, 1, null, null, 0);
 }
 
 static int C_Thread_call_func(void* self) {
   C_Thread* self_cast = self;
 
-  os_atomic_u32_store(&self_cast->done, 0);
-
-  self_cast->tid = gettid();
   self_cast->thread_func(self);
 
   os_atomic_u32_store(&self_cast->done, 1);
@@ -92,8 +110,11 @@ C_Thread* C_Thread_new_stack_size(
   C_Thread* self = allocate(sizeof(C_Thread));
   self->base = ClassObject_construct(C_Thread_destroy, null);
   self->args = args;
+  self->stack = null;
   self->stack_size = stack_size;
   self->thread_func = thread_func;
+  self->done = 0;
+  self->tid = 0;
 
   return self;
 }
@@ -125,8 +146,8 @@ C_EmptyResult* C_Thread_run(C_Thread* self) {
   pid_t tid = clone(C_Thread_call_func,
     (void*)mem_align_forward((u64)((u8*)stack.ptr + stack.size), 16),
     CLONE_VM | CLONE_FS | CLONE_FILES | CLONE_SIGHAND | CLONE_THREAD |
-      CLONE_SYSVSEM,
-    self);
+      CLONE_SYSVSEM | CLONE_PARENT_SETTID | CLONE_CHILD_CLEARTID,
+    self, &self->tid, null, &self->tid);
 
   if (tid == -1) {
     result = C_EmptyResult_new_err(E(EG_OS_THREADS, E_Unspecified,
@@ -142,12 +163,33 @@ ret:
 
 void C_Thread_join(C_Thread* self) {
   while (os_atomic_u32_load(&self->done) == 0) {
-    futex(&self->done, FUTEX_WAIT, 0, null, null, null);
+    futex(&self->done, FUTEX_WAIT, 0, null, null, 0);
+  }
+
+  /* the thread still runs on its stack after setting done,
+   * wait for the kernel to clear tid on exit before the stack can be freed */
+  u32 tid;
+  while ((tid = os_atomic_u32_load((u32*)&self->tid)) != 0) {
+    futex((u32*)&self->tid, FUTEX_WAIT, tid, null, null, 0);
   }
 }
 
+C_Array* C_Thread_get_args_B(C_Thread* self) { return self->args; }
+
+void* C_Thread_get_arg_B(C_Thread* self, u32 index) {
+  if (index >= C_Array_get_len(self->args)) {
+    crash(E(EG_OS_THREADS, E_OutOfBounds,
+      SV("C_Thread_get_arg_B -> index is outside of the args")));
+  }
+  return C_Array_get_data(self->args)[index];
+}
+
 void C_Thread_destroy(void* self) {
   C_Thread* self_cast = self;
+  if (self_cast->stack == null) {
+    return;
+  }
+
   MemoryResult release = global_memory_base->release(
     global_memory_base, self_cast->stack, self_cast->stack_size);
   if (!release.ok) {
@@ -155,3 +197,15 @@ void C_Thread_destroy(void* self) {
       SV("C_Thread_destroy -> failed to release threads stack")));
   }
 }
+
+u32 os_threads_cpu_count(void) {
+  cpu_set_t set;
+  if (sched_getaffinity(0, sizeof(set), &set) != 0) {
+    return 1;
+  }
+
+  s32 count = CPU_COUNT(&set);
+  return count > 0 ? count : 1;
+}
+
+void os_threads_yield(void) { sched_yield(); }
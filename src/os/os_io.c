@@ -3,6 +3,7 @@
 #include <c_base/base/memory/handles.h>
 #include <c_base/base/memory/memory.h>
 #include <c_base/base/memory/objects.h>
+#include <c_base/base/strings/C_StringBuilder.h>
 #include <c_base/base/strings/string_convert.h>
 #include <c_base/base/strings/strings.h>
 #include <c_base/base/varargs.h>
@@ -17,43 +18,83 @@ GenericValImpl_ErrorCode(EG_OS_IO)
 
 static Mutex write_mutex = MutexConstructStatic;
 
-void console_write_P(void* obj, ...) {
+/******************************
+ * sinks
+ ******************************/
+static void console_flush(void* target, StringView chars) {
+  (void)target;
+  while (chars.len) {
+    C_Result* result = console_write_chars_R(chars.chars, chars.len);
+    u32 written = C_Handle_u32_get_value(C_Result_force_B(result));
+    Unref(result);
+    if (written == 0) {
+      crash(E(EG_OS_IO, E_Unspecified,
+        SV("console_write -> invalid number or characters written")));
+    }
+
+    chars.chars += written;
+    chars.len -= written;
+  }
+}
+
+static void console_flush_locked(void* target, StringView chars) {
   Mutex_lock(&write_mutex);
-  C_Array* args;
-  VarargsLoad(args, obj);
+  console_flush(target, chars);
+  Mutex_unlock(&write_mutex);
+}
 
-  C_ArrayForeach(args, {
-    C_String* text = IFormattable_to_str_PR(value);
+C_StringBuilder* console_new_sink(void) {
+  return C_StringBuilder_new_sink(IOSinkCap, console_flush_locked, null);
+}
 
-    C_Result* result =
-      console_write_chars_R(C_String_get_chars(text), C_String_get_len(text));
-    if (C_Handle_u32_get_value(C_Result_force_B(result)) !=
-        C_String_get_len(text)) {
+static void C_File_flush(void* target, StringView chars) {
+  while (chars.len) {
+    C_Result* result = C_File_write_chars_R(target, chars.chars, chars.len);
+    u32 written = C_Handle_u32_get_value(C_Result_force_B(result));
+    Unref(result);
+    if (written == 0) {
       crash(E(EG_OS_IO, E_Unspecified,
-        SV("console_write -> invalid number or characters written")));
+        SV("C_File_write -> invalid number or characters written")));
     }
-    Unref(result);
-    Unref(text);
-  });
 
-  Unref(args);
-  Mutex_unlock(&write_mutex);
+    chars.chars += written;
+    chars.len -= written;
+  }
 }
 
-void console_write_ln_P(void* obj, ...) {
-  C_Array* args;
-  VarargsLoad(args, obj);
+C_StringBuilder* C_File_new_sink(C_File* self) {
+  return C_StringBuilder_new_sink(IOSinkCap, C_File_flush, self);
+}
 
-  C_List* list = C_List_new();
-  C_ArrayForeach(args, { C_List_push_P(list, value); });
-  C_List_push_P(list, PS("\n"));
+/******************************
+ * console
+ ******************************/
+// the lock keeps the text of one call together
+static void console_write_args(C_Array* args, bool line) {
+  Mutex_lock(&write_mutex);
+  C_StringBuilder* sink =
+    C_StringBuilder_new_sink(IOSinkCap, console_flush, null);
+
+  C_ArrayForeach(args, { C_StringBuilder_append_str_P(sink, value); });
+  if (line) {
+    C_StringBuilder_append_char(sink, '\n');
+  }
 
-  C_String* join = C_String_join_PR(Pass(C_List_to_array_PR(list)));
+  Unref(sink);
+  Mutex_unlock(&write_mutex);
+}
 
-  console_write_P(join, ArgsEnd);
+void console_write_P(void* obj, ...) {
+  C_Array* args;
+  VarargsLoad(args, obj);
+  console_write_args(args, false);
+  Unref(args);
+}
 
-  Unref(join);
-  Unref(list);
+void console_write_ln_P(void* obj, ...) {
+  C_Array* args;
+  VarargsLoad(args, obj);
+  console_write_args(args, true);
   Unref(args);
 }
 
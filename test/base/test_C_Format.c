@@ -0,0 +1,123 @@
+// clang-format off
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <cmocka.h>
+// clang-format on
+
+#include "../test_helpers.h"
+#include <c_base/base/memory/handles.h>
+#include <c_base/base/memory/memory.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/base/strings/C_StringBuilder.h>
+#include <c_base/base/strings/format.h>
+#include <c_base/ds/C_List.h>
+
+static void assert_view_equals(StringView view, char* expected) {
+  u32 len = 0;
+  while (expected[len]) {
+    len++;
+  }
+  assert_int_equal(len, view.len);
+  assert_true(mem_equals(view.chars, expected, len));
+}
+
+static void assert_value_equals(C_String* value, char* expected) {
+  assert_non_null(value);
+  assert_view_equals(C_String_get_view(value), expected);
+  Unref(value);
+}
+
+static void test_C_Format_new_P(void** state) {
+  (void)state;
+
+  C_Format* format = C_Format_new_P(PS("start=<;end=>;sep=a=b;width"));
+  AssertClassEqual(format, ClassObject_id);
+  assert_int_equal(4, C_Format_get_len(format));
+
+  assert_view_equals(C_Format_get(format, FormatStart), "<");
+  assert_view_equals(C_Format_get(format, FormatEnd), ">");
+  // only the first '=' ends the key
+  assert_view_equals(C_Format_get(format, FormatSep), "a=b");
+  assert_view_equals(C_Format_get(format, FormatElSep), "");
+  assert_true(C_Format_has(format, FormatSep));
+  assert_false(C_Format_has(format, FormatElSep));
+
+  assert_value_equals(C_Format_get_value_R(format, SV("width")), "");
+  assert_value_equals(C_Format_get_value_R(format, SV("sep")), "a=b");
+  assert_null(C_Format_get_value_R(format, SV("height")));
+  Unref(format);
+
+  // the last value counts, empty pairs are skipped
+  format = C_Format_new_P(PS(";sep=1;;sep=2;"));
+  assert_int_equal(2, C_Format_get_len(format));
+  assert_view_equals(C_Format_get(format, FormatSep), "2");
+  assert_value_equals(C_Format_get_value_R(format, SV("sep")), "2");
+  Unref(format);
+
+  format = C_Format_new_P(PS(""));
+  assert_int_equal(0, C_Format_get_len(format));
+  assert_false(C_Format_has(format, FormatStart));
+  Unref(format);
+}
+
+static void test_C_Format_static(void** state) {
+  (void)state;
+
+  assert_view_equals(C_Format_get(C_FormatList, FormatStart), "[");
+  assert_view_equals(C_Format_get(C_FormatSet, FormatEnd), "}");
+  assert_view_equals(C_Format_get(C_FormatMap, FormatElSep), " : ");
+  assert_false(C_Format_has(C_FormatList, FormatElSep));
+  assert_null(C_Format_get_format_B(C_FormatList));
+  assert_value_equals(C_Format_get_value_R(C_FormatMap, SV("sep")), ", ");
+
+  // references do not destroy them
+  Unref(Ref(C_FormatList));
+  assert_view_equals(C_Format_get(C_FormatList, FormatSep), ", ");
+}
+
+static void test_C_Format_write(void** state) {
+  (void)state;
+
+  C_List* list = C_List_new();
+  C_List_push_P(list, Pass(C_Handle_u32_new(1)));
+  C_List_push_P(list, Pass(C_Handle_u32_new(2)));
+
+  C_Format* format = C_Format_new_P(PS("start=(;end=);sep=|"));
+  C_String* str = IFormattable_to_str_compiled_PR(list, format);
+  assert_value_equals(str, "(1|2)");
+
+  // a format is reused, a missing field is empty
+  C_Format* no_sep = C_Format_new_P(PS("start=(;end=)"));
+  C_StringBuilder* builder = C_StringBuilder_new();
+  C_StringBuilder_append_str_format_P(builder, list, format);
+  C_StringBuilder_append_str_format_P(builder, list, no_sep);
+  C_StringBuilder_append_str_format_P(builder, list, C_FormatSet);
+  assert_view_equals(C_StringBuilder_get_view(builder), "(1|2)(12){1, 2}");
+
+  Unref(builder);
+  Unref(no_sep);
+  Unref(format);
+  Unref(list);
+}
+
+static void test_format_get_value_PR(void** state) {
+  (void)state;
+
+  C_String* format = S("start=[;end=];sep=, ");
+  assert_value_equals(format_get_value_PR(format, PS("sep")), ", ");
+  assert_value_equals(format_get_value_PR(format, PS("end")), "]");
+  assert_null(format_get_value_PR(format, PS("missing")));
+  Unref(format);
+}
+
+int main(void) {
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_C_Format_new_P),
+    cmocka_unit_test(test_C_Format_static),
+    cmocka_unit_test(test_C_Format_write),
+    cmocka_unit_test(test_format_get_value_PR),
+  };
+
+  return cmocka_run_group_tests(tests, null, test_teardown);
+}
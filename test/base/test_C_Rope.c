@@ -0,0 +1,192 @@
+// clang-format off
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <cmocka.h>
+// clang-format on
+
+#include "../test_helpers.h"
+#include "c_base/base/memory/allocator.h"
+#include <c_base/base/memory/memory.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/base/strings/C_Rope.h>
+
+#define MODEL_CAP 200000
+#define EDIT_COUNT 3000
+
+static u64 test_seed = 88172645463325252ull;
+
+static u64 test_rand(void) {
+  test_seed ^= test_seed << 13;
+  test_seed ^= test_seed >> 7;
+  test_seed ^= test_seed << 17;
+  return test_seed;
+}
+
+static void assert_rope_equals(C_Rope* rope, ascii* chars, u64 len) {
+  assert_int_equal(len, C_Rope_get_len(rope));
+
+  C_String* flat = C_Rope_to_str_R(rope);
+  assert_int_equal(len, C_String_get_len(flat));
+  assert_true(mem_equals(C_String_get_chars(flat), chars, len));
+  Unref(flat);
+
+  /* an AVL tree of n chunks is at most 1.44 log2(n) deep, there are no
+   * more chunks than chars */
+  u64 chunks = len + 2;
+  u32 log2 = 0;
+  while ((1ull << log2) < chunks) {
+    log2++;
+  }
+  assert_true(C_Rope_get_depth(rope) <= log2 * 3 / 2 + 1);
+}
+
+static void test_C_Rope_new(void** state) {
+  (void)state;
+
+  C_Rope* rope = C_Rope_new();
+  AssertClassEqual(rope, ClassObject_id);
+  assert_int_equal(0, C_Rope_get_len(rope));
+  assert_int_equal(0, C_Rope_get_depth(rope));
+  assert_rope_equals(rope, "", 0);
+  Unref(rope);
+
+  ascii chars[5000];
+  for (u32 i = 0; i < 5000; i++) {
+    chars[i] = 'a' + i % 26;
+  }
+  rope = C_Rope_new_view(StringView_construct(chars, 5000));
+  assert_rope_equals(rope, chars, 5000);
+  assert_int_equal('a' + 4999 % 26, C_Rope_at(rope, 4999));
+
+  C_String* str = IFormattable_to_str_PR(rope);
+  assert_int_equal(5000, C_String_get_len(str));
+  Unref(str);
+
+  Unref(rope);
+}
+
+static void test_C_Rope_append(void** state) {
+  (void)state;
+
+  C_Rope* rope = C_Rope_new();
+  ascii* model = allocate(MODEL_CAP);
+  u64 len = 0;
+
+  // pieces of every length, so chunks fill up and overflow
+  while (len + 100 < MODEL_CAP) {
+    u32 piece = test_rand() % 100;
+    for (u32 i = 0; i < piece; i++) {
+      model[len + i] = 'a' + (len + i) % 26;
+    }
+    C_Rope_append(rope, StringView_construct(model + len, piece));
+    len += piece;
+  }
+  assert_rope_equals(rope, model, len);
+
+  for (u32 i = 0; i < 1000; i++) {
+    u64 index = test_rand() % len;
+    assert_int_equal(model[index], C_Rope_at(rope, index));
+  }
+
+  deallocate(model);
+  Unref(rope);
+}
+
+static void test_C_Rope_insert(void** state) {
+  (void)state;
+
+  C_Rope* rope = C_Rope_new();
+  ascii* model = allocate(MODEL_CAP);
+  u64 len = 0;
+
+  ascii text[3000];
+  for (u32 i = 0; i < 3000; i++) {
+    text[i] = '0' + i % 10;
+  }
+
+  // inserts and deletes at random places, some longer than a chunk
+  for (u32 edit = 0; edit < EDIT_COUNT; edit++) {
+    u64 index = len ? test_rand() % (len + 1) : 0;
+    if (len > 20000 || (len && test_rand() % 3 == 0)) {
+      u64 delete_len = test_rand() % (len - index + 1);
+      if (delete_len > 2500) {
+        delete_len = 2500;
+      }
+      C_Rope_delete(rope, index, delete_len);
+      mem_copy(model + index, model + index + delete_len,
+        len - index - delete_len);
+      len -= delete_len;
+    } else {
+      u32 text_len = edit % 50 == 0 ? 3000 : test_rand() % 40;
+      C_Rope_insert(rope, index, StringView_construct(text, text_len));
+      mem_copy(model + index + text_len, model + index, len - index);
+      mem_copy(model + index, text, text_len);
+      len += text_len;
+    }
+
+    if (edit % 100 == 0) {
+      assert_rope_equals(rope, model, len);
+    }
+  }
+  assert_rope_equals(rope, model, len);
+
+  C_Rope_delete(rope, 0, len);
+  assert_rope_equals(rope, model, 0);
+
+  deallocate(model);
+  Unref(rope);
+}
+
+static void test_C_Rope_concat_PR(void** state) {
+  (void)state;
+
+  ascii chars[10000];
+  for (u32 i = 0; i < 10000; i++) {
+    chars[i] = 'a' + i % 26;
+  }
+
+  C_Rope* a = C_Rope_new_view(StringView_construct(chars, 6000));
+  C_Rope* b = C_Rope_new_view(StringView_construct(chars + 6000, 4000));
+  C_Rope* both = C_Rope_concat_PR(a, b);
+  assert_rope_equals(both, chars, 10000);
+
+  // the ropes share their chunks, editing one leaves the others alone
+  C_Rope_insert(both, 3000, SV("xyz"));
+  C_Rope_delete(a, 0, 10);
+  assert_rope_equals(b, chars + 6000, 4000);
+  assert_rope_equals(a, chars + 10, 5990);
+  assert_int_equal(10003, C_Rope_get_len(both));
+  assert_int_equal('x', C_Rope_at(both, 3000));
+  assert_int_equal(chars[3000], C_Rope_at(both, 3003));
+
+  C_Rope* sub = C_Rope_substr_R(b, 1000, 2500);
+  assert_rope_equals(sub, chars + 7000, 2500);
+  C_Rope_append(sub, SV("!"));
+  assert_rope_equals(b, chars + 6000, 4000);
+
+  C_Rope* empty = C_Rope_substr_R(b, 4000, 0);
+  assert_int_equal(0, C_Rope_get_len(empty));
+
+  // a rope appended to itself
+  C_Rope_append_rope_P(b, b);
+  assert_int_equal(8000, C_Rope_get_len(b));
+  assert_int_equal(chars[6000], C_Rope_at(b, 4000));
+
+  Unref(empty);
+  Unref(sub);
+  Unref(both);
+  Unref(a);
+  Unref(b);
+}
+
+int main(void) {
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_C_Rope_new),
+    cmocka_unit_test(test_C_Rope_append),
+    cmocka_unit_test(test_C_Rope_insert),
+    cmocka_unit_test(test_C_Rope_concat_PR),
+  };
+
+  return cmocka_run_group_tests(tests, null, test_teardown);
+}
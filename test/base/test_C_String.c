@@ -0,0 +1,108 @@
+// clang-format off
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <cmocka.h>
+// clang-format on
+
+#include "../test_helpers.h"
+#include <c_base/base/memory/allocator.h>
+#include <c_base/base/memory/memory.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/base/strings/string_convert.h>
+#include <c_base/base/strings/strings.h>
+#include <c_base/base/varargs.h>
+
+static void assert_str_equals(C_String* str, char* expected) {
+  u32 len = 0;
+  while (expected[len]) {
+    len++;
+  }
+  assert_int_equal(len, C_String_get_len(str));
+  assert_true(mem_equals(C_String_get_chars(str), expected, len));
+}
+
+static void test_C_String_new_copy_inline(void** state) {
+  (void)state;
+
+  ascii chars[StringInlineCap + 1];
+  for (u32 i = 0; i <= StringInlineCap; i++) {
+    chars[i] = 'a' + i % 26;
+  }
+
+  // a short copy is one allocation, its chars are in the string
+  u64 allocations = allocator_get_allocations();
+  C_String* short_str = C_String_new_copy(chars, StringInlineCap);
+  assert_int_equal(1, allocator_get_allocations() - allocations);
+  assert_true(mem_equals(
+    C_String_get_chars(short_str), chars, StringInlineCap));
+  assert_true((u8*)C_String_get_chars(short_str) > (u8*)short_str);
+
+  allocations = allocator_get_allocations();
+  C_String* long_str = C_String_new_copy(chars, StringInlineCap + 1);
+  assert_int_equal(2, allocator_get_allocations() - allocations);
+  assert_true(mem_equals(
+    C_String_get_chars(long_str), chars, StringInlineCap + 1));
+
+  // the copies do not share the chars
+  chars[0] = 'z';
+  assert_int_equal('a', C_String_at(short_str, 0));
+  assert_int_equal('a', C_String_at(long_str, 0));
+
+  Unref(long_str);
+  Unref(short_str);
+}
+
+static void test_C_String_put_inline(void** state) {
+  (void)state;
+
+  C_String* str = C_String_new_empty(3);
+  assert_int_equal(3, C_String_get_len(str));
+  assert_true(mem_equals(C_String_get_chars(str), "\0\0\0", 3));
+  C_String_put(str, 0, 'a');
+  C_String_put(str, 1, 'b');
+  C_String_put(str, 2, 'c');
+  assert_str_equals(str, "abc");
+
+  // a substring shares the inline chars and keeps the string alive
+  C_String* substr = C_String_substr_R(str, 1, 2);
+  Unref(str);
+  assert_str_equals(substr, "bc");
+
+  C_String* other = S("bc");
+  assert_true(C_String_equals(substr, other));
+  assert_int_equal(IHashable_hash(substr), IHashable_hash(other));
+  assert_int_equal(0, C_String_compare(substr, other));
+  Unref(other);
+  Unref(substr);
+}
+
+static void test_C_String_inline_results(void** state) {
+  (void)state;
+
+  C_String* number = u64_to_str_R(u64_MAX);
+  assert_str_equals(number, "18446744073709551615");
+  C_String* negative = s64_to_str_R(s64_MIN);
+  assert_str_equals(negative, "-9223372036854775808");
+
+  C_String* both = C_String_concat_PR(number, PS(" "), negative, ArgsEnd);
+  assert_str_equals(both, "18446744073709551615 -9223372036854775808");
+
+  C_String* joined = C_String_concat_PR(PS("ab"), PS("cd"), ArgsEnd);
+  assert_str_equals(joined, "abcd");
+
+  Unref(joined);
+  Unref(both);
+  Unref(negative);
+  Unref(number);
+}
+
+int main(void) {
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_C_String_new_copy_inline),
+    cmocka_unit_test(test_C_String_put_inline),
+    cmocka_unit_test(test_C_String_inline_results),
+  };
+
+  return cmocka_run_group_tests(tests, null, test_teardown);
+}
@@ -0,0 +1,261 @@
+// clang-format off
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <cmocka.h>
+// clang-format on
+
+#include "../test_helpers.h"
+#include <c_base/base/memory/allocator.h>
+#include <c_base/base/memory/handles.h>
+#include <c_base/base/memory/memory.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/base/strings/C_StringBuilder.h>
+#include <c_base/base/strings/C_Rope.h>
+#include <c_base/base/strings/format.h>
+#include <c_base/base/strings/string_convert.h>
+#include <c_base/ds/C_DArray.h>
+#include <c_base/ds/C_List.h>
+
+static void assert_builder_equals(C_StringBuilder* builder, char* cstr) {
+  StringView view = C_StringBuilder_get_view(builder);
+  assert_int_equal(cstr_len(cstr), view.len);
+  assert_true(mem_equals(view.chars, cstr, view.len));
+}
+
+static void assert_str_equals(C_String* string, char* cstr) {
+  assert_int_equal(cstr_len(cstr), C_String_get_len(string));
+  assert_true(mem_equals(C_String_get_chars(string), cstr, cstr_len(cstr)));
+}
+
+static void test_C_StringBuilder_new(void** state) {
+  (void)state;
+
+  C_StringBuilder* builder = C_StringBuilder_new();
+  AssertClassEqual(builder, ClassObject_id);
+  assert_int_equal(0, C_StringBuilder_get_len(builder));
+  assert_int_equal(StringBuilderStartCap, C_StringBuilder_get_cap(builder));
+  Unref(builder);
+
+  builder = C_StringBuilder_new_cap(0);
+  assert_int_equal(0, C_StringBuilder_get_cap(builder));
+  C_String* empty = C_StringBuilder_finish_R(builder);
+  assert_int_equal(0, C_String_get_len(empty));
+  Unref(empty);
+
+  C_StringBuilder_append_char(builder, 'x');
+  assert_builder_equals(builder, "x");
+  Unref(builder);
+}
+
+static void test_C_StringBuilder_append(void** state) {
+  (void)state;
+
+  C_StringBuilder* builder = C_StringBuilder_new_cap(4);
+  C_StringBuilder_append_char(builder, '<');
+  C_StringBuilder_append_view(builder, SV("view"));
+  C_StringBuilder_append_P(builder, PS("string"));
+  C_StringBuilder_append_str_P(builder, Pass(C_Handle_u32_new(42)));
+  C_StringBuilder_append_str_P(builder, null);
+  C_StringBuilder_append_char(builder, '>');
+  assert_builder_equals(builder, "<viewstring42null>");
+
+  C_StringBuilder_pop(builder, 5);
+  assert_builder_equals(builder, "<viewstring42");
+
+  C_String* copy = IFormattable_to_str_PR(builder);
+  assert_str_equals(copy, "<viewstring42");
+  Unref(copy);
+
+  C_StringBuilder_clear(builder);
+  assert_int_equal(0, C_StringBuilder_get_len(builder));
+  assert_builder_equals(builder, "");
+
+  // doubling, every append stays in place after the last growth
+  for (u32 i = 0; i < 100000; i++) {
+    C_StringBuilder_append_char(builder, 'a' + i % 26);
+  }
+  assert_int_equal(100000, C_StringBuilder_get_len(builder));
+  assert_true(C_StringBuilder_get_cap(builder) < 2 * 100000);
+  assert_int_equal('a' + 99999 % 26,
+    C_StringBuilder_get_view(builder).chars[99999]);
+
+  Unref(builder);
+}
+
+static void test_C_StringBuilder_append_numbers(void** state) {
+  (void)state;
+
+  C_StringBuilder* builder = C_StringBuilder_new();
+  C_StringBuilder_append_u64(builder, 0);
+  C_StringBuilder_append_char(builder, ' ');
+  C_StringBuilder_append_u64(builder, u64_MAX);
+  C_StringBuilder_append_char(builder, ' ');
+  C_StringBuilder_append_s64(builder, -123);
+  C_StringBuilder_append_char(builder, ' ');
+  C_StringBuilder_append_s64(builder, s64_MIN);
+  assert_builder_equals(
+    builder, "0 18446744073709551615 -123 -9223372036854775808");
+  C_StringBuilder_clear(builder);
+
+  f64 floats[] = {0, -1.5, 3.14159265, 1e25, 1.0 / 0.0, -1.0 / 0.0};
+  for (u32 i = 0; i < sizeof(floats) / sizeof(f64); i++) {
+    C_StringBuilder_clear(builder);
+    C_StringBuilder_append_f64(builder, floats[i]);
+
+    C_String* expected = f64_to_str_R(floats[i]);
+    StringView view = C_StringBuilder_get_view(builder);
+    assert_int_equal(C_String_get_len(expected), view.len);
+    assert_true(
+      mem_equals(C_String_get_chars(expected), view.chars, view.len));
+    Unref(expected);
+  }
+
+  Unref(builder);
+}
+
+static void test_C_StringBuilder_finish_R(void** state) {
+  (void)state;
+
+  C_StringBuilder* builder = C_StringBuilder_new();
+  C_StringBuilder_append_view(builder, SV("hello world"));
+  ascii* chars = C_StringBuilder_get_view(builder).chars;
+
+  // the string takes the buffer, nothing is copied
+  C_String* result = C_StringBuilder_finish_R(builder);
+  assert_ptr_equal(chars, C_String_get_chars(result));
+  assert_str_equals(result, "hello world");
+  assert_int_equal(0, C_StringBuilder_get_len(builder));
+  assert_int_equal(0, C_StringBuilder_get_cap(builder));
+
+  // the builder starts over with a new buffer
+  C_StringBuilder_append_view(builder, SV("again"));
+  C_String* again = C_StringBuilder_finish_R(builder);
+  assert_str_equals(again, "again");
+  assert_str_equals(result, "hello world");
+
+  Unref(again);
+  Unref(result);
+  Unref(builder);
+}
+
+// the sink in these tests flushes into another builder and counts flushes
+static u32 test_flush_count = 0;
+
+static void test_flush(void* target, StringView chars) {
+  C_StringBuilder_append_view(target, chars);
+  test_flush_count++;
+}
+
+static void test_C_StringBuilder_new_sink(void** state) {
+  (void)state;
+
+  C_StringBuilder* out = C_StringBuilder_new();
+  C_StringBuilder* sink = C_StringBuilder_new_sink(64, test_flush, out);
+  test_flush_count = 0;
+
+  // small pieces stay in the buffer until it is full
+  for (u32 i = 0; i < 10; i++) {
+    C_StringBuilder_append_view(sink, SV("0123456789"));
+  }
+  assert_int_equal(1, test_flush_count);
+  assert_int_equal(60, C_StringBuilder_get_len(out));
+  assert_int_equal(40, C_StringBuilder_get_len(sink));
+
+  // a piece larger than the buffer goes straight through
+  ascii large[200];
+  mem_set(large, 'x', 200);
+  C_StringBuilder_append_view(sink, StringView_construct(large, 200));
+  assert_int_equal(3, test_flush_count);
+  assert_int_equal(300, C_StringBuilder_get_len(out));
+  assert_int_equal(0, C_StringBuilder_get_len(sink));
+
+  for (u32 i = 0; i < 100; i++) {
+    C_StringBuilder_append_u64(sink, u64_MAX);
+  }
+  assert_int_equal(64, C_StringBuilder_get_cap(sink));
+
+  // destroy flushes the rest
+  Unref(sink);
+  assert_int_equal(300 + 100 * 20, C_StringBuilder_get_len(out));
+  Unref(out);
+}
+
+/* a type from before write_to, it only makes strings */
+static Interface* test_old_interfaces[2];
+static IFormattable test_old_i_formattable = {0};
+
+static C_String* test_old_to_str_R(void* self) {
+  (void)self;
+  return S("old");
+}
+
+static void test_old_destroy(void* self) { (void)self; }
+
+static ClassObject* test_old_new(void) {
+  test_old_i_formattable = IFormattable_construct(test_old_to_str_R);
+  test_old_interfaces[0] = (Interface*)&test_old_i_formattable;
+  test_old_interfaces[1] = null;
+
+  ClassObject* self = allocate(sizeof(ClassObject));
+  *self = ClassObject_construct(test_old_destroy, test_old_interfaces);
+  return self;
+}
+
+static void test_IFormattable_write_to_PR(void** state) {
+  (void)state;
+
+  C_List* inner = C_List_new();
+  C_List_push_P(inner, Pass(C_Handle_s32_new(-7)));
+  C_List_push_P(inner, Pass(test_old_new()));
+
+  C_DArray* darray = C_DArray_new();
+  C_DArray_push_P(darray, Pass(C_Handle_u64_new(u64_MAX)));
+  C_DArray_push_P(darray, PS("text"));
+  C_DArray_push_P(darray, null);
+  C_DArray_push_P(darray, Pass(C_Handle_f64_new(2.5)));
+  C_DArray_push_P(darray, Pass(C_Handle_b8_new(5)));
+  C_DArray_push_P(darray, Pass(C_Handle_bool_new(true)));
+  C_DArray_push_P(darray, Pass(C_Rope_new_view(SV("rope"))));
+  C_DArray_push_P(darray, inner);
+
+  char* expected =
+    "[18446744073709551615, text, null, 2.5, 10100000, true, rope, [-7, old]]";
+
+  C_StringBuilder* builder = C_StringBuilder_new();
+  IFormattable_write_to_PR(darray, builder, null);
+  assert_builder_equals(builder, expected);
+
+  // the old api makes its strings through write_to
+  C_String* str = IFormattable_to_str_PR(darray);
+  assert_str_equals(str, expected);
+  Unref(str);
+
+  C_StringBuilder_clear(builder);
+  IFormattable_write_to_PR(
+    inner, builder, Pass(C_Format_new_P(PS("start=(;end=);sep=|"))));
+  assert_builder_equals(builder, "(-7|old)");
+
+  C_String* format = S("start=<;end=>;sep=-");
+  str = C_List_to_str_format_R(inner, format);
+  assert_str_equals(str, "<-7-old>");
+  Unref(str);
+  Unref(format);
+
+  Unref(builder);
+  Unref(darray);
+  Unref(inner);
+}
+
+int main(void) {
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_C_StringBuilder_new),
+    cmocka_unit_test(test_C_StringBuilder_append),
+    cmocka_unit_test(test_C_StringBuilder_append_numbers),
+    cmocka_unit_test(test_C_StringBuilder_finish_R),
+    cmocka_unit_test(test_C_StringBuilder_new_sink),
+    cmocka_unit_test(test_IFormattable_write_to_PR),
+  };
+
+  return cmocka_run_group_tests(tests, null, test_teardown);
+}
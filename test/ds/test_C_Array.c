@@ -45,6 +45,19 @@ static void test_C_Array_new(void** state) {
   Unref(array);
 }
 
+static void test_C_Array_new_single_allocation(void** state) {
+  (void)state;
+
+  u64 allocations = allocator_get_allocations();
+  C_Array* array = C_Array_new(5);
+  assert_int_equal(1, allocator_get_allocations() - allocations);
+
+  // the values start out null
+  C_ArrayForeach(array, { assert_null(value); });
+
+  Unref(array);
+}
+
 static void test_C_Array_destroy(void** state) {
   (void)state;
 
@@ -241,10 +254,61 @@ static void test_C_Array_clear(void** state) {
   Unref(array);
 }
 
+static s32 compare_desc(void* a, void* b) {
+  return C_Handle_s32_compare(b, a);
+}
+
+static void test_C_Array_sort(void** state) {
+  (void)state;
+
+  C_Array* array = C_Array_new(5);
+  C_Array_put_P(array, 0, Pass(C_Handle_s32_new(3)));
+  C_Array_put_P(array, 1, Pass(C_Handle_s32_new(-7)));
+  C_Array_put_P(array, 2, Pass(C_Handle_s32_new(0)));
+  C_Array_put_P(array, 3, Pass(C_Handle_s32_new(12)));
+  C_Array_put_P(array, 4, Pass(C_Handle_s32_new(-1)));
+
+  C_Array_sort(array);
+
+  s32 expected[] = {-7, -1, 0, 3, 12};
+  C_ArrayForeach(array, {
+    assert_int_equal(expected[iter], C_Handle_s32_get_value(value));
+  });
+
+  // nulls take the generic compare path and sort first
+  C_Array_put_P(array, 2, null);
+  C_Array_sort(array);
+  assert_null(C_Array_at_B(array, 0));
+  assert_int_equal(-7, C_Handle_s32_get_value(C_Array_at_B(array, 1)));
+  assert_int_equal(12, C_Handle_s32_get_value(C_Array_at_B(array, 4)));
+
+  Unref(array);
+}
+
+static void test_C_Array_sort_by(void** state) {
+  (void)state;
+
+  C_Array* array = C_Array_new(4);
+  C_Array_put_P(array, 0, Pass(C_Handle_s32_new(2)));
+  C_Array_put_P(array, 1, Pass(C_Handle_s32_new(9)));
+  C_Array_put_P(array, 2, Pass(C_Handle_s32_new(-4)));
+  C_Array_put_P(array, 3, Pass(C_Handle_s32_new(5)));
+
+  C_Array_sort_by(array, compare_desc);
+
+  s32 expected[] = {9, 5, 2, -4};
+  C_ArrayForeach(array, {
+    assert_int_equal(expected[iter], C_Handle_s32_get_value(value));
+  });
+
+  Unref(array);
+}
+
 int main(void) {
   const struct CMUnitTest tests[] = {
     cmocka_unit_test(test_C_ArrayForeach),
     cmocka_unit_test(test_C_Array_new),
+    cmocka_unit_test(test_C_Array_new_single_allocation),
     cmocka_unit_test(test_C_Array_destroy),
     cmocka_unit_test(test_C_Array_put_P),
     cmocka_unit_test(test_C_Array_at_B),
@@ -256,6 +320,8 @@ int main(void) {
     cmocka_unit_test(test_C_Array_equals),
     cmocka_unit_test(test_C_Array_to_str_format_R),
     cmocka_unit_test(test_C_Array_clear),
+    cmocka_unit_test(test_C_Array_sort),
+    cmocka_unit_test(test_C_Array_sort_by),
   };
 
   return cmocka_run_group_tests(tests, null, test_teardown);
@@ -0,0 +1,209 @@
+// clang-format off
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <cmocka.h>
+// clang-format on
+
+#include "../test_helpers.h"
+#include "c_base/base/memory/allocator.h"
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_BitSet.h>
+#include <c_base/ds/ds_simd.h>
+
+// not a multiple of 64, the last word is partly used
+#define TEST_LEN 1000
+
+static void test_C_BitSet_new(void** state) {
+  (void)state;
+
+  C_BitSet* set = C_BitSet_new(TEST_LEN);
+
+  AssertClassEqual(set, ClassObject_id);
+  assert_int_equal(TEST_LEN, C_BitSet_get_len(set));
+  assert_int_equal(16, C_BitSet_get_word_len(set));
+  assert_int_equal(0, C_BitSet_count(set));
+
+  C_BitSet* empty = C_BitSet_new(0);
+  assert_int_equal(0, C_BitSet_get_word_len(empty));
+  assert_int_equal(0, C_BitSet_count(empty));
+  assert_int_equal(0, C_BitSet_find_next_set(empty, 0));
+
+  Unref(empty);
+  Unref(set);
+}
+
+static void test_C_BitSet_set(void** state) {
+  (void)state;
+
+  C_BitSet* set = C_BitSet_new(TEST_LEN);
+  for (u64 i = 0; i < TEST_LEN; i += 3) {
+    C_BitSet_set(set, i);
+  }
+
+  for (u64 i = 0; i < TEST_LEN; i++) {
+    assert_int_equal(i % 3 == 0, C_BitSet_test(set, i));
+  }
+  assert_int_equal((TEST_LEN + 2) / 3, C_BitSet_count(set));
+
+  for (u64 i = 0; i < TEST_LEN; i += 6) {
+    C_BitSet_clear(set, i);
+  }
+  for (u64 i = 0; i < TEST_LEN; i++) {
+    assert_int_equal(i % 3 == 0 && i % 6 != 0, C_BitSet_test(set, i));
+  }
+
+  C_BitSet_set_all(set);
+  assert_int_equal(TEST_LEN, C_BitSet_count(set));
+  assert_true(C_BitSet_test(set, TEST_LEN - 1));
+
+  C_BitSet_clear_all(set);
+  assert_int_equal(0, C_BitSet_count(set));
+
+  Unref(set);
+}
+
+static void test_C_BitSet_find_next_set(void** state) {
+  (void)state;
+
+  C_BitSet* set = C_BitSet_new(TEST_LEN);
+  assert_int_equal(TEST_LEN, C_BitSet_find_next_set(set, 0));
+
+  C_BitSet_set(set, 5);
+  C_BitSet_set(set, 64);
+  C_BitSet_set(set, 700);
+  C_BitSet_set(set, TEST_LEN - 1);
+
+  assert_int_equal(5, C_BitSet_find_next_set(set, 0));
+  assert_int_equal(5, C_BitSet_find_next_set(set, 5));
+  assert_int_equal(64, C_BitSet_find_next_set(set, 6));
+  assert_int_equal(700, C_BitSet_find_next_set(set, 65));
+  assert_int_equal(TEST_LEN - 1, C_BitSet_find_next_set(set, 701));
+  assert_int_equal(TEST_LEN, C_BitSet_find_next_set(set, TEST_LEN));
+
+  Unref(set);
+}
+
+static void test_C_BitSet_rank(void** state) {
+  (void)state;
+
+  C_BitSet* set = C_BitSet_new(TEST_LEN);
+  for (u64 i = 0; i < TEST_LEN; i += 2) {
+    C_BitSet_set(set, i);
+  }
+
+  for (u64 i = 0; i <= TEST_LEN; i++) {
+    assert_int_equal((i + 1) / 2, C_BitSet_rank(set, i));
+  }
+
+  Unref(set);
+}
+
+static void test_C_BitSet_ops(void** state) {
+  (void)state;
+
+  C_BitSet* a = C_BitSet_new(TEST_LEN);
+  C_BitSet* b = C_BitSet_new(TEST_LEN);
+  for (u64 i = 0; i < TEST_LEN; i++) {
+    if (i % 2 == 0) {
+      C_BitSet_set(a, i);
+    }
+    if (i % 3 == 0) {
+      C_BitSet_set(b, i);
+    }
+  }
+
+  // every level has to give the same bits
+  SimdLevel max_level = simd_detect_level();
+  for (SimdLevel level = SIMD_SCALAR; level <= max_level; level++) {
+    simd_set_level(level);
+
+    C_BitSet* result = C_BitSet_new_copy(a);
+    C_BitSet_and(result, b);
+    for (u64 i = 0; i < TEST_LEN; i++) {
+      assert_int_equal(i % 6 == 0, C_BitSet_test(result, i));
+    }
+    Unref(result);
+
+    result = C_BitSet_new_copy(a);
+    C_BitSet_or(result, b);
+    for (u64 i = 0; i < TEST_LEN; i++) {
+      assert_int_equal(i % 2 == 0 || i % 3 == 0, C_BitSet_test(result, i));
+    }
+    Unref(result);
+
+    result = C_BitSet_new_copy(a);
+    C_BitSet_xor(result, b);
+    for (u64 i = 0; i < TEST_LEN; i++) {
+      bool expected = (i % 2 == 0) != (i % 3 == 0);
+      assert_int_equal(expected, C_BitSet_test(result, i));
+    }
+    Unref(result);
+
+    result = C_BitSet_new_copy(a);
+    C_BitSet_andnot(result, b);
+    for (u64 i = 0; i < TEST_LEN; i++) {
+      assert_int_equal(i % 2 == 0 && i % 3 != 0, C_BitSet_test(result, i));
+    }
+    assert_int_equal(
+      TEST_LEN / 2 - (TEST_LEN + 5) / 6, C_BitSet_count(result));
+    Unref(result);
+  }
+  simd_set_level(max_level);
+
+  Unref(a);
+  Unref(b);
+}
+
+static void test_C_BitSet_equals(void** state) {
+  (void)state;
+
+  C_BitSet* a = C_BitSet_new(TEST_LEN);
+  C_BitSet* b = C_BitSet_new(TEST_LEN);
+  C_BitSet* other_len = C_BitSet_new(TEST_LEN + 1);
+
+  C_BitSet_set(a, 10);
+  assert_false(C_BitSet_equals(a, b));
+  C_BitSet_set(b, 10);
+  assert_true(C_BitSet_equals(a, b));
+  assert_int_equal(C_BitSet_hash(a), C_BitSet_hash(b));
+  assert_false(C_BitSet_equals(a, other_len));
+
+  Unref(a);
+  Unref(b);
+  Unref(other_len);
+}
+
+static void test_C_BitSet_to_str_format_R(void** state) {
+  (void)state;
+
+  C_BitSet* set = C_BitSet_new(TEST_LEN);
+  C_BitSet_set(set, 1);
+  C_BitSet_set(set, 64);
+  C_BitSet_set(set, 999);
+
+  C_String* correct_result = S("<1|64|999>");
+  C_String* format = S("start=<;end=>;sep=|");
+  C_String* result = C_BitSet_to_str_format_R(set, format);
+
+  assert_true(C_String_equals(correct_result, result));
+
+  Unref(format);
+  Unref(correct_result);
+  Unref(result);
+  Unref(set);
+}
+
+int main(void) {
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_C_BitSet_new),
+    cmocka_unit_test(test_C_BitSet_set),
+    cmocka_unit_test(test_C_BitSet_find_next_set),
+    cmocka_unit_test(test_C_BitSet_rank),
+    cmocka_unit_test(test_C_BitSet_ops),
+    cmocka_unit_test(test_C_BitSet_equals),
+    cmocka_unit_test(test_C_BitSet_to_str_format_R),
+  };
+
+  return cmocka_run_group_tests(tests, null, test_teardown);
+}
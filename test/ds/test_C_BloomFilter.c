@@ -0,0 +1,125 @@
+// clang-format off
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <cmocka.h>
+// clang-format on
+
+#include "../test_helpers.h"
+#include "c_base/base/memory/allocator.h"
+#include <c_base/base/memory/handles.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_BloomFilter.h>
+#include <c_base/ds/ds_simd.h>
+
+#define TEST_LEN 10000
+
+CreateTestHook(C_Handle_u32, C_Handle_u32_destroy)
+
+static void test_C_BloomFilter_new(void** state) {
+  (void)state;
+
+  C_BloomFilter* filter = C_BloomFilter_new(TEST_LEN, 10);
+
+  AssertClassEqual(filter, ClassObject_id);
+  assert_int_equal(0, C_BloomFilter_get_len(filter));
+  assert_true(C_BloomFilter_get_bits(filter) >= TEST_LEN * 10);
+  assert_int_equal(0, C_BloomFilter_get_bits(filter) % 256);
+
+  // an empty filter still has one block
+  C_BloomFilter* empty = C_BloomFilter_new(0, 10);
+  assert_int_equal(256, C_BloomFilter_get_bits(empty));
+  assert_false(C_BloomFilter_contains_bytes(empty, "a", 1));
+
+  Unref(empty);
+  Unref(filter);
+}
+
+static void test_C_BloomFilter_add_P(void** state) {
+  (void)state;
+
+  /* test passing */ {
+    C_BloomFilter* filter = C_BloomFilter_new(TEST_LEN, 10);
+    C_Handle_u32* key = C_Handle_u32_new(10);
+    TestHook(C_Handle_u32, key);
+
+    AssertHookDestroyed(1, { C_BloomFilter_add_P(filter, Pass(key)); });
+    Unref(filter);
+  }
+
+  C_BloomFilter* filter = C_BloomFilter_new(TEST_LEN, 10);
+  for (u32 i = 0; i < TEST_LEN; i++) {
+    C_BloomFilter_add_P(filter, Pass(C_Handle_u32_new(i)));
+  }
+  assert_int_equal(TEST_LEN, C_BloomFilter_get_len(filter));
+
+  // no added key is missed, other keys are reported rarely
+  u32 false_positives = 0;
+  for (u32 i = 0; i < TEST_LEN; i++) {
+    assert_true(C_BloomFilter_contains_P(filter, Pass(C_Handle_u32_new(i))));
+    false_positives +=
+      C_BloomFilter_contains_P(filter, Pass(C_Handle_u32_new(TEST_LEN + i)));
+  }
+  assert_true(false_positives < TEST_LEN / 50);
+
+  Unref(filter);
+}
+
+static void test_C_BloomFilter_levels(void** state) {
+  (void)state;
+
+  // the scalar and the avx2 version set and test the same bits
+  SimdLevel max_level = simd_get_level();
+  simd_set_level(SIMD_SCALAR);
+  C_BloomFilter* scalar = C_BloomFilter_new(TEST_LEN, 8);
+  for (u32 i = 0; i < TEST_LEN; i++) {
+    C_BloomFilter_add_bytes(scalar, &i, sizeof(u32));
+  }
+  simd_set_level(max_level);
+
+  C_BloomFilter* best = C_BloomFilter_new(TEST_LEN, 8);
+  for (u32 i = 0; i < TEST_LEN; i++) {
+    C_BloomFilter_add_bytes(best, &i, sizeof(u32));
+  }
+
+  for (u32 i = 0; i < 2 * TEST_LEN; i++) {
+    bool expected = C_BloomFilter_contains_bytes(best, &i, sizeof(u32));
+    assert_int_equal(
+      expected, C_BloomFilter_contains_bytes(scalar, &i, sizeof(u32)));
+    simd_set_level(SIMD_SCALAR);
+    assert_int_equal(
+      expected, C_BloomFilter_contains_bytes(best, &i, sizeof(u32)));
+    simd_set_level(max_level);
+  }
+
+  Unref(scalar);
+  Unref(best);
+}
+
+static void test_C_BloomFilter_clear(void** state) {
+  (void)state;
+
+  C_BloomFilter* filter = C_BloomFilter_new(TEST_LEN, 10);
+  for (u64 i = 0; i < TEST_LEN; i++) {
+    C_BloomFilter_add_hash(filter, ds_hash_mix(i));
+  }
+
+  C_BloomFilter_clear(filter);
+  assert_int_equal(0, C_BloomFilter_get_len(filter));
+  for (u64 i = 0; i < TEST_LEN; i++) {
+    assert_false(C_BloomFilter_contains_hash(filter, ds_hash_mix(i)));
+  }
+
+  Unref(filter);
+}
+
+int main(void) {
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_C_BloomFilter_new),
+    cmocka_unit_test(test_C_BloomFilter_add_P),
+    cmocka_unit_test(test_C_BloomFilter_levels),
+    cmocka_unit_test(test_C_BloomFilter_clear),
+  };
+
+  return cmocka_run_group_tests(tests, null, test_teardown);
+}
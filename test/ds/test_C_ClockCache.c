@@ -0,0 +1,242 @@
+// clang-format off
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <cmocka.h>
+// clang-format on
+
+#include "../test_helpers.h"
+#include "c_base/base/memory/allocator.h"
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_Array.h>
+#include <c_base/ds/C_ClockCache.h>
+#include <c_base/os/os_threads.h>
+#include <stdio.h>
+
+#define THREAD_COUNT 4
+#define THREAD_KEYS 500
+#define THREAD_ROUNDS 20
+
+typedef struct {
+  u32 evicted;
+  u64 last_evicted;
+} EvictData;
+
+/* every thread puts and gets its own keys, values are the key number
+ * times two and must never come back for a different key */
+typedef struct {
+  ClassObject base;
+  C_ClockCache* cache;
+  u32 thread;
+  bool correct;
+} CacheJob;
+
+static void CacheJob_destroy(void* self) { (void)self; }
+
+static void count_evict(StringView key, void* value, void* data) {
+  (void)key;
+  EvictData* data_cast = data;
+  data_cast->evicted++;
+  data_cast->last_evicted = *(u64*)value;
+}
+
+static StringView key_of(ascii* buffer, u64 key) {
+  s32 len = snprintf(buffer, 32, "key-%llu", (unsigned long long)key);
+  return StringView_construct(buffer, (u32)len);
+}
+
+static void put_u64(C_ClockCache* cache, u64 key, u64 value) {
+  ascii buffer[32];
+  C_ClockCache_put(cache, key_of(buffer, key), &value);
+}
+
+static bool get_u64(C_ClockCache* cache, u64 key, u64* value) {
+  ascii buffer[32];
+  return C_ClockCache_get(cache, key_of(buffer, key), value);
+}
+
+static void cache_func(C_Thread* thread) {
+  CacheJob* job = C_Thread_get_arg_B(thread, 0);
+  u64 first = (u64)job->thread * THREAD_KEYS;
+
+  for (u32 round = 0; round < THREAD_ROUNDS; round++) {
+    for (u64 key = first; key < first + THREAD_KEYS; key++) {
+      u64 value = 0;
+      if (get_u64(job->cache, key, &value)) {
+        job->correct &= value == key * 2;
+      } else {
+        put_u64(job->cache, key, key * 2);
+      }
+    }
+    os_threads_yield();
+  }
+}
+
+static void test_C_ClockCache_new(void** state) {
+  (void)state;
+
+  C_ClockCache* cache = C_ClockCache_new(100, 3, sizeof(u64));
+
+  AssertClassEqual(cache, ClassObject_id);
+  assert_int_equal(0, C_ClockCache_get_len(cache));
+  // 4 shards of 25
+  assert_int_equal(100, C_ClockCache_get_cap(cache));
+
+  u64 value = 0;
+  assert_false(get_u64(cache, 1, &value));
+
+  Unref(cache);
+
+  cache = C_ClockCache_new(10, 4, sizeof(u64));
+  assert_int_equal(12, C_ClockCache_get_cap(cache));
+  Unref(cache);
+}
+
+static void test_C_ClockCache_put(void** state) {
+  (void)state;
+
+  C_ClockCache* cache = C_ClockCache_new(64, 4, sizeof(u64));
+  for (u64 i = 0; i < 32; i++) {
+    put_u64(cache, i, i * 3);
+  }
+  assert_int_equal(32, C_ClockCache_get_len(cache));
+
+  for (u64 i = 0; i < 32; i++) {
+    u64 value = 0;
+    assert_true(get_u64(cache, i, &value));
+    assert_int_equal(i * 3, value);
+  }
+
+  // a second put replaces the value
+  put_u64(cache, 7, 1000);
+  u64 value = 0;
+  assert_true(get_u64(cache, 7, &value));
+  assert_int_equal(1000, value);
+  assert_int_equal(32, C_ClockCache_get_len(cache));
+
+  assert_true(C_ClockCache_remove(cache, SV("key-7")));
+  assert_false(C_ClockCache_remove(cache, SV("key-7")));
+  assert_false(get_u64(cache, 7, &value));
+  assert_int_equal(31, C_ClockCache_get_len(cache));
+
+  // the empty key is a key like any other
+  u64 empty = 5;
+  C_ClockCache_put(cache, SV(""), &empty);
+  assert_true(C_ClockCache_get(cache, SV(""), &value));
+  assert_int_equal(5, value);
+
+  CacheStats stats = C_ClockCache_get_stats(cache);
+  assert_int_equal(34, stats.hits);
+  assert_int_equal(1, stats.misses);
+  assert_int_equal(0, stats.evictions);
+
+  C_ClockCache_clear(cache);
+  assert_int_equal(0, C_ClockCache_get_len(cache));
+  assert_false(get_u64(cache, 1, &value));
+
+  Unref(cache);
+}
+
+static void test_C_ClockCache_evict(void** state) {
+  (void)state;
+
+  // one shard, so the order of the slots is known
+  EvictData data = {0};
+  C_ClockCache* cache = C_ClockCache_new(4, 1, sizeof(u64));
+  C_ClockCache_set_evict(cache, count_evict, &data);
+
+  for (u64 i = 0; i < 4; i++) {
+    put_u64(cache, i, i);
+  }
+
+  // 0 and 2 are used and get a second chance, 1 is evicted
+  u64 value = 0;
+  assert_true(get_u64(cache, 0, &value));
+  assert_true(get_u64(cache, 2, &value));
+  put_u64(cache, 4, 4);
+
+  assert_int_equal(1, data.evicted);
+  assert_int_equal(1, data.last_evicted);
+  assert_int_equal(4, C_ClockCache_get_len(cache));
+
+  // 2 loses its second chance and 3 is evicted, then 0 whose bit is gone
+  put_u64(cache, 5, 5);
+  assert_int_equal(3, data.last_evicted);
+  put_u64(cache, 6, 6);
+  assert_int_equal(0, data.last_evicted);
+
+  assert_true(get_u64(cache, 2, &value));
+  assert_true(get_u64(cache, 4, &value));
+  assert_false(get_u64(cache, 1, &value));
+  assert_false(get_u64(cache, 3, &value));
+
+  CacheStats stats = C_ClockCache_get_stats(cache);
+  assert_int_equal(3, stats.evictions);
+
+  // a full cache keeps its size for any number of puts
+  for (u64 i = 100; i < 1100; i++) {
+    put_u64(cache, i, i);
+  }
+  assert_int_equal(4, C_ClockCache_get_len(cache));
+  assert_int_equal(1003, data.evicted);
+
+  Unref(cache);
+}
+
+static void test_C_ClockCache_threads(void** state) {
+  (void)state;
+
+  // smaller than all keys, so the threads evict each other's entries
+  C_ClockCache* cache =
+    C_ClockCache_new(THREAD_COUNT * THREAD_KEYS / 2, 8, sizeof(u64));
+
+  CacheJob* jobs[THREAD_COUNT];
+  C_Array* args[THREAD_COUNT];
+  C_Thread* threads[THREAD_COUNT];
+
+  for (u32 i = 0; i < THREAD_COUNT; i++) {
+    jobs[i] = allocate(sizeof(CacheJob));
+    jobs[i]->base = ClassObject_construct(CacheJob_destroy, null);
+    jobs[i]->cache = cache;
+    jobs[i]->thread = i;
+    jobs[i]->correct = true;
+    args[i] = C_Array_new(1);
+    C_Array_put_P(args[i], 0, jobs[i]);
+
+    threads[i] = C_Thread_new(cache_func, args[i]);
+    C_EmptyResult* result = C_Thread_run(threads[i]);
+    assert_true(C_EmptyResult_get_ok(result));
+    Unref(result);
+  }
+
+  for (u32 i = 0; i < THREAD_COUNT; i++) {
+    C_Thread_join(threads[i]);
+  }
+
+  for (u32 i = 0; i < THREAD_COUNT; i++) {
+    assert_true(jobs[i]->correct);
+  }
+  assert_true(C_ClockCache_get_len(cache) <= C_ClockCache_get_cap(cache));
+
+  CacheStats stats = C_ClockCache_get_stats(cache);
+  assert_int_equal(
+    THREAD_COUNT * THREAD_KEYS * THREAD_ROUNDS, stats.hits + stats.misses);
+
+  for (u32 i = 0; i < THREAD_COUNT; i++) {
+    Unref(threads[i]);
+    Unref(args[i]);
+    Unref(jobs[i]);
+  }
+  Unref(cache);
+}
+
+int main(void) {
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_C_ClockCache_new),
+    cmocka_unit_test(test_C_ClockCache_put),
+    cmocka_unit_test(test_C_ClockCache_evict),
+    cmocka_unit_test(test_C_ClockCache_threads),
+  };
+
+  return cmocka_run_group_tests(tests, null, test_teardown);
+}
@@ -0,0 +1,142 @@
+// clang-format off
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <cmocka.h>
+// clang-format on
+
+#include "../test_helpers.h"
+#include "c_base/base/memory/allocator.h"
+#include <c_base/base/memory/handles.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_CuckooFilter.h>
+
+#define TEST_LEN 10000
+
+CreateTestHook(C_Handle_u32, C_Handle_u32_destroy)
+
+static void test_C_CuckooFilter_new(void** state) {
+  (void)state;
+
+  C_CuckooFilter* filter = C_CuckooFilter_new(TEST_LEN);
+
+  AssertClassEqual(filter, ClassObject_id);
+  assert_int_equal(0, C_CuckooFilter_get_len(filter));
+  assert_true(C_CuckooFilter_get_cap(filter) >= TEST_LEN);
+
+  Unref(filter);
+}
+
+static void test_C_CuckooFilter_add_P(void** state) {
+  (void)state;
+
+  /* test passing */ {
+    C_CuckooFilter* filter = C_CuckooFilter_new(TEST_LEN);
+    C_Handle_u32* key = C_Handle_u32_new(10);
+    TestHook(C_Handle_u32, key);
+
+    AssertHookDestroyed(1, { C_CuckooFilter_add_P(filter, Pass(key)); });
+    Unref(filter);
+  }
+
+  C_CuckooFilter* filter = C_CuckooFilter_new(TEST_LEN);
+  for (u32 i = 0; i < TEST_LEN; i++) {
+    assert_true(C_CuckooFilter_add_P(filter, Pass(C_Handle_u32_new(i))));
+  }
+  assert_int_equal(TEST_LEN, C_CuckooFilter_get_len(filter));
+
+  u32 false_positives = 0;
+  for (u32 i = 0; i < TEST_LEN; i++) {
+    assert_true(
+      C_CuckooFilter_contains_P(filter, Pass(C_Handle_u32_new(i))));
+    false_positives += C_CuckooFilter_contains_P(
+      filter, Pass(C_Handle_u32_new(TEST_LEN + i)));
+  }
+  assert_true(false_positives < TEST_LEN / 1000);
+
+  Unref(filter);
+}
+
+static void test_C_CuckooFilter_remove_P(void** state) {
+  (void)state;
+
+  C_CuckooFilter* filter = C_CuckooFilter_new(TEST_LEN);
+  for (u32 i = 0; i < TEST_LEN; i++) {
+    C_CuckooFilter_add_bytes(filter, &i, sizeof(u32));
+  }
+
+  // every other key is removed, the rest stays
+  for (u32 i = 0; i < TEST_LEN; i += 2) {
+    assert_true(C_CuckooFilter_remove_bytes(filter, &i, sizeof(u32)));
+  }
+  assert_int_equal(TEST_LEN / 2, C_CuckooFilter_get_len(filter));
+
+  u32 false_positives = 0;
+  for (u32 i = 0; i < TEST_LEN; i++) {
+    bool contained = C_CuckooFilter_contains_bytes(filter, &i, sizeof(u32));
+    if (i % 2) {
+      assert_true(contained);
+    } else {
+      false_positives += contained;
+    }
+  }
+  assert_true(false_positives < TEST_LEN / 1000);
+
+  u32 missing = TEST_LEN * 3;
+  assert_false(C_CuckooFilter_remove_bytes(filter, &missing, sizeof(u32)));
+
+  /* test passing */ {
+    C_Handle_u32* key = C_Handle_u32_new(TEST_LEN * 4);
+    TestHook(C_Handle_u32, key);
+    C_CuckooFilter_add_P(filter, key);
+    AssertHookDestroyed(
+      1, { assert_true(C_CuckooFilter_remove_P(filter, Pass(key))); });
+  }
+
+  Unref(filter);
+}
+
+static void test_C_CuckooFilter_full(void** state) {
+  (void)state;
+
+  // adds fail once the buckets are full, the added keys are still found
+  C_CuckooFilter* filter = C_CuckooFilter_new(1000);
+  u64 cap = C_CuckooFilter_get_cap(filter);
+  u64 added = 0;
+  while (C_CuckooFilter_add_hash(filter, ds_hash_mix(added))) {
+    added++;
+    assert_true(added <= cap);
+  }
+  assert_true(added >= cap * 9 / 10);
+  assert_int_equal(added, C_CuckooFilter_get_len(filter));
+
+  for (u64 i = 0; i < added; i++) {
+    assert_true(C_CuckooFilter_contains_hash(filter, ds_hash_mix(i)));
+  }
+
+  // removing keys makes room again
+  for (u64 i = 0; i < added; i += 2) {
+    assert_true(C_CuckooFilter_remove_hash(filter, ds_hash_mix(i)));
+  }
+  for (u64 i = 1; i < added; i += 2) {
+    assert_true(C_CuckooFilter_contains_hash(filter, ds_hash_mix(i)));
+  }
+  assert_true(C_CuckooFilter_add_hash(filter, ds_hash_mix(0)));
+
+  C_CuckooFilter_clear(filter);
+  assert_int_equal(0, C_CuckooFilter_get_len(filter));
+  assert_false(C_CuckooFilter_contains_hash(filter, ds_hash_mix(2)));
+
+  Unref(filter);
+}
+
+int main(void) {
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_C_CuckooFilter_new),
+    cmocka_unit_test(test_C_CuckooFilter_add_P),
+    cmocka_unit_test(test_C_CuckooFilter_remove_P),
+    cmocka_unit_test(test_C_CuckooFilter_full),
+  };
+
+  return cmocka_run_group_tests(tests, null, test_teardown);
+}
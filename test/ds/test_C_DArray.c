@@ -135,6 +135,68 @@ static void test_C_DArray_push_P(void** state) {
   }
 }
 
+static void test_C_DArray_push_many_P(void** state) {
+  (void)state;
+
+  /* test passing */ {
+    C_DArray* darray = C_DArray_new();
+    TestHook(C_DArray, darray);
+
+    C_Handle_u32* handle = C_Handle_u32_new(10);
+    TestHook(C_Handle_u32, handle);
+
+    void* values[] = {handle, handle};
+    AssertHookDestroyed(1, { C_DArray_push_many_P(Pass(darray), values, 2); });
+    AssertHookDestroyed(1, { Unref(handle); });
+  }
+
+  /* test logic */ {
+    C_DArray* darray = C_DArray_new();
+    C_DArray_push_P(darray, Pass(C_Handle_u32_new(0)));
+
+    C_Array* array = C_Array_new(20);
+    for (u32 i = 0; i < 20; i++) {
+      C_Array_put_P(array, i, Pass(C_Handle_u32_new(i + 1)));
+    }
+
+    C_DArray_push_array_P(darray, array);
+    C_DArray_push_many_P(darray, C_Array_get_data(array), 3);
+
+    assert_int_equal(24, C_DArray_get_len(darray));
+    for (u32 i = 0; i < 21; i++) {
+      assert_int_equal(i, C_Handle_u32_get_value(C_DArray_at_B(darray, i)));
+    }
+    for (u32 i = 21; i < 24; i++) {
+      assert_int_equal(
+        i - 20, C_Handle_u32_get_value(C_DArray_at_B(darray, i)));
+    }
+
+    Unref(array);
+    Unref(darray);
+  }
+
+  /* test pushing its own data */ {
+    C_DArray* darray = C_DArray_new();
+    for (u32 i = 0; i < DArrayInlineCap; i++) {
+      C_DArray_push_P(darray, Pass(C_Handle_u32_new(i)));
+    }
+
+    // the data moves out of the inline values while it is copied
+    for (u32 round = 0; round < 3; round++) {
+      C_DArray_push_many_P(
+        darray, C_DArray_get_data(darray), C_DArray_get_len(darray));
+    }
+
+    assert_int_equal(DArrayInlineCap * 8, C_DArray_get_len(darray));
+    for (u32 i = 0; i < DArrayInlineCap * 8; i++) {
+      assert_int_equal(i % DArrayInlineCap,
+        C_Handle_u32_get_value(C_DArray_at_B(darray, i)));
+    }
+
+    Unref(darray);
+  }
+}
+
 static void test_C_DArray_push_front_P(void** state) {
   (void)state;
 
@@ -370,6 +432,73 @@ static void test_C_DArray_resize(void** state) {
   Unref(darray);
 }
 
+static void test_C_DArray_inline(void** state) {
+  (void)state;
+
+  C_Handle_u32* handles[3 * DArrayInlineCap];
+  for (u32 i = 0; i < 3 * DArrayInlineCap; i++) {
+    handles[i] = C_Handle_u32_new(i);
+  }
+
+  // only the darray itself is allocated while the values fit inline
+  u64 allocations = allocator_get_allocations();
+  C_DArray* darray = C_DArray_new();
+  for (u32 i = 0; i < DArrayInlineCap; i++) {
+    C_DArray_push_P(darray, handles[i]);
+  }
+  assert_int_equal(1, allocator_get_allocations() - allocations);
+
+  // spills to the heap and comes back on compress
+  for (u32 i = DArrayInlineCap; i < 3 * DArrayInlineCap; i++) {
+    C_DArray_push_P(darray, handles[i]);
+  }
+  for (u32 i = 0; i < 2 * DArrayInlineCap; i++) {
+    Unref(C_DArray_pop_R(darray));
+  }
+  C_DArray_compress(darray);
+  assert_int_equal(DArrayInlineCap, C_DArray_get_cap(darray));
+
+  C_DArrayForeach(
+    darray, { assert_int_equal(iter, C_Handle_u32_get_value(value)); });
+
+  Unref(darray);
+  for (u32 i = 0; i < 3 * DArrayInlineCap; i++) {
+    Unref(handles[i]);
+  }
+}
+
+static void test_C_DArray_set_growth(void** state) {
+  (void)state;
+
+  assert_int_equal(16, DArrayGrowth_double(8, 9));
+  assert_int_equal(100, DArrayGrowth_double(8, 100));
+  assert_int_equal(13, DArrayGrowth_one_half(8, 9));
+  assert_int_equal(DArrayGrowthPage / sizeof(void*), DArrayGrowth_pages(8, 9));
+
+  C_DArray* darray = C_DArray_new_cap(4);
+  C_DArray_set_growth(darray, DArrayGrowth_one_half);
+
+  for (u32 i = 0; i < 5; i++) {
+    C_DArray_push_P(darray, Pass(C_Handle_u32_new(i)));
+  }
+  assert_int_equal(7, C_DArray_get_cap(darray));
+
+  C_DArray_set_growth(darray, DArrayGrowth_pages);
+  C_DArray_reserve(darray, 600);
+  assert_int_equal(
+    2 * DArrayGrowthPage / sizeof(void*), C_DArray_get_cap(darray));
+
+  // reserving less than the capacity does nothing
+  C_DArray_reserve(darray, 10);
+  assert_int_equal(
+    2 * DArrayGrowthPage / sizeof(void*), C_DArray_get_cap(darray));
+
+  C_DArrayForeach(
+    darray, { assert_int_equal(iter, C_Handle_u32_get_value(value)); });
+
+  Unref(darray);
+}
+
 static void test_C_DArray_compress(void** state) {
   (void)state;
 
@@ -406,6 +535,105 @@ static void test_C_DArray_clear(void** state) {
   Unref(darray);
 }
 
+static void test_C_DArray_sort(void** state) {
+  (void)state;
+
+  // long enough to go through partitioning, not only insertion sort
+  C_DArray* darray = C_DArray_new();
+  u32 seed = 7;
+  for (u32 i = 0; i < 1000; i++) {
+    seed = seed * 1103515245 + 12345;
+    C_DArray_push_P(darray, Pass(C_Handle_u32_new((seed >> 8) % 500)));
+  }
+
+  C_DArray_sort(darray);
+
+  assert_int_equal(1000, C_DArray_get_len(darray));
+  for (u32 i = 1; i < C_DArray_get_len(darray); i++) {
+    assert_true(C_Handle_u32_get_value(C_DArray_at_B(darray, i - 1)) <=
+                C_Handle_u32_get_value(C_DArray_at_B(darray, i)));
+  }
+
+  Unref(darray);
+}
+
+static s32 compare_desc(void* a, void* b) {
+  return C_Handle_u32_compare(b, a);
+}
+
+static void test_C_DArray_sort_parallel(void** state) {
+  (void)state;
+
+  // values repeat from a small pool, freeing a handle per value is slow
+  C_Handle_u32* pool[1000];
+  for (u32 i = 0; i < 1000; i++) {
+    pool[i] = C_Handle_u32_new(i);
+  }
+
+  u32 len = SortParallelMinLen * 2 + 7;
+  C_DArray* darray = C_DArray_new_cap(len);
+  u32 seed = 3;
+  u64 sum = 0;
+  for (u32 i = 0; i < len; i++) {
+    seed = seed * 1103515245 + 12345;
+    u32 value = (seed >> 8) % 1000;
+    sum += value;
+    C_DArray_push_P(darray, pool[value]);
+  }
+
+  C_DArray_sort_parallel(darray, 4);
+
+  u64 sorted_sum = C_Handle_u32_get_value(C_DArray_at_B(darray, 0));
+  for (u32 i = 1; i < len; i++) {
+    u32 prev = C_Handle_u32_get_value(C_DArray_at_B(darray, i - 1));
+    u32 current = C_Handle_u32_get_value(C_DArray_at_B(darray, i));
+    assert_true(prev <= current);
+    sorted_sum += current;
+  }
+  assert_int_equal(sum, sorted_sum);
+
+  C_DArray_sort_by_parallel(darray, compare_desc, 3);
+  for (u32 i = 1; i < len; i++) {
+    assert_true(C_Handle_u32_get_value(C_DArray_at_B(darray, i - 1)) >=
+                C_Handle_u32_get_value(C_DArray_at_B(darray, i)));
+  }
+
+  // a null makes the key extraction give up and compare instead
+  Unref(C_DArray_remove_R(darray, len / 2));
+  C_DArray_add_P(darray, len / 2, null);
+  C_DArray_sort_parallel(darray, 4);
+  assert_null(C_DArray_at_B(darray, 0));
+  for (u32 i = 2; i < len; i++) {
+    assert_true(C_Handle_u32_get_value(C_DArray_at_B(darray, i - 1)) <=
+                C_Handle_u32_get_value(C_DArray_at_B(darray, i)));
+  }
+
+  Unref(darray);
+  for (u32 i = 0; i < 1000; i++) {
+    Unref(pool[i]);
+  }
+}
+
+static void test_C_DArray_sort_strings(void** state) {
+  (void)state;
+
+  C_DArray* darray = C_DArray_new();
+  C_DArray_push_P(darray, Pass(S("pear")));
+  C_DArray_push_P(darray, Pass(S("apple")));
+  C_DArray_push_P(darray, Pass(S("app")));
+  C_DArray_push_P(darray, Pass(S("banana")));
+
+  C_DArray_sort(darray);
+
+  C_String* expected[] = {S("app"), S("apple"), S("banana"), S("pear")};
+  C_DArrayForeach(darray, {
+    assert_true(C_String_equals(expected[iter], value));
+    Unref(expected[iter]);
+  });
+
+  Unref(darray);
+}
+
 static void test_C_DArray_equals(void** state) {
   (void)state;
 
@@ -453,6 +681,150 @@ static void test_C_DArray_to_str_format_R(void** state) {
   Unref(darray);
 }
 
+static C_DArray* make_sorted(u32* values, u32 len) {
+  C_DArray* darray = C_DArray_new();
+  for (u32 i = 0; i < len; i++) {
+    C_DArray_push_P(darray, Pass(C_Handle_u32_new(values[i])));
+  }
+  return darray;
+}
+
+static void assert_darray_values(C_DArray* darray, u32* values, u32 len) {
+  assert_int_equal(len, C_DArray_get_len(darray));
+  C_DArrayForeach(darray,
+    { assert_int_equal(values[iter], C_Handle_u32_get_value(value)); });
+}
+
+static void test_C_DArray_lower_bound(void** state) {
+  (void)state;
+
+  u32 values[] = {1, 3, 3, 3, 5, 8};
+  C_DArray* darray = make_sorted(values, 6);
+  C_Handle_u32* three = C_Handle_u32_new(3);
+  C_Handle_u32* four = C_Handle_u32_new(4);
+  C_Handle_u32* nine = C_Handle_u32_new(9);
+
+  CompareFunc compare = C_Handle_u32_compare;
+  assert_int_equal(1, C_DArray_lower_bound(darray, three, compare));
+  assert_int_equal(4, C_DArray_upper_bound(darray, three, compare));
+  assert_int_equal(4, C_DArray_lower_bound(darray, four, compare));
+  assert_int_equal(4, C_DArray_upper_bound(darray, four, compare));
+  assert_int_equal(6, C_DArray_lower_bound(darray, nine, compare));
+
+  SortedRange range = C_DArray_equal_range(darray, three, compare);
+  assert_int_equal(1, range.begin);
+  assert_int_equal(4, range.end);
+
+  range = C_DArray_equal_range(darray, four, compare);
+  assert_int_equal(range.begin, range.end);
+
+  Unref(three);
+  Unref(four);
+  Unref(nine);
+  Unref(darray);
+}
+
+static void test_C_DArray_insert_sorted_P(void** state) {
+  (void)state;
+
+  /* test passing */ {
+    C_DArray* darray = C_DArray_new();
+    C_Handle_u32* handle = C_Handle_u32_new(10);
+    TestHook(C_Handle_u32, handle);
+
+    C_DArray_insert_sorted_P(darray, Pass(handle), C_Handle_u32_compare);
+    AssertHookDestroyed(1, { Unref(darray); });
+  }
+
+  u32 inserts[] = {5, 1, 9, 5, 3, 0};
+  u32 correct_values[] = {0, 1, 3, 5, 5, 9};
+
+  C_DArray* darray = C_DArray_new();
+  for (u32 i = 0; i < 6; i++) {
+    C_DArray_insert_sorted_P(
+      darray, Pass(C_Handle_u32_new(inserts[i])), C_Handle_u32_compare);
+  }
+  assert_darray_values(darray, correct_values, 6);
+
+  // equal values go after the ones already there
+  C_Handle_u32* five = C_Handle_u32_new(5);
+  assert_int_equal(
+    5, C_DArray_insert_sorted_P(darray, five, C_Handle_u32_compare));
+  assert_ptr_equal(five, C_DArray_at_B(darray, 5));
+
+  Unref(five);
+  Unref(darray);
+}
+
+static void test_C_DArray_set_operations(void** state) {
+  (void)state;
+
+  u32 a_values[] = {1, 2, 2, 4, 6, 9};
+  u32 b_values[] = {2, 3, 4, 4, 9, 10};
+  u32 union_values[] = {1, 2, 2, 3, 4, 4, 6, 9, 10};
+  u32 intersection_values[] = {2, 4, 9};
+  u32 difference_values[] = {1, 2, 6};
+
+  C_DArray* a = make_sorted(a_values, 6);
+  C_DArray* b = make_sorted(b_values, 6);
+
+  C_DArray* result = C_DArray_union_R(a, b, C_Handle_u32_compare);
+  assert_darray_values(result, union_values, 9);
+  Unref(result);
+
+  result = C_DArray_intersection_R(a, b, C_Handle_u32_compare);
+  assert_darray_values(result, intersection_values, 3);
+  // equal values are taken from a
+  assert_ptr_equal(C_DArray_at_B(a, 1), C_DArray_at_B(result, 0));
+  Unref(result);
+
+  result = C_DArray_difference_R(a, b, C_Handle_u32_compare);
+  assert_darray_values(result, difference_values, 3);
+  Unref(result);
+
+  C_DArray* empty = C_DArray_new();
+  result = C_DArray_intersection_R(a, empty, C_Handle_u32_compare);
+  assert_int_equal(0, C_DArray_get_len(result));
+  Unref(result);
+  result = C_DArray_union_R(empty, b, C_Handle_u32_compare);
+  assert_darray_values(result, b_values, 6);
+  Unref(result);
+
+  Unref(empty);
+  Unref(a);
+  Unref(b);
+}
+
+static void test_C_DArray_intersection_R_skewed(void** state) {
+  (void)state;
+
+  // far past the gallop ratio, in both argument orders
+  C_DArray* small = C_DArray_new();
+  C_DArray* large = C_DArray_new();
+  for (u32 i = 0; i < 10; i++) {
+    C_DArray_push_P(small, Pass(C_Handle_u32_new(i * 97 + 1)));
+  }
+  for (u32 i = 0; i < 1000; i++) {
+    C_DArray_push_P(large, Pass(C_Handle_u32_new(i * 2)));
+  }
+
+  u32 correct_values[] = {98, 292, 486, 680, 874};
+
+  C_DArray* result =
+    C_DArray_intersection_R(small, large, C_Handle_u32_compare);
+  assert_darray_values(result, correct_values, 5);
+  assert_ptr_equal(C_DArray_at_B(small, 1), C_DArray_at_B(result, 0));
+  Unref(result);
+
+  result = C_DArray_intersection_R(large, small, C_Handle_u32_compare);
+  assert_darray_values(result, correct_values, 5);
+  assert_ptr_equal(C_DArray_at_B(large, 49), C_DArray_at_B(result, 0));
+  Unref(result);
+
+  Unref(small);
+  Unref(large);
+}
+
 int main(void) {
   const struct CMUnitTest tests[] = {
     cmocka_unit_test(test_C_DArrayForeach),
@@ -461,6 +833,7 @@ int main(void) {
     cmocka_unit_test(test_C_DArray_destroy),
     cmocka_unit_test(test_C_DArray_to_array_PR),
     cmocka_unit_test(test_C_DArray_push_P),
+    cmocka_unit_test(test_C_DArray_push_many_P),
     cmocka_unit_test(test_C_DArray_push_front_P),
     cmocka_unit_test(test_C_DArray_pop_R),
     cmocka_unit_test(test_C_DArray_pop_front_R),
@@ -473,10 +846,19 @@ int main(void) {
     cmocka_unit_test(test_C_DArray_at_B),
     cmocka_unit_test(test_C_DArray_remove_R),
     cmocka_unit_test(test_C_DArray_resize),
+    cmocka_unit_test(test_C_DArray_inline),
+    cmocka_unit_test(test_C_DArray_set_growth),
     cmocka_unit_test(test_C_DArray_compress),
     cmocka_unit_test(test_C_DArray_clear),
+    cmocka_unit_test(test_C_DArray_sort),
+    cmocka_unit_test(test_C_DArray_sort_parallel),
+    cmocka_unit_test(test_C_DArray_sort_strings),
     cmocka_unit_test(test_C_DArray_equals),
     cmocka_unit_test(test_C_DArray_to_str_format_R),
+    cmocka_unit_test(test_C_DArray_lower_bound),
+    cmocka_unit_test(test_C_DArray_insert_sorted_P),
+    cmocka_unit_test(test_C_DArray_set_operations),
+    cmocka_unit_test(test_C_DArray_intersection_R_skewed),
   };
 
   return cmocka_run_group_tests(tests, null, test_teardown);
@@ -0,0 +1,283 @@
+// clang-format off
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <cmocka.h>
+// clang-format on
+
+#include "../test_helpers.h"
+#include "c_base/base/memory/allocator.h"
+#include "c_base/base/strings/strings.h"
+#include <c_base/base/memory/handles.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_Array.h>
+#include <c_base/ds/C_Deque.h>
+
+/* more than the starting capacity, so the buffer grows while wrapped */
+#define TEST_LEN 37
+
+CreateTestHook(C_Deque, C_Deque_destroy)
+CreateTestHook(C_Handle_u32, C_Handle_u32_destroy)
+
+static C_Deque* make_deque(u32 len) {
+  C_Deque* deque = C_Deque_new();
+  for (u32 i = 0; i < len; i++) {
+    C_Deque_push_P(deque, Pass(C_Handle_u32_new(i)));
+  }
+  return deque;
+}
+
+static void test_C_DequeForeach(void** state) {
+  (void)state;
+
+  C_Deque* deque = make_deque(TEST_LEN);
+
+  u32 count = 0;
+  C_DequeForeach(deque, {
+    assert_int_equal(iter, C_Handle_u32_get_value(value));
+    count++;
+  });
+  assert_int_equal(TEST_LEN, count);
+
+  Unref(deque);
+}
+
+static void test_C_Deque_new_cap(void** state) {
+  (void)state;
+
+  C_Deque* deque = C_Deque_new_cap(100);
+
+  AssertClassEqual(deque, ClassObject_id);
+  assert_int_equal(0, C_Deque_get_len(deque));
+  assert_int_equal(128, C_Deque_get_cap(deque));
+
+  Unref(deque);
+}
+
+static void test_C_Deque_destroy(void** state) {
+  (void)state;
+
+  C_Deque* deque = C_Deque_new();
+
+  C_Handle_u32* handle = C_Handle_u32_new(10);
+  TestHook(C_Handle_u32, handle);
+
+  C_Deque_push_P(deque, Pass(handle));
+
+  AssertHookDestroyed(1, { C_Deque_destroy(deque); });
+
+  deallocate(deque);
+  refs--; // reset refs after deallocation
+}
+
+static void test_C_Deque_to_array_PR(void** state) {
+  (void)state;
+
+  /* test passing */ {
+    C_Deque* deque = C_Deque_new();
+    TestHook(C_Deque, deque);
+    AssertHookDestroyed(1, { Unref(C_Deque_to_array_PR(Pass(deque))); });
+  }
+
+  /* test logic */ {
+    C_Deque* deque = make_deque(TEST_LEN);
+    C_Array* array = C_Deque_to_array_PR(deque);
+
+    C_ArrayForeach(
+      array, { assert_int_equal(iter, C_Handle_u32_get_value(value)); });
+
+    Unref(array);
+    Unref(deque);
+  }
+}
+
+static void test_C_Deque_push_front_P(void** state) {
+  (void)state;
+
+  C_Deque* deque = C_Deque_new();
+  for (u32 i = 0; i < TEST_LEN; i++) {
+    C_Deque_push_front_P(deque, Pass(C_Handle_u32_new(TEST_LEN - 1 - i)));
+  }
+
+  C_DequeForeach(
+    deque, { assert_int_equal(iter, C_Handle_u32_get_value(value)); });
+
+  Unref(deque);
+}
+
+static void test_C_Deque_pop_R(void** state) {
+  (void)state;
+
+  C_Deque* deque = make_deque(TEST_LEN);
+
+  for (u32 i = TEST_LEN; i > 0; i--) {
+    C_Handle_u32* pop = C_Deque_pop_R(deque);
+    assert_int_equal(i - 1, C_Handle_u32_get_value(pop));
+    Unref(pop);
+  }
+  assert_int_equal(0, C_Deque_get_len(deque));
+
+  Unref(deque);
+}
+
+static void test_C_Deque_pop_front_R(void** state) {
+  (void)state;
+
+  C_Deque* deque = make_deque(TEST_LEN);
+
+  for (u32 i = 0; i < TEST_LEN; i++) {
+    C_Handle_u32* pop = C_Deque_pop_front_R(deque);
+    assert_int_equal(i, C_Handle_u32_get_value(pop));
+    Unref(pop);
+  }
+  assert_int_equal(0, C_Deque_get_len(deque));
+
+  Unref(deque);
+}
+
+static void test_C_Deque_fifo(void** state) {
+  (void)state;
+
+  // the window moves around the buffer many times without growing it
+  C_Deque* deque = C_Deque_new();
+  u32 next_push = 0;
+  u32 next_pop = 0;
+  for (u32 i = 0; i < 5; i++) {
+    C_Deque_push_P(deque, Pass(C_Handle_u32_new(next_push++)));
+  }
+  u32 cap = C_Deque_get_cap(deque);
+
+  for (u32 i = 0; i < 1000; i++) {
+    C_Deque_push_P(deque, Pass(C_Handle_u32_new(next_push++)));
+    C_Handle_u32* pop = C_Deque_pop_front_R(deque);
+    assert_int_equal(next_pop++, C_Handle_u32_get_value(pop));
+    Unref(pop);
+  }
+
+  assert_int_equal(cap, C_Deque_get_cap(deque));
+  C_DequeForeach(deque, {
+    assert_int_equal(next_pop + iter, C_Handle_u32_get_value(value));
+  });
+
+  Unref(deque);
+}
+
+static void test_C_Deque_peek(void** state) {
+  (void)state;
+
+  C_Deque* deque = make_deque(TEST_LEN);
+
+  assert_int_equal(TEST_LEN - 1, C_Handle_u32_get_value(C_Deque_peek_B(deque)));
+  assert_int_equal(0, C_Handle_u32_get_value(C_Deque_peek_front_B(deque)));
+
+  C_Handle_u32* peek = C_Deque_peek_R(deque);
+  C_Handle_u32* peek_front = C_Deque_peek_front_R(deque);
+  assert_int_equal(TEST_LEN - 1, C_Handle_u32_get_value(peek));
+  assert_int_equal(0, C_Handle_u32_get_value(peek_front));
+
+  assert_int_equal(TEST_LEN, C_Deque_get_len(deque));
+
+  Unref(peek);
+  Unref(peek_front);
+  Unref(deque);
+}
+
+static void test_C_Deque_at_R(void** state) {
+  (void)state;
+
+  C_Deque* deque = make_deque(TEST_LEN);
+  Unref(C_Deque_pop_front_R(deque));
+  C_Deque_push_P(deque, Pass(C_Handle_u32_new(TEST_LEN)));
+
+  for (u32 i = 0; i < TEST_LEN; i++) {
+    C_Handle_u32* value = C_Deque_at_R(deque, i);
+    assert_int_equal(i + 1, C_Handle_u32_get_value(value));
+    Unref(value);
+  }
+
+  Unref(deque);
+}
+
+static void test_C_Deque_put_P(void** state) {
+  (void)state;
+
+  C_Deque* deque = make_deque(3);
+
+  C_Handle_u32* handle = C_Deque_at_R(deque, 1);
+  TestHook(C_Handle_u32, handle);
+  Unref(handle);
+
+  AssertHookDestroyed(
+    1, { C_Deque_put_P(deque, 1, Pass(C_Handle_u32_new(50))); });
+  assert_int_equal(50, C_Handle_u32_get_value(C_Deque_at_B(deque, 1)));
+
+  Unref(deque);
+}
+
+static void test_C_Deque_clear(void** state) {
+  (void)state;
+
+  C_Deque* deque = make_deque(TEST_LEN);
+
+  C_Deque_clear(deque);
+  assert_int_equal(0, C_Deque_get_len(deque));
+
+  C_Deque_push_P(deque, Pass(C_Handle_u32_new(50)));
+  assert_int_equal(1, C_Deque_get_len(deque));
+
+  Unref(deque);
+}
+
+static void test_C_Deque_equals(void** state) {
+  (void)state;
+
+  C_Deque* deque = make_deque(TEST_LEN);
+  C_Deque* deque2 = make_deque(TEST_LEN);
+
+  assert_true(C_Deque_equals(deque, deque2));
+
+  Unref(C_Deque_pop_R(deque));
+
+  assert_false(C_Deque_equals(deque, deque2));
+
+  Unref(deque);
+  Unref(deque2);
+}
+
+static void test_C_Deque_to_str_format_R(void** state) {
+  (void)state;
+
+  C_Deque* deque = make_deque(3);
+
+  C_String* correct_result = S("{0, 1, 2}");
+  C_String* format = S("start={;end=};sep=, ");
+  C_String* result = C_Deque_to_str_format_R(deque, format);
+
+  assert_true(C_String_equals(correct_result, result));
+
+  Unref(format);
+  Unref(correct_result);
+  Unref(result);
+  Unref(deque);
+}
+
+int main(void) {
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_C_DequeForeach),
+    cmocka_unit_test(test_C_Deque_new_cap),
+    cmocka_unit_test(test_C_Deque_destroy),
+    cmocka_unit_test(test_C_Deque_to_array_PR),
+    cmocka_unit_test(test_C_Deque_push_front_P),
+    cmocka_unit_test(test_C_Deque_pop_R),
+    cmocka_unit_test(test_C_Deque_pop_front_R),
+    cmocka_unit_test(test_C_Deque_fifo),
+    cmocka_unit_test(test_C_Deque_peek),
+    cmocka_unit_test(test_C_Deque_at_R),
+    cmocka_unit_test(test_C_Deque_put_P),
+    cmocka_unit_test(test_C_Deque_clear),
+    cmocka_unit_test(test_C_Deque_equals),
+    cmocka_unit_test(test_C_Deque_to_str_format_R),
+  };
+
+  return cmocka_run_group_tests(tests, null, test_teardown);
+}
@@ -32,6 +32,30 @@ static void test_C_ListForeach(void** state) {
   Unref(list);
 }
 
+static void test_ListCursor(void** state) {
+  (void)state;
+
+  C_List* list = C_List_new();
+  C_List_push_P(list, Pass(C_Handle_u32_new(0)));
+  C_List_push_P(list, Pass(C_Handle_u32_new(1)));
+  C_List_push_P(list, Pass(C_Handle_u32_new(2)));
+
+  ListCursor cursor = ListCursor_construct(list);
+  for (u32 i = 0; i < 3; i++) {
+    assert_true(ListCursor_valid(&cursor));
+    assert_int_equal(i, C_Handle_u32_get_value(ListCursor_get_B(&cursor)));
+    ListCursor_next(&cursor);
+  }
+  assert_false(ListCursor_valid(&cursor));
+
+  cursor = ListCursor_construct(list);
+  C_Handle_u32* first = ListCursor_get_R(&cursor);
+  assert_int_equal(0, C_Handle_u32_get_value(first));
+  Unref(first);
+
+  Unref(list);
+}
+
 static void test_C_List_new(void** state) {
   (void)state;
   C_List* list = C_List_new();
@@ -342,6 +366,38 @@ static void test_C_List_remove_R(void** state) {
   Unref(list);
 }
 
+static void test_C_List_remove_cursor_R(void** state) {
+  (void)state;
+
+  C_List* list = C_List_new();
+  C_List_push_P(list, Pass(C_Handle_u32_new(10)));
+  C_List_push_P(list, Pass(C_Handle_u32_new(20)));
+  C_List_push_P(list, Pass(C_Handle_u32_new(30)));
+  C_List_push_P(list, Pass(C_Handle_u32_new(40)));
+
+  ListCursor cursor = ListCursor_construct(list);
+  ListCursor_next(&cursor);
+
+  C_Handle_u32* val1 = C_List_remove_cursor_R(list, &cursor);
+  assert_int_equal(20, C_Handle_u32_get_value(val1));
+  assert_int_equal(30, C_Handle_u32_get_value(ListCursor_get_B(&cursor)));
+
+  ListCursor_next(&cursor);
+  C_Handle_u32* val3 = C_List_remove_cursor_R(list, &cursor);
+  assert_int_equal(40, C_Handle_u32_get_value(val3));
+  assert_false(ListCursor_valid(&cursor));
+
+  assert_int_equal(2, C_List_get_len(list));
+  assert_int_equal(30, C_Handle_u32_get_value(C_List_peek_B(list)));
+
+  C_List_push_P(list, Pass(C_Handle_u32_new(50)));
+  assert_int_equal(50, C_Handle_u32_get_value(C_List_at_B(list, 2)));
+
+  Unref(val1);
+  Unref(val3);
+  Unref(list);
+}
+
 static void test_C_List_clear(void** state) {
   (void)state;
 
@@ -387,6 +443,91 @@ static void test_C_List_equals(void** state) {
   Unref(list2);
 }
 
+// only the thousands are compared, the rest records the insertion order
+static s32 compare_thousands(void* a, void* b) {
+  u32 a_key = C_Handle_u32_get_value(a) / 1000;
+  u32 b_key = C_Handle_u32_get_value(b) / 1000;
+  return a_key < b_key ? -1 : a_key > b_key;
+}
+
+static void test_C_List_sort(void** state) {
+  (void)state;
+
+  C_List* list = C_List_new();
+  for (u32 i = 0; i < 100; i++) {
+    C_List_push_P(list, Pass(C_Handle_u32_new(((i * 37) % 10) * 1000 + i)));
+  }
+
+  C_List_sort_by(list, compare_thousands);
+
+  assert_int_equal(100, C_List_get_len(list));
+  u32 last = 0;
+  C_ListForeach(list, {
+    u32 current = C_Handle_u32_get_value(value);
+    // keys ascend and equal keys keep their insertion order
+    assert_true(current >= last);
+    last = current;
+  });
+
+  // the tail has to be the last node after relinking
+  C_List_push_P(list, Pass(C_Handle_u32_new(0)));
+  assert_int_equal(0, C_Handle_u32_get_value(C_List_peek_B(list)));
+
+  C_List_clear(list);
+  C_List_push_P(list, Pass(C_Handle_u32_new(2)));
+  C_List_push_P(list, Pass(C_Handle_u32_new(1)));
+  C_List_push_P(list, Pass(C_Handle_u32_new(3)));
+  C_List_sort(list);
+  C_ListForeach(list, {
+    assert_int_equal(iter + 1, C_Handle_u32_get_value(value));
+  });
+
+  Unref(list);
+}
+
+static void test_C_List_get_stats(void** state) {
+  (void)state;
+
+  /* queue churn reuses the released nodes */ {
+    C_List* list = C_List_new();
+    for (u32 round = 0; round < 4; round++) {
+      for (u32 i = 0; i < 8; i++) {
+        C_List_push_P(list, Pass(C_Handle_u32_new(i)));
+      }
+      for (u32 i = 0; i < 8; i++) {
+        C_Handle_u32* pop = C_List_pop_front_R(list);
+        assert_int_equal(i, C_Handle_u32_get_value(pop));
+        Unref(pop);
+      }
+    }
+
+    ListStats stats = C_List_get_stats(list);
+    assert_int_equal(8, stats.node_misses);
+    assert_int_equal(24, stats.node_hits);
+    assert_int_equal(8, stats.spare_nodes);
+    assert_true(ListStats_hit_rate(&stats) == 0.75);
+
+    Unref(list);
+  }
+
+  /* disabled cache */ {
+    C_List* list = C_List_new();
+    C_List_set_node_cache_cap(list, 0);
+
+    C_List_push_P(list, Pass(C_Handle_u32_new(1)));
+    Unref(C_List_pop_R(list));
+    C_List_push_P(list, Pass(C_Handle_u32_new(2)));
+    assert_int_equal(2, C_Handle_u32_get_value(C_List_peek_B(list)));
+
+    ListStats stats = C_List_get_stats(list);
+    assert_int_equal(2, stats.node_misses);
+    assert_int_equal(0, stats.node_hits);
+    assert_int_equal(0, stats.spare_nodes);
+
+    Unref(list);
+  }
+}
+
 static void test_C_List_to_str_format_R(void** state) {
   (void)state;
 
@@ -410,6 +551,7 @@ static void test_C_List_to_str_format_R(void** state) {
 int main(void) {
   const struct CMUnitTest tests[] = {
     cmocka_unit_test(test_C_ListForeach),
+    cmocka_unit_test(test_ListCursor),
     cmocka_unit_test(test_C_List_new),
     cmocka_unit_test(test_C_List_destroy),
     cmocka_unit_test(test_C_List_to_array_PR),
@@ -425,8 +567,11 @@ int main(void) {
     cmocka_unit_test(test_C_List_at_R),
     cmocka_unit_test(test_C_List_at_B),
     cmocka_unit_test(test_C_List_remove_R),
+    cmocka_unit_test(test_C_List_remove_cursor_R),
     cmocka_unit_test(test_C_List_clear),
+    cmocka_unit_test(test_C_List_sort),
     cmocka_unit_test(test_C_List_equals),
+    cmocka_unit_test(test_C_List_get_stats),
     cmocka_unit_test(test_C_List_to_str_format_R),
   };
 
@@ -0,0 +1,272 @@
+// clang-format off
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <cmocka.h>
+// clang-format on
+
+#include "../test_helpers.h"
+#include "c_base/base/memory/allocator.h"
+#include <c_base/base/memory/handles.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_LruCache.h>
+
+#define TEST_BUDGET 10
+
+CreateTestHook(C_Handle_u32, C_Handle_u32_destroy)
+
+typedef struct {
+  u32 evicted;
+  u32 last_evicted;
+  u32 loaded;
+} CallbackData;
+
+static u64 value_cost(void* key, void* value, void* data) {
+  (void)key;
+  (void)data;
+  return C_Handle_u32_get_value(value);
+}
+
+static void count_evict(void* key, void* value, void* data) {
+  (void)value;
+  CallbackData* data_cast = data;
+  data_cast->evicted++;
+  data_cast->last_evicted = C_Handle_u32_get_value(key);
+}
+
+// keys below 100 load their square, the others are missing
+static void* load_square(void* key, void* data) {
+  CallbackData* data_cast = data;
+  u32 value = C_Handle_u32_get_value(key);
+  if (value >= 100) {
+    return null;
+  }
+
+  data_cast->loaded++;
+  return C_Handle_u32_new(value * value);
+}
+
+static void put_u32(C_LruCache* cache, u32 key, u32 value) {
+  C_LruCache_put_P(
+    cache, Pass(C_Handle_u32_new(key)), Pass(C_Handle_u32_new(value)));
+}
+
+static bool contains_u32(C_LruCache* cache, u32 key) {
+  return C_LruCache_contains_P(cache, Pass(C_Handle_u32_new(key)));
+}
+
+static void test_C_LruCache_new(void** state) {
+  (void)state;
+
+  C_LruCache* cache = C_LruCache_new(TEST_BUDGET);
+
+  AssertClassEqual(cache, ClassObject_id);
+  assert_int_equal(0, C_LruCache_get_len(cache));
+  assert_int_equal(0, C_LruCache_get_used(cache));
+  assert_int_equal(TEST_BUDGET, C_LruCache_get_budget(cache));
+  assert_null(C_LruCache_get_PB(cache, Pass(C_Handle_u32_new(1))));
+
+  Unref(cache);
+}
+
+static void test_C_LruCache_put_P(void** state) {
+  (void)state;
+
+  /* test passing */ {
+    C_LruCache* cache = C_LruCache_new(TEST_BUDGET);
+    C_Handle_u32* key = C_Handle_u32_new(1);
+    C_Handle_u32* value = C_Handle_u32_new(2);
+    TestHook(C_Handle_u32, key);
+    TestHook(C_Handle_u32, value);
+
+    AssertHookDestroyed(0, {
+      C_LruCache_put_P(cache, Pass(key), Pass(value));
+    });
+    AssertHookDestroyed(2, { Unref(cache); });
+  }
+
+  C_LruCache* cache = C_LruCache_new(TEST_BUDGET);
+  for (u32 i = 0; i < 100; i++) {
+    put_u32(cache, i, i * 2);
+  }
+  assert_int_equal(TEST_BUDGET, C_LruCache_get_len(cache));
+  assert_int_equal(TEST_BUDGET, C_LruCache_get_used(cache));
+
+  // only the newest entries are left
+  for (u32 i = 0; i < 100; i++) {
+    assert_int_equal(i >= 90, contains_u32(cache, i));
+  }
+
+  // a second put of a key replaces its value and keeps the length
+  C_Handle_u32* value = C_Handle_u32_new(5);
+  TestHook(C_Handle_u32, value);
+  C_LruCache_put_P(cache, Pass(C_Handle_u32_new(95)), Pass(value));
+  AssertHookDestroyed(1, {
+    C_LruCache_put_P(
+      cache, Pass(C_Handle_u32_new(95)), Pass(C_Handle_u32_new(6)));
+  });
+  assert_int_equal(TEST_BUDGET, C_LruCache_get_len(cache));
+
+  C_Handle_u32* got = C_LruCache_get_PB(cache, Pass(C_Handle_u32_new(95)));
+  assert_int_equal(6, C_Handle_u32_get_value(got));
+
+  Unref(cache);
+}
+
+static void test_C_LruCache_get_PB(void** state) {
+  (void)state;
+
+  C_LruCache* cache = C_LruCache_new(3);
+  put_u32(cache, 1, 10);
+  put_u32(cache, 2, 20);
+  put_u32(cache, 3, 30);
+
+  // the hit makes 1 the newest, so 2 is evicted next
+  C_Handle_u32* got = C_LruCache_get_PB(cache, Pass(C_Handle_u32_new(1)));
+  assert_int_equal(10, C_Handle_u32_get_value(got));
+  put_u32(cache, 4, 40);
+
+  assert_true(contains_u32(cache, 1));
+  assert_false(contains_u32(cache, 2));
+  assert_true(contains_u32(cache, 3));
+  assert_true(contains_u32(cache, 4));
+
+  // contains does not count as a use, 3 is still the oldest
+  put_u32(cache, 5, 50);
+  assert_false(contains_u32(cache, 3));
+
+  got = C_LruCache_get_PR(cache, Pass(C_Handle_u32_new(5)));
+  assert_int_equal(50, C_Handle_u32_get_value(got));
+  Unref(got);
+  assert_null(C_LruCache_get_PR(cache, Pass(C_Handle_u32_new(2))));
+
+  CacheStats stats = C_LruCache_get_stats(cache);
+  assert_int_equal(2, stats.hits);
+  assert_int_equal(1, stats.misses);
+  assert_int_equal(2, stats.evictions);
+  assert_float_equal(2.0 / 3.0, CacheStats_hit_rate(&stats), 0.0001);
+
+  Unref(cache);
+}
+
+static void test_C_LruCache_callbacks(void** state) {
+  (void)state;
+
+  CallbackData data = {0};
+  C_LruCache* cache = C_LruCache_new(100);
+  C_LruCache_set_callbacks(cache, (CacheCallbacks){
+                                    .cost = value_cost,
+                                    .evict = count_evict,
+                                    .load = load_square,
+                                    .data = &data,
+                                  });
+
+  // the values are their own cost
+  put_u32(cache, 1, 40);
+  put_u32(cache, 2, 40);
+  assert_int_equal(80, C_LruCache_get_used(cache));
+  put_u32(cache, 3, 30);
+  assert_int_equal(70, C_LruCache_get_used(cache));
+  assert_int_equal(1, data.evicted);
+  assert_int_equal(1, data.last_evicted);
+
+  // an entry larger than the budget does not stay
+  put_u32(cache, 4, 200);
+  assert_int_equal(0, C_LruCache_get_len(cache));
+  assert_int_equal(0, C_LruCache_get_used(cache));
+  assert_int_equal(4, data.evicted);
+  assert_int_equal(4, data.last_evicted);
+
+  // a miss loads the value and puts it, the second get is a hit
+  C_Handle_u32* key = C_Handle_u32_new(9);
+  C_Handle_u32* got = C_LruCache_get_or_load_PR(cache, key);
+  assert_int_equal(81, C_Handle_u32_get_value(got));
+  Unref(got);
+  got = C_LruCache_get_or_load_PR(cache, key);
+  assert_int_equal(81, C_Handle_u32_get_value(got));
+  Unref(got);
+  Unref(key);
+  assert_int_equal(1, data.loaded);
+  assert_int_equal(81, C_LruCache_get_used(cache));
+
+  // nothing to load
+  assert_null(C_LruCache_get_or_load_PR(cache, Pass(C_Handle_u32_new(100))));
+  assert_int_equal(1, C_LruCache_get_len(cache));
+
+  Unref(cache);
+}
+
+static void test_C_LruCache_remove_PR(void** state) {
+  (void)state;
+
+  CallbackData data = {0};
+  C_LruCache* cache = C_LruCache_new(TEST_BUDGET);
+  C_LruCache_set_callbacks(
+    cache, (CacheCallbacks){.evict = count_evict, .data = &data});
+
+  for (u32 i = 0; i < TEST_BUDGET; i++) {
+    put_u32(cache, i, i);
+  }
+
+  C_Handle_u32* value = C_LruCache_remove_PR(cache, Pass(C_Handle_u32_new(4)));
+  assert_int_equal(4, C_Handle_u32_get_value(value));
+  Unref(value);
+  assert_null(C_LruCache_remove_PR(cache, Pass(C_Handle_u32_new(4))));
+  assert_int_equal(TEST_BUDGET - 1, C_LruCache_get_len(cache));
+  assert_int_equal(0, data.evicted);
+
+  // the removed entry left room, the next put evicts nothing
+  put_u32(cache, 20, 20);
+  assert_int_equal(0, data.evicted);
+  put_u32(cache, 21, 21);
+  assert_int_equal(1, data.evicted);
+  assert_int_equal(0, data.last_evicted);
+
+  C_LruCache_clear(cache);
+  assert_int_equal(0, C_LruCache_get_len(cache));
+  assert_int_equal(0, C_LruCache_get_used(cache));
+  assert_false(contains_u32(cache, 21));
+
+  // the cache is usable after a clear
+  for (u32 i = 0; i < 1000; i++) {
+    put_u32(cache, i, i);
+  }
+  assert_int_equal(TEST_BUDGET, C_LruCache_get_len(cache));
+
+  Unref(cache);
+}
+
+static void test_C_LruCache_clear(void** state) {
+  (void)state;
+
+  C_LruCache* cache = C_LruCache_new(1000);
+  for (u32 round = 0; round < 3; round++) {
+    u64 allocations = allocator_get_allocations();
+    for (u32 i = 0; i < 1000; i++) {
+      put_u32(cache, i, i);
+    }
+    assert_int_equal(1000, C_LruCache_get_len(cache));
+
+    // a key and a value each, and entries beyond the kept spares
+    u64 entries = allocator_get_allocations() - allocations - 2000;
+    if (round > 0) {
+      assert_int_equal(1000 - LruSpareCap, entries);
+    }
+    C_LruCache_clear(cache);
+  }
+
+  Unref(cache);
+}
+
+int main(void) {
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_C_LruCache_new),
+    cmocka_unit_test(test_C_LruCache_put_P),
+    cmocka_unit_test(test_C_LruCache_get_PB),
+    cmocka_unit_test(test_C_LruCache_callbacks),
+    cmocka_unit_test(test_C_LruCache_remove_PR),
+    cmocka_unit_test(test_C_LruCache_clear),
+  };
+
+  return cmocka_run_group_tests(tests, null, test_teardown);
+}
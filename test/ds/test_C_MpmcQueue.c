@@ -0,0 +1,192 @@
+// clang-format off
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <cmocka.h>
+// clang-format on
+
+#include "../test_helpers.h"
+#include "c_base/base/memory/allocator.h"
+#include <c_base/base/memory/memory.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_Array.h>
+#include <c_base/ds/C_MpmcQueue.h>
+#include <c_base/os/os_atomic.h>
+#include <c_base/os/os_threads.h>
+
+#define TEST_CAP 5
+#define PRODUCERS 3
+#define CONSUMERS 3
+// values per producer
+#define THREAD_LEN 200000
+
+/* producer p pushes p * THREAD_LEN + i for i = 0 .. THREAD_LEN - 1.
+ * consumers pop until all values are out, count every value and check
+ * that the values of one producer arrive in order */
+typedef struct {
+  ClassObject base;
+  C_MpmcQueue* queue;
+  u32 producer;
+
+  // shared by the consumers
+  u64* popped;
+  u8* seen;
+  bool ordered;
+} QueueJob;
+
+static void QueueJob_destroy(void* self) { (void)self; }
+
+static QueueJob* QueueJob_new(C_MpmcQueue* queue, u64* popped, u8* seen) {
+  QueueJob* self = allocate(sizeof(QueueJob));
+  self->base = ClassObject_construct(QueueJob_destroy, null);
+  self->queue = queue;
+  self->producer = 0;
+  self->popped = popped;
+  self->seen = seen;
+  self->ordered = true;
+  return self;
+}
+
+static void producer_func(C_Thread* thread) {
+  QueueJob* job = C_Thread_get_arg_B(thread, 0);
+  u64 first = (u64)job->producer * THREAD_LEN;
+  for (u64 i = first; i < first + THREAD_LEN; i++) {
+    while (!C_MpmcQueue_push(job->queue, (void*)i)) {
+      os_threads_yield();
+    }
+  }
+}
+
+static void consumer_func(C_Thread* thread) {
+  QueueJob* job = C_Thread_get_arg_B(thread, 0);
+  u64 last[PRODUCERS];
+  mem_set(last, 0xff, sizeof(last));
+
+  while (os_atomic_u64_load_acquire(job->popped) < PRODUCERS * THREAD_LEN) {
+    void* value = null;
+    if (!C_MpmcQueue_pop(job->queue, &value)) {
+      os_threads_yield();
+      continue;
+    }
+
+    u64 index = (u64)value;
+    u32 producer = (u32)(index / THREAD_LEN);
+    if (last[producer] != u64_MAX && last[producer] >= index) {
+      job->ordered = false;
+    }
+    last[producer] = index;
+    // every value has one byte, only its consumer writes it
+    job->seen[index]++;
+    os_atomic_u64_fetch_add(job->popped, 1);
+  }
+}
+
+static void test_C_MpmcQueue_new(void** state) {
+  (void)state;
+
+  C_MpmcQueue* queue = C_MpmcQueue_new(TEST_CAP);
+
+  AssertClassEqual(queue, ClassObject_id);
+  assert_int_equal(8, C_MpmcQueue_get_cap(queue));
+  assert_int_equal(0, C_MpmcQueue_get_len(queue));
+
+  void* value = null;
+  assert_false(C_MpmcQueue_pop(queue, &value));
+
+  Unref(queue);
+
+  queue = C_MpmcQueue_new(1);
+  assert_int_equal(2, C_MpmcQueue_get_cap(queue));
+  Unref(queue);
+}
+
+static void test_C_MpmcQueue_push(void** state) {
+  (void)state;
+
+  C_MpmcQueue* queue = C_MpmcQueue_new(TEST_CAP);
+  u64 next_push = 0;
+  u64 next_pop = 0;
+
+  // several rounds over the slots, filled and emptied each time
+  for (u32 round = 0; round < 10; round++) {
+    while (C_MpmcQueue_push(queue, (void*)next_push)) {
+      next_push++;
+    }
+    assert_int_equal(8, C_MpmcQueue_get_len(queue));
+
+    void* value = null;
+    for (u32 i = 0; i < 5; i++) {
+      assert_true(C_MpmcQueue_pop(queue, &value));
+      assert_int_equal(next_pop++, (u64)value);
+    }
+    assert_int_equal(3, C_MpmcQueue_get_len(queue));
+  }
+
+  void* value = null;
+  while (C_MpmcQueue_pop(queue, &value)) {
+    assert_int_equal(next_pop++, (u64)value);
+  }
+  assert_int_equal(next_push, next_pop);
+  assert_int_equal(0, C_MpmcQueue_get_len(queue));
+
+  Unref(queue);
+}
+
+static void test_C_MpmcQueue_threads(void** state) {
+  (void)state;
+
+  // small, so producers wait for consumers and the other way around
+  C_MpmcQueue* queue = C_MpmcQueue_new(16);
+  u64 popped = 0;
+  u8* seen = allocate(PRODUCERS * THREAD_LEN);
+  mem_set(seen, 0, PRODUCERS * THREAD_LEN);
+
+  u32 thread_len = PRODUCERS + CONSUMERS;
+  QueueJob* jobs[PRODUCERS + CONSUMERS];
+  C_Array* args[PRODUCERS + CONSUMERS];
+  C_Thread* threads[PRODUCERS + CONSUMERS];
+
+  for (u32 i = 0; i < thread_len; i++) {
+    jobs[i] = QueueJob_new(queue, &popped, seen);
+    jobs[i]->producer = i;
+    args[i] = C_Array_new(1);
+    C_Array_put_P(args[i], 0, jobs[i]);
+
+    threads[i] = C_Thread_new(i < PRODUCERS ? producer_func : consumer_func,
+      args[i]);
+    C_EmptyResult* result = C_Thread_run(threads[i]);
+    assert_true(C_EmptyResult_get_ok(result));
+    Unref(result);
+  }
+
+  for (u32 i = 0; i < thread_len; i++) {
+    C_Thread_join(threads[i]);
+  }
+
+  assert_int_equal(PRODUCERS * THREAD_LEN, popped);
+  for (u32 i = 0; i < PRODUCERS * THREAD_LEN; i++) {
+    assert_int_equal(1, seen[i]);
+  }
+  for (u32 i = PRODUCERS; i < thread_len; i++) {
+    assert_true(jobs[i]->ordered);
+  }
+  assert_int_equal(0, C_MpmcQueue_get_len(queue));
+
+  for (u32 i = 0; i < thread_len; i++) {
+    Unref(threads[i]);
+    Unref(args[i]);
+    Unref(jobs[i]);
+  }
+  deallocate(seen);
+  Unref(queue);
+}
+
+int main(void) {
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_C_MpmcQueue_new),
+    cmocka_unit_test(test_C_MpmcQueue_push),
+    cmocka_unit_test(test_C_MpmcQueue_threads),
+  };
+
+  return cmocka_run_group_tests(tests, null, test_teardown);
+}
@@ -0,0 +1,276 @@
+// clang-format off
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <cmocka.h>
+// clang-format on
+
+#include "../test_helpers.h"
+#include "c_base/base/memory/allocator.h"
+#include "c_base/base/strings/strings.h"
+#include <c_base/base/memory/handles.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_OrderedMap.h>
+
+/* enough keys for a tree with two levels of branches,
+ * so splits, borrows and merges all happen on leaves and on branches */
+#define TEST_LEN 3000
+
+CreateTestHook(C_Handle_u32, C_Handle_u32_destroy)
+
+static u64 rand_state = 88172645463325252ull;
+
+static u32 test_rand(void) {
+  rand_state ^= rand_state << 13;
+  rand_state ^= rand_state >> 7;
+  rand_state ^= rand_state << 17;
+  return (u32)rand_state;
+}
+
+// 0 .. len - 1 in a random order
+static void shuffle(u32* values, u32 len) {
+  for (u32 i = 0; i < len; i++) {
+    values[i] = i;
+  }
+  for (u32 i = len - 1; i > 0; i--) {
+    u32 j = test_rand() % (i + 1);
+    u32 tmp = values[i];
+    values[i] = values[j];
+    values[j] = tmp;
+  }
+}
+
+static void assert_map_sorted(C_OrderedMap* map) {
+  u32 count = 0;
+  u32 last = 0;
+  C_OrderedMapForeach(map, {
+    u32 current = C_Handle_u32_get_value(key);
+    if (iter > 0) {
+      assert_true(last < current);
+    }
+    // every test stores key * 10 as the value
+    assert_int_equal(current * 10, C_Handle_u32_get_value(value));
+    last = current;
+    count++;
+  });
+  assert_int_equal(C_OrderedMap_get_len(map), count);
+}
+
+static C_OrderedMap* make_map(u32* order, u32 len) {
+  C_OrderedMap* map = C_OrderedMap_new();
+  for (u32 i = 0; i < len; i++) {
+    C_OrderedMap_put_P(map, Pass(C_Handle_u32_new(order[i])),
+      Pass(C_Handle_u32_new(order[i] * 10)));
+  }
+  return map;
+}
+
+static void test_C_OrderedMap_new(void** state) {
+  (void)state;
+
+  C_OrderedMap* map = C_OrderedMap_new();
+
+  AssertClassEqual(map, ClassObject_id);
+  assert_int_equal(0, C_OrderedMap_get_len(map));
+
+  MapCursor cursor = MapCursor_construct(map);
+  assert_false(MapCursor_valid(&cursor));
+
+  Unref(map);
+}
+
+static void test_C_OrderedMap_destroy(void** state) {
+  (void)state;
+
+  C_OrderedMap* map = C_OrderedMap_new();
+  C_Handle_u32* key = C_Handle_u32_new(10);
+  C_Handle_u32* value = C_Handle_u32_new(20);
+  TestHook(C_Handle_u32, key);
+  TestHook(C_Handle_u32, value);
+
+  C_OrderedMap_put_P(map, Pass(key), Pass(value));
+
+  AssertHookDestroyed(2, { Unref(map); });
+}
+
+static void test_C_OrderedMap_put_P(void** state) {
+  (void)state;
+
+  u32 order[TEST_LEN];
+  shuffle(order, TEST_LEN);
+  C_OrderedMap* map = make_map(order, TEST_LEN);
+
+  assert_int_equal(TEST_LEN, C_OrderedMap_get_len(map));
+  assert_true(C_OrderedMap_get_depth(map) >= 2);
+  assert_map_sorted(map);
+
+  for (u32 i = 0; i < TEST_LEN; i += 7) {
+    C_Handle_u32* key = C_Handle_u32_new(i);
+    assert_true(C_OrderedMap_contains_P(map, key));
+    assert_int_equal(
+      i * 10, C_Handle_u32_get_value(C_OrderedMap_at_PB(map, key)));
+    Unref(key);
+  }
+  assert_false(C_OrderedMap_contains_P(map, Pass(C_Handle_u32_new(TEST_LEN))));
+
+  Unref(map);
+}
+
+static void test_C_OrderedMap_lower_bound_P(void** state) {
+  (void)state;
+
+  // only even keys, so odd keys are between two stored ones
+  C_OrderedMap* map = C_OrderedMap_new();
+  for (u32 i = 0; i < TEST_LEN; i++) {
+    C_OrderedMap_put_P(map, Pass(C_Handle_u32_new(2 * i)),
+      Pass(C_Handle_u32_new(20 * i)));
+  }
+
+  // every range from any start, crossing leaves
+  for (u32 start = 0; start < 2 * TEST_LEN; start += 31) {
+    MapCursor cursor =
+      C_OrderedMap_lower_bound_P(map, Pass(C_Handle_u32_new(start)));
+    u32 expected = start + start % 2;
+    for (u32 i = 0; i < 40 && expected < 2 * TEST_LEN; i++) {
+      assert_true(MapCursor_valid(&cursor));
+      assert_int_equal(
+        expected, C_Handle_u32_get_value(MapCursor_get_key_B(&cursor)));
+      expected += 2;
+      MapCursor_next(&cursor);
+    }
+  }
+
+  MapCursor cursor =
+    C_OrderedMap_lower_bound_P(map, Pass(C_Handle_u32_new(2 * TEST_LEN)));
+  assert_false(MapCursor_valid(&cursor));
+
+  Unref(map);
+}
+
+static void test_C_OrderedMap_remove_PR(void** state) {
+  (void)state;
+
+  u32 order[TEST_LEN];
+  shuffle(order, TEST_LEN);
+  C_OrderedMap* map = make_map(order, TEST_LEN);
+
+  shuffle(order, TEST_LEN);
+  for (u32 i = 0; i < TEST_LEN; i++) {
+    C_Handle_u32* value =
+      C_OrderedMap_remove_PR(map, Pass(C_Handle_u32_new(order[i])));
+    assert_int_equal(order[i] * 10, C_Handle_u32_get_value(value));
+    Unref(value);
+
+    if (i % 250 == 0) {
+      assert_map_sorted(map);
+    }
+  }
+
+  assert_int_equal(0, C_OrderedMap_get_len(map));
+  assert_int_equal(0, C_OrderedMap_get_depth(map));
+
+  // the map still works after it shrunk back to a leaf
+  C_OrderedMap_put_P(
+    map, Pass(C_Handle_u32_new(1)), Pass(C_Handle_u32_new(10)));
+  assert_map_sorted(map);
+
+  Unref(map);
+}
+
+static void test_C_OrderedMap_mixed(void** state) {
+  (void)state;
+
+  // random puts and removes against a table of what should be stored
+  bool stored[TEST_LEN] = {0};
+  C_OrderedMap* map = C_OrderedMap_new();
+  u32 len = 0;
+
+  for (u32 i = 0; i < 4 * TEST_LEN; i++) {
+    u32 key = test_rand() % TEST_LEN;
+    if (stored[key]) {
+      Unref(C_OrderedMap_remove_PR(map, Pass(C_Handle_u32_new(key))));
+      len--;
+    } else {
+      C_OrderedMap_put_P(
+        map, Pass(C_Handle_u32_new(key)), Pass(C_Handle_u32_new(key * 10)));
+      len++;
+    }
+    stored[key] = !stored[key];
+  }
+
+  assert_int_equal(len, C_OrderedMap_get_len(map));
+  assert_map_sorted(map);
+  C_OrderedMapForeach(
+    map, { assert_true(stored[C_Handle_u32_get_value(key)]); });
+
+  Unref(map);
+}
+
+static void test_C_OrderedMap_clear(void** state) {
+  (void)state;
+
+  u32 order[TEST_LEN];
+  shuffle(order, TEST_LEN);
+  C_OrderedMap* map = make_map(order, TEST_LEN);
+
+  C_OrderedMap_clear(map);
+  assert_int_equal(0, C_OrderedMap_get_len(map));
+  MapCursor cursor = MapCursor_construct(map);
+  assert_false(MapCursor_valid(&cursor));
+
+  Unref(map);
+}
+
+static void test_C_OrderedMap_equals(void** state) {
+  (void)state;
+
+  u32 order[100];
+  shuffle(order, 100);
+  C_OrderedMap* map = make_map(order, 100);
+  shuffle(order, 100);
+  C_OrderedMap* map2 = make_map(order, 100);
+
+  // the shape of the trees differs, the contents do not
+  assert_true(C_OrderedMap_equals(map, map2));
+  assert_int_equal(C_OrderedMap_hash(map), C_OrderedMap_hash(map2));
+
+  Unref(C_OrderedMap_remove_PR(map2, Pass(C_Handle_u32_new(50))));
+  assert_false(C_OrderedMap_equals(map, map2));
+
+  Unref(map);
+  Unref(map2);
+}
+
+static void test_C_OrderedMap_to_str_format_R(void** state) {
+  (void)state;
+
+  u32 order[] = {2, 0, 1};
+  C_OrderedMap* map = make_map(order, 3);
+
+  C_String* correct_result = S("{0: 0, 1: 10, 2: 20}");
+  C_String* format = S("start={;end=};sep=, ;el_sep=: ");
+  C_String* result = C_OrderedMap_to_str_format_R(map, format);
+
+  assert_true(C_String_equals(correct_result, result));
+
+  Unref(format);
+  Unref(correct_result);
+  Unref(result);
+  Unref(map);
+}
+
+int main(void) {
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_C_OrderedMap_new),
+    cmocka_unit_test(test_C_OrderedMap_destroy),
+    cmocka_unit_test(test_C_OrderedMap_put_P),
+    cmocka_unit_test(test_C_OrderedMap_lower_bound_P),
+    cmocka_unit_test(test_C_OrderedMap_remove_PR),
+    cmocka_unit_test(test_C_OrderedMap_mixed),
+    cmocka_unit_test(test_C_OrderedMap_clear),
+    cmocka_unit_test(test_C_OrderedMap_equals),
+    cmocka_unit_test(test_C_OrderedMap_to_str_format_R),
+  };
+
+  return cmocka_run_group_tests(tests, null, test_teardown);
+}
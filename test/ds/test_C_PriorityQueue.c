@@ -0,0 +1,231 @@
+// clang-format off
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <cmocka.h>
+// clang-format on
+
+#include "../test_helpers.h"
+#include "c_base/base/memory/allocator.h"
+#include "c_base/base/strings/strings.h"
+#include <c_base/base/memory/handles.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_PriorityQueue.h>
+
+#define TEST_LEN 500
+
+CreateTestHook(C_Handle_u32, C_Handle_u32_destroy)
+
+static u64 rand_state = 88172645463325252ull;
+
+static u32 test_rand(void) {
+  rand_state ^= rand_state << 13;
+  rand_state ^= rand_state >> 7;
+  rand_state ^= rand_state << 17;
+  return (u32)rand_state;
+}
+
+static void test_C_PriorityQueue_new(void** state) {
+  (void)state;
+
+  C_PriorityQueue* queue = C_PriorityQueue_new();
+
+  AssertClassEqual(queue, ClassObject_id);
+  assert_int_equal(0, C_PriorityQueue_get_len(queue));
+
+  Unref(queue);
+}
+
+static void test_C_PriorityQueue_push_P(void** state) {
+  (void)state;
+
+  /* test passing */ {
+    C_PriorityQueue* queue = C_PriorityQueue_new();
+    C_Handle_u32* handle = C_Handle_u32_new(10);
+    TestHook(C_Handle_u32, handle);
+
+    C_PriorityQueue_push_P(queue, Pass(handle));
+    AssertHookDestroyed(1, { Unref(queue); });
+  }
+
+  C_PriorityQueue* queue = C_PriorityQueue_new();
+  C_PriorityQueue_push_P(queue, Pass(C_Handle_u32_new(30)));
+  C_PriorityQueue_push_P(queue, Pass(C_Handle_u32_new(10)));
+  C_PriorityQueue_push_P(queue, Pass(C_Handle_u32_new(20)));
+
+  assert_int_equal(3, C_PriorityQueue_get_len(queue));
+  assert_int_equal(
+    10, C_Handle_u32_get_value(C_PriorityQueue_peek_B(queue)));
+
+  Unref(queue);
+}
+
+static void test_C_PriorityQueue_pop_R(void** state) {
+  (void)state;
+
+  // enough values for a few levels of the heap, popped in order
+  C_PriorityQueue* queue = C_PriorityQueue_new_by(C_Handle_u32_compare);
+  for (u32 i = 0; i < TEST_LEN; i++) {
+    C_PriorityQueue_push_P(queue, Pass(C_Handle_u32_new(test_rand() % 100)));
+  }
+
+  u32 last = 0;
+  for (u32 i = 0; i < TEST_LEN; i++) {
+    C_Handle_u32* value = C_PriorityQueue_pop_R(queue);
+    assert_true(last <= C_Handle_u32_get_value(value));
+    last = C_Handle_u32_get_value(value);
+    Unref(value);
+  }
+  assert_int_equal(0, C_PriorityQueue_get_len(queue));
+
+  Unref(queue);
+}
+
+static void test_C_PriorityQueue_decrease_key_P(void** state) {
+  (void)state;
+
+  C_PriorityQueue* queue = C_PriorityQueue_new();
+  PriorityHandle handles[TEST_LEN];
+  for (u32 i = 0; i < TEST_LEN; i++) {
+    handles[i] =
+      C_PriorityQueue_push_P(queue, Pass(C_Handle_u32_new(1000 + i)));
+  }
+
+  C_Handle_u32* smallest = C_Handle_u32_new(5);
+  C_PriorityQueue_decrease_key_P(queue, handles[TEST_LEN - 1], smallest);
+  C_PriorityQueue_decrease_key_P(
+    queue, handles[200], Pass(C_Handle_u32_new(7)));
+  assert_ptr_equal(smallest, C_PriorityQueue_peek_B(queue));
+
+  C_Handle_u32* value = C_PriorityQueue_pop_R(queue);
+  assert_ptr_equal(smallest, value);
+  Unref(value);
+  assert_false(C_PriorityQueue_contains(queue, handles[TEST_LEN - 1]));
+  assert_true(C_PriorityQueue_contains(queue, handles[200]));
+
+  value = C_PriorityQueue_pop_R(queue);
+  assert_int_equal(7, C_Handle_u32_get_value(value));
+  Unref(value);
+
+  // slots of popped values are reused, their old handles stay invalid
+  PriorityHandle reused =
+    C_PriorityQueue_push_P(queue, Pass(C_Handle_u32_new(1)));
+  assert_true((u32)reused == (u32)handles[200] ||
+              (u32)reused == (u32)handles[TEST_LEN - 1]);
+  assert_true(C_PriorityQueue_contains(queue, reused));
+  assert_false(C_PriorityQueue_contains(queue, handles[200]));
+  assert_false(C_PriorityQueue_contains(queue, handles[TEST_LEN - 1]));
+
+  value = C_PriorityQueue_pop_R(queue);
+  assert_int_equal(1, C_Handle_u32_get_value(value));
+  Unref(value);
+  for (u32 i = 0; i < TEST_LEN; i++) {
+    if (i == 200 || i == TEST_LEN - 1) {
+      continue;
+    }
+    value = C_PriorityQueue_pop_R(queue);
+    assert_int_equal(1000 + i, C_Handle_u32_get_value(value));
+    Unref(value);
+  }
+
+  Unref(smallest);
+  Unref(queue);
+}
+
+static void test_C_PriorityQueue_clear(void** state) {
+  (void)state;
+
+  /* test passing */ {
+    C_PriorityQueue* queue = C_PriorityQueue_new();
+    C_Handle_u32* handle = C_Handle_u32_new(10);
+    TestHook(C_Handle_u32, handle);
+
+    PriorityHandle pq_handle = C_PriorityQueue_push_P(queue, Pass(handle));
+    AssertHookDestroyed(1, { C_PriorityQueue_clear(queue); });
+    assert_false(C_PriorityQueue_contains(queue, pq_handle));
+    Unref(queue);
+  }
+}
+
+static void test_C_PriorityQueue_to_str_format_R(void** state) {
+  (void)state;
+
+  C_PriorityQueue* queue = C_PriorityQueue_new();
+  C_PriorityQueue_push_P(queue, Pass(C_Handle_u32_new(2)));
+  C_PriorityQueue_push_P(queue, Pass(C_Handle_u32_new(1)));
+
+  C_String* correct_result = S("{1, 2}");
+  C_String* format = S("start={;end=};sep=, ");
+  C_String* result = C_PriorityQueue_to_str_format_R(queue, format);
+
+  assert_true(C_String_equals(correct_result, result));
+
+  Unref(format);
+  Unref(correct_result);
+  Unref(result);
+  Unref(queue);
+}
+
+static void test_C_PriorityQueue_u64(void** state) {
+  (void)state;
+
+  C_PriorityQueue_u64* queue = C_PriorityQueue_u64_new();
+  PriorityHandle handles[TEST_LEN];
+  for (u32 i = 0; i < TEST_LEN; i++) {
+    handles[i] = C_PriorityQueue_u64_push(queue, 1000 + test_rand() % 100, i);
+  }
+
+  C_PriorityQueue_u64_decrease_key(queue, handles[321], 3);
+  PriorityEntry entry = C_PriorityQueue_u64_peek(queue);
+  assert_int_equal(3, entry.priority);
+  assert_int_equal(321, entry.value);
+
+  u64 last = 0;
+  for (u32 i = 0; i < TEST_LEN; i++) {
+    entry = C_PriorityQueue_u64_pop(queue);
+    assert_true(last <= entry.priority);
+    last = entry.priority;
+  }
+  assert_int_equal(0, C_PriorityQueue_u64_get_len(queue));
+  assert_false(C_PriorityQueue_u64_contains(queue, handles[0]));
+
+  // a stale handle does not reach the value in its reused slot
+  PriorityHandle first = C_PriorityQueue_u64_push(queue, 5, 50);
+  C_PriorityQueue_u64_pop(queue);
+  PriorityHandle second = C_PriorityQueue_u64_push(queue, 6, 60);
+  assert_int_equal((u32)first, (u32)second);
+  assert_false(C_PriorityQueue_u64_contains(queue, first));
+  assert_true(C_PriorityQueue_u64_contains(queue, second));
+
+  // clear invalidates every handle, also for the slots pushed again
+  C_PriorityQueue_u64_clear(queue);
+  assert_false(C_PriorityQueue_u64_contains(queue, second));
+  PriorityHandle third = C_PriorityQueue_u64_push(queue, 7, 70);
+  assert_false(C_PriorityQueue_u64_contains(queue, second));
+  assert_true(C_PriorityQueue_u64_contains(queue, third));
+  C_PriorityQueue_u64_clear(queue);
+
+  C_PriorityQueue_u64_push(queue, 2, 20);
+  C_PriorityQueue_u64_push(queue, 1, 10);
+  C_String* correct_result = S("[1:10, 2:20]");
+  C_String* result = C_PriorityQueue_u64_to_str_R(queue);
+  assert_true(C_String_equals(correct_result, result));
+
+  Unref(correct_result);
+  Unref(result);
+  Unref(queue);
+}
+
+int main(void) {
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_C_PriorityQueue_new),
+    cmocka_unit_test(test_C_PriorityQueue_push_P),
+    cmocka_unit_test(test_C_PriorityQueue_pop_R),
+    cmocka_unit_test(test_C_PriorityQueue_decrease_key_P),
+    cmocka_unit_test(test_C_PriorityQueue_clear),
+    cmocka_unit_test(test_C_PriorityQueue_to_str_format_R),
+    cmocka_unit_test(test_C_PriorityQueue_u64),
+  };
+
+  return cmocka_run_group_tests(tests, null, test_teardown);
+}
@@ -0,0 +1,331 @@
+// clang-format off
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <cmocka.h>
+// clang-format on
+
+#include "../test_helpers.h"
+#include "c_base/base/memory/allocator.h"
+#include "c_base/base/strings/strings.h"
+#include <c_base/base/memory/handles.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_RadixTree.h>
+
+/* half of the keys are decimal numbers, which are prefixes of each other,
+ * the other half are 4 random bytes below one shared byte, enough for a
+ * node with all 256 children */
+#define TEST_LEN 3000
+#define KEY_CAP 8
+
+CreateTestHook(C_Handle_u32, C_Handle_u32_destroy)
+
+static u64 rand_state = 88172645463325252ull;
+
+static u32 test_rand(void) {
+  rand_state ^= rand_state << 13;
+  rand_state ^= rand_state >> 7;
+  rand_state ^= rand_state << 17;
+  return (u32)rand_state;
+}
+
+// 0 .. len - 1 in a random order
+static void shuffle(u32* values, u32 len) {
+  for (u32 i = 0; i < len; i++) {
+    values[i] = i;
+  }
+  for (u32 i = len - 1; i > 0; i--) {
+    u32 j = test_rand() % (i + 1);
+    u32 tmp = values[i];
+    values[i] = values[j];
+    values[j] = tmp;
+  }
+}
+
+static StringView make_key(u32 i, ascii* buffer) {
+  if (i < TEST_LEN / 2) {
+    ascii digits[KEY_CAP];
+    u32 len = 0;
+    do {
+      digits[len++] = (ascii)('0' + i % 10);
+      i /= 10;
+    } while (i);
+    buffer[0] = 'k';
+    for (u32 j = 0; j < len; j++) {
+      buffer[1 + j] = digits[len - 1 - j];
+    }
+    return StringView_construct(buffer, len + 1);
+  }
+
+  // an odd factor keeps the keys distinct
+  u32 bits = i * 2654435761u;
+  buffer[0] = 0;
+  for (u32 j = 0; j < 4; j++) {
+    buffer[1 + j] = (ascii)(bits >> (24 - 8 * j));
+  }
+  return StringView_construct(buffer, 5);
+}
+
+static C_RadixTree* make_tree(u32* order, u32 len) {
+  C_RadixTree* tree = C_RadixTree_new();
+  ascii buffer[KEY_CAP];
+  for (u32 i = 0; i < len; i++) {
+    StringView key = make_key(order[i], buffer);
+    C_RadixTree_put_P(tree, key, Pass(C_Handle_u32_new(order[i])));
+  }
+  return tree;
+}
+
+static void assert_tree_contains(C_RadixTree* tree, u32 i) {
+  ascii buffer[KEY_CAP];
+  StringView key = make_key(i, buffer);
+  assert_true(C_RadixTree_contains(tree, key));
+  assert_int_equal(i, C_Handle_u32_get_value(C_RadixTree_at_B(tree, key)));
+}
+
+static void test_C_RadixTree_new(void** state) {
+  (void)state;
+
+  C_RadixTree* tree = C_RadixTree_new();
+
+  AssertClassEqual(tree, ClassObject_id);
+  assert_int_equal(0, C_RadixTree_get_len(tree));
+  assert_false(C_RadixTree_contains(tree, SV("")));
+
+  Unref(tree);
+}
+
+static void test_C_RadixTree_destroy(void** state) {
+  (void)state;
+
+  C_RadixTree* tree = C_RadixTree_new();
+  C_Handle_u32* first = C_Handle_u32_new(10);
+  C_Handle_u32* second = C_Handle_u32_new(20);
+  TestHook(C_Handle_u32, first);
+  TestHook(C_Handle_u32, second);
+
+  C_RadixTree_put_P(tree, SV("first"), Pass(first));
+  C_RadixTree_put_P(tree, SV("firstly"), Pass(second));
+
+  AssertHookDestroyed(2, { Unref(tree); });
+}
+
+static void test_C_RadixTree_put_P(void** state) {
+  (void)state;
+
+  u32 order[TEST_LEN];
+  shuffle(order, TEST_LEN);
+  C_RadixTree* tree = make_tree(order, TEST_LEN);
+
+  assert_int_equal(TEST_LEN, C_RadixTree_get_len(tree));
+  for (u32 i = 0; i < TEST_LEN; i++) {
+    assert_tree_contains(tree, i);
+  }
+  assert_false(C_RadixTree_contains(tree, SV("k")));
+  assert_false(C_RadixTree_contains(tree, SV("k99999")));
+  assert_false(C_RadixTree_contains(tree, SV("x")));
+
+  // keys that end inside a prefix or a leaf, and the empty key
+  C_RadixTree* short_tree = C_RadixTree_new();
+  C_RadixTree_put_P(short_tree, SV("romane"), Pass(C_Handle_u32_new(1)));
+  C_RadixTree_put_P(short_tree, SV("romanus"), Pass(C_Handle_u32_new(2)));
+  C_RadixTree_put_P(short_tree, SV("rom"), Pass(C_Handle_u32_new(3)));
+  C_RadixTree_put_P(short_tree, SV(""), Pass(C_Handle_u32_new(4)));
+  C_RadixTree_put_P(short_tree, SV("romanes"), Pass(C_Handle_u32_new(5)));
+  assert_int_equal(
+    3, C_Handle_u32_get_value(C_RadixTree_at_B(short_tree, SV("rom"))));
+  assert_int_equal(
+    4, C_Handle_u32_get_value(C_RadixTree_at_B(short_tree, SV(""))));
+  assert_int_equal(
+    5, C_Handle_u32_get_value(C_RadixTree_at_B(short_tree, SV("romanes"))));
+  assert_false(C_RadixTree_contains(short_tree, SV("roman")));
+
+  Unref(short_tree);
+  Unref(tree);
+}
+
+static void test_C_RadixTree_remove_R(void** state) {
+  (void)state;
+
+  /* test passing */ {
+    C_RadixTree* tree = C_RadixTree_new();
+    C_Handle_u32* value = C_Handle_u32_new(10);
+    TestHook(C_Handle_u32, value);
+
+    C_RadixTree_put_P(tree, SV("key"), Pass(value));
+    C_Handle_u32* removed = C_RadixTree_remove_R(tree, SV("key"));
+    assert_ptr_equal(value, removed);
+    AssertHookDestroyed(1, { Unref(removed); });
+    Unref(tree);
+  }
+
+  u32 order[TEST_LEN];
+  shuffle(order, TEST_LEN);
+  C_RadixTree* tree = make_tree(order, TEST_LEN);
+
+  // the first half is removed, nodes shrink and collapse on the way
+  shuffle(order, TEST_LEN);
+  ascii buffer[KEY_CAP];
+  for (u32 i = 0; i < TEST_LEN / 2; i++) {
+    StringView key = make_key(order[i], buffer);
+    C_Handle_u32* value = C_RadixTree_remove_R(tree, key);
+    assert_int_equal(order[i], C_Handle_u32_get_value(value));
+    assert_false(C_RadixTree_contains(tree, key));
+    Unref(value);
+  }
+  assert_int_equal(TEST_LEN - TEST_LEN / 2, C_RadixTree_get_len(tree));
+  for (u32 i = TEST_LEN / 2; i < TEST_LEN; i++) {
+    assert_tree_contains(tree, order[i]);
+  }
+
+  // removed keys can be added again
+  for (u32 i = 0; i < TEST_LEN / 2; i++) {
+    StringView key = make_key(order[i], buffer);
+    C_RadixTree_put_P(tree, key, Pass(C_Handle_u32_new(order[i])));
+  }
+  for (u32 i = 0; i < TEST_LEN; i++) {
+    assert_tree_contains(tree, i);
+  }
+
+  for (u32 i = 0; i < TEST_LEN; i++) {
+    Unref(C_RadixTree_remove_R(tree, make_key(order[i], buffer)));
+  }
+  assert_int_equal(0, C_RadixTree_get_len(tree));
+
+  Unref(tree);
+}
+
+static void test_C_RadixTree_longest_prefix_B(void** state) {
+  (void)state;
+
+  C_RadixTree* tree = C_RadixTree_new();
+  C_RadixTree_put_P(tree, SV("10."), Pass(C_Handle_u32_new(1)));
+  C_RadixTree_put_P(tree, SV("10.0.0."), Pass(C_Handle_u32_new(2)));
+  C_RadixTree_put_P(tree, SV("10.0.1."), Pass(C_Handle_u32_new(3)));
+  C_RadixTree_put_P(tree, SV("10.0.0.12"), Pass(C_Handle_u32_new(4)));
+
+  u32 len = 0;
+  C_Handle_u32* value =
+    C_RadixTree_longest_prefix_B(tree, SV("10.0.0.7"), &len);
+  assert_int_equal(2, C_Handle_u32_get_value(value));
+  assert_int_equal(7, len);
+
+  value = C_RadixTree_longest_prefix_B(tree, SV("10.0.0.123"), &len);
+  assert_int_equal(4, C_Handle_u32_get_value(value));
+  assert_int_equal(9, len);
+
+  value = C_RadixTree_longest_prefix_B(tree, SV("10.2.3.4"), &len);
+  assert_int_equal(1, C_Handle_u32_get_value(value));
+  assert_int_equal(3, len);
+
+  assert_null(C_RadixTree_longest_prefix_B(tree, SV("192.168.0.1"), &len));
+  assert_null(C_RadixTree_longest_prefix_B(tree, SV("10"), &len));
+
+  Unref(tree);
+}
+
+typedef struct {
+  u32 count;
+  u32 limit;
+  u32 values[TEST_LEN];
+} VisitData;
+
+static bool visit_collect(StringView key, void* value, void* data) {
+  (void)key;
+  VisitData* visit_data = data;
+  visit_data->values[visit_data->count++] = C_Handle_u32_get_value(value);
+  return visit_data->count < visit_data->limit;
+}
+
+static void test_C_RadixTree_foreach_prefix(void** state) {
+  (void)state;
+
+  u32 order[TEST_LEN];
+  shuffle(order, TEST_LEN);
+  C_RadixTree* tree = make_tree(order, TEST_LEN);
+
+  // k12, k120 .. k129, k1200 .. k1299 in byte order
+  VisitData data = {0, TEST_LEN, {0}};
+  C_RadixTree_foreach_prefix(tree, SV("k12"), visit_collect, &data);
+  assert_int_equal(111, data.count);
+  assert_int_equal(12, data.values[0]);
+  assert_int_equal(120, data.values[1]);
+  assert_int_equal(1200, data.values[2]);
+  assert_int_equal(1209, data.values[11]);
+  assert_int_equal(121, data.values[12]);
+
+  // the raw keys, all below byte 0
+  data.count = 0;
+  C_RadixTree_foreach_prefix(
+    tree, StringView_construct("\0", 1), visit_collect, &data);
+  assert_int_equal(TEST_LEN - TEST_LEN / 2, data.count);
+
+  data.count = 0;
+  C_RadixTree_foreach_prefix(tree, SV("k999"), visit_collect, &data);
+  assert_int_equal(1, data.count);
+  assert_int_equal(999, data.values[0]);
+
+  data.count = 0;
+  C_RadixTree_foreach_prefix(tree, SV("j"), visit_collect, &data);
+  assert_int_equal(0, data.count);
+
+  // everything, stopped after 5 keys
+  data.count = 0;
+  data.limit = 5;
+  C_RadixTree_foreach_prefix(tree, SV(""), visit_collect, &data);
+  assert_int_equal(5, data.count);
+
+  Unref(tree);
+}
+
+static void test_C_RadixTree_clear(void** state) {
+  (void)state;
+
+  /* test passing */ {
+    C_RadixTree* tree = C_RadixTree_new();
+    C_Handle_u32* value = C_Handle_u32_new(10);
+    TestHook(C_Handle_u32, value);
+
+    C_RadixTree_put_P(tree, SV("key"), Pass(value));
+    C_RadixTree_put_P(tree, SV("keys"), Pass(C_Handle_u32_new(20)));
+    AssertHookDestroyed(1, { C_RadixTree_clear(tree); });
+    assert_int_equal(0, C_RadixTree_get_len(tree));
+    assert_false(C_RadixTree_contains(tree, SV("key")));
+    Unref(tree);
+  }
+}
+
+static void test_C_RadixTree_to_str_format_R(void** state) {
+  (void)state;
+
+  C_RadixTree* tree = C_RadixTree_new();
+  C_RadixTree_put_P(tree, SV("b"), Pass(C_Handle_u32_new(2)));
+  C_RadixTree_put_P(tree, SV("ab"), Pass(C_Handle_u32_new(3)));
+  C_RadixTree_put_P(tree, SV("a"), Pass(C_Handle_u32_new(1)));
+
+  C_String* correct_result = S("{a: 1, ab: 3, b: 2}");
+  C_String* format = S("start={;end=};sep=, ;el_sep=: ");
+  C_String* result = C_RadixTree_to_str_format_R(tree, format);
+
+  assert_true(C_String_equals(correct_result, result));
+
+  Unref(format);
+  Unref(correct_result);
+  Unref(result);
+  Unref(tree);
+}
+
+int main(void) {
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_C_RadixTree_new),
+    cmocka_unit_test(test_C_RadixTree_destroy),
+    cmocka_unit_test(test_C_RadixTree_put_P),
+    cmocka_unit_test(test_C_RadixTree_remove_R),
+    cmocka_unit_test(test_C_RadixTree_longest_prefix_B),
+    cmocka_unit_test(test_C_RadixTree_foreach_prefix),
+    cmocka_unit_test(test_C_RadixTree_clear),
+    cmocka_unit_test(test_C_RadixTree_to_str_format_R),
+  };
+
+  return cmocka_run_group_tests(tests, null, test_teardown);
+}
@@ -0,0 +1,237 @@
+// clang-format off
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <cmocka.h>
+// clang-format on
+
+#include "../test_helpers.h"
+#include "c_base/base/memory/allocator.h"
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_BitSet.h>
+#include <c_base/ds/C_RoaringBitSet.h>
+#include <c_base/ds/ds_simd.h>
+
+// 4 containers, values are checked against a C_BitSet of the same range
+#define TEST_RANGE (4 * 65536)
+
+static u64 test_rand_state = 88172645463325252ull;
+
+static u32 test_rand(void) {
+  test_rand_state ^= test_rand_state << 13;
+  test_rand_state ^= test_rand_state >> 7;
+  test_rand_state ^= test_rand_state << 17;
+  return (u32)test_rand_state;
+}
+
+/* container 0 gets ~1% of its values (an array), container 1 about 30%
+ * (a bitmap), container 3 every value in every 2nd, container 2 none */
+static void test_fill(C_RoaringBitSet* set, C_BitSet* expected, u32 seed) {
+  test_rand_state = 88172645463325252ull + seed;
+  for (u32 value = 0; value < TEST_RANGE; value++) {
+    u32 container = value / 65536;
+    bool add = (container == 0 && test_rand() % 100 == 0) ||
+               (container == 1 && test_rand() % 10 < 3) ||
+               (container == 3 && value % 2 == seed % 2);
+    if (add) {
+      C_RoaringBitSet_add(set, value);
+      C_BitSet_set(expected, value);
+    }
+  }
+}
+
+static void test_assert_same(C_RoaringBitSet* set, C_BitSet* expected) {
+  assert_int_equal(C_BitSet_count(expected), C_RoaringBitSet_get_len(set));
+  for (u32 value = 0; value < TEST_RANGE; value++) {
+    assert_int_equal(
+      C_BitSet_test(expected, value), C_RoaringBitSet_contains(set, value));
+  }
+}
+
+static void test_C_RoaringBitSet_new(void** state) {
+  (void)state;
+
+  C_RoaringBitSet* set = C_RoaringBitSet_new();
+
+  AssertClassEqual(set, ClassObject_id);
+  assert_int_equal(0, C_RoaringBitSet_get_len(set));
+  assert_false(C_RoaringBitSet_contains(set, 0));
+  assert_int_equal(RoaringBitSetEnd, C_RoaringBitSet_find_next(set, 0));
+
+  Unref(set);
+}
+
+static void test_C_RoaringBitSet_add(void** state) {
+  (void)state;
+
+  C_RoaringBitSet* set = C_RoaringBitSet_new();
+  C_BitSet* expected = C_BitSet_new(TEST_RANGE);
+  test_fill(set, expected, 0);
+  test_assert_same(set, expected);
+
+  assert_false(C_RoaringBitSet_add(set, 65536 * 3));
+  assert_true(C_RoaringBitSet_add(set, 65536 * 3 + 1));
+  assert_true(C_RoaringBitSet_add(set, u32_MAX));
+  assert_true(C_RoaringBitSet_contains(set, u32_MAX));
+  assert_false(C_RoaringBitSet_contains(set, u32_MAX - 1));
+
+  Unref(expected);
+  Unref(set);
+}
+
+static void test_C_RoaringBitSet_remove(void** state) {
+  (void)state;
+
+  C_RoaringBitSet* set = C_RoaringBitSet_new();
+  C_BitSet* expected = C_BitSet_new(TEST_RANGE);
+  test_fill(set, expected, 0);
+
+  // the bitmaps drop below 4096 values and become arrays again
+  for (u32 value = 0; value < TEST_RANGE; value++) {
+    if (value % 16) {
+      assert_int_equal(C_BitSet_test(expected, value),
+        C_RoaringBitSet_remove(set, value));
+      C_BitSet_clear(expected, value);
+    }
+  }
+  test_assert_same(set, expected);
+
+  for (u32 value = 0; value < TEST_RANGE; value += 16) {
+    C_RoaringBitSet_remove(set, value);
+  }
+  assert_int_equal(0, C_RoaringBitSet_get_len(set));
+  assert_false(C_RoaringBitSet_remove(set, 0));
+  assert_int_equal(RoaringBitSetEnd, C_RoaringBitSet_find_next(set, 0));
+
+  Unref(expected);
+  Unref(set);
+}
+
+static void test_C_RoaringBitSet_find_next(void** state) {
+  (void)state;
+
+  C_RoaringBitSet* set = C_RoaringBitSet_new();
+  C_BitSet* expected = C_BitSet_new(TEST_RANGE);
+  test_fill(set, expected, 0);
+
+  u64 value = C_RoaringBitSet_find_next(set, 0);
+  u64 index = C_BitSet_find_next_set(expected, 0);
+  while (index < TEST_RANGE) {
+    assert_int_equal(index, value);
+    value = C_RoaringBitSet_find_next(set, value + 1);
+    index = C_BitSet_find_next_set(expected, index + 1);
+  }
+  assert_int_equal(RoaringBitSetEnd, value);
+
+  C_RoaringBitSet_add(set, u32_MAX);
+  assert_int_equal(u32_MAX, C_RoaringBitSet_find_next(set, TEST_RANGE));
+  assert_int_equal(
+    RoaringBitSetEnd, C_RoaringBitSet_find_next(set, RoaringBitSetEnd));
+
+  Unref(expected);
+  Unref(set);
+}
+
+static void test_C_RoaringBitSet_ops(void** state) {
+  (void)state;
+
+  C_RoaringBitSet* a = C_RoaringBitSet_new();
+  C_RoaringBitSet* b = C_RoaringBitSet_new();
+  C_BitSet* expected_a = C_BitSet_new(TEST_RANGE);
+  C_BitSet* expected_b = C_BitSet_new(TEST_RANGE);
+  test_fill(a, expected_a, 0);
+  test_fill(b, expected_b, 1);
+  // b alone has container 2
+  C_RoaringBitSet_add(b, 65536 * 2 + 7);
+  C_BitSet_set(expected_b, 65536 * 2 + 7);
+
+  // every level has to give the same sets
+  SimdLevel max_level = simd_detect_level();
+  for (SimdLevel level = SIMD_SCALAR; level <= max_level; level++) {
+    simd_set_level(level);
+
+    C_BitSet* expected = C_BitSet_new_copy(expected_a);
+    C_BitSet_and(expected, expected_b);
+    C_RoaringBitSet* result = C_RoaringBitSet_and_R(a, b);
+    test_assert_same(result, expected);
+    Unref(result);
+    Unref(expected);
+
+    expected = C_BitSet_new_copy(expected_a);
+    C_BitSet_or(expected, expected_b);
+    result = C_RoaringBitSet_or_R(a, b);
+    test_assert_same(result, expected);
+    Unref(result);
+    Unref(expected);
+  }
+  simd_set_level(max_level);
+
+  // a and b stay unchanged
+  test_assert_same(a, expected_a);
+  test_assert_same(b, expected_b);
+
+  Unref(expected_a);
+  Unref(expected_b);
+  Unref(a);
+  Unref(b);
+}
+
+static void test_C_RoaringBitSet_get_bytes(void** state) {
+  (void)state;
+
+  C_RoaringBitSet* sparse = C_RoaringBitSet_new();
+  C_RoaringBitSet* dense = C_RoaringBitSet_new();
+  for (u32 i = 0; i < 1000; i++) {
+    C_RoaringBitSet_add(sparse, i * 1000003u);
+  }
+  for (u32 i = 0; i < 65536; i++) {
+    C_RoaringBitSet_add(dense, i);
+  }
+
+  // 1000 values in up to 1000 arrays, 65536 values in one bitmap
+  assert_true(C_RoaringBitSet_get_bytes(sparse) < 100000);
+  assert_true(C_RoaringBitSet_get_bytes(dense) < 9000);
+
+  C_RoaringBitSet_clear(dense);
+  assert_int_equal(0, C_RoaringBitSet_get_len(dense));
+  assert_false(C_RoaringBitSet_contains(dense, 10));
+  C_RoaringBitSet_add(dense, 10);
+  assert_true(C_RoaringBitSet_contains(dense, 10));
+
+  Unref(sparse);
+  Unref(dense);
+}
+
+static void test_C_RoaringBitSet_to_str_format_R(void** state) {
+  (void)state;
+
+  C_RoaringBitSet* set = C_RoaringBitSet_new();
+  C_RoaringBitSet_add(set, 70000);
+  C_RoaringBitSet_add(set, 1);
+  C_RoaringBitSet_add(set, u32_MAX);
+
+  C_String* correct_result = S("<1|70000|4294967295>");
+  C_String* format = S("start=<;end=>;sep=|");
+  C_String* result = C_RoaringBitSet_to_str_format_R(set, format);
+
+  assert_true(C_String_equals(correct_result, result));
+
+  Unref(format);
+  Unref(correct_result);
+  Unref(result);
+  Unref(set);
+}
+
+int main(void) {
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_C_RoaringBitSet_new),
+    cmocka_unit_test(test_C_RoaringBitSet_add),
+    cmocka_unit_test(test_C_RoaringBitSet_remove),
+    cmocka_unit_test(test_C_RoaringBitSet_find_next),
+    cmocka_unit_test(test_C_RoaringBitSet_ops),
+    cmocka_unit_test(test_C_RoaringBitSet_get_bytes),
+    cmocka_unit_test(test_C_RoaringBitSet_to_str_format_R),
+  };
+
+  return cmocka_run_group_tests(tests, null, test_teardown);
+}
@@ -0,0 +1,264 @@
+// clang-format off
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <cmocka.h>
+// clang-format on
+
+#include "../test_helpers.h"
+#include "c_base/base/memory/allocator.h"
+#include "c_base/base/strings/C_StringBuilder.h"
+#include "c_base/base/strings/strings.h"
+#include <c_base/base/memory/handles.h>
+#include <c_base/base/memory/memory.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_Array.h>
+#include <c_base/ds/C_DArray.h>
+#include <c_base/ds/C_Slice.h>
+
+#define TEST_LEN 20
+
+CreateTestHook(C_Array, C_Array_destroy)
+CreateTestHook(C_String, C_String_destroy)
+
+static C_Array* make_array(u32 len) {
+  C_Array* array = C_Array_new(len);
+  for (u32 i = 0; i < len; i++) {
+    C_Array_put_P(array, i, Pass(C_Handle_u32_new(i)));
+  }
+  return array;
+}
+
+static void test_C_SliceForeach(void** state) {
+  (void)state;
+
+  C_Slice* slice = C_Slice_new_array_P(Pass(make_array(TEST_LEN)), 5, 15);
+
+  u32 count = 0;
+  C_SliceForeach(slice, {
+    assert_int_equal(iter + 5, C_Handle_u32_get_value(value));
+    count++;
+  });
+  assert_int_equal(10, count);
+
+  Unref(slice);
+}
+
+static void test_C_Slice_keeps_parent(void** state) {
+  (void)state;
+
+  /* test passing */ {
+    C_Array* array = make_array(TEST_LEN);
+    TestHook(C_Array, array);
+
+    C_Slice* slice = C_Slice_new_array_P(Pass(array), 0, 2);
+    AssertHookDestroyed(1, { Unref(slice); });
+  }
+
+  C_Array* array = make_array(TEST_LEN);
+  C_Slice* slice = C_Slice_new_array_P(array, 2, 4);
+  Unref(array);
+
+  assert_int_equal(2, C_Handle_u32_get_value(C_Slice_at_B(slice, 0)));
+  assert_ptr_equal(array, C_Slice_get_parent_B(slice));
+
+  Unref(slice);
+}
+
+static void test_C_Slice_at(void** state) {
+  (void)state;
+
+  C_Array* array = make_array(TEST_LEN);
+  C_Slice* slice = C_Slice_new_array_P(array, 5, 15);
+
+  assert_int_equal(10, C_Slice_get_len(slice));
+  assert_false(C_Slice_is_string(slice));
+  for (u32 i = 0; i < 10; i++) {
+    assert_ptr_equal(C_Array_at_B(array, i + 5), C_Slice_at_B(slice, i));
+  }
+
+  // no copy, the values are the parents
+  assert_ptr_equal(C_Array_get_data(array) + 5, C_Slice_get_data(slice));
+
+  void* value = C_Slice_at_R(slice, 3);
+  assert_int_equal(8, C_Handle_u32_get_value(value));
+  Unref(value);
+
+  Unref(slice);
+  Unref(array);
+}
+
+static void test_C_Slice_slice_R(void** state) {
+  (void)state;
+
+  C_Array* array = make_array(TEST_LEN);
+  C_Slice* slice = C_Slice_new_array_P(array, 5, 15);
+  C_Slice* inner = C_Slice_slice_R(slice, 2, 4);
+
+  assert_int_equal(2, C_Slice_get_len(inner));
+  assert_int_equal(7, C_Handle_u32_get_value(C_Slice_at_B(inner, 0)));
+  assert_int_equal(8, C_Handle_u32_get_value(C_Slice_at_B(inner, 1)));
+
+  // the inner slice references the array, not the outer slice
+  assert_ptr_equal(array, C_Slice_get_parent_B(inner));
+  Unref(slice);
+  assert_int_equal(7, C_Handle_u32_get_value(C_Slice_at_B(inner, 0)));
+
+  C_Slice* empty = C_Slice_slice_R(inner, 2, 2);
+  assert_int_equal(0, C_Slice_get_len(empty));
+
+  Unref(empty);
+  Unref(inner);
+  Unref(array);
+}
+
+static void test_C_Slice_darray(void** state) {
+  (void)state;
+
+  C_DArray* darray = C_DArray_new();
+  for (u32 i = 0; i < 4; i++) {
+    C_DArray_push_P(darray, Pass(C_Handle_u32_new(i)));
+  }
+
+  C_Slice* slice = C_Slice_new_darray_P(darray, 1, 3);
+
+  // the darray moves its values when it grows, the slice follows
+  for (u32 i = 4; i < 100; i++) {
+    C_DArray_push_P(darray, Pass(C_Handle_u32_new(i)));
+  }
+  assert_int_equal(1, C_Handle_u32_get_value(C_Slice_at_B(slice, 0)));
+  assert_int_equal(2, C_Handle_u32_get_value(C_Slice_at_B(slice, 1)));
+
+  Unref(slice);
+  Unref(darray);
+}
+
+static void test_C_Slice_string(void** state) {
+  (void)state;
+
+  C_String* string = C_String_new_copy("hello world", 11);
+  C_Slice* slice = C_Slice_new_string_P(string, 6, 11);
+  Unref(string);
+
+  assert_true(C_Slice_is_string(slice));
+  assert_int_equal(5, C_Slice_get_len(slice));
+  assert_int_equal('w', C_Slice_char_at(slice, 0));
+  assert_int_equal('d', C_Slice_char_at(slice, 4));
+
+  C_Slice* inner = C_Slice_slice_R(slice, 1, 3);
+  C_String* correct_result = S("or");
+  C_String* result = C_Slice_to_string_R(inner);
+  assert_true(C_String_equals(correct_result, result));
+
+  // writing the chars into a builder with room allocates nothing
+  C_StringBuilder* builder = C_StringBuilder_new_cap(16);
+  u64 allocations = allocator_get_allocations();
+  C_Slice_write_to(slice, builder, null);
+  assert_int_equal(0, allocator_get_allocations() - allocations);
+  StringView written = C_StringBuilder_get_view(builder);
+  assert_int_equal(5, written.len);
+  assert_true(mem_equals(written.chars, "world", 5));
+
+  Unref(builder);
+  Unref(correct_result);
+  Unref(result);
+  Unref(inner);
+  Unref(slice);
+}
+
+static void test_C_String_substr_R_keeps_parent(void** state) {
+  (void)state;
+
+  C_String* string = C_String_new_copy("hello world", 11);
+  TestHook(C_String, string);
+
+  C_String* substr = C_String_substr_R(string, 0, 5);
+  C_String* inner = C_String_substr_R(substr, 1, 3);
+
+  AssertHookDestroyed(0, { Unref(string); });
+  AssertHookDestroyed(0, { Unref(substr); });
+
+  C_String* correct_result = S("ell");
+  assert_true(C_String_equals(correct_result, inner));
+  Unref(correct_result);
+
+  AssertHookDestroyed(1, { Unref(inner); });
+}
+
+static void test_C_Slice_equals(void** state) {
+  (void)state;
+
+  C_Array* array = make_array(TEST_LEN);
+  C_Array* array2 = make_array(TEST_LEN);
+  C_Slice* slice = C_Slice_new_array_P(array, 3, 8);
+  C_Slice* slice2 = C_Slice_new_array_P(array2, 3, 8);
+  C_Slice* other = C_Slice_new_array_P(array2, 4, 9);
+
+  assert_true(C_Slice_equals(slice, slice2));
+  assert_int_equal(C_Slice_hash(slice), C_Slice_hash(slice2));
+  assert_false(C_Slice_equals(slice, other));
+
+  C_String* string = C_String_new_copy("abcabc", 6);
+  C_Slice* first = C_Slice_new_string_P(string, 0, 3);
+  C_Slice* second = C_Slice_new_string_P(string, 3, 6);
+  assert_true(C_Slice_equals(first, second));
+  assert_int_equal(C_Slice_hash(first), C_Slice_hash(second));
+
+  Unref(first);
+  Unref(second);
+  Unref(string);
+  Unref(slice);
+  Unref(slice2);
+  Unref(other);
+  Unref(array);
+  Unref(array2);
+}
+
+static void test_C_Slice_to_array_R(void** state) {
+  (void)state;
+
+  C_Array* array = make_array(TEST_LEN);
+  C_Slice* slice = C_Slice_new_array_P(array, 10, 13);
+
+  C_Array* copy = C_Slice_to_array_R(slice);
+  assert_int_equal(3, C_Array_get_len(copy));
+  assert_ptr_equal(C_Array_at_B(array, 10), C_Array_at_B(copy, 0));
+
+  Unref(copy);
+  Unref(slice);
+  Unref(array);
+}
+
+static void test_C_Slice_to_str_format_R(void** state) {
+  (void)state;
+
+  C_Slice* slice = C_Slice_new_array_P(Pass(make_array(TEST_LEN)), 0, 3);
+
+  C_String* correct_result = S("{0, 1, 2}");
+  C_String* format = S("start={;end=};sep=, ");
+  C_String* result = C_Slice_to_str_format_R(slice, format);
+
+  assert_true(C_String_equals(correct_result, result));
+
+  Unref(format);
+  Unref(correct_result);
+  Unref(result);
+  Unref(slice);
+}
+
+int main(void) {
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_C_SliceForeach),
+    cmocka_unit_test(test_C_Slice_keeps_parent),
+    cmocka_unit_test(test_C_Slice_at),
+    cmocka_unit_test(test_C_Slice_slice_R),
+    cmocka_unit_test(test_C_Slice_darray),
+    cmocka_unit_test(test_C_Slice_string),
+    cmocka_unit_test(test_C_String_substr_R_keeps_parent),
+    cmocka_unit_test(test_C_Slice_equals),
+    cmocka_unit_test(test_C_Slice_to_array_R),
+    cmocka_unit_test(test_C_Slice_to_str_format_R),
+  };
+
+  return cmocka_run_group_tests(tests, null, test_teardown);
+}
@@ -0,0 +1,189 @@
+// clang-format off
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <cmocka.h>
+// clang-format on
+
+#include "../test_helpers.h"
+#include "c_base/base/memory/allocator.h"
+#include <c_base/base/memory/handles.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_SlotMap.h>
+
+#define TEST_LEN 1000
+
+CreateTestHook(C_Handle_u32, C_Handle_u32_destroy)
+
+static u32 value_at(C_SlotMap* map, u64 handle) {
+  return C_Handle_u32_get_value(C_SlotMap_at_B(map, handle));
+}
+
+static void test_C_SlotMap_new(void** state) {
+  (void)state;
+
+  C_SlotMap* map = C_SlotMap_new();
+
+  AssertClassEqual(map, ClassObject_id);
+  assert_int_equal(0, C_SlotMap_get_len(map));
+  assert_null(C_SlotMap_at_B(map, SlotMapNullHandle));
+  assert_false(C_SlotMap_contains(map, 1));
+
+  Unref(map);
+
+  map = C_SlotMap_new_cap(100);
+  assert_int_equal(100, C_SlotMap_get_cap(map));
+  Unref(map);
+}
+
+static void test_C_SlotMap_insert_P(void** state) {
+  (void)state;
+
+  /* test passing */ {
+    C_SlotMap* map = C_SlotMap_new();
+    C_Handle_u32* value = C_Handle_u32_new(1);
+    TestHook(C_Handle_u32, value);
+
+    AssertHookDestroyed(0, { C_SlotMap_insert_P(map, Pass(value)); });
+    AssertHookDestroyed(1, { Unref(map); });
+  }
+
+  C_SlotMap* map = C_SlotMap_new_cap(1);
+  u64 handles[TEST_LEN];
+  for (u32 i = 0; i < TEST_LEN; i++) {
+    handles[i] = C_SlotMap_insert_P(map, Pass(C_Handle_u32_new(i)));
+    assert_int_not_equal(SlotMapNullHandle, handles[i]);
+  }
+  assert_int_equal(TEST_LEN, C_SlotMap_get_len(map));
+
+  // growing keeps every handle valid
+  for (u32 i = 0; i < TEST_LEN; i++) {
+    assert_true(C_SlotMap_contains(map, handles[i]));
+    assert_int_equal(i, value_at(map, handles[i]));
+  }
+
+  C_Handle_u32* got = C_SlotMap_at_R(map, handles[7]);
+  assert_int_equal(7, C_Handle_u32_get_value(got));
+  Unref(got);
+
+  Unref(map);
+}
+
+static void test_C_SlotMap_remove_R(void** state) {
+  (void)state;
+
+  C_SlotMap* map = C_SlotMap_new();
+  u64 handles[TEST_LEN];
+  for (u32 i = 0; i < TEST_LEN; i++) {
+    handles[i] = C_SlotMap_insert_P(map, Pass(C_Handle_u32_new(i)));
+  }
+
+  // the even values go, the odd ones keep their handles
+  for (u32 i = 0; i < TEST_LEN; i += 2) {
+    C_Handle_u32* value = C_SlotMap_remove_R(map, handles[i]);
+    assert_int_equal(i, C_Handle_u32_get_value(value));
+    Unref(value);
+  }
+  assert_int_equal(TEST_LEN / 2, C_SlotMap_get_len(map));
+
+  for (u32 i = 0; i < TEST_LEN; i++) {
+    assert_int_equal(i % 2, C_SlotMap_contains(map, handles[i]));
+    if (i % 2) {
+      assert_int_equal(i, value_at(map, handles[i]));
+    } else {
+      assert_null(C_SlotMap_at_B(map, handles[i]));
+      assert_null(C_SlotMap_remove_R(map, handles[i]));
+    }
+  }
+
+  // new values reuse the slots, old handles stay stale
+  for (u32 i = 0; i < TEST_LEN / 2; i++) {
+    u64 handle = C_SlotMap_insert_P(map, Pass(C_Handle_u32_new(5000 + i)));
+    assert_true((u32)handle < TEST_LEN);
+    assert_int_equal(5000 + i, value_at(map, handle));
+  }
+  assert_int_equal(TEST_LEN, C_SlotMap_get_len(map));
+  for (u32 i = 0; i < TEST_LEN; i += 2) {
+    assert_false(C_SlotMap_contains(map, handles[i]));
+  }
+
+  Unref(map);
+}
+
+static void test_C_SlotMap_forged_handle(void** state) {
+  (void)state;
+
+  C_SlotMap* map = C_SlotMap_new();
+  u64 handle = C_SlotMap_insert_P(map, Pass(C_Handle_u32_new(1)));
+  Unref(C_SlotMap_remove_R(map, handle));
+
+  // the free slot has the next generation, no handle had it yet
+  u64 forged = ((handle >> 32) + 1) << 32 | (u32)handle;
+  assert_false(C_SlotMap_contains(map, forged));
+  assert_null(C_SlotMap_at_B(map, forged));
+  assert_null(C_SlotMap_remove_R(map, forged));
+
+  // the free list is intact, the slot is reused with a new handle
+  u64 again = C_SlotMap_insert_P(map, Pass(C_Handle_u32_new(2)));
+  assert_int_equal((u32)handle, (u32)again);
+  assert_int_not_equal(forged, again);
+  assert_int_not_equal(handle, again);
+  assert_int_equal(2, value_at(map, again));
+  assert_false(C_SlotMap_contains(map, forged));
+  assert_int_equal(1, C_SlotMap_get_len(map));
+
+  Unref(map);
+}
+
+static void test_C_SlotMap_values(void** state) {
+  (void)state;
+
+  C_SlotMap* map = C_SlotMap_new();
+  u64 handles[10];
+  for (u32 i = 0; i < 10; i++) {
+    handles[i] = C_SlotMap_insert_P(map, Pass(C_Handle_u32_new(i)));
+  }
+  Unref(C_SlotMap_remove_R(map, handles[2]));
+  Unref(C_SlotMap_remove_R(map, handles[5]));
+
+  // the values stay packed and every index knows its handle
+  u32 sum = 0;
+  u32 count = 0;
+  C_SlotMapForeach(map, {
+    assert_ptr_equal(value, C_SlotMap_at_B(map, handle));
+    sum += C_Handle_u32_get_value(value);
+    count++;
+  });
+  assert_int_equal(8, count);
+  assert_int_equal(45 - 2 - 5, sum);
+
+  void** values = C_SlotMap_get_values(map);
+  for (u32 i = 0; i < C_SlotMap_get_len(map); i++) {
+    assert_non_null(values[i]);
+  }
+
+  // clear makes every handle stale
+  C_SlotMap_clear(map);
+  assert_int_equal(0, C_SlotMap_get_len(map));
+  for (u32 i = 0; i < 10; i++) {
+    assert_false(C_SlotMap_contains(map, handles[i]));
+  }
+
+  u64 handle = C_SlotMap_insert_P(map, Pass(C_Handle_u32_new(42)));
+  assert_int_equal(42, value_at(map, handle));
+  assert_int_equal(handle, C_SlotMap_handle_at(map, 0));
+
+  Unref(map);
+}
+
+int main(void) {
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_C_SlotMap_new),
+    cmocka_unit_test(test_C_SlotMap_insert_P),
+    cmocka_unit_test(test_C_SlotMap_remove_R),
+    cmocka_unit_test(test_C_SlotMap_forged_handle),
+    cmocka_unit_test(test_C_SlotMap_values),
+  };
+
+  return cmocka_run_group_tests(tests, null, test_teardown);
+}
@@ -0,0 +1,128 @@
+// clang-format off
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <cmocka.h>
+// clang-format on
+
+#include "../test_helpers.h"
+#include "c_base/base/memory/allocator.h"
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_Array.h>
+#include <c_base/ds/C_SpscQueue.h>
+#include <c_base/os/os_threads.h>
+
+#define TEST_CAP 5
+#define THREAD_LEN 1000000
+
+/* the producer thread pushes 1 .. THREAD_LEN, values are not objects so
+ * no reference counts are touched on the other thread */
+typedef struct {
+  ClassObject base;
+  C_SpscQueue* queue;
+} ProducerJob;
+
+static void ProducerJob_destroy(void* self) { (void)self; }
+
+static void producer_func(C_Thread* thread) {
+  ProducerJob* job = C_Thread_get_arg_B(thread, 0);
+  for (u64 i = 1; i <= THREAD_LEN; i++) {
+    while (!C_SpscQueue_push(job->queue, (void*)i)) {
+      os_threads_yield();
+    }
+  }
+}
+
+static void test_C_SpscQueue_new(void** state) {
+  (void)state;
+
+  C_SpscQueue* queue = C_SpscQueue_new(TEST_CAP);
+
+  AssertClassEqual(queue, ClassObject_id);
+  assert_int_equal(8, C_SpscQueue_get_cap(queue));
+  assert_int_equal(0, C_SpscQueue_get_len(queue));
+
+  void* value = null;
+  assert_false(C_SpscQueue_pop(queue, &value));
+
+  Unref(queue);
+
+  queue = C_SpscQueue_new(1);
+  assert_int_equal(1, C_SpscQueue_get_cap(queue));
+  Unref(queue);
+}
+
+static void test_C_SpscQueue_push(void** state) {
+  (void)state;
+
+  C_SpscQueue* queue = C_SpscQueue_new(TEST_CAP);
+  u64 next_push = 0;
+  u64 next_pop = 0;
+
+  // several rounds over the slots, filled and emptied each time
+  for (u32 round = 0; round < 10; round++) {
+    while (C_SpscQueue_push(queue, (void*)next_push)) {
+      next_push++;
+    }
+    assert_int_equal(8, C_SpscQueue_get_len(queue));
+
+    void* value = null;
+    for (u32 i = 0; i < 5; i++) {
+      assert_true(C_SpscQueue_pop(queue, &value));
+      assert_int_equal(next_pop++, (u64)value);
+    }
+    assert_int_equal(3, C_SpscQueue_get_len(queue));
+  }
+
+  void* value = null;
+  while (C_SpscQueue_pop(queue, &value)) {
+    assert_int_equal(next_pop++, (u64)value);
+  }
+  assert_int_equal(next_push, next_pop);
+  assert_int_equal(0, C_SpscQueue_get_len(queue));
+
+  Unref(queue);
+}
+
+static void test_C_SpscQueue_threads(void** state) {
+  (void)state;
+
+  // small, so the producer is often stopped by a full queue
+  C_SpscQueue* queue = C_SpscQueue_new(64);
+  ProducerJob* job = allocate(sizeof(ProducerJob));
+  job->base = ClassObject_construct(ProducerJob_destroy, null);
+  job->queue = queue;
+
+  C_Array* args = C_Array_new(1);
+  C_Array_put_P(args, 0, Pass(job));
+  C_Thread* thread = C_Thread_new(producer_func, args);
+  C_EmptyResult* result = C_Thread_run(thread);
+  assert_true(C_EmptyResult_get_ok(result));
+  Unref(result);
+
+  // every value arrives once and in order
+  for (u64 i = 1; i <= THREAD_LEN; i++) {
+    void* value = null;
+    while (!C_SpscQueue_pop(queue, &value)) {
+      os_threads_yield();
+    }
+    assert_int_equal(i, (u64)value);
+  }
+
+  C_Thread_join(thread);
+  assert_int_equal(0, C_SpscQueue_get_len(queue));
+
+  Unref(thread);
+  Unref(args);
+  Unref(queue);
+}
+
+int main(void) {
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_C_SpscQueue_new),
+    cmocka_unit_test(test_C_SpscQueue_push),
+    cmocka_unit_test(test_C_SpscQueue_threads),
+  };
+
+  return cmocka_run_group_tests(tests, null, test_teardown);
+}
@@ -0,0 +1,329 @@
+// clang-format off
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <cmocka.h>
+// clang-format on
+
+#include "../test_helpers.h"
+#include "c_base/base/strings/strings.h"
+#include <c_base/base/memory/handles.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_Array.h>
+#include <c_base/ds/C_UnrolledList.h>
+
+/* enough values to spread over several nodes */
+#define TEST_LEN (UnrolledNodeCap * 4 + 3)
+
+CreateTestHook(C_UnrolledList, C_UnrolledList_destroy)
+CreateTestHook(C_Handle_u32, C_Handle_u32_destroy)
+
+static C_UnrolledList* make_list(u32 len) {
+  C_UnrolledList* list = C_UnrolledList_new();
+  for (u32 i = 0; i < len; i++) {
+    C_UnrolledList_push_P(list, Pass(C_Handle_u32_new(i)));
+  }
+  return list;
+}
+
+static void test_C_UnrolledListForeach(void** state) {
+  (void)state;
+
+  C_UnrolledList* list = make_list(TEST_LEN);
+
+  u32 count = 0;
+  C_UnrolledListForeach(list, {
+    assert_int_equal(iter, C_Handle_u32_get_value(value));
+    count++;
+  });
+  assert_int_equal(TEST_LEN, count);
+
+  Unref(list);
+}
+
+static void test_C_UnrolledList_new(void** state) {
+  (void)state;
+  C_UnrolledList* list = C_UnrolledList_new();
+
+  AssertClassEqual(list, ClassObject_id);
+  assert_int_equal(C_UnrolledList_get_len(list), 0);
+
+  Unref(list);
+}
+
+static void test_C_UnrolledList_destroy(void** state) {
+  (void)state;
+
+  C_UnrolledList* list = C_UnrolledList_new();
+
+  C_Handle_u32* handle = C_Handle_u32_new(10);
+  TestHook(C_Handle_u32, handle);
+
+  C_UnrolledList_push_P(list, Pass(handle));
+
+  AssertHookDestroyed(1, { C_UnrolledList_destroy(list); });
+
+  deallocate(list);
+  refs--; // reset refs after deallocation
+}
+
+static void test_C_UnrolledList_to_array_PR(void** state) {
+  (void)state;
+
+  /* test passing */ {
+    C_UnrolledList* list = C_UnrolledList_new();
+    TestHook(C_UnrolledList, list);
+    AssertHookDestroyed(
+      1, { Unref(C_UnrolledList_to_array_PR(Pass(list))); });
+  }
+
+  /* test logic */ {
+    C_UnrolledList* list = make_list(TEST_LEN);
+    C_Array* result = C_UnrolledList_to_array_PR(list);
+
+    assert_int_equal(TEST_LEN, C_Array_get_len(result));
+    C_ArrayForeach(
+      result, { assert_int_equal(iter, C_Handle_u32_get_value(value)); });
+
+    Unref(list);
+    Unref(result);
+  }
+}
+
+static void test_C_UnrolledList_push_P(void** state) {
+  (void)state;
+
+  /* test passing */ {
+    C_UnrolledList* list = C_UnrolledList_new();
+    TestHook(C_UnrolledList, list);
+
+    C_Handle_u32* handle = C_Handle_u32_new(10);
+    TestHook(C_Handle_u32, handle);
+
+    AssertHookDestroyed(
+      2, { C_UnrolledList_push_P(Pass(list), Pass(handle)); });
+  }
+
+  /* test logic */ {
+    C_UnrolledList* list = make_list(TEST_LEN);
+
+    assert_int_equal(TEST_LEN, C_UnrolledList_get_len(list));
+    for (u32 i = 0; i < TEST_LEN; i++) {
+      assert_int_equal(i, C_Handle_u32_get_value(C_UnrolledList_at_B(list, i)));
+    }
+
+    Unref(list);
+  }
+}
+
+static void test_C_UnrolledList_push_front_P(void** state) {
+  (void)state;
+
+  C_UnrolledList* list = C_UnrolledList_new();
+  for (u32 i = 0; i < TEST_LEN; i++) {
+    C_UnrolledList_push_front_P(list, Pass(C_Handle_u32_new(TEST_LEN - 1 - i)));
+  }
+
+  C_UnrolledListForeach(
+    list, { assert_int_equal(iter, C_Handle_u32_get_value(value)); });
+
+  Unref(list);
+}
+
+static void test_C_UnrolledList_pop_R(void** state) {
+  (void)state;
+
+  C_UnrolledList* list = make_list(TEST_LEN);
+
+  for (u32 i = TEST_LEN; i > 0; i--) {
+    C_Handle_u32* pop = C_UnrolledList_pop_R(list);
+    assert_int_equal(i - 1, C_Handle_u32_get_value(pop));
+    Unref(pop);
+  }
+  assert_int_equal(0, C_UnrolledList_get_len(list));
+
+  C_UnrolledList_push_P(list, Pass(C_Handle_u32_new(7)));
+  assert_int_equal(7, C_Handle_u32_get_value(C_UnrolledList_peek_B(list)));
+
+  Unref(list);
+}
+
+static void test_C_UnrolledList_pop_front_R(void** state) {
+  (void)state;
+
+  C_UnrolledList* list = make_list(TEST_LEN);
+
+  for (u32 i = 0; i < TEST_LEN; i++) {
+    C_Handle_u32* pop = C_UnrolledList_pop_front_R(list);
+    assert_int_equal(i, C_Handle_u32_get_value(pop));
+    Unref(pop);
+  }
+  assert_int_equal(0, C_UnrolledList_get_len(list));
+
+  Unref(list);
+}
+
+static void test_C_UnrolledList_peek(void** state) {
+  (void)state;
+
+  C_UnrolledList* list = make_list(TEST_LEN);
+
+  assert_int_equal(
+    TEST_LEN - 1, C_Handle_u32_get_value(C_UnrolledList_peek_B(list)));
+  assert_int_equal(0, C_Handle_u32_get_value(C_UnrolledList_peek_front_B(list)));
+
+  C_Handle_u32* peek = C_UnrolledList_peek_R(list);
+  C_Handle_u32* peek_front = C_UnrolledList_peek_front_R(list);
+  assert_int_equal(TEST_LEN - 1, C_Handle_u32_get_value(peek));
+  assert_int_equal(0, C_Handle_u32_get_value(peek_front));
+
+  assert_int_equal(TEST_LEN, C_UnrolledList_get_len(list));
+
+  Unref(peek);
+  Unref(peek_front);
+  Unref(list);
+}
+
+static void test_C_UnrolledList_add_P(void** state) {
+  (void)state;
+
+  /* test passing */ {
+    C_UnrolledList* list = C_UnrolledList_new();
+    TestHook(C_UnrolledList, list);
+    C_Handle_u32* handle = C_Handle_u32_new(10);
+    TestHook(C_Handle_u32, handle);
+
+    AssertHookDestroyed(
+      2, { C_UnrolledList_add_P(Pass(list), 0, Pass(handle)); });
+  }
+
+  /* test logic: inserting the odd numbers into the middle of full nodes */ {
+    C_UnrolledList* list = C_UnrolledList_new();
+    for (u32 i = 0; i < TEST_LEN; i++) {
+      C_UnrolledList_push_P(list, Pass(C_Handle_u32_new(i * 2)));
+    }
+    for (u32 i = 0; i < TEST_LEN; i++) {
+      C_UnrolledList_add_P(list, i * 2 + 1, Pass(C_Handle_u32_new(i * 2 + 1)));
+    }
+
+    assert_int_equal(TEST_LEN * 2, C_UnrolledList_get_len(list));
+    C_UnrolledListForeach(
+      list, { assert_int_equal(iter, C_Handle_u32_get_value(value)); });
+    for (u32 i = 0; i < TEST_LEN * 2; i++) {
+      assert_int_equal(i, C_Handle_u32_get_value(C_UnrolledList_at_B(list, i)));
+    }
+
+    Unref(list);
+  }
+}
+
+static void test_C_UnrolledList_at_R(void** state) {
+  (void)state;
+
+  C_UnrolledList* list = make_list(TEST_LEN);
+
+  C_Handle_u32* val0 = C_UnrolledList_at_R(list, 0);
+  C_Handle_u32* val1 = C_UnrolledList_at_R(list, UnrolledNodeCap);
+  C_Handle_u32* val2 = C_UnrolledList_at_R(list, TEST_LEN - 1);
+
+  assert_int_equal(0, C_Handle_u32_get_value(val0));
+  assert_int_equal(UnrolledNodeCap, C_Handle_u32_get_value(val1));
+  assert_int_equal(TEST_LEN - 1, C_Handle_u32_get_value(val2));
+
+  Unref(val0);
+  Unref(val1);
+  Unref(val2);
+  Unref(list);
+}
+
+static void test_C_UnrolledList_remove_R(void** state) {
+  (void)state;
+
+  C_UnrolledList* list = make_list(TEST_LEN);
+
+  /* remove every even value, front to back */
+  for (u32 i = 0; i < (TEST_LEN + 1) / 2; i++) {
+    C_Handle_u32* removed = C_UnrolledList_remove_R(list, i);
+    assert_int_equal(i * 2, C_Handle_u32_get_value(removed));
+    Unref(removed);
+  }
+
+  assert_int_equal(TEST_LEN / 2, C_UnrolledList_get_len(list));
+  C_UnrolledListForeach(
+    list, { assert_int_equal(iter * 2 + 1, C_Handle_u32_get_value(value)); });
+
+  while (C_UnrolledList_get_len(list) != 0) {
+    Unref(C_UnrolledList_remove_R(list, C_UnrolledList_get_len(list) / 2));
+  }
+
+  Unref(list);
+}
+
+static void test_C_UnrolledList_clear(void** state) {
+  (void)state;
+
+  C_UnrolledList* list = make_list(TEST_LEN);
+
+  C_UnrolledList_clear(list);
+  assert_int_equal(0, C_UnrolledList_get_len(list));
+
+  C_UnrolledList_push_P(list, Pass(C_Handle_u32_new(50)));
+  assert_int_equal(1, C_UnrolledList_get_len(list));
+
+  Unref(list);
+}
+
+static void test_C_UnrolledList_equals(void** state) {
+  (void)state;
+
+  C_UnrolledList* list = make_list(TEST_LEN);
+  C_UnrolledList* list2 = make_list(TEST_LEN);
+
+  assert_true(C_UnrolledList_equals(list, list2));
+
+  Unref(C_UnrolledList_pop_R(list));
+
+  assert_false(C_UnrolledList_equals(list, list2));
+
+  Unref(list);
+  Unref(list2);
+}
+
+static void test_C_UnrolledList_to_str_format_R(void** state) {
+  (void)state;
+
+  C_UnrolledList* list = make_list(3);
+
+  C_String* correct_result = S("{0, 1, 2}");
+  C_String* format = S("start={;end=};sep=, ");
+  C_String* result = C_UnrolledList_to_str_format_R(list, format);
+
+  assert_true(C_String_equals(correct_result, result));
+
+  Unref(format);
+  Unref(correct_result);
+  Unref(result);
+  Unref(list);
+}
+
+int main(void) {
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_C_UnrolledListForeach),
+    cmocka_unit_test(test_C_UnrolledList_new),
+    cmocka_unit_test(test_C_UnrolledList_destroy),
+    cmocka_unit_test(test_C_UnrolledList_to_array_PR),
+    cmocka_unit_test(test_C_UnrolledList_push_P),
+    cmocka_unit_test(test_C_UnrolledList_push_front_P),
+    cmocka_unit_test(test_C_UnrolledList_pop_R),
+    cmocka_unit_test(test_C_UnrolledList_pop_front_R),
+    cmocka_unit_test(test_C_UnrolledList_peek),
+    cmocka_unit_test(test_C_UnrolledList_add_P),
+    cmocka_unit_test(test_C_UnrolledList_at_R),
+    cmocka_unit_test(test_C_UnrolledList_remove_R),
+    cmocka_unit_test(test_C_UnrolledList_clear),
+    cmocka_unit_test(test_C_UnrolledList_equals),
+    cmocka_unit_test(test_C_UnrolledList_to_str_format_R),
+  };
+
+  return cmocka_run_group_tests(tests, null, test_teardown);
+}
@@ -0,0 +1,252 @@
+// clang-format off
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <cmocka.h>
+// clang-format on
+
+#include "../test_helpers.h"
+#include "c_base/base/memory/allocator.h"
+#include "c_base/base/strings/strings.h"
+#include <c_base/base/memory/handles.h>
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_DArray.h>
+#include <c_base/ds/C_Vec.h>
+
+/* more than the starting capacity, so the vec grows */
+#define TEST_LEN 37
+
+CreateTestHook(C_Vec_u32, C_Vec_u32_destroy)
+CreateTestHook(C_DArray, C_DArray_destroy)
+
+static C_Vec_u32* make_vec(u32 len) {
+  C_Vec_u32* vec = C_Vec_u32_new();
+  for (u32 i = 0; i < len; i++) {
+    C_Vec_u32_push(vec, i);
+  }
+  return vec;
+}
+
+static void test_C_Vec_new_cap(void** state) {
+  (void)state;
+
+  C_Vec_u32* vec = C_Vec_u32_new_cap(100);
+
+  AssertClassEqual(vec, ClassObject_id);
+  assert_int_equal(0, C_Vec_u32_get_len(vec));
+  assert_int_equal(100, C_Vec_u32_get_cap(vec));
+
+  Unref(vec);
+}
+
+static void test_C_Vec_push(void** state) {
+  (void)state;
+
+  C_Vec_u32* vec = make_vec(TEST_LEN);
+
+  assert_int_equal(TEST_LEN, C_Vec_u32_get_len(vec));
+  u32* data = C_Vec_u32_get_data(vec);
+  for (u32 i = 0; i < TEST_LEN; i++) {
+    assert_int_equal(i, C_Vec_u32_at(vec, i));
+    assert_int_equal(i, data[i]);
+  }
+
+  u32 many[] = {100, 101, 102};
+  C_Vec_u32_push_many(vec, many, 3);
+  assert_int_equal(TEST_LEN + 3, C_Vec_u32_get_len(vec));
+  assert_int_equal(102, C_Vec_u32_at(vec, TEST_LEN + 2));
+
+  Unref(vec);
+
+  // the vec's own data, past its capacity
+  vec = C_Vec_u32_new_from(many, 3);
+  for (u32 round = 0; round < 4; round++) {
+    C_Vec_u32_push_many(vec, C_Vec_u32_get_data(vec), C_Vec_u32_get_len(vec));
+  }
+  assert_int_equal(48, C_Vec_u32_get_len(vec));
+  for (u32 i = 0; i < 48; i++) {
+    assert_int_equal(100 + i % 3, C_Vec_u32_at(vec, i));
+  }
+
+  Unref(vec);
+}
+
+static void test_C_Vec_pop(void** state) {
+  (void)state;
+
+  C_Vec_u32* vec = make_vec(TEST_LEN);
+
+  for (u32 i = TEST_LEN; i > 0; i--) {
+    assert_int_equal(i - 1, C_Vec_u32_pop(vec));
+  }
+  assert_int_equal(0, C_Vec_u32_get_len(vec));
+
+  Unref(vec);
+}
+
+static void test_C_Vec_put(void** state) {
+  (void)state;
+
+  C_Vec_u32* vec = make_vec(TEST_LEN);
+
+  C_Vec_u32_put(vec, 5, 1000);
+  assert_int_equal(1000, C_Vec_u32_at(vec, 5));
+  assert_int_equal(6, C_Vec_u32_at(vec, 6));
+
+  Unref(vec);
+}
+
+static void test_C_Vec_resize(void** state) {
+  (void)state;
+
+  C_Vec_u32* vec = make_vec(4);
+
+  C_Vec_u32_resize(vec, 2);
+  assert_int_equal(2, C_Vec_u32_get_len(vec));
+
+  C_Vec_u32_resize(vec, TEST_LEN);
+  assert_int_equal(TEST_LEN, C_Vec_u32_get_len(vec));
+  assert_true(C_Vec_u32_get_cap(vec) >= TEST_LEN);
+  assert_int_equal(1, C_Vec_u32_at(vec, 1));
+  for (u32 i = 2; i < TEST_LEN; i++) {
+    assert_int_equal(0, C_Vec_u32_at(vec, i));
+  }
+
+  Unref(vec);
+}
+
+static void test_C_Vec_slice_R(void** state) {
+  (void)state;
+
+  C_Vec_u32* vec = make_vec(TEST_LEN);
+
+  C_Vec_u32* slice = C_Vec_u32_slice_R(vec, 10, 20);
+  assert_int_equal(10, C_Vec_u32_get_len(slice));
+  for (u32 i = 0; i < 10; i++) {
+    assert_int_equal(10 + i, C_Vec_u32_at(slice, i));
+  }
+
+  // the slice is a copy
+  C_Vec_u32_put(slice, 0, 1000);
+  assert_int_equal(10, C_Vec_u32_at(vec, 10));
+
+  C_Vec_u32* empty = C_Vec_u32_slice_R(vec, 5, 5);
+  assert_int_equal(0, C_Vec_u32_get_len(empty));
+
+  Unref(empty);
+  Unref(slice);
+  Unref(vec);
+}
+
+static void test_C_Vec_darray(void** state) {
+  (void)state;
+
+  /* test passing */ {
+    C_Vec_u32* vec = C_Vec_u32_new();
+    TestHook(C_Vec_u32, vec);
+    AssertHookDestroyed(1, { Unref(C_Vec_u32_to_darray_PR(Pass(vec))); });
+
+    C_DArray* darray = C_DArray_new();
+    TestHook(C_DArray, darray);
+    AssertHookDestroyed(1, { Unref(C_Vec_u32_from_darray_P(Pass(darray))); });
+  }
+
+  C_Vec_u32* vec = make_vec(TEST_LEN);
+  C_DArray* darray = C_Vec_u32_to_darray_PR(vec);
+
+  assert_int_equal(TEST_LEN, C_DArray_get_len(darray));
+  C_DArrayForeach(
+    darray, { assert_int_equal(iter, C_Handle_u32_get_value(value)); });
+
+  C_Vec_u32* back = C_Vec_u32_from_darray_P(darray);
+  assert_true(C_Vec_u32_equals(vec, back));
+
+  Unref(back);
+  Unref(darray);
+  Unref(vec);
+}
+
+static void test_C_Vec_f64(void** state) {
+  (void)state;
+
+  C_Vec_f64* vec = C_Vec_f64_new();
+  C_Vec_f64_push(vec, 1.5);
+  C_Vec_f64_push(vec, -0.25);
+  C_Vec_f64_push(vec, 3);
+
+  f64 sum = 0;
+  for (u32 i = 0; i < C_Vec_f64_get_len(vec); i++) {
+    sum += C_Vec_f64_at(vec, i);
+  }
+  assert_true(sum == 4.25);
+
+  C_DArray* darray = C_Vec_f64_to_darray_PR(vec);
+  assert_true(C_Handle_f64_get_value(C_DArray_at_B(darray, 1)) == -0.25);
+
+  // float keys sort like their values
+  C_DArray_sort(darray);
+  assert_true(C_Handle_f64_get_value(C_DArray_at_B(darray, 0)) == -0.25);
+  assert_true(C_Handle_f64_get_value(C_DArray_at_B(darray, 2)) == 3);
+
+  C_String* correct_result = S("[1.5, -0.25, 3.0]");
+  C_String* result = C_Vec_f64_to_str_R(vec);
+  assert_true(C_String_equals(correct_result, result));
+
+  Unref(correct_result);
+  Unref(result);
+  Unref(darray);
+  Unref(vec);
+}
+
+static void test_C_Vec_equals(void** state) {
+  (void)state;
+
+  C_Vec_u32* vec = make_vec(TEST_LEN);
+  C_Vec_u32* vec2 = make_vec(TEST_LEN);
+
+  assert_true(C_Vec_u32_equals(vec, vec2));
+  assert_int_equal(C_Vec_u32_hash(vec), C_Vec_u32_hash(vec2));
+
+  C_Vec_u32_put(vec2, 3, 1000);
+  assert_false(C_Vec_u32_equals(vec, vec2));
+
+  C_Vec_u32_pop(vec);
+  assert_false(C_Vec_u32_equals(vec, vec2));
+
+  Unref(vec);
+  Unref(vec2);
+}
+
+static void test_C_Vec_to_str_format_R(void** state) {
+  (void)state;
+
+  C_Vec_u32* vec = make_vec(3);
+
+  C_String* correct_result = S("{0, 1, 2}");
+  C_String* format = S("start={;end=};sep=, ");
+  C_String* result = C_Vec_u32_to_str_format_R(vec, format);
+
+  assert_true(C_String_equals(correct_result, result));
+
+  Unref(format);
+  Unref(correct_result);
+  Unref(result);
+  Unref(vec);
+}
+
+int main(void) {
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_C_Vec_new_cap),
+    cmocka_unit_test(test_C_Vec_push),
+    cmocka_unit_test(test_C_Vec_pop),
+    cmocka_unit_test(test_C_Vec_put),
+    cmocka_unit_test(test_C_Vec_resize),
+    cmocka_unit_test(test_C_Vec_slice_R),
+    cmocka_unit_test(test_C_Vec_darray),
+    cmocka_unit_test(test_C_Vec_f64),
+    cmocka_unit_test(test_C_Vec_equals),
+    cmocka_unit_test(test_C_Vec_to_str_format_R),
+  };
+
+  return cmocka_run_group_tests(tests, null, test_teardown);
+}
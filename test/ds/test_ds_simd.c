@@ -0,0 +1,185 @@
+// clang-format off
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <cmocka.h>
+// clang-format on
+
+#include "../test_helpers.h"
+#include <c_base/base/memory/allocator.h>
+#include <c_base/ds/ds_simd.h>
+
+/* not a multiple of any vector width, so every kernel runs its tail */
+#define TEST_LEN 1003
+
+static u64 rand_state = 88172645463325252ull;
+
+static u64 test_rand(void) {
+  rand_state ^= rand_state << 13;
+  rand_state ^= rand_state >> 7;
+  rand_state ^= rand_state << 17;
+  return rand_state;
+}
+
+/* runs the kernels on every level the cpu has and compares them with the
+ * scalar results. floats hold small integers so their sums are exact */
+#define TestSimdKernels(T, A, make_value)                                      \
+  static void test_simd_##T(void** state) {                                    \
+    (void)state;                                                               \
+                                                                               \
+    T* a = allocate(TEST_LEN * sizeof(T));                                     \
+    T* b = allocate(TEST_LEN * sizeof(T));                                     \
+    T* expected = allocate(TEST_LEN * sizeof(T));                              \
+    T* result = allocate(TEST_LEN * sizeof(T));                                \
+    for (u32 i = 0; i < TEST_LEN; i++) {                                       \
+      a[i] = make_value;                                                       \
+      b[i] = make_value;                                                       \
+    }                                                                          \
+    /* the minimum twice and near the end, argmin must pick the first */       \
+    a[TEST_LEN - 5] = 0;                                                       \
+    a[TEST_LEN - 2] = 0;                                                       \
+    T needle = a[700];                                                         \
+                                                                               \
+    simd_set_level(SIMD_SCALAR);                                               \
+    A sum = simd_sum_##T(a, TEST_LEN);                                         \
+    T min = simd_min_##T(a, TEST_LEN);                                         \
+    T max = simd_max_##T(a, TEST_LEN);                                         \
+    u32 argmin = simd_argmin_##T(a, TEST_LEN);                                 \
+    u32 find = simd_find_##T(a, TEST_LEN, needle);                             \
+    u32 count = simd_count_##T(a, TEST_LEN, needle);                           \
+    A dot = simd_dot_##T(a, b, TEST_LEN);                                      \
+                                                                               \
+    assert_int_equal(TEST_LEN - 5, argmin);                                    \
+    assert_true(find <= 700);                                                  \
+    assert_true(count >= 1);                                                   \
+    assert_int_equal(TEST_LEN, simd_find_##T(b, TEST_LEN, (T)7777777));        \
+                                                                               \
+    SimdLevel max_level = simd_detect_level();                                 \
+    for (SimdLevel level = SIMD_SCALAR; level <= max_level; level++) {         \
+      assert_int_equal(level, simd_set_level(level));                          \
+                                                                               \
+      assert_true(sum == simd_sum_##T(a, TEST_LEN));                           \
+      assert_true(min == simd_min_##T(a, TEST_LEN));                           \
+      assert_true(max == simd_max_##T(a, TEST_LEN));                           \
+      assert_int_equal(argmin, simd_argmin_##T(a, TEST_LEN));                  \
+      assert_int_equal(find, simd_find_##T(a, TEST_LEN, needle));              \
+      assert_int_equal(count, simd_count_##T(a, TEST_LEN, needle));           \
+      assert_true(dot == simd_dot_##T(a, b, TEST_LEN));                        \
+                                                                               \
+      /* short inputs never reach the vector loop */                           \
+      assert_true(a[1] == simd_max_##T(a + 1, 1));                             \
+      assert_int_equal(0, simd_count_##T(a, 0, needle));                       \
+                                                                               \
+      simd_add_##T(result, a, b, TEST_LEN);                                    \
+      for (u32 i = 0; i < TEST_LEN; i++) {                                     \
+        assert_true((T)(a[i] + b[i]) == result[i]);                            \
+      }                                                                        \
+      simd_mul_##T(result, a, b, TEST_LEN);                                    \
+      for (u32 i = 0; i < TEST_LEN; i++) {                                     \
+        assert_true((T)(a[i] * b[i]) == result[i]);                            \
+      }                                                                        \
+      simd_scale_##T(result, a, 3, TEST_LEN);                                  \
+      for (u32 i = 0; i < TEST_LEN; i++) {                                     \
+        assert_true((T)(a[i] * 3) == result[i]);                               \
+      }                                                                        \
+                                                                               \
+      /* dst may be one of the inputs */                                       \
+      for (u32 i = 0; i < TEST_LEN; i++) {                                     \
+        expected[i] = a[i];                                                    \
+      }                                                                        \
+      simd_add_##T(expected, expected, b, TEST_LEN);                           \
+      simd_add_##T(result, a, b, TEST_LEN);                                    \
+      for (u32 i = 0; i < TEST_LEN; i++) {                                     \
+        assert_true(expected[i] == result[i]);                                 \
+      }                                                                        \
+    }                                                                          \
+                                                                               \
+    simd_set_level(max_level);                                                 \
+    deallocate(a);                                                             \
+    deallocate(b);                                                             \
+    deallocate(expected);                                                      \
+    deallocate(result);                                                        \
+  }
+
+// values above 2^31 catch signed compares
+TestSimdKernels(u32, u64, (u32)test_rand() | 1)
+// values that only differ in the low half catch broken 64 bit compares
+TestSimdKernels(u64, u64, ((u64)3 << 40) + (test_rand() & 0xffff) + 1)
+TestSimdKernels(f32, f32, (f32)(test_rand() % 64) + 1)
+TestSimdKernels(f64, f64, (f64)(test_rand() % 1024) + 1)
+
+static void test_simd_bits(void** state) {
+  (void)state;
+
+  u64* a = allocate(TEST_LEN * sizeof(u64));
+  u64* b = allocate(TEST_LEN * sizeof(u64));
+  u64* result = allocate(TEST_LEN * sizeof(u64));
+  for (u32 i = 0; i < TEST_LEN; i++) {
+    a[i] = test_rand();
+    b[i] = test_rand();
+  }
+  a[7] = ~0ull;
+
+  u64 count = 0;
+  for (u32 i = 0; i < TEST_LEN; i++) {
+    for (u32 bit = 0; bit < 64; bit++) {
+      count += (a[i] >> bit) & 1;
+    }
+  }
+
+  SimdLevel max_level = simd_detect_level();
+  for (SimdLevel level = SIMD_SCALAR; level <= max_level; level++) {
+    simd_set_level(level);
+
+    assert_int_equal(count, simd_popcount_bits(a, TEST_LEN));
+    assert_int_equal(64, simd_popcount_bits(a + 7, 1));
+
+    simd_and_bits(result, a, b, TEST_LEN);
+    for (u32 i = 0; i < TEST_LEN; i++) {
+      assert_true((a[i] & b[i]) == result[i]);
+    }
+    simd_or_bits(result, a, b, TEST_LEN);
+    for (u32 i = 0; i < TEST_LEN; i++) {
+      assert_true((a[i] | b[i]) == result[i]);
+    }
+    simd_xor_bits(result, a, b, TEST_LEN);
+    for (u32 i = 0; i < TEST_LEN; i++) {
+      assert_true((a[i] ^ b[i]) == result[i]);
+    }
+    simd_andnot_bits(result, a, b, TEST_LEN);
+    for (u32 i = 0; i < TEST_LEN; i++) {
+      assert_true((a[i] & ~b[i]) == result[i]);
+    }
+  }
+
+  simd_set_level(max_level);
+  deallocate(a);
+  deallocate(b);
+  deallocate(result);
+}
+
+static void test_simd_set_level(void** state) {
+  (void)state;
+
+  SimdLevel max_level = simd_detect_level();
+
+  assert_int_equal(SIMD_SCALAR, simd_set_level(SIMD_SCALAR));
+  assert_int_equal(SIMD_SCALAR, simd_get_level());
+
+  // capped at what the cpu supports
+  assert_int_equal(max_level, simd_set_level(SIMD_AVX2));
+  assert_int_equal(max_level, simd_get_level());
+}
+
+int main(void) {
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_simd_u32),
+    cmocka_unit_test(test_simd_u64),
+    cmocka_unit_test(test_simd_f32),
+    cmocka_unit_test(test_simd_f64),
+    cmocka_unit_test(test_simd_bits),
+    cmocka_unit_test(test_simd_set_level),
+  };
+
+  return cmocka_run_group_tests(tests, null, test_teardown);
+}
@@ -0,0 +1,98 @@
+// clang-format off
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <cmocka.h>
+// clang-format on
+
+#include "../test_helpers.h"
+#include "c_base/base/memory/allocator.h"
+#include <c_base/base/memory/objects.h>
+#include <c_base/ds/C_Array.h>
+#include <c_base/os/os_threads.h>
+
+#define THREAD_COUNT 8
+#define THREAD_LEN 1000000
+
+/* every thread adds THREAD_LEN to the counter, one at a time under the lock.
+ * the increment is not atomic, a lost update means the lock let two in */
+typedef struct {
+  ClassObject base;
+  Mutex* lock;
+  u64* counter;
+} CounterJob;
+
+static void CounterJob_destroy(void* self) { (void)self; }
+
+static void counter_func(C_Thread* thread) {
+  CounterJob* job = C_Thread_get_arg_B(thread, 0);
+  for (u32 i = 0; i < THREAD_LEN; i++) {
+    Mutex_lock(job->lock);
+    (*job->counter)++;
+    Mutex_unlock(job->lock);
+
+    // allocate takes its own lock, so threads also wait on that one
+    if (i % 64 == 0) {
+      deallocate(allocate(64));
+    }
+  }
+}
+
+static void test_Mutex_lock(void** state) {
+  (void)state;
+
+  Mutex lock = Mutex_construct();
+  for (u32 i = 0; i < 10; i++) {
+    Mutex_lock(&lock);
+    Mutex_unlock(&lock);
+  }
+  assert_int_equal(0, lock.ftx);
+}
+
+static void test_Mutex_contention(void** state) {
+  (void)state;
+
+  Mutex lock = Mutex_construct();
+  u64 counter = 0;
+
+  CounterJob* jobs[THREAD_COUNT];
+  C_Array* args[THREAD_COUNT];
+  C_Thread* threads[THREAD_COUNT];
+
+  for (u32 i = 0; i < THREAD_COUNT; i++) {
+    jobs[i] = allocate(sizeof(CounterJob));
+    jobs[i]->base = ClassObject_construct(CounterJob_destroy, null);
+    jobs[i]->lock = &lock;
+    jobs[i]->counter = &counter;
+    args[i] = C_Array_new(1);
+    C_Array_put_P(args[i], 0, jobs[i]);
+
+    threads[i] = C_Thread_new(counter_func, args[i]);
+    C_EmptyResult* result = C_Thread_run(threads[i]);
+    assert_true(C_EmptyResult_get_ok(result));
+    Unref(result);
+  }
+
+  for (u32 i = 0; i < THREAD_COUNT; i++) {
+    C_Thread_join(threads[i]);
+  }
+
+  assert_int_equal((u64)THREAD_COUNT * THREAD_LEN, counter);
+  // no thread is left waiting on the lock
+  assert_int_equal(0, lock.ftx);
+
+  for (u32 i = 0; i < THREAD_COUNT; i++) {
+    Unref(threads[i]);
+    Unref(args[i]);
+    Unref(jobs[i]);
+  }
+}
+
+int main(void) {
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_Mutex_lock),
+    cmocka_unit_test(test_Mutex_contention),
+  };
+
+  return cmocka_run_group_tests(tests, null, test_teardown);
+}